@@ -64,8 +64,9 @@ func InvalidArgumentError(message string) error {
 type Durability uint32
 
 const (
-	DurabilityFast  Durability = 0
-	DurabilityFlush Durability = 1
+	DurabilityFast        Durability = 0
+	DurabilityFlush       Durability = 1
+	DurabilityGroupCommit Durability = 2
 )
 
 type AppendConfig struct {
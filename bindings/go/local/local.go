@@ -59,19 +59,27 @@ type Pool struct {
 	ptr *C.plsm_pool_t
 }
 
+// streamBatchSize caps how many messages one batch call into the C ABI drains.
+const streamBatchSize = 64
+
 type Stream struct {
-	ptr *C.plsm_stream_t
+	ptr     *C.plsm_stream_t
+	pending [][]byte
+	offsets []C.size_t
 }
 
 type Lite3Stream struct {
-	ptr *C.plsm_lite3_stream_t
+	ptr     *C.plsm_lite3_stream_t
+	pending []*Lite3Frame
+	frames  []C.plsm_lite3_frame_t
 }
 
 type Durability = api.Durability
 
 const (
-	DurabilityFast  Durability = api.DurabilityFast
-	DurabilityFlush Durability = api.DurabilityFlush
+	DurabilityFast        Durability = api.DurabilityFast
+	DurabilityFlush       Durability = api.DurabilityFlush
+	DurabilityGroupCommit Durability = api.DurabilityGroupCommit
 )
 
 type PoolRef = api.PoolRef
@@ -392,16 +400,37 @@ func (s *Stream) NextJSON() ([]byte, error) {
 	if s == nil || s.ptr == nil {
 		return nil, closedError("stream")
 	}
-	var cBuf C.plsm_buf_t
+	if len(s.pending) == 0 {
+		if err := s.fill(); err != nil {
+			return nil, err
+		}
+	}
+	msg := s.pending[0]
+	s.pending[0] = nil
+	s.pending = s.pending[1:]
+	return msg, nil
+}
+
+// fill refills pending with one plsm_stream_next_batch call.
+func (s *Stream) fill() error {
+	if s.offsets == nil {
+		s.offsets = make([]C.size_t, streamBatchSize+1)
+	}
+	var cArena C.plsm_buf_t
 	var cErr *C.plsm_error_t
-	rc := C.plsm_stream_next(s.ptr, &cBuf, &cErr)
-	switch rc {
-	case 1:
-		return copyAndFreeBuf(&cBuf), nil
-	case 0:
-		return nil, io.EOF
+	rc := C.plsm_stream_next_batch(s.ptr, C.size_t(streamBatchSize), &cArena, &s.offsets[0], &cErr)
+	switch {
+	case rc > 0:
+		arena := copyAndFreeBuf(&cArena)
+		s.pending = make([][]byte, 0, int(rc))
+		for i := 0; i < int(rc); i++ {
+			s.pending = append(s.pending, arena[s.offsets[i]:s.offsets[i+1]:s.offsets[i+1]])
+		}
+		return nil
+	case rc == 0:
+		return io.EOF
 	default:
-		return nil, fromCError(cErr)
+		return fromCError(cErr)
 	}
 }
 
@@ -409,16 +438,48 @@ func (s *Lite3Stream) Next() (*Lite3Frame, error) {
 	if s == nil || s.ptr == nil {
 		return nil, closedError("stream")
 	}
-	var cFrame C.plsm_lite3_frame_t
+	if len(s.pending) == 0 {
+		if err := s.fill(); err != nil {
+			return nil, err
+		}
+	}
+	frame := s.pending[0]
+	s.pending[0] = nil
+	s.pending = s.pending[1:]
+	return frame, nil
+}
+
+// fill refills pending with one plsm_lite3_stream_next_batch call.
+func (s *Lite3Stream) fill() error {
+	if s.frames == nil {
+		s.frames = make([]C.plsm_lite3_frame_t, streamBatchSize)
+	}
+	var cArena C.plsm_buf_t
 	var cErr *C.plsm_error_t
-	rc := C.plsm_lite3_stream_next(s.ptr, &cFrame, &cErr)
-	switch rc {
-	case 1:
-		return copyAndFreeLite3Frame(&cFrame), nil
-	case 0:
-		return nil, io.EOF
+	rc := C.plsm_lite3_stream_next_batch(s.ptr, C.size_t(len(s.frames)), &s.frames[0], &cArena, &cErr)
+	switch {
+	case rc > 0:
+		// Frame payloads point into the arena, so copy them out before freeing it once.
+		s.pending = make([]*Lite3Frame, 0, int(rc))
+		for i := 0; i < int(rc); i++ {
+			frame := &s.frames[i]
+			var payload []byte
+			if frame.payload.data != nil && frame.payload.len != 0 {
+				payload = C.GoBytes(unsafe.Pointer(frame.payload.data), C.int(frame.payload.len))
+			}
+			s.pending = append(s.pending, &Lite3Frame{
+				Seq:         uint64(frame.seq),
+				TimestampNs: uint64(frame.timestamp_ns),
+				Flags:       uint32(frame.flags),
+				Payload:     payload,
+			})
+		}
+		C.plsm_buf_free(&cArena)
+		return nil
+	case rc == 0:
+		return io.EOF
 	default:
-		return nil, fromCError(cErr)
+		return fromCError(cErr)
 	}
 }
 
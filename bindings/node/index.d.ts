@@ -5,7 +5,8 @@
 
 export const enum Durability {
   Fast = 0,
-  Flush = 1
+  Flush = 1,
+  GroupCommit = 2
 }
 export const enum ErrorKind {
   Internal = 1,
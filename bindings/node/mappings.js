@@ -3,7 +3,7 @@ Purpose: Centralize Node binding value mappings shared across local and remote p
 Key Exports: ERROR_KIND_VALUES, mapErrorKind, mapDurability.
 Role: Keep error-kind and durability normalization behavior consistent.
 Invariants: Error kind names map to stable numeric values for v0 semantics.
-Invariants: Durability accepts fast/flush and numeric enum aliases 0/1.
+Invariants: Durability accepts fast/flush/group and numeric enum aliases 0/1/2.
 */
 
 const ERROR_KIND_VALUES = Object.freeze({
@@ -20,8 +20,10 @@ const ERROR_KIND_VALUES = Object.freeze({
 const DURABILITY_VALUES = Object.freeze({
   fast: "fast",
   flush: "flush",
+  group: "group",
   0: "fast",
   1: "flush",
+  2: "group",
 });
 
 function mapErrorKind(value, fallback = undefined) {
@@ -45,7 +47,7 @@ function mapDurability(value) {
   if (mapped) {
     return mapped;
   }
-  throw new TypeError("durability must be Durability.Fast or Durability.Flush");
+  throw new TypeError("durability must be Durability.Fast, Durability.Flush, or Durability.GroupCommit");
 }
 
 module.exports = {
@@ -165,6 +165,7 @@ unsafe extern "C" {
 pub enum Durability {
     Fast = 0,
     Flush = 1,
+    GroupCommit = 2,
 }
 
 #[napi]
@@ -397,7 +397,7 @@ test("remote append rejects invalid durability before fetch", async () => {
     const pool = new RemotePool(client, "demo");
     await assert.rejects(
       pool.append({ value: 1 }, [], "bogus"),
-      /durability must be Durability\.Fast or Durability\.Flush/
+      /durability must be Durability\.Fast, Durability\.Flush, or Durability\.GroupCommit/
     );
     assert.equal(called, false);
   } finally {
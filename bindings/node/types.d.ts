@@ -10,6 +10,7 @@ Notes: Canonical declaration source for package typing (`package.json#types`).
 export const enum Durability {
   Fast = 0,
   Flush = 1,
+  GroupCommit = 2,
 }
 
 export const enum ErrorKind {
@@ -23,6 +23,7 @@ from ctypes import (
     c_uint8,
     c_void_p,
 )
+from collections import deque
 from datetime import datetime, timezone
 from enum import IntEnum
 import json
@@ -47,6 +48,7 @@ class ErrorKind(IntEnum):
 class Durability(IntEnum):
     FAST = 0
     FLUSH = 1
+    GROUP_COMMIT = 2
 
 
 class PlasmiteError(RuntimeError):
@@ -303,6 +305,27 @@ _LIB.plsm_lite3_stream_next.argtypes = [
 ]
 _LIB.plsm_lite3_stream_next.restype = c_int
 
+_LIB.plsm_stream_next_batch.argtypes = [
+    POINTER(plsm_stream_t),
+    c_size_t,
+    POINTER(plsm_buf_t),
+    POINTER(c_size_t),
+    POINTER(POINTER(plsm_error_t)),
+]
+_LIB.plsm_stream_next_batch.restype = c_int
+
+_LIB.plsm_lite3_stream_next_batch.argtypes = [
+    POINTER(plsm_lite3_stream_t),
+    c_size_t,
+    POINTER(plsm_lite3_frame_t),
+    POINTER(plsm_buf_t),
+    POINTER(POINTER(plsm_error_t)),
+]
+_LIB.plsm_lite3_stream_next_batch.restype = c_int
+
+# Messages drained per batch call into the C ABI by Stream/Lite3Stream iterators.
+_STREAM_BATCH_SIZE = 64
+
 _LIB.plsm_stream_free.argtypes = [POINTER(plsm_stream_t)]
 _LIB.plsm_stream_free.restype = None
 
@@ -760,17 +783,26 @@ class Pool:
 class Stream:
     def __init__(self, ptr: POINTER(plsm_stream_t)) -> None:
         self._ptr = ptr
+        self._pending: deque[bytes] = deque()
+        self._offsets = (c_size_t * (_STREAM_BATCH_SIZE + 1))()
 
     def next_json(self) -> Optional[bytes]:
         _require_open(self._ptr, "stream")
-        buf = plsm_buf_t()
+        if self._pending:
+            return self._pending.popleft()
+        arena = plsm_buf_t()
         out_err = POINTER(plsm_error_t)()
-        rc = _LIB.plsm_stream_next(self._ptr, byref(buf), byref(out_err))
-        if rc == 1:
-            return _buf_to_bytes(buf)
+        rc = _LIB.plsm_stream_next_batch(
+            self._ptr, _STREAM_BATCH_SIZE, byref(arena), self._offsets, byref(out_err)
+        )
         if rc == 0:
             return None
-        raise _take_error(out_err)
+        if rc < 0:
+            raise _take_error(out_err)
+        data = _buf_to_bytes(arena)
+        offsets = self._offsets
+        self._pending.extend(data[offsets[i] : offsets[i + 1]] for i in range(rc))
+        return self._pending.popleft()
 
     def __iter__(self) -> Stream:
         return self
@@ -800,17 +832,36 @@ class Stream:
 class Lite3Stream:
     def __init__(self, ptr: POINTER(plsm_lite3_stream_t)) -> None:
         self._ptr = ptr
+        self._pending: deque[Lite3Frame] = deque()
+        self._frames = (plsm_lite3_frame_t * _STREAM_BATCH_SIZE)()
 
     def next(self) -> Optional[Lite3Frame]:
         _require_open(self._ptr, "stream")
-        frame = plsm_lite3_frame_t()
+        if self._pending:
+            return self._pending.popleft()
+        arena = plsm_buf_t()
         out_err = POINTER(plsm_error_t)()
-        rc = _LIB.plsm_lite3_stream_next(self._ptr, byref(frame), byref(out_err))
-        if rc == 1:
-            return _frame_to_py(frame)
+        rc = _LIB.plsm_lite3_stream_next_batch(
+            self._ptr, _STREAM_BATCH_SIZE, self._frames, byref(arena), byref(out_err)
+        )
         if rc == 0:
             return None
-        raise _take_error(out_err)
+        if rc < 0:
+            raise _take_error(out_err)
+        # Payloads point into the arena: copy every frame out before freeing it once.
+        base = arena.data or 0
+        data = _buf_to_bytes(arena)
+        for frame in self._frames[:rc]:
+            start = (frame.payload.data or base) - base
+            self._pending.append(
+                Lite3Frame(
+                    seq=int(frame.seq),
+                    timestamp_ns=int(frame.timestamp_ns),
+                    flags=int(frame.flags),
+                    payload=data[start : start + frame.payload.len],
+                )
+            )
+        return self._pending.popleft()
 
     def __iter__(self) -> Lite3Stream:
         return self
@@ -3,7 +3,10 @@
 //! Invariants: `cargo:rerun-if-changed` covers C sources plus embedded UI assets used by the server.
 //! Invariants: Produces a `lite3` object library linked into the Rust crate.
 //! Invariants: Requests C23-compatible mode for vendored Lite3 sources that declare variables after labels.
-//! Invariants: Uses only Cargo-provided env vars (e.g. `CARGO_MANIFEST_DIR`).
+//! Invariants: Uses only Cargo-provided env vars (e.g. `CARGO_MANIFEST_DIR`), plus the
+//! Invariants: `PLASMITE_LITE3_NODE_SEARCH=scalar` override for benchmarking the node-search fallback.
+//! Invariants: Node search follows the Rust target features (AVX2 only when the target enables it).
+//! Invariants: At most one `lite3-node-*` feature; it predefines all three Lite3 node-size macros.
 use std::env;
 use std::fs;
 use std::path::{Path, PathBuf};
@@ -18,6 +21,11 @@ fn main() {
 
     println!("cargo:rerun-if-changed=c/lite3_shim.c");
     println!("cargo:rerun-if-changed=c/lite3_shim.h");
+    println!("cargo:rerun-if-changed=c/lite3_node_search.h");
+    println!("cargo:rerun-if-changed=c/lite3_json_writer.c");
+    println!("cargo:rerun-if-changed=c/lite3_json_escape.h");
+    println!("cargo:rerun-if-changed=c/lite3_json_arena.c");
+    println!("cargo:rerun-if-env-changed=PLASMITE_LITE3_NODE_SEARCH");
     println!("cargo:rerun-if-changed=vendor/lite3/include/lite3.h");
     println!("cargo:rerun-if-changed=vendor/lite3/include/lite3_context_api.h");
     println!("cargo:rerun-if-changed=vendor/lite3/src/lite3.c");
@@ -35,6 +43,7 @@ fn main() {
     build
         .include(&include_dir)
         .include(&lib_dir)
+        .include(manifest_dir.join("c"))
         .file(lite3_dir.join("src").join("lite3.c"))
         .file(lite3_dir.join("src").join("json_dec.c"))
         .file(lite3_dir.join("src").join("json_enc.c"))
@@ -42,13 +51,63 @@ fn main() {
         .file(lite3_dir.join("src").join("debug.c"))
         .file(lite3_dir.join("lib").join("yyjson").join("yyjson.c"))
         .file(lite3_dir.join("lib").join("nibble_base64").join("base64.c"))
-        .file(manifest_dir.join("c").join("lite3_shim.c"));
+        .file(manifest_dir.join("c").join("lite3_shim.c"))
+        .file(manifest_dir.join("c").join("lite3_json_writer.c"))
+        .file(manifest_dir.join("c").join("lite3_json_arena.c"));
 
     configure_lite3_compiler(&mut build, &target);
+    configure_node_size(&mut build);
+    configure_node_search(&mut build, &target);
 
     build.compile("lite3");
 }
 
+/// Lite3 node-size settings from `lite3.h`: (feature suffix, `LITE3_NODE_SIZE`,
+/// `LITE3_TREE_HEIGHT_MAX`, `LITE3_NODE_SIZE_KC_OFFSET`). 96 is the upstream default.
+const LITE3_NODE_CONFIGS: [(&str, u32, u32, u32); 4] = [
+    ("48", 48, 14, 16),
+    ("192", 192, 7, 64),
+    ("384", 384, 5, 128),
+    ("768", 768, 4, 256),
+];
+
+fn configure_node_size(build: &mut cc::Build) {
+    let enabled = LITE3_NODE_CONFIGS
+        .iter()
+        .filter(|(suffix, ..)| env::var_os(format!("CARGO_FEATURE_LITE3_NODE_{suffix}")).is_some())
+        .collect::<Vec<_>>();
+    let &[&(_, node_size, height_max, kc_offset)] = enabled.as_slice() else {
+        if enabled.len() > 1 {
+            panic!("enable at most one `lite3-node-*` feature");
+        }
+        return;
+    };
+    build
+        .define("LITE3_NODE_SIZE", node_size.to_string().as_str())
+        .define("LITE3_TREE_HEIGHT_MAX", height_max.to_string().as_str())
+        .define("LITE3_NODE_SIZE_KC_OFFSET", kc_offset.to_string().as_str());
+}
+
+fn configure_node_search(build: &mut cc::Build, target: &str) {
+    build.define("PLASMITE_NODE_SEARCH", None);
+    if env::var("PLASMITE_LITE3_NODE_SEARCH").is_ok_and(|value| value == "scalar") {
+        build.define("PLASMITE_NODE_SEARCH_SCALAR", None);
+        return;
+    }
+    // SSE2 (x86_64) and NEON (aarch64) are baseline; AVX2 must be enabled for the Rust target
+    // too (e.g. `-C target-cpu=native`) so the C side never outruns the host the crate targets.
+    let arch = env::var("CARGO_CFG_TARGET_ARCH").unwrap_or_default();
+    let features = env::var("CARGO_CFG_TARGET_FEATURE").unwrap_or_default();
+    let has_avx2 = features.split(',').any(|feature| feature == "avx2");
+    if has_avx2 && (arch == "x86_64" || arch == "x86") {
+        if target.contains("windows-msvc") {
+            build.flag_if_supported("/arch:AVX2");
+        } else {
+            build.flag_if_supported("-mavx2");
+        }
+    }
+}
+
 fn ensure_c23_label_decl_support(target: &str, out_dir: &Path) {
     let probe_source = out_dir.join("lite3_c23_probe.c");
     fs::write(
@@ -0,0 +1,333 @@
+/*
+Purpose: Decode JSON text into Lite3 with yyjson documents carved from a reusable bump arena.
+Exports: `plasmite_lite3_arena_new/free`, `plasmite_lite3_json_dec_arena`,
+Exports: `plasmite_lite3_json_dec_set` (declared in `c/lite3_shim.h`).
+Role: Allocation-free steady state for the JSON -> Lite3 path (`feed`, `Lite3Buf::from_json_str`).
+Invariants: Text is parsed once; on `ENOBUFS` the output grows through `plasmite_lite3_out.grow`
+Invariants: and only the failed insert is retried, so large documents never decode twice.
+Invariants: Every byte below `out->len` is written (alignment gaps are zeroed), so the output
+Invariants: buffer itself may start uninitialized.
+Invariants: One arena serves one thread; every decode resets it, so nothing outlives the call.
+Invariants: Requests that do not fit the bump buffer spill to malloc; the next reset grows the
+Invariants: buffer to cover that demand (up to `ARENA_RETAIN_MAX`), so spills stop after warm-up.
+Invariants: Unparseable text is `EBADMSG`, distinct from Lite3 errors (`ENOBUFS` when the buffer
+Invariants: cannot grow, `EINVAL` for nesting or a scalar root, `EILSEQ` for NUL in a key).
+*/
+#include "lite3_shim.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lite3.h"
+#include "yyjson/yyjson.h"
+
+#define ARENA_ALIGN ((size_t)16)
+#define ARENA_MIN_CAP ((size_t)64 * 1024)
+/* Larger demand is still served (by spilling) but never kept across messages. */
+#define ARENA_RETAIN_MAX ((size_t)16 * 1024 * 1024)
+/* First-guess Lite3 bytes per yyjson value (keys count as values), on top of the text length. */
+#define DEC_BYTES_PER_VAL ((size_t)16)
+
+/* Header of one malloc'd overflow block; 16 bytes on 64-bit, so the data after it stays aligned. */
+typedef struct arena_spill {
+        struct arena_spill *next;
+        size_t size;
+} arena_spill;
+
+struct plasmite_lite3_arena {
+        yyjson_alc alc;
+        unsigned char *base;
+        size_t cap;
+        size_t used;
+        /* Offset of the most recent bump allocation, so yyjson's grow-in-place reallocs stay cheap. */
+        size_t last;
+        /* Bytes requested since the last reset, including spills; sizes the next buffer. */
+        size_t demand;
+        arena_spill *spill;
+};
+
+static size_t align_up(size_t size)
+{
+        return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+static void *arena_malloc(void *ctx, size_t size)
+{
+        plasmite_lite3_arena *arena = ctx;
+        size_t need = align_up(size);
+        if (need < size || size > SIZE_MAX - sizeof(arena_spill))
+                return NULL;
+        arena->demand += need;
+        if (arena->cap - arena->used >= need) {
+                arena->last = arena->used;
+                arena->used += need;
+                return arena->base + arena->last;
+        }
+        arena_spill *spill = malloc(sizeof(arena_spill) + size);
+        if (!spill)
+                return NULL;
+        spill->next = arena->spill;
+        spill->size = size;
+        arena->spill = spill;
+        return spill + 1;
+}
+
+static void *arena_realloc(void *ctx, void *ptr, size_t old_size, size_t size)
+{
+        plasmite_lite3_arena *arena = ctx;
+        if (!ptr)
+                return arena_malloc(ctx, size);
+        if (arena->base && (unsigned char *)ptr == arena->base + arena->last) {
+                size_t need = align_up(size);
+                if (need >= size && arena->cap - arena->last >= need) {
+                        size_t held = arena->used - arena->last;
+                        if (need > held)
+                                arena->demand += need - held;
+                        arena->used = arena->last + need;
+                        return ptr;
+                }
+        }
+        void *next = arena_malloc(ctx, size);
+        if (next)
+                memcpy(next, ptr, old_size < size ? old_size : size);
+        return next;
+}
+
+static void arena_free(void *ctx, void *ptr)
+{
+        /* Everything is released together by `arena_reset`. */
+        (void)ctx;
+        (void)ptr;
+}
+
+static void arena_reset(plasmite_lite3_arena *arena)
+{
+        while (arena->spill) {
+                arena_spill *next = arena->spill->next;
+                free(arena->spill);
+                arena->spill = next;
+        }
+        if (arena->demand > arena->cap && arena->cap < ARENA_RETAIN_MAX) {
+                size_t cap = arena->cap ? arena->cap : ARENA_MIN_CAP;
+                while (cap < arena->demand && cap < ARENA_RETAIN_MAX)
+                        cap *= 2;
+                /* Contents are dead after a reset, so a fresh block beats realloc's copy. */
+                unsigned char *base = malloc(cap);
+                if (base) {
+                        free(arena->base);
+                        arena->base = base;
+                        arena->cap = cap;
+                }
+        }
+        arena->used = 0;
+        arena->last = 0;
+        arena->demand = 0;
+}
+
+plasmite_lite3_arena *plasmite_lite3_arena_new(void)
+{
+        plasmite_lite3_arena *arena = calloc(1, sizeof(*arena));
+        if (!arena)
+                return NULL;
+        arena->alc.malloc = arena_malloc;
+        arena->alc.realloc = arena_realloc;
+        arena->alc.free = arena_free;
+        arena->alc.ctx = arena;
+        return arena;
+}
+
+void plasmite_lite3_arena_free(plasmite_lite3_arena *arena)
+{
+        if (!arena)
+                return;
+        arena_reset(arena);
+        free(arena->base);
+        free(arena);
+}
+
+static yyjson_doc *arena_read(plasmite_lite3_arena *arena, const char *json_str, size_t json_len)
+{
+        /* Without YYJSON_READ_INSITU yyjson copies the input, so the cast never writes through. */
+        return yyjson_read_opts((char *)json_str, json_len, YYJSON_READ_NOFLAG, &arena->alc, NULL);
+}
+
+static int out_grow(plasmite_lite3_out *out, size_t min_cap)
+{
+        size_t cap = 0;
+        unsigned char *buf = out->grow ? out->grow(out->ctx, out->len, min_cap, &cap) : NULL;
+        if (!buf || cap <= out->cap) {
+                errno = ENOBUFS;
+                return -1;
+        }
+        out->buf = buf;
+        out->cap = cap;
+        return 0;
+}
+
+/*
+Runs one shim setter against `out`, growing and retrying on ENOBUFS (setters leave the document
+valid, possibly with `len` advanced by a node split). Node splits realign `len` without writing
+the gap, so up to 3 bytes past it are zeroed first.
+*/
+#define DEC_INSERT(out, call)                                                                   \
+        do {                                                                                    \
+                for (;;) {                                                                      \
+                        size_t gap = (out)->cap - (out)->len < 3 ? (out)->cap - (out)->len : 3;   \
+                        if (gap)                                                                \
+                                memset((out)->buf + (out)->len, 0, gap);                        \
+                        if ((call) == 0)                                                        \
+                                break;                                                          \
+                        if (errno != ENOBUFS || out_grow((out), (out)->cap + 1) < 0)            \
+                                return -1;                                                      \
+                }                                                                               \
+        } while (0)
+
+static int dec_members(plasmite_lite3_out *out, size_t ofs, yyjson_val *ctn, size_t depth);
+
+/* Stores `val` under `key` (NULL appends to an array) in the container at `ofs`. */
+static int dec_value(plasmite_lite3_out *out, size_t ofs, const char *key, yyjson_val *val, size_t depth)
+{
+        switch (yyjson_get_type(val)) {
+        case YYJSON_TYPE_NULL:
+                DEC_INSERT(out, plasmite_lite3_set_null(out->buf, &out->len, ofs, out->cap, key));
+                return 0;
+        case YYJSON_TYPE_BOOL: {
+                bool b = yyjson_get_bool(val);
+                DEC_INSERT(out, plasmite_lite3_set_bool(out->buf, &out->len, ofs, out->cap, key, b));
+                return 0;
+        }
+        case YYJSON_TYPE_NUM:
+                /* As vendored `lite3_json_dec`: integers beyond INT64_MAX fall back to f64. */
+                if (yyjson_is_sint(val)) {
+                        int64_t i = yyjson_get_sint(val);
+                        DEC_INSERT(out, plasmite_lite3_set_i64(out->buf, &out->len, ofs, out->cap, key, i));
+                } else if (yyjson_is_uint(val) && yyjson_get_uint(val) <= INT64_MAX) {
+                        int64_t i = (int64_t)yyjson_get_uint(val);
+                        DEC_INSERT(out, plasmite_lite3_set_i64(out->buf, &out->len, ofs, out->cap, key, i));
+                } else {
+                        double f = yyjson_get_num(val);
+                        DEC_INSERT(out, plasmite_lite3_set_f64(out->buf, &out->len, ofs, out->cap, key, f));
+                }
+                return 0;
+        case YYJSON_TYPE_STR: {
+                const char *str = yyjson_get_str(val);
+                size_t len = yyjson_get_len(val);
+                DEC_INSERT(out, plasmite_lite3_set_str(out->buf, &out->len, ofs, out->cap, key, str, len));
+                return 0;
+        }
+        case YYJSON_TYPE_OBJ:
+        case YYJSON_TYPE_ARR: {
+                if (depth > LITE3_JSON_NESTING_DEPTH_MAX) {
+                        errno = EINVAL;
+                        return -1;
+                }
+                size_t child_ofs = 0;
+                if (yyjson_is_obj(val))
+                        DEC_INSERT(out, plasmite_lite3_set_obj(out->buf, &out->len, ofs, out->cap, key, &child_ofs));
+                else
+                        DEC_INSERT(out, plasmite_lite3_set_arr(out->buf, &out->len, ofs, out->cap, key, &child_ofs));
+                return dec_members(out, child_ofs, val, depth);
+        }
+        default:
+                errno = EINVAL;
+                return -1;
+        }
+}
+
+/* Decodes the members of `ctn` (already created at `ofs`) one level below `depth`. */
+static int dec_members(plasmite_lite3_out *out, size_t ofs, yyjson_val *ctn, size_t depth)
+{
+        if (yyjson_is_obj(ctn)) {
+                yyjson_val *key;
+                yyjson_obj_iter iter = yyjson_obj_iter_with(ctn);
+                while ((key = yyjson_obj_iter_next(&iter))) {
+                        /* Lite3 keys are NUL-terminated; an embedded NUL would silently truncate. */
+                        if (memchr(yyjson_get_str(key), 0, yyjson_get_len(key))) {
+                                errno = EILSEQ;
+                                return -1;
+                        }
+                        if (dec_value(out, ofs, yyjson_get_str(key), yyjson_obj_iter_get_val(key), depth + 1) < 0)
+                                return -1;
+                }
+        } else {
+                yyjson_val *item;
+                yyjson_arr_iter iter = yyjson_arr_iter_with(ctn);
+                while ((item = yyjson_arr_iter_next(&iter))) {
+                        if (dec_value(out, ofs, NULL, item, depth + 1) < 0)
+                                return -1;
+                }
+        }
+        return 0;
+}
+
+/* Parses `json_str` into the arena and pre-sizes `out` for it (best effort: growth still works). */
+static yyjson_val *dec_begin(plasmite_lite3_arena *arena, plasmite_lite3_out *out,
+                             const char *json_str, size_t json_len, yyjson_doc **out_doc)
+{
+        errno = 0;
+        yyjson_doc *doc = arena_read(arena, json_str, json_len);
+        if (!doc) {
+                arena_reset(arena);
+                errno = EBADMSG;
+                return NULL;
+        }
+        size_t want = out->len + json_len + DEC_BYTES_PER_VAL * yyjson_doc_get_val_count(doc);
+        if (want > out->cap)
+                (void)out_grow(out, want);
+        errno = 0;
+        *out_doc = doc;
+        return yyjson_doc_get_root(doc);
+}
+
+static int dec_end(plasmite_lite3_arena *arena, yyjson_doc *doc, int ret)
+{
+        int err = errno;
+        yyjson_doc_free(doc);
+        arena_reset(arena);
+        errno = err;
+        return ret;
+}
+
+static int dec_root(plasmite_lite3_out *out, yyjson_val *root)
+{
+        if (yyjson_is_obj(root))
+                DEC_INSERT(out, lite3_init_obj(out->buf, &out->len, out->cap));
+        else if (yyjson_is_arr(root))
+                DEC_INSERT(out, lite3_init_arr(out->buf, &out->len, out->cap));
+        else {
+                errno = EINVAL;
+                return -1;
+        }
+        return dec_members(out, 0, root, 1);
+}
+
+int plasmite_lite3_json_dec_arena(
+        plasmite_lite3_arena *arena,
+        const char *json_str,
+        size_t json_len,
+        plasmite_lite3_out *out)
+{
+        yyjson_doc *doc = NULL;
+        out->len = 0;
+        yyjson_val *root = dec_begin(arena, out, json_str, json_len, &doc);
+        if (!root)
+                return -1;
+        return dec_end(arena, doc, dec_root(out, root));
+}
+
+int plasmite_lite3_json_dec_set(
+        plasmite_lite3_arena *arena,
+        plasmite_lite3_out *out,
+        const char *key,
+        const char *json_str,
+        size_t json_len)
+{
+        yyjson_doc *doc = NULL;
+        yyjson_val *root = dec_begin(arena, out, json_str, json_len, &doc);
+        if (!root)
+                return -1;
+        /* Depth 2: the value sits one level below the root object. */
+        return dec_end(arena, doc, dec_value(out, 0, key, root, 2));
+}
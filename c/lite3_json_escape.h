@@ -0,0 +1,87 @@
+/*
+Purpose: Find the next byte of a JSON string body that cannot be copied through verbatim.
+Exports: `plasmite_json_scan_plain`, `PLASMITE_JSON_SCAN_KERNEL`.
+Role: Bulk-copy kernel for the streaming Lite3 → JSON writer (`c/lite3_json_writer.c`).
+Invariants: Stops at control bytes (< 0x20), `"`, `\`, and any byte >= 0x80 (UTF-8 to validate).
+Invariants: Returns an index in `0..=len`; never reads past `s + len`.
+Invariants: Kernel is picked at compile time (AVX2, SSE2, NEON, else scalar);
+Invariants: defining `PLASMITE_JSON_SCAN_SCALAR` forces the scalar loop.
+*/
+#ifndef PLASMITE_LITE3_JSON_ESCAPE_H
+#define PLASMITE_LITE3_JSON_ESCAPE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(PLASMITE_JSON_SCAN_SCALAR)
+#define PLASMITE_JSON_SCAN_KERNEL "scalar"
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define PLASMITE_JSON_SCAN_KERNEL "avx2"
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PLASMITE_JSON_SCAN_KERNEL "sse2"
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PLASMITE_JSON_SCAN_KERNEL "neon"
+#else
+#define PLASMITE_JSON_SCAN_KERNEL "scalar"
+#endif
+
+static inline int plasmite_json_byte_is_plain(unsigned char c)
+{
+        return c >= 0x20 && c < 0x80 && c != '"' && c != '\\';
+}
+
+static inline size_t plasmite_json_scan_plain(const unsigned char *s, size_t len)
+{
+        size_t i = 0;
+#if defined(PLASMITE_JSON_SCAN_SCALAR)
+#elif defined(__AVX2__)
+        /* As signed bytes, both >= 0x80 and < 0x20 compare below 0x20: one compare covers both. */
+        const __m256i space = _mm256_set1_epi8(0x20);
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        for (; i + 32 <= len; i += 32) {
+                __m256i v = _mm256_loadu_si256((const __m256i *)(s + i));
+                __m256i hit = _mm256_or_si256(
+                        _mm256_cmpgt_epi8(space, v),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)));
+                unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+                if (mask)
+                        return i + (size_t)__builtin_ctz(mask);
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i space = _mm_set1_epi8(0x20);
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        for (; i + 16 <= len; i += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i *)(s + i));
+                __m128i hit = _mm_or_si128(
+                        _mm_cmplt_epi8(v, space),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)));
+                unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+                if (mask)
+                        return i + (size_t)__builtin_ctz(mask);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const uint8x16_t space = vdupq_n_u8(0x20);
+        const uint8x16_t high = vdupq_n_u8(0x80);
+        const uint8x16_t quote = vdupq_n_u8('"');
+        const uint8x16_t backslash = vdupq_n_u8('\\');
+        for (; i + 16 <= len; i += 16) {
+                uint8x16_t v = vld1q_u8(s + i);
+                uint8x16_t hit = vorrq_u8(
+                        vorrq_u8(vcltq_u8(v, space), vcgeq_u8(v, high)),
+                        vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)));
+                /* No movemask on NEON: test for any hit, then let the tail loop find it. */
+                if (vmaxvq_u8(hit))
+                        break;
+        }
+#endif
+        while (i < len && plasmite_json_byte_is_plain(s[i]))
+                i++;
+        return i;
+}
+
+#endif
@@ -0,0 +1,429 @@
+/*
+Purpose: Stream Lite3 values straight to compact JSON text, without a yyjson mutable document.
+Exports: `plasmite_lite3_json_write` (declared in `c/lite3_shim.h`).
+Role: Hot output path for CLI/serve/ABI JSON; `lite3_json_enc` remains for pretty/debug output.
+Invariants: Output matches serde_json's compact writer byte for byte: object keys sorted by
+Invariants: bytes, ryu float layout, serde string escapes, padded base64 for Lite3 bytes.
+Invariants: snprintf-style: returns the full JSON length and writes at most `out_cap` bytes,
+Invariants: so callers grow their buffer to the returned length and call again.
+Invariants: Rejects what `Lite3DocRef::to_value_at` rejects (invalid UTF-8, non-finite
+Invariants: floats, nesting deeper than 32) with -1 and errno set.
+*/
+#include "lite3_shim.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lite3.h"
+#include "lite3_json_escape.h"
+#include "yyjson/yyjson.h"
+
+/* Same limit as `MAX_VALUE_NESTING_DEPTH` on the Rust side. */
+#define PLASMITE_JSON_MAX_DEPTH 32
+
+/* One object member, collected so members can be written in sorted key order. */
+typedef struct {
+        const char *key;
+        size_t key_len;
+        size_t val_ofs;
+} json_entry;
+
+typedef struct {
+        const unsigned char *buf;
+        size_t buf_len;
+        char *out;
+        size_t cap;
+        size_t len;
+        /* Member scratch shared by every nesting level; each object uses a suffix. */
+        json_entry *entries;
+        size_t entries_len;
+        size_t entries_cap;
+} json_writer;
+
+static void put(json_writer *w, const void *src, size_t n)
+{
+        if (w->len < w->cap) {
+                size_t room = w->cap - w->len;
+                memcpy(w->out + w->len, src, n < room ? n : room);
+        }
+        w->len += n;
+}
+
+static void put_byte(json_writer *w, char c)
+{
+        if (w->len < w->cap)
+                w->out[w->len] = c;
+        w->len++;
+}
+
+/* Length of the valid UTF-8 sequence starting at `s[0] >= 0x80`, or 0 when invalid. */
+static size_t utf8_seq_len(const unsigned char *s, size_t len)
+{
+        unsigned char c = s[0];
+        unsigned char lo = 0x80, hi = 0xBF;
+        size_t n;
+        if (c >= 0xC2 && c <= 0xDF) {
+                n = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+                n = 3;
+                if (c == 0xE0)
+                        lo = 0xA0;
+                else if (c == 0xED)
+                        hi = 0x9F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+                n = 4;
+                if (c == 0xF0)
+                        lo = 0x90;
+                else if (c == 0xF4)
+                        hi = 0x8F;
+        } else {
+                return 0;
+        }
+        if (len < n || s[1] < lo || s[1] > hi)
+                return 0;
+        for (size_t i = 2; i < n; i++) {
+                if ((s[i] & 0xC0) != 0x80)
+                        return 0;
+        }
+        return n;
+}
+
+static int put_string(json_writer *w, const unsigned char *s, size_t len)
+{
+        static const char hex[] = "0123456789abcdef";
+        put_byte(w, '"');
+        size_t i = 0;
+        while (i < len) {
+                size_t plain = plasmite_json_scan_plain(s + i, len - i);
+                put(w, s + i, plain);
+                i += plain;
+                if (i == len)
+                        break;
+                unsigned char c = s[i];
+                if (c >= 0x80) {
+                        size_t n = utf8_seq_len(s + i, len - i);
+                        if (n == 0) {
+                                errno = EILSEQ;
+                                return -1;
+                        }
+                        put(w, s + i, n);
+                        i += n;
+                        continue;
+                }
+                char esc[6] = { '\\', 0 };
+                size_t esc_len = 2;
+                switch (c) {
+                case '"': esc[1] = '"'; break;
+                case '\\': esc[1] = '\\'; break;
+                case '\b': esc[1] = 'b'; break;
+                case '\t': esc[1] = 't'; break;
+                case '\n': esc[1] = 'n'; break;
+                case '\f': esc[1] = 'f'; break;
+                case '\r': esc[1] = 'r'; break;
+                default:
+                        esc[1] = 'u';
+                        esc[2] = '0';
+                        esc[3] = '0';
+                        esc[4] = hex[c >> 4];
+                        esc[5] = hex[c & 0xF];
+                        esc_len = 6;
+                        break;
+                }
+                put(w, esc, esc_len);
+                i++;
+        }
+        put_byte(w, '"');
+        return 0;
+}
+
+static void put_base64(json_writer *w, const unsigned char *bytes, size_t len)
+{
+        static const char alphabet[] =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        put_byte(w, '"');
+        for (size_t i = 0; i < len; i += 3) {
+                uint32_t b1 = i + 1 < len ? bytes[i + 1] : 0;
+                uint32_t b2 = i + 2 < len ? bytes[i + 2] : 0;
+                uint32_t triple = ((uint32_t)bytes[i] << 16) | (b1 << 8) | b2;
+                char quad[4] = {
+                        alphabet[(triple >> 18) & 63],
+                        alphabet[(triple >> 12) & 63],
+                        i + 1 < len ? alphabet[(triple >> 6) & 63] : '=',
+                        i + 2 < len ? alphabet[triple & 63] : '=',
+                };
+                put(w, quad, 4);
+        }
+        put_byte(w, '"');
+}
+
+static void put_u64(json_writer *w, uint64_t value)
+{
+        char digits[20];
+        size_t n = 0;
+        do {
+                digits[sizeof(digits) - 1 - n++] = (char)('0' + value % 10);
+                value /= 10;
+        } while (value);
+        put(w, digits + sizeof(digits) - n, n);
+}
+
+static void put_i64(json_writer *w, int64_t value)
+{
+        if (value < 0) {
+                put_byte(w, '-');
+                put_u64(w, (uint64_t)0 - (uint64_t)value);
+        } else {
+                put_u64(w, (uint64_t)value);
+        }
+}
+
+/*
+Shortest round-trip digits come from yyjson; the layout is re-cut to ryu's (what serde_json
+prints): plain decimals for exponents in [-5, 16), `1e20`-style scientific notation otherwise.
+*/
+static int put_f64(json_writer *w, double value)
+{
+        if (!isfinite(value)) {
+                errno = EDOM;
+                return -1;
+        }
+        yyjson_val num;
+        num.tag = YYJSON_TYPE_NUM | YYJSON_SUBTYPE_REAL;
+        num.uni.f64 = value;
+        char raw[48];
+        const char *end = yyjson_write_number(&num, raw);
+        if (!end) {
+                errno = EINVAL;
+                return -1;
+        }
+
+        const char *p = raw;
+        int negative = *p == '-';
+        p += negative;
+        char digits[32];
+        int n = 0, before_dot = -1;
+        for (; p < end && *p != 'e' && *p != 'E'; p++) {
+                if (*p == '.')
+                        before_dot = n;
+                else if (n < (int)sizeof(digits))
+                        digits[n++] = *p;
+        }
+        if (before_dot < 0)
+                before_dot = n;
+        int exp10 = 0;
+        if (p < end) {
+                p++;
+                int exp_negative = *p == '-';
+                p += (*p == '-' || *p == '+');
+                for (; p < end; p++)
+                        exp10 = exp10 * 10 + (*p - '0');
+                exp10 = exp_negative ? -exp10 : exp10;
+        }
+
+        /* Normalize to `0.d1d2…dn × 10^kk` with d1 != 0 and dn != 0. */
+        int first = 0;
+        while (first < n && digits[first] == '0')
+                first++;
+        while (n > first && digits[n - 1] == '0')
+                n--;
+        if (negative)
+                put_byte(w, '-');
+        if (first == n) {
+                put(w, "0.0", 3);
+                return 0;
+        }
+        const char *d = digits + first;
+        int length = n - first;
+        int kk = before_dot + exp10 - first;
+        int k = kk - length;
+
+        if (k >= 0 && kk <= 16) {
+                put(w, d, (size_t)length);
+                for (int i = length; i < kk; i++)
+                        put_byte(w, '0');
+                put(w, ".0", 2);
+        } else if (kk > 0 && kk <= 16) {
+                put(w, d, (size_t)kk);
+                put_byte(w, '.');
+                put(w, d + kk, (size_t)(length - kk));
+        } else if (kk > -5 && kk <= 0) {
+                put(w, "0.", 2);
+                for (int i = 0; i < -kk; i++)
+                        put_byte(w, '0');
+                put(w, d, (size_t)length);
+        } else {
+                put_byte(w, d[0]);
+                if (length > 1) {
+                        put_byte(w, '.');
+                        put(w, d + 1, (size_t)(length - 1));
+                }
+                put_byte(w, 'e');
+                put_i64(w, kk - 1);
+        }
+        return 0;
+}
+
+static int write_value(json_writer *w, size_t ofs, size_t depth);
+
+static int entry_cmp(const void *lhs, const void *rhs)
+{
+        const json_entry *a = lhs;
+        const json_entry *b = rhs;
+        size_t n = a->key_len < b->key_len ? a->key_len : b->key_len;
+        int c = memcmp(a->key, b->key, n);
+        if (c != 0)
+                return c;
+        return (a->key_len > b->key_len) - (a->key_len < b->key_len);
+}
+
+static int push_entry(json_writer *w, json_entry entry)
+{
+        if (w->entries_len == w->entries_cap) {
+                size_t cap = w->entries_cap ? w->entries_cap * 2 : 32;
+                json_entry *grown = realloc(w->entries, cap * sizeof(*grown));
+                if (!grown) {
+                        errno = ENOMEM;
+                        return -1;
+                }
+                w->entries = grown;
+                w->entries_cap = cap;
+        }
+        w->entries[w->entries_len++] = entry;
+        return 0;
+}
+
+static int write_object(json_writer *w, size_t ofs, size_t depth)
+{
+        plasmite_lite3_iter iter;
+        if (plasmite_lite3_iter_create(w->buf, w->buf_len, ofs, &iter) < 0)
+                return -1;
+        size_t base = w->entries_len;
+        int ret;
+        for (;;) {
+                json_entry entry;
+                ret = plasmite_lite3_iter_next(
+                        w->buf, w->buf_len, &iter, &entry.key, &entry.key_len, &entry.val_ofs);
+                if (ret != LITE3_ITER_ITEM)
+                        break;
+                if (push_entry(w, entry) < 0)
+                        return -1;
+        }
+        if (ret != LITE3_ITER_DONE) {
+                errno = errno ? errno : EINVAL;
+                return -1;
+        }
+
+        size_t count = w->entries_len - base;
+        qsort(w->entries + base, count, sizeof(json_entry), entry_cmp);
+        put_byte(w, '{');
+        for (size_t i = 0; i < count; i++) {
+                /* Copy out: nested objects may grow (and move) the shared scratch. */
+                json_entry entry = w->entries[base + i];
+                if (i > 0)
+                        put_byte(w, ',');
+                if (put_string(w, (const unsigned char *)entry.key, entry.key_len) < 0)
+                        return -1;
+                put_byte(w, ':');
+                if (write_value(w, entry.val_ofs, depth) < 0)
+                        return -1;
+        }
+        put_byte(w, '}');
+        w->entries_len = base;
+        return 0;
+}
+
+static int write_array(json_writer *w, size_t ofs, size_t depth)
+{
+        plasmite_lite3_iter iter;
+        if (plasmite_lite3_iter_create(w->buf, w->buf_len, ofs, &iter) < 0)
+                return -1;
+        put_byte(w, '[');
+        size_t val_ofs;
+        int ret;
+        for (size_t i = 0;; i++) {
+                ret = plasmite_lite3_iter_next(w->buf, w->buf_len, &iter, NULL, NULL, &val_ofs);
+                if (ret != LITE3_ITER_ITEM)
+                        break;
+                if (i > 0)
+                        put_byte(w, ',');
+                if (write_value(w, val_ofs, depth) < 0)
+                        return -1;
+        }
+        if (ret != LITE3_ITER_DONE) {
+                errno = errno ? errno : EINVAL;
+                return -1;
+        }
+        put_byte(w, ']');
+        return 0;
+}
+
+static int write_value(json_writer *w, size_t ofs, size_t depth)
+{
+        plasmite_lite3_value val;
+        if (plasmite_lite3_val_read(w->buf, w->buf_len, ofs, &val) < 0)
+                return -1;
+        switch (val.type) {
+        case LITE3_TYPE_NULL:
+                put(w, "null", 4);
+                return 0;
+        case LITE3_TYPE_BOOL:
+                if (val.boolean)
+                        put(w, "true", 4);
+                else
+                        put(w, "false", 5);
+                return 0;
+        case LITE3_TYPE_I64:
+                put_i64(w, val.i64);
+                return 0;
+        case LITE3_TYPE_F64:
+                return put_f64(w, val.f64);
+        case LITE3_TYPE_BYTES:
+                put_base64(w, val.ptr, val.len);
+                return 0;
+        case LITE3_TYPE_STRING:
+                return put_string(w, val.ptr, val.len);
+        case LITE3_TYPE_OBJECT:
+        case LITE3_TYPE_ARRAY:
+                if (depth + 1 > PLASMITE_JSON_MAX_DEPTH) {
+                        errno = ELOOP;
+                        return -1;
+                }
+                return val.type == LITE3_TYPE_OBJECT ? write_object(w, ofs, depth + 1)
+                                                     : write_array(w, ofs, depth + 1);
+        default:
+                errno = EINVAL;
+                return -1;
+        }
+}
+
+int64_t plasmite_lite3_json_write(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t ofs,
+        char *out,
+        size_t out_cap)
+{
+        if (!buf || (!out && out_cap > 0)) {
+                errno = EINVAL;
+                return -1;
+        }
+        json_writer w = {
+                .buf = buf,
+                .buf_len = buf_len,
+                .out = out,
+                .cap = out_cap,
+        };
+        errno = 0;
+        int ret = write_value(&w, ofs, 0);
+        free(w.entries);
+        if (ret < 0)
+                return -1;
+        return (int64_t)w.len;
+}
+
+const char *plasmite_lite3_json_scan_kernel(void)
+{
+        return PLASMITE_JSON_SCAN_KERNEL;
+}
@@ -0,0 +1,71 @@
+/*
+Purpose: Lower-bound search over the sorted key hashes of one Lite3 B-tree node.
+Exports: `plasmite_node_lower_bound8`, `PLASMITE_NODE_SEARCH_KERNEL`.
+Role: Compare-and-movemask kernels patched into vendored `lite3.c` node walks.
+Invariants: Reads exactly 8 u32 lanes from `hashes`; callers guarantee they are in bounds.
+Invariants: Returns the count of the first `key_count` lanes below `hash`, in `0..=key_count`.
+Invariants: Kernel is picked at compile time (AVX2, SSE2, NEON, else scalar);
+Invariants: defining `PLASMITE_NODE_SEARCH_SCALAR` forces the scalar loop.
+*/
+#ifndef PLASMITE_LITE3_NODE_SEARCH_H
+#define PLASMITE_LITE3_NODE_SEARCH_H
+
+#include <stdint.h>
+
+#if defined(PLASMITE_NODE_SEARCH_SCALAR)
+#define PLASMITE_NODE_SEARCH_KERNEL "scalar"
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define PLASMITE_NODE_SEARCH_KERNEL "avx2"
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PLASMITE_NODE_SEARCH_KERNEL "sse2"
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define PLASMITE_NODE_SEARCH_KERNEL "neon"
+#else
+#define PLASMITE_NODE_SEARCH_KERNEL "scalar"
+#endif
+
+static inline int plasmite_node_lower_bound8(const uint32_t *hashes, int key_count, uint32_t hash)
+{
+#if defined(PLASMITE_NODE_SEARCH_SCALAR)
+        int i = 0;
+        while (i < key_count && hashes[i] < hash)
+                i++;
+        return i;
+#elif defined(__AVX2__)
+        /* No unsigned compare before AVX-512: flip the sign bit so signed `>` orders u32s. */
+        const __m256i bias = _mm256_set1_epi32((int)0x80000000u);
+        __m256i lanes = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)hashes), bias);
+        __m256i target = _mm256_xor_si256(_mm256_set1_epi32((int)hash), bias);
+        unsigned less = (unsigned)_mm256_movemask_ps(
+                _mm256_castsi256_ps(_mm256_cmpgt_epi32(target, lanes)));
+        return __builtin_popcount(less & ((1u << key_count) - 1u));
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+        __m128i target = _mm_xor_si128(_mm_set1_epi32((int)hash), bias);
+        __m128i lo = _mm_xor_si128(_mm_loadu_si128((const __m128i *)hashes), bias);
+        __m128i hi = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(hashes + 4)), bias);
+        unsigned less = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target, lo)))
+                | ((unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(target, hi))) << 4);
+        return __builtin_popcount(less & ((1u << key_count) - 1u));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        static const uint32_t lane_index[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+        uint32x4_t target = vdupq_n_u32(hash);
+        uint32x4_t count = vdupq_n_u32((uint32_t)key_count);
+        uint32x4_t lo = vandq_u32(vcltq_u32(vld1q_u32(hashes), target),
+                                  vcltq_u32(vld1q_u32(lane_index), count));
+        uint32x4_t hi = vandq_u32(vcltq_u32(vld1q_u32(hashes + 4), target),
+                                  vcltq_u32(vld1q_u32(lane_index + 4), count));
+        /* Matching lanes are all-ones; shift each down to 1 and sum across both halves. */
+        return (int)vaddvq_u32(vaddq_u32(vshrq_n_u32(lo, 31), vshrq_n_u32(hi, 31)));
+#else
+        int i = 0;
+        while (i < key_count && hashes[i] < hash)
+                i++;
+        return i;
+#endif
+}
+
+#endif
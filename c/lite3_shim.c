@@ -9,8 +9,13 @@ Invariants: This file should not contain business logic; it only forwards to Lit
 
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "lite3.h"
+#include "lite3_node_search.h"
+
+_Static_assert(sizeof(lite3_iter) <= sizeof(plasmite_lite3_iter),
+               "plasmite_lite3_iter too small for lite3_iter");
 
 int plasmite_lite3_json_dec(
         const char *json_str,
@@ -146,6 +151,280 @@ int plasmite_lite3_arr_get_str(
         return 0;
 }
 
+int plasmite_lite3_iter_create(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t ofs,
+        plasmite_lite3_iter *out)
+{
+        if (!out) {
+                errno = EINVAL;
+                return -1;
+        }
+        return lite3_iter_create(buf, buf_len, ofs, (lite3_iter *)out);
+}
+
+int plasmite_lite3_iter_next(
+        const unsigned char *buf,
+        size_t buf_len,
+        plasmite_lite3_iter *iter,
+        const char **out_key,
+        size_t *out_key_len,
+        size_t *out_val_ofs)
+{
+        lite3_str key = {0};
+        int ret = lite3_iter_next(
+                buf, buf_len, (lite3_iter *)iter, out_key ? &key : NULL, out_val_ofs);
+        if (ret != LITE3_ITER_ITEM) {
+                return ret;
+        }
+        if (out_key) {
+                *out_key = LITE3_STR(buf, key);
+                if (!*out_key) {
+                        errno = EINVAL;
+                        return -1;
+                }
+        }
+        if (out_key_len) {
+                *out_key_len = out_key ? (size_t)key.len : 0;
+        }
+        return ret;
+}
+
+int plasmite_lite3_val_read(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t val_ofs,
+        plasmite_lite3_value *out)
+{
+        if (!buf || !out || val_ofs >= buf_len) {
+                errno = EINVAL;
+                return -1;
+        }
+        memset(out, 0, sizeof(*out));
+        lite3_val *val = (lite3_val *)(buf + val_ofs);
+        enum lite3_type type = lite3_val_type(val);
+        out->type = (uint8_t)type;
+        /* The fixed-size part (scalar, or string/bytes length prefix) must fit before it is read. */
+        if (type < LITE3_TYPE_INVALID
+            && buf_len - val_ofs < LITE3_VAL_SIZE + lite3_type_sizes[type]) {
+                errno = EBADMSG;
+                return -1;
+        }
+        switch (type) {
+        case LITE3_TYPE_NULL:
+        case LITE3_TYPE_OBJECT:
+        case LITE3_TYPE_ARRAY:
+                break;
+        case LITE3_TYPE_BOOL:
+                out->boolean = lite3_val_bool(val);
+                break;
+        case LITE3_TYPE_I64:
+                out->i64 = lite3_val_i64(val);
+                break;
+        case LITE3_TYPE_F64:
+                out->f64 = lite3_val_f64(val);
+                break;
+        case LITE3_TYPE_BYTES:
+                out->ptr = lite3_val_bytes(val, &out->len);
+                break;
+        case LITE3_TYPE_STRING:
+                out->ptr = (const unsigned char *)lite3_val_str_n(val, &out->len);
+                break;
+        default:
+                errno = EINVAL;
+                return -1;
+        }
+        if (out->ptr && (size_t)(out->ptr - buf) + out->len > buf_len) {
+                errno = EBADMSG;
+                return -1;
+        }
+        return 0;
+}
+
+void plasmite_lite3_path_compile(
+        const char *const *segments,
+        size_t count,
+        plasmite_lite3_key *out)
+{
+        for (size_t i = 0; i < count; i++) {
+                lite3_key_data key_data = lite3_get_key_data(segments[i]);
+                out[i].key = segments[i];
+                out[i].hash = key_data.hash;
+                out[i].size = key_data.size;
+        }
+}
+
+int plasmite_lite3_path_get(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t ofs,
+        const plasmite_lite3_key *path,
+        size_t count,
+        size_t *out_ofs,
+        plasmite_lite3_value *out_val)
+{
+        if (!buf || (count > 0 && !path)) {
+                errno = EINVAL;
+                return -1;
+        }
+        size_t cur = ofs;
+        for (size_t i = 0; i < count; i++) {
+                if (cur >= buf_len) {
+                        errno = EFAULT;
+                        return -1;
+                }
+                if (buf[cur] != LITE3_TYPE_OBJECT) {
+                        return 1;
+                }
+                if (_lite3_verify_obj_get(buf, buf_len, cur, path[i].key) < 0) {
+                        return -1;
+                }
+                lite3_key_data key_data = { .hash = path[i].hash, .size = path[i].size };
+                lite3_val *val = NULL;
+                errno = 0;
+                if (lite3_get_impl(buf, buf_len, cur, path[i].key, key_data, &val) < 0) {
+                        return errno == ENOENT ? 1 : -1;
+                }
+                cur = (size_t)((const unsigned char *)val - buf);
+        }
+        if (out_ofs) {
+                *out_ofs = cur;
+        }
+        if (out_val) {
+                return plasmite_lite3_val_read(buf, buf_len, cur, out_val);
+        }
+        return 0;
+}
+
+int plasmite_lite3_init_obj(
+        unsigned char *buf,
+        size_t *out_len,
+        size_t buf_sz)
+{
+        errno = 0;
+        return lite3_init_obj(buf, out_len, buf_sz);
+}
+
+int plasmite_lite3_set_null(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_null(buf, inout_len, ofs, buf_sz);
+        }
+        return _lite3_set_null_impl(buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key));
+}
+
+int plasmite_lite3_set_bool(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        bool value)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_bool(buf, inout_len, ofs, buf_sz, value);
+        }
+        return _lite3_set_bool_impl(
+                buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key), value);
+}
+
+int plasmite_lite3_set_i64(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        int64_t value)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_i64(buf, inout_len, ofs, buf_sz, value);
+        }
+        return _lite3_set_i64_impl(
+                buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key), value);
+}
+
+int plasmite_lite3_set_f64(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        double value)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_f64(buf, inout_len, ofs, buf_sz, value);
+        }
+        return _lite3_set_f64_impl(
+                buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key), value);
+}
+
+int plasmite_lite3_set_str(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        const char *str,
+        size_t str_len)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_str_n(buf, inout_len, ofs, buf_sz, str, str_len);
+        }
+        return _lite3_set_str_n_impl(
+                buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key), str, str_len);
+}
+
+int plasmite_lite3_set_obj(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        size_t *out_ofs)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_obj(buf, inout_len, ofs, buf_sz, out_ofs);
+        }
+        int ret = _lite3_verify_obj_set(buf, inout_len, ofs, buf_sz, key);
+        if (ret < 0) {
+                return ret;
+        }
+        return lite3_set_obj_impl(
+                buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key), out_ofs);
+}
+
+int plasmite_lite3_set_arr(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        size_t *out_ofs)
+{
+        errno = 0;
+        if (!key) {
+                return lite3_arr_append_arr(buf, inout_len, ofs, buf_sz, out_ofs);
+        }
+        int ret = _lite3_verify_obj_set(buf, inout_len, ofs, buf_sz, key);
+        if (ret < 0) {
+                return ret;
+        }
+        return lite3_set_arr_impl(
+                buf, inout_len, ofs, buf_sz, key, lite3_get_key_data(key), out_ofs);
+}
+
 int plasmite_lite3_last_errno(void)
 {
         return errno;
@@ -155,3 +434,17 @@ void plasmite_lite3_free(void *ptr)
 {
         free(ptr);
 }
+
+const char *plasmite_lite3_node_search_kernel(void)
+{
+#if defined(PLASMITE_NODE_SEARCH) && LITE3_NODE_SIZE == 96
+        return PLASMITE_NODE_SEARCH_KERNEL;
+#else
+        return "scalar";
+#endif
+}
+
+size_t plasmite_lite3_node_size(void)
+{
+        return LITE3_NODE_SIZE;
+}
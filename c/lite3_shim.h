@@ -1,9 +1,15 @@
 /*
 Purpose: Expose a small, stable C ABI for Lite3 functionality used by Rust.
-Exports: `plasmite_lite3_json_dec`, `plasmite_lite3_json_enc(_pretty)`, `plasmite_lite3_get_*`, `plasmite_lite3_free`.
+Exports: `plasmite_lite3_json_dec`, `plasmite_lite3_json_enc(_pretty)`, `plasmite_lite3_get_*`,
+Exports: `plasmite_lite3_iter_*`, `plasmite_lite3_val_read`, `plasmite_lite3_free`.
+Exports: `plasmite_lite3_init_obj`, `plasmite_lite3_set_*` (NULL key appends to an array).
+Exports: `plasmite_lite3_node_search_kernel`, `plasmite_lite3_node_size`, `plasmite_lite3_path_compile`, `plasmite_lite3_path_get`.
+Exports: `plasmite_lite3_json_write`, `plasmite_lite3_json_scan_kernel` (in `c/lite3_json_writer.c`).
+Exports: `plasmite_lite3_arena_*`, `plasmite_lite3_json_dec_arena/set` (in `c/lite3_json_arena.c`).
 Role: Thin boundary between the Rust crate and the vendored Lite3 implementation.
 Invariants: Function signatures are part of the Rust FFI contract; change with care.
 Invariants: Returned heap pointers are freed by calling `plasmite_lite3_free`.
+Invariants: On `ENOBUFS` setters leave `buf` a valid document, so callers may grow it and retry.
 */
 #ifndef PLASMITE_LITE3_SHIM_H
 #define PLASMITE_LITE3_SHIM_H
@@ -16,6 +22,28 @@ Invariants: Returned heap pointers are freed by calling `plasmite_lite3_free`.
 extern "C" {
 #endif
 
+/* Opaque, stack-allocatable iterator state; large enough for any `lite3_iter` build. */
+typedef struct {
+        uint64_t opaque[16];
+} plasmite_lite3_iter;
+
+/* Decoded view of one Lite3 value; `ptr`/`len` borrow from the Lite3 buffer. */
+typedef struct {
+        uint8_t type;
+        bool boolean;
+        int64_t i64;
+        double f64;
+        const unsigned char *ptr;
+        size_t len;
+} plasmite_lite3_value;
+
+/* One precompiled object key: `lite3_get_key_data` output plus the NUL-terminated key it borrows. */
+typedef struct {
+        const char *key;
+        uint32_t hash;
+        uint32_t size;
+} plasmite_lite3_key;
+
 int plasmite_lite3_json_dec(
         const char *json_str,
         size_t json_len,
@@ -87,10 +115,174 @@ int plasmite_lite3_arr_get_str(
         const char **out_ptr,
         size_t *out_len);
 
+int plasmite_lite3_iter_create(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t ofs,
+        plasmite_lite3_iter *out);
+
+int plasmite_lite3_iter_next(
+        const unsigned char *buf,
+        size_t buf_len,
+        plasmite_lite3_iter *iter,
+        const char **out_key,
+        size_t *out_key_len,
+        size_t *out_val_ofs);
+
+int plasmite_lite3_val_read(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t val_ofs,
+        plasmite_lite3_value *out);
+
+int plasmite_lite3_init_obj(
+        unsigned char *buf,
+        size_t *out_len,
+        size_t buf_sz);
+
+/* Setters insert under `key` in the object at `ofs`, or append when `key` is NULL. */
+int plasmite_lite3_set_null(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key);
+
+int plasmite_lite3_set_bool(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        bool value);
+
+int plasmite_lite3_set_i64(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        int64_t value);
+
+int plasmite_lite3_set_f64(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        double value);
+
+int plasmite_lite3_set_str(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        const char *str,
+        size_t str_len);
+
+int plasmite_lite3_set_obj(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        size_t *out_ofs);
+
+int plasmite_lite3_set_arr(
+        unsigned char *buf,
+        size_t *inout_len,
+        size_t ofs,
+        size_t buf_sz,
+        const char *key,
+        size_t *out_ofs);
+
 int plasmite_lite3_last_errno(void);
 
 void plasmite_lite3_free(void *ptr);
 
+/* Hash `count` NUL-terminated segments into `out`; `out[i].key` borrows `segments[i]`. */
+void plasmite_lite3_path_compile(
+        const char *const *segments,
+        size_t count,
+        plasmite_lite3_key *out);
+
+/*
+Resolve a compiled key path from the object at `ofs` in one call.
+Returns 0 and fills `out_ofs`/`out_val` (either may be NULL); 1 when a key is missing or a
+value along the path is not an object; -1 with errno set when the buffer is invalid.
+*/
+int plasmite_lite3_path_get(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t ofs,
+        const plasmite_lite3_key *path,
+        size_t count,
+        size_t *out_ofs,
+        plasmite_lite3_value *out_val);
+
+/* Name of the node-search kernel compiled into Lite3 ("avx2", "sse2", "neon", "scalar"). */
+const char *plasmite_lite3_node_search_kernel(void);
+
+/* `LITE3_NODE_SIZE` the vendored Lite3 was compiled with (96 unless a `lite3-node-*` feature is on). */
+size_t plasmite_lite3_node_size(void);
+
+/*
+Write the value at `ofs` as compact JSON into `out[0..out_cap)` without building a document.
+Returns the full JSON length even when it exceeds `out_cap` (nothing past `out_cap` is written;
+grow to the returned length and call again), or -1 with errno set for invalid Lite3 data.
+*/
+int64_t plasmite_lite3_json_write(
+        const unsigned char *buf,
+        size_t buf_len,
+        size_t ofs,
+        char *out,
+        size_t out_cap);
+
+/* Name of the string-escape scan kernel used by `plasmite_lite3_json_write`. */
+const char *plasmite_lite3_json_scan_kernel(void);
+
+/* Reusable yyjson allocator for JSON decoding; not thread-safe, keep one per thread. */
+typedef struct plasmite_lite3_arena plasmite_lite3_arena;
+
+/* Returns NULL on allocation failure. The bump buffer itself is allocated on first use. */
+plasmite_lite3_arena *plasmite_lite3_arena_new(void);
+
+void plasmite_lite3_arena_free(plasmite_lite3_arena *arena);
+
+/*
+Caller-owned output for the arena decoders. Bytes in `[len, cap)` may be uninitialized. `grow`
+(optional) must return a buffer of at least `min_cap` bytes whose first `len` bytes match `buf`
+and store its size in `*out_cap`, or return NULL to fail the decode with ENOBUFS.
+*/
+typedef struct {
+        unsigned char *buf;
+        size_t len;
+        size_t cap;
+        unsigned char *(*grow)(void *ctx, size_t len, size_t min_cap, size_t *out_cap);
+        void *ctx;
+} plasmite_lite3_out;
+
+/* `plasmite_lite3_json_dec` with the yyjson document in `arena`; writes a new document to `out`. */
+int plasmite_lite3_json_dec_arena(
+        plasmite_lite3_arena *arena,
+        const char *json_str,
+        size_t json_len,
+        plasmite_lite3_out *out);
+
+/*
+Decode one JSON value of any type and store it under `key` in the root object of `out`.
+errno: `EBADMSG` when the text is not JSON, `EILSEQ` for an object key with a NUL byte,
+`EINVAL` past `LITE3_JSON_NESTING_DEPTH_MAX`, `ENOBUFS` when `out` cannot grow. On failure the
+value may be partially written.
+*/
+int plasmite_lite3_json_dec_set(
+        plasmite_lite3_arena *arena,
+        plasmite_lite3_out *out,
+        const char *key,
+        const char *json_str,
+        size_t json_len);
+
 #ifdef __cplusplus
 }
 #endif
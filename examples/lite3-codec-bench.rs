@@ -0,0 +1,343 @@
+//! Purpose: Developer-only microbenchmarks for the Lite3 codec, isolated from the pool.
+//! Exports: None (example binary entry point only).
+//! Role: Times JSON decode, JSON encode, keyed lookup and iteration over a fixed payload corpus.
+//! Invariants: Not part of the shipped user CLI; built via `cargo run --example`.
+//! Invariants: Allocation counts cover the Rust heap only (C-side `malloc` is not observed).
+//! Invariants: Node size comes from the build (`--features lite3-node-*`), never from flags.
+#![allow(clippy::result_large_err)]
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::hint::black_box;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+use clap::Parser;
+use serde_json::{Map, Value, json};
+
+use plasmite::api::lite3::{self, Lite3Buf, Lite3Path};
+use plasmite::api::{Error, ErrorKind, to_exit_code};
+
+static ALLOCS: AtomicU64 = AtomicU64::new(0);
+static ALLOC_BYTES: AtomicU64 = AtomicU64::new(0);
+
+struct CountingAlloc;
+
+unsafe impl GlobalAlloc for CountingAlloc {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        ALLOCS.fetch_add(1, Ordering::Relaxed);
+        ALLOC_BYTES.fetch_add(layout.size() as u64, Ordering::Relaxed);
+        unsafe { System.alloc(layout) }
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        unsafe { System.dealloc(ptr, layout) }
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        ALLOCS.fetch_add(1, Ordering::Relaxed);
+        ALLOC_BYTES.fetch_add(new_size as u64, Ordering::Relaxed);
+        unsafe { System.realloc(ptr, layout, new_size) }
+    }
+}
+
+#[global_allocator]
+static GLOBAL: CountingAlloc = CountingAlloc;
+
+#[derive(Parser)]
+#[command(
+    name = "lite3-codec-bench",
+    version,
+    about = "Developer-only Lite3 codec microbenchmarks",
+    long_about = None
+)]
+struct CodecCli {
+    #[arg(long = "case", help = "Repeatable corpus case to run (default: all)")]
+    cases: Vec<String>,
+    #[arg(
+        long,
+        default_value_t = 200,
+        help = "Minimum measured time per case/op (milliseconds)"
+    )]
+    min_time_ms: u64,
+    #[arg(long, default_value = "table", help = "Output format: json|table")]
+    format: String,
+}
+
+fn main() {
+    let exit_code = match run() {
+        Ok(()) => 0,
+        Err(err) => {
+            eprintln!(
+                "error: {}",
+                err.message().unwrap_or("lite3 codec bench failed")
+            );
+            to_exit_code(err.kind())
+        }
+    };
+    std::process::exit(exit_code);
+}
+
+fn run() -> Result<(), Error> {
+    let cli = CodecCli::parse();
+    let json_out = match cli.format.as_str() {
+        "json" => true,
+        "table" => false,
+        _ => {
+            return Err(Error::new(ErrorKind::Usage).with_message("format must be json or table"));
+        }
+    };
+    let min_time = Duration::from_millis(cli.min_time_ms.max(1));
+    let corpus = corpus();
+    for name in &cli.cases {
+        if !corpus.iter().any(|case| case.name == name) {
+            return Err(Error::new(ErrorKind::Usage)
+                .with_message(format!("unknown case: {name}"))
+                .with_hint(corpus_hint(&corpus)));
+        }
+    }
+
+    let mut results = Vec::new();
+    for case in corpus
+        .iter()
+        .filter(|case| cli.cases.is_empty() || cli.cases.iter().any(|name| name == case.name))
+    {
+        results.extend(bench_case(case, min_time)?);
+    }
+
+    if json_out {
+        let report = json!({
+            "node_size": lite3::node_size(),
+            "node_search_kernel": lite3::node_search_kernel(),
+            "json_scan_kernel": lite3::json_scan_kernel(),
+            "results": results.iter().map(Sample::to_json).collect::<Vec<_>>(),
+        });
+        println!("{report}");
+    } else {
+        print_table(&results);
+    }
+    Ok(())
+}
+
+/// One payload shape: JSON text plus the lookup path exercised by the `get` op.
+struct Case {
+    name: &'static str,
+    json: String,
+    probe: Lite3Path,
+}
+
+fn corpus_hint(corpus: &[Case]) -> String {
+    let names = corpus.iter().map(|case| case.name).collect::<Vec<_>>();
+    format!("Known cases: {}.", names.join(", "))
+}
+
+fn corpus() -> Vec<Case> {
+    let mut out = Vec::new();
+
+    // Typical small event: a handful of tags and scalar fields.
+    let small = json!({
+        "meta": {"tags": ["deploy", "prod"]},
+        "data": {"service": "api", "level": "info", "status": 200, "latency_ms": 12.5,
+                 "ok": true, "region": "us-east-1", "msg": "request served"}
+    });
+    out.push(case("small_event", &small, &["data", "status"]));
+
+    // Wide object: key counts far past one node, so lookups walk several levels.
+    let wide = (0..256)
+        .map(|index| {
+            let value = match index % 4 {
+                0 => json!(index),
+                1 => json!(format!("value-{index}")),
+                2 => json!(index as f64 * 0.5),
+                _ => json!(index % 3 == 0),
+            };
+            (format!("field_{index:03}"), value)
+        })
+        .collect::<Map<_, _>>();
+    out.push(case(
+        "wide_object",
+        &json!({"meta": {"tags": []}, "data": wide}),
+        &["data", "field_200"],
+    ));
+
+    // Deep nesting: one small object per level, kept under the 32-level codec limit.
+    let mut deep = json!({"leaf": 1});
+    for level in (0..24).rev() {
+        deep = json!({format!("l{level}"): deep, "n": level});
+    }
+    let deep_path = (0..24).map(|level| format!("l{level}")).collect::<Vec<_>>();
+    let mut deep_keys = vec!["data"];
+    deep_keys.extend(deep_path.iter().map(String::as_str));
+    out.push(case(
+        "deep_nesting",
+        &json!({"meta": {"tags": []}, "data": deep}),
+        &deep_keys,
+    ));
+
+    // Tag arrays: many short strings, the shape `meta.tags` filtering reads.
+    let tags = (0..128)
+        .map(|index| format!("tag-{index}"))
+        .collect::<Vec<_>>();
+    let items = (0..64)
+        .map(|index| json!({"id": index, "kind": "item"}))
+        .collect::<Vec<_>>();
+    out.push(case(
+        "tag_array",
+        &json!({"meta": {"tags": tags}, "data": {"items": items, "count": 64}}),
+        &["data", "count"],
+    ));
+
+    // Large string: one long escaped-free body, dominated by copy bandwidth.
+    let text = "lorem ipsum dolor sit amet ".repeat(64 * 1024 / 27);
+    out.push(case(
+        "large_string",
+        &json!({"meta": {"tags": ["log"]}, "data": {"body": text, "len": text.len()}}),
+        &["data", "len"],
+    ));
+
+    // Large bytes: JSON has no bytes type, so this is the base64 text binary payloads become.
+    let blob = (0..192 * 1024)
+        .map(|index| {
+            b"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[index % 64]
+        })
+        .map(char::from)
+        .collect::<String>();
+    out.push(case(
+        "large_bytes",
+        &json!({"meta": {"tags": ["blob"]}, "data": {"blob": blob, "encoding": "base64"}}),
+        &["data", "encoding"],
+    ));
+
+    out
+}
+
+fn case(name: &'static str, value: &Value, probe: &[&str]) -> Case {
+    Case {
+        name,
+        json: value.to_string(),
+        probe: Lite3Path::new(probe.iter().copied()).expect("valid probe path"),
+    }
+}
+
+struct Sample {
+    case: &'static str,
+    op: &'static str,
+    json_bytes: usize,
+    lite3_bytes: usize,
+    iterations: u64,
+    ns_per_op: f64,
+    alloc_bytes_per_op: f64,
+    allocs_per_op: f64,
+}
+
+impl Sample {
+    fn to_json(&self) -> Value {
+        json!({
+            "case": self.case,
+            "op": self.op,
+            "json_bytes": self.json_bytes,
+            "lite3_bytes": self.lite3_bytes,
+            "iterations": self.iterations,
+            "ns_per_op": self.ns_per_op,
+            "bytes_per_op": self.alloc_bytes_per_op,
+            "allocs_per_op": self.allocs_per_op,
+        })
+    }
+}
+
+fn bench_case(case: &Case, min_time: Duration) -> Result<Vec<Sample>, Error> {
+    let buf = Lite3Buf::from_json_str(&case.json)?;
+    let doc = buf.as_doc();
+    if doc.offset_at_path(0, &case.probe)?.is_none() {
+        return Err(Error::new(ErrorKind::Internal)
+            .with_message(format!("probe path missing in case {}", case.name)));
+    }
+    let sizes = (case.json.len(), buf.len());
+    let mut out = Vec::new();
+
+    // lite3_json_dec: JSON text -> Lite3 (arena parse, in-place growth).
+    out.push(measure(case.name, "decode", sizes, min_time, || {
+        Lite3Buf::from_json_str(black_box(&case.json)).map(|buf| buf.len())
+    })?);
+    // lite3_json_enc: Lite3 -> heap JSON string through the vendored encoder.
+    out.push(measure(case.name, "encode", sizes, min_time, || {
+        doc.to_json(false).map(|json| json.len())
+    })?);
+    // Streaming writer into a reused Vec, the path tail/serve use.
+    let mut scratch = Vec::new();
+    out.push(measure(case.name, "write_json", sizes, min_time, || {
+        scratch.clear();
+        doc.write_json_at(0, &mut scratch).map(|()| scratch.len())
+    })?);
+    // lite3_get_impl: precompiled path lookup (hash walk per level).
+    out.push(measure(case.name, "get", sizes, min_time, || {
+        doc.offset_at_path(0, black_box(&case.probe))
+            .map(|ofs| ofs.unwrap_or(0))
+    })?);
+    // lite3_iter: native walk of every node into a `serde_json::Value`.
+    out.push(measure(case.name, "iterate", sizes, min_time, || {
+        doc.to_value().map(|value| value.is_object() as usize)
+    })?);
+    Ok(out)
+}
+
+/// Run `op` in doubling batches until one batch takes at least `min_time`, then report that batch.
+fn measure(
+    case: &'static str,
+    op: &'static str,
+    (json_bytes, lite3_bytes): (usize, usize),
+    min_time: Duration,
+    mut run: impl FnMut() -> Result<usize, Error>,
+) -> Result<Sample, Error> {
+    black_box(run()?);
+    let mut iterations = 1u64;
+    loop {
+        let allocs = ALLOCS.load(Ordering::Relaxed);
+        let alloc_bytes = ALLOC_BYTES.load(Ordering::Relaxed);
+        let start = Instant::now();
+        for _ in 0..iterations {
+            black_box(run()?);
+        }
+        let elapsed = start.elapsed();
+        if elapsed >= min_time {
+            let per_op = |total: u64| total as f64 / iterations as f64;
+            return Ok(Sample {
+                case,
+                op,
+                json_bytes,
+                lite3_bytes,
+                iterations,
+                ns_per_op: elapsed.as_nanos() as f64 / iterations as f64,
+                alloc_bytes_per_op: per_op(ALLOC_BYTES.load(Ordering::Relaxed) - alloc_bytes),
+                allocs_per_op: per_op(ALLOCS.load(Ordering::Relaxed) - allocs),
+            });
+        }
+        iterations = iterations.saturating_mul(2);
+    }
+}
+
+fn print_table(results: &[Sample]) {
+    println!(
+        "lite3 node_size={} node_search={} json_scan={}",
+        lite3::node_size(),
+        lite3::node_search_kernel(),
+        lite3::json_scan_kernel()
+    );
+    println!(
+        "{:<14} {:<11} {:>10} {:>10} {:>12} {:>10} {:>10} {:>10}",
+        "case", "op", "json_B", "lite3_B", "ns/op", "MB/s", "B/op", "allocs/op"
+    );
+    for sample in results {
+        // Throughput is measured against the JSON text size so node sizes compare directly.
+        let mbps = sample.json_bytes as f64 / sample.ns_per_op * 1e3;
+        println!(
+            "{:<14} {:<11} {:>10} {:>10} {:>12.1} {:>10.1} {:>10.1} {:>10.2}",
+            sample.case,
+            sample.op,
+            sample.json_bytes,
+            sample.lite3_bytes,
+            sample.ns_per_op,
+            mbps,
+            sample.alloc_bytes_per_op,
+            sample.allocs_per_op
+        );
+    }
+}
@@ -14,7 +14,7 @@ use serde_json::{Map, Value, json};
 #[path = "../src/bench.rs"]
 mod bench;
 
-use bench::{BenchArgs, BenchFormat, WorkerArgs, WorkerRole};
+use bench::{BenchArgs, BenchFormat, RegressionThresholds, WorkerArgs, WorkerRole};
 use plasmite::api::{Durability, Error, ErrorKind, to_exit_code};
 
 fn main() {
@@ -37,6 +37,7 @@ fn run() -> Result<(), Error> {
             messages,
             payload_bytes,
             durability,
+            rate,
             out_json,
         }) => bench::run_worker(WorkerArgs {
             pool_path: pool,
@@ -45,6 +46,7 @@ fn run() -> Result<(), Error> {
             payload_bytes: payload_bytes as usize,
             out_json,
             durability: parse_durability(&durability)?,
+            rate,
         }),
         None => {
             let pool_sizes = if cli.options.pool_size.is_empty() {
@@ -77,6 +79,30 @@ fn run() -> Result<(), Error> {
                     .collect::<Result<Vec<_>, _>>()?
             };
 
+            let subscribers = if cli.options.subscribers.is_empty() {
+                vec![1usize, 4usize, 16usize]
+            } else {
+                cli.options
+                    .subscribers
+                    .iter()
+                    .map(|value| parse_usize(value, "subscribers"))
+                    .collect::<Result<Vec<_>, _>>()?
+            };
+
+            let large_payload_sizes = if cli.options.large_payload_bytes.is_empty() {
+                vec![
+                    1024 * 1024usize,
+                    4 * 1024 * 1024usize,
+                    16 * 1024 * 1024usize,
+                ]
+            } else {
+                cli.options
+                    .large_payload_bytes
+                    .iter()
+                    .map(|value| parse_size(value).map(|size| size as usize))
+                    .collect::<Result<Vec<_>, _>>()?
+            };
+
             let durabilities = parse_bench_durabilities(&cli.options.durability)?;
             let format = BenchFormat::parse(&cli.options.format)?;
             bench::run_bench(
@@ -88,6 +114,19 @@ fn run() -> Result<(), Error> {
                     writers: writer_counts,
                     format,
                     durabilities,
+                    scenarios: cli.options.scenario,
+                    subscribers,
+                    follow_rate: cli.options.follow_rate,
+                    large_payload_sizes,
+                    large_messages: cli.options.large_messages,
+                    plasmite_bin: cli.options.plasmite_bin,
+                    baseline: cli.options.baseline,
+                    save_baseline: cli.options.save_baseline,
+                    thresholds: RegressionThresholds {
+                        max_time_pct: cli.options.max_regression_pct,
+                        max_p99_pct: cli.options.max_p99_regression_pct,
+                        noise_floor_ms: cli.options.noise_floor_ms,
+                    },
                 },
                 env!("CARGO_PKG_VERSION"),
             )
@@ -133,11 +172,67 @@ struct BenchOptions {
     writers: Vec<String>,
     #[arg(
         long,
-        help = "Durability mode(s): fast|flush|both (repeatable; default: fast)"
+        help = "Durability mode(s): fast|flush|group|both (repeatable; default: fast)"
     )]
     durability: Vec<String>,
     #[arg(long, default_value = "both", help = "Output format: json|table|both")]
     format: String,
+    #[arg(
+        long,
+        help = "Repeatable scenario to run (default: all; unknown names list them)"
+    )]
+    scenario: Vec<String>,
+    #[arg(
+        long,
+        help = "Repeatable subscriber counts for tail_fanout (default: 1,4,16)"
+    )]
+    subscribers: Vec<String>,
+    #[arg(
+        long,
+        default_value_t = 10_000,
+        help = "Paced writer rate in msgs/s for follow_paced and tail_fanout (0 = unpaced)"
+    )]
+    follow_rate: u64,
+    #[arg(
+        long = "large-payload-bytes",
+        help = "Repeatable large_payload size (bytes or K/M/G; default: 1M,4M,16M)"
+    )]
+    large_payload_bytes: Vec<String>,
+    #[arg(long, default_value_t = 16, help = "Messages per large_payload size")]
+    large_messages: u64,
+    #[arg(
+        long,
+        help = "plasmite binary for serve/CLI scenarios (default: target/<profile>/plasmite)"
+    )]
+    plasmite_bin: Option<PathBuf>,
+    #[arg(
+        long,
+        help = "Compare against this baseline JSON; exit 1 on regressions"
+    )]
+    baseline: Option<PathBuf>,
+    #[arg(
+        long,
+        help = "Write this run's JSON to a file for use as a later --baseline"
+    )]
+    save_baseline: Option<PathBuf>,
+    #[arg(
+        long,
+        default_value_t = 10.0,
+        help = "Allowed ms/msg increase vs baseline (percent)"
+    )]
+    max_regression_pct: f64,
+    #[arg(
+        long,
+        default_value_t = 25.0,
+        help = "Allowed p99 latency increase vs baseline (percent)"
+    )]
+    max_p99_regression_pct: f64,
+    #[arg(
+        long,
+        default_value_t = 5.0,
+        help = "Rows shorter than this (ms) are reported but never fail the baseline gate"
+    )]
+    noise_floor_ms: f64,
 }
 
 #[derive(Subcommand)]
@@ -152,8 +247,18 @@ enum BenchCommand {
         messages: u64,
         #[arg(long = "payload-bytes", help = "Approximate payload size in bytes")]
         payload_bytes: u64,
-        #[arg(long, default_value = "fast", help = "Durability mode: fast|flush")]
+        #[arg(
+            long,
+            default_value = "fast",
+            help = "Durability mode: fast|flush|group"
+        )]
         durability: String,
+        #[arg(
+            long,
+            default_value_t = 0,
+            help = "Writer pacing in msgs/s (0 = unpaced)"
+        )]
+        rate: u64,
         #[arg(long = "out-json", help = "Write worker result JSON to this path")]
         out_json: PathBuf,
     },
@@ -231,9 +336,10 @@ fn parse_durability(input: &str) -> Result<Durability, Error> {
     match input.trim() {
         "fast" => Ok(Durability::Fast),
         "flush" => Ok(Durability::Flush),
+        "group" => Ok(Durability::group_commit()),
         _ => Err(Error::new(ErrorKind::Usage)
             .with_message("invalid durability")
-            .with_hint("Use fast or flush.")),
+            .with_hint("Use fast, flush, or group.")),
     }
 }
 
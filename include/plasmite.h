@@ -1,6 +1,8 @@
 /*
 Purpose: C ABI for Plasmite bindings using libplasmite.
-Key Exports: Client/Pool/Stream handles, JSON + Lite3 append/get/tail functions, buffers, errors.
+Key Exports: Client/Pool/Stream handles, JSON + Lite3 append/get/tail functions, buffers, errors,
+Key Exports: reserve/commit zero-copy appends, batch appends, batch stream reads,
+Key Exports: borrowed Lite3 views, precompiled Lite3 key paths, hot-path metrics.
 Role: Stable boundary for official bindings (Go/Python/Node) in v0.
 
 ABI stability:
@@ -45,6 +47,7 @@ typedef struct plsm_client plsm_client_t;
 typedef struct plsm_pool plsm_pool_t;
 typedef struct plsm_stream plsm_stream_t;
 typedef struct plsm_lite3_stream plsm_lite3_stream_t;
+typedef struct plsm_lite3_path plsm_lite3_path_t;
 
 typedef enum plsm_error_kind {
     PLSM_ERROR_INTERNAL = 1,
@@ -69,6 +72,42 @@ typedef struct plsm_lite3_frame {
     plsm_buf_t payload;
 } plsm_lite3_frame_t;
 
+/*
+Borrowed Lite3 frame: data points into the pool mmap instead of a copy.
+  - Readable only while the pool/stream handle that produced it is open.
+  - A writer may reclaim the bytes at any time; decode in place, then call
+    plsm_view_still_valid() and discard the result if it returns 0. Copy
+    the payload if it must outlive that check.
+  - map_base, map_len and frame_offset are the validity token; treat them
+    as opaque.
+  - Views hand out bytes as stored: in a compressed pool, flags has
+    PLSM_FRAME_FLAG_ZSTD set and data is a zstd frame rather than Lite3.
+    plsm_lite3_frame_t copies (and plsm_pool_get_lite3) are always decoded.
+*/
+#define PLSM_FRAME_FLAG_ZSTD 1u
+
+typedef struct plsm_lite3_view {
+    uint64_t seq;
+    uint64_t timestamp_ns;
+    uint32_t flags;
+    const uint8_t *data;
+    size_t len;
+    const uint8_t *map_base;
+    size_t map_len;
+    uint64_t frame_offset;
+} plsm_lite3_view_t;
+
+/*
+Durability values for the append functions' durability argument.
+  - FAST leaves write-back to the OS; FLUSH syncs the append before returning.
+  - GROUP_COMMIT also returns once the append is synced, but by a background
+    flush shared with concurrent appends to the pool in this process (default
+    window: 2 ms or 1 MiB pending). Reserve/commit applies it at commit.
+*/
+#define PLSM_DURABILITY_FAST 0u
+#define PLSM_DURABILITY_FLUSH 1u
+#define PLSM_DURABILITY_GROUP_COMMIT 2u
+
 typedef struct plsm_error {
     int32_t kind;
     char *message;
@@ -148,6 +187,22 @@ int plsm_lite3_stream_next(
     plsm_lite3_frame_t *out_frame,
     plsm_error_t **out_err);
 
+/*
+Time seek: skip messages stamped before timestamp_ns (Unix nanoseconds).
+  - Repositions the stream via the pool's time checkpoints instead of reading
+    from the oldest message; call it right after open.
+  - Combines with since_seq: both bounds must hold. Returns 0 on success.
+*/
+int plsm_stream_seek_time(
+    plsm_stream_t *stream,
+    uint64_t timestamp_ns,
+    plsm_error_t **out_err);
+
+int plsm_lite3_stream_seek_time(
+    plsm_lite3_stream_t *stream,
+    uint64_t timestamp_ns,
+    plsm_error_t **out_err);
+
 void plsm_stream_free(plsm_stream_t *stream);
 void plsm_lite3_stream_free(plsm_lite3_stream_t *stream);
 
@@ -155,6 +210,132 @@ void plsm_buf_free(plsm_buf_t *buf);
 void plsm_lite3_frame_free(plsm_lite3_frame_t *frame);
 void plsm_error_free(plsm_error_t *err);
 
+/*
+Zero-copy append: reserve up to max_len payload bytes inside the pool's ring,
+write a Lite3 payload into *out_buf, then commit the bytes actually used.
+  - The reservation holds the pool's append lock; other appends through the same
+    handle fail with PLSM_ERROR_BUSY until commit or abort.
+  - *out_buf is borrowed pool memory, valid only until commit/abort/pool free.
+  - Commit validates the payload; on failure the reservation is released.
+  - Frames evicted to fit max_len stay evicted even on abort.
+*/
+int plsm_pool_append_reserve(
+    plsm_pool_t *pool,
+    size_t max_len,
+    uint32_t durability,
+    uint8_t **out_buf,
+    plsm_error_t **out_err);
+
+int plsm_pool_append_commit(
+    plsm_pool_t *pool,
+    size_t payload_len,
+    uint64_t *out_seq,
+    plsm_error_t **out_err);
+
+void plsm_pool_append_abort(plsm_pool_t *pool);
+
+/*
+Batch append: append count Lite3 payloads under one append lock with one
+shared timestamp, one coalesced flush (FLUSH or GROUP_COMMIT), and one wakeup.
+  - payloads[i] points at payload_lens[i] bytes; every payload is validated
+    before anything is written.
+  - On success *out_first_seq is the first assigned seq; the batch occupies
+    first_seq .. first_seq + count - 1.
+  - *out_count (may be NULL) receives how many payloads were committed, also
+    on error: a failure part-way can leave payloads[0 .. *out_count - 1]
+    committed from *out_first_seq, so resume after them rather than resending.
+*/
+int plsm_pool_append_batch(
+    plsm_pool_t *pool,
+    const uint8_t *const *payloads,
+    const size_t *payload_lens,
+    size_t count,
+    uint32_t durability,
+    uint64_t *out_first_seq,
+    size_t *out_count,
+    plsm_error_t **out_err);
+
+/*
+Batch stream reads: return up to max messages per call instead of one.
+  - Both take (stream, capacity, outputs..., out_err).
+  - Waits (like the single-message call) for the first message only, then
+    takes whatever is already available; returns the count, 0 at stream end.
+  - All bytes land in one *out_arena buffer; free it once with plsm_buf_free.
+  - plsm_stream_next_batch: message i is the JSON at
+    arena.data[out_offsets[i] .. out_offsets[i + 1]]; out_offsets needs
+    max_messages + 1 entries.
+  - plsm_lite3_stream_next_batch: out_frames[i].payload points into the
+    arena; do not pass these frames to plsm_lite3_frame_free.
+  - An error after some messages were gathered is reported by the next call.
+*/
+int plsm_stream_next_batch(
+    plsm_stream_t *stream,
+    size_t max_messages,
+    plsm_buf_t *out_arena,
+    size_t *out_offsets,
+    plsm_error_t **out_err);
+
+int plsm_lite3_stream_next_batch(
+    plsm_lite3_stream_t *stream,
+    size_t max_frames,
+    plsm_lite3_frame_t *out_frames,
+    plsm_buf_t *out_arena,
+    plsm_error_t **out_err);
+
+/*
+Zero-copy reads: fill *out_view with a borrowed frame (see plsm_lite3_view_t).
+  - plsm_pool_get_lite3_view returns 0 on success.
+  - plsm_lite3_stream_next_view returns 1 with a view, 0 at stream end.
+  - plsm_view_still_valid returns 1 while the frame is unchanged, else 0.
+*/
+int plsm_pool_get_lite3_view(
+    plsm_pool_t *pool,
+    uint64_t seq,
+    plsm_lite3_view_t *out_view,
+    plsm_error_t **out_err);
+
+int plsm_lite3_stream_next_view(
+    plsm_lite3_stream_t *stream,
+    plsm_lite3_view_t *out_view,
+    plsm_error_t **out_err);
+
+int plsm_view_still_valid(const plsm_lite3_view_t *view);
+
+/*
+Precompiled object key path ("meta.tags", "data.level"): keys are hashed once at
+compile time, then resolved against any payload in a single call.
+  - plsm_lite3_path_get returns 1 and fills *out_offset (byte offset of the value
+    within data) and *out_type (LITE3_TYPE_* code) when the path resolves, 0 when
+    a key is missing or an intermediate value is not an object, -1 on error.
+  - out_offset and out_type may be NULL. Free paths with plsm_lite3_path_free.
+*/
+int plsm_lite3_path_compile(
+    const char *path,
+    plsm_lite3_path_t **out_path,
+    plsm_error_t **out_err);
+
+int plsm_lite3_path_get(
+    const plsm_lite3_path_t *path,
+    const uint8_t *data,
+    size_t len,
+    uint64_t *out_offset,
+    uint8_t *out_type,
+    plsm_error_t **out_err);
+
+void plsm_lite3_path_free(plsm_lite3_path_t *path);
+
+/*
+Hot-path metrics: fill *out_json with a JSON object of the pool's counters
+(append_lock, get, cursor, notify), summed over every process using the pool,
+plus "lite3" codec counters for the calling process. Histogram "*_buckets"
+arrays count values up to 1, 4, 16, ... 4^14, then everything above.
+Free *out_json with plsm_buf_free. Returns 0 on success.
+*/
+int plsm_pool_metrics_json(
+    plsm_pool_t *pool,
+    plsm_buf_t *out_json,
+    plsm_error_t **out_err);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -1,5 +1,5 @@
 //! Purpose: C ABI bridge for bindings (libplasmite).
-//! Exports: C-callable client/pool/stream functions and buffer/error helpers.
+//! Exports: C-callable client/pool/stream functions, compiled Lite3 paths, and buffer/error helpers.
 //! Role: Stable ABI surface for non-Rust bindings in v0.
 //!
 //! ABI stability: additive-only within a major version — no field removals,
@@ -13,13 +13,14 @@
 
 use crate::api::{LocalClient, PoolApiExt, PoolOptions, PoolRef};
 use crate::core::error::{Error, ErrorKind};
-use crate::core::pool::Pool;
+use crate::core::lite3::{Lite3DocRef, Lite3Path};
+use crate::core::pool::{Pool, Reservation};
 use serde_json::Value;
 use std::ffi::{CStr, CString};
 use std::os::raw::c_char;
 use std::path::PathBuf;
 use std::ptr;
-use std::time::{Duration, Instant};
+use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 
 #[repr(C)]
 pub struct plsm_client {
@@ -29,28 +30,150 @@ pub struct plsm_client {
 #[repr(C)]
 pub struct plsm_pool {
     pool: Pool,
+    // Outstanding `plsm_pool_append_reserve`; holds the pool's append lock.
+    reservation: Option<Reservation>,
 }
 
 #[repr(C)]
 pub struct plsm_stream {
-    pool: Pool,
-    cursor: crate::api::Cursor,
-    since_seq: Option<u64>,
-    max_messages: Option<usize>,
-    seen: usize,
-    poll_interval: Duration,
-    deadline: Option<Instant>,
+    state: StreamState,
 }
 
 #[repr(C)]
 pub struct plsm_lite3_stream {
+    state: StreamState,
+}
+
+#[repr(C)]
+pub struct plsm_lite3_path {
+    path: Lite3Path,
+}
+
+/// Cursor state shared by the JSON and Lite3 stream handles.
+struct StreamState {
     pool: Pool,
     cursor: crate::api::Cursor,
     since_seq: Option<u64>,
+    since_ns: Option<u64>,
     max_messages: Option<usize>,
     seen: usize,
     poll_interval: Duration,
     deadline: Option<Instant>,
+    // Failure hit after a batch call already collected frames; reported by the next call so
+    // the collected frames are not lost.
+    pending_error: Option<Error>,
+}
+
+impl StreamState {
+    fn new(
+        pool: Pool,
+        since_seq: Option<u64>,
+        max_messages: Option<usize>,
+        deadline: Option<Instant>,
+    ) -> Self {
+        Self {
+            pool,
+            cursor: crate::api::Cursor::new(),
+            since_seq,
+            since_ns: None,
+            max_messages,
+            seen: 0,
+            poll_interval: Duration::from_millis(50),
+            deadline,
+            pending_error: None,
+        }
+    }
+
+    /// Skip frames stamped before `timestamp_ns`, repositioning the cursor through the pool's
+    /// time checkpoints.
+    fn seek_time(&mut self, timestamp_ns: u64) -> Result<(), Error> {
+        self.cursor.seek_to_time(&self.pool, timestamp_ns)?;
+        self.since_ns = Some(timestamp_ns);
+        Ok(())
+    }
+
+    /// Up to `max` frames for one batch call, read through `Cursor::next_batch` so the pool
+    /// header is decoded once per batch rather than per frame. Waits only for the first
+    /// frame. A failure after frames were gathered comes back alongside them, for the caller
+    /// to keep as `pending_error` once it is done with the frames. The pool comes back too,
+    /// for decoding compressed payloads while the frames are borrowed.
+    fn next_frames(&mut self, max: usize) -> (&Pool, Vec<crate::api::FrameRef<'_>>, Option<Error>) {
+        let limit = self
+            .max_messages
+            .map_or(max, |cap| cap.saturating_sub(self.seen).min(max));
+        let (since_seq, since_ns) = (self.since_seq, self.since_ns);
+        let mut frames = Vec::new();
+        let mut failure = None;
+        while frames.len() < limit {
+            if self
+                .deadline
+                .is_some_and(|deadline| Instant::now() >= deadline)
+            {
+                break;
+            }
+            match self
+                .cursor
+                .next_batch(&self.pool, limit - frames.len(), &mut frames)
+            {
+                Ok(crate::api::BatchResult::Frames(_)) => frames.retain(|frame| {
+                    since_seq.is_none_or(|min_seq| frame.seq >= min_seq)
+                        && since_ns.is_none_or(|since| frame.timestamp_ns >= since)
+                }),
+                Ok(crate::api::BatchResult::WouldBlock) => {
+                    if !frames.is_empty() {
+                        break;
+                    }
+                    std::thread::sleep(self.poll_interval);
+                }
+                Ok(crate::api::BatchResult::FellBehind) => {}
+                Err(err) => {
+                    failure = Some(err);
+                    break;
+                }
+            }
+        }
+        self.seen += frames.len();
+        (&self.pool, frames, failure)
+    }
+
+    /// Next frame at or after `since_seq` (and `since_ns`), waiting for appends;
+    /// `Ok(None)` means the stream ended (max or deadline). The frame comes with its pool.
+    fn next_frame(&mut self) -> Result<Option<(&Pool, crate::api::FrameRef<'_>)>, Error> {
+        if let Some(max) = self.max_messages {
+            if self.seen >= max {
+                return Ok(None);
+            }
+        }
+
+        loop {
+            if let Some(deadline) = self.deadline {
+                if Instant::now() >= deadline {
+                    return Ok(None);
+                }
+            }
+
+            match self.cursor.next(&self.pool)? {
+                crate::api::CursorResult::Message(frame) => {
+                    if let Some(min_seq) = self.since_seq {
+                        if frame.seq < min_seq {
+                            continue;
+                        }
+                    }
+                    if let Some(since) = self.since_ns {
+                        if frame.timestamp_ns < since {
+                            continue;
+                        }
+                    }
+                    self.seen += 1;
+                    return Ok(Some((&self.pool, frame)));
+                }
+                crate::api::CursorResult::WouldBlock => {
+                    std::thread::sleep(self.poll_interval);
+                }
+                crate::api::CursorResult::FellBehind => continue,
+            }
+        }
+    }
 }
 
 #[repr(C)]
@@ -67,6 +190,20 @@ pub struct plsm_lite3_frame {
     payload: plsm_buf,
 }
 
+/// Borrowed frame: `data` points into the pool mmap. The trailing fields are the validity
+/// token read back by `plsm_view_still_valid`.
+#[repr(C)]
+pub struct plsm_lite3_view {
+    seq: u64,
+    timestamp_ns: u64,
+    flags: u32,
+    data: *const u8,
+    len: usize,
+    map_base: *const u8,
+    map_len: usize,
+    frame_offset: u64,
+}
+
 #[repr(C)]
 pub struct plsm_error {
     kind: i32,
@@ -153,7 +290,10 @@ pub extern "C" fn plsm_pool_create(
             Error::new(ErrorKind::Usage).with_message("out_pool is null"),
         );
     }
-    let handle = Box::new(plsm_pool { pool });
+    let handle = Box::new(plsm_pool {
+        pool,
+        reservation: None,
+    });
     unsafe {
         *out_pool = Box::into_raw(handle);
     }
@@ -185,7 +325,10 @@ pub extern "C" fn plsm_pool_open(
             Error::new(ErrorKind::Usage).with_message("out_pool is null"),
         );
     }
-    let handle = Box::new(plsm_pool { pool });
+    let handle = Box::new(plsm_pool {
+        pool,
+        reservation: None,
+    });
     unsafe {
         *out_pool = Box::into_raw(handle);
     }
@@ -217,6 +360,9 @@ pub extern "C" fn plsm_pool_append_json(
         Ok(pool) => pool,
         Err(code) => return code,
     };
+    if pool.reservation.is_some() {
+        return fail(out_err, reservation_outstanding());
+    }
     let data = match parse_json_bytes(json_bytes, json_len) {
         Ok(value) => value,
         Err(err) => return fail(out_err, err),
@@ -225,15 +371,9 @@ pub extern "C" fn plsm_pool_append_json(
         Ok(tags) => tags,
         Err(err) => return fail(out_err, err),
     };
-    let durability = match durability {
-        0 => crate::api::Durability::Fast,
-        1 => crate::api::Durability::Flush,
-        _ => {
-            return fail(
-                out_err,
-                Error::new(ErrorKind::Usage).with_message("invalid durability"),
-            );
-        }
+    let durability = match durability_from_code(durability) {
+        Ok(durability) => durability,
+        Err(err) => return fail(out_err, err),
     };
     let message = match pool.pool.append_json_now(&data, &tags, durability) {
         Ok(message) => message,
@@ -258,6 +398,9 @@ pub extern "C" fn plsm_pool_append_lite3(
         Ok(pool) => pool,
         Err(code) => return code,
     };
+    if pool.reservation.is_some() {
+        return fail(out_err, reservation_outstanding());
+    }
     if out_seq.is_null() {
         return fail(
             out_err,
@@ -271,15 +414,9 @@ pub extern "C" fn plsm_pool_append_lite3(
         );
     }
     let payload = unsafe { std::slice::from_raw_parts(payload, payload_len) };
-    let durability = match durability {
-        0 => crate::api::Durability::Fast,
-        1 => crate::api::Durability::Flush,
-        _ => {
-            return fail(
-                out_err,
-                Error::new(ErrorKind::Usage).with_message("invalid durability"),
-            );
-        }
+    let durability = match durability_from_code(durability) {
+        Ok(durability) => durability,
+        Err(err) => return fail(out_err, err),
     };
     let seq = match pool.pool.append_lite3_now(payload, durability) {
         Ok(seq) => seq,
@@ -291,6 +428,185 @@ pub extern "C" fn plsm_pool_append_lite3(
     0
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_pool_append_reserve(
+    pool: *mut plsm_pool,
+    max_len: usize,
+    durability: u32,
+    out_buf: *mut *mut u8,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let pool = match borrow_pool(pool, out_err) {
+        Ok(pool) => pool,
+        Err(code) => return code,
+    };
+    if out_buf.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_buf is null"),
+        );
+    }
+    if pool.reservation.is_some() {
+        return fail(out_err, reservation_outstanding());
+    }
+    let durability = match durability_from_code(durability) {
+        Ok(durability) => durability,
+        Err(err) => return fail(out_err, err),
+    };
+    let timestamp_ns = match now_ns() {
+        Ok(timestamp_ns) => timestamp_ns,
+        Err(err) => return fail(out_err, err),
+    };
+    let options = crate::api::AppendOptions::new(timestamp_ns, durability);
+    let reservation = match pool.pool.reserve(max_len, options) {
+        Ok(reservation) => reservation,
+        Err(err) => return fail(out_err, err),
+    };
+    let buf = pool.pool.reserved_payload_mut(&reservation).as_mut_ptr();
+    pool.reservation = Some(reservation);
+    unsafe {
+        *out_buf = buf;
+    }
+    0
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_pool_append_commit(
+    pool: *mut plsm_pool,
+    payload_len: usize,
+    out_seq: *mut u64,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let pool = match borrow_pool(pool, out_err) {
+        Ok(pool) => pool,
+        Err(code) => return code,
+    };
+    if out_seq.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_seq is null"),
+        );
+    }
+    let Some(reservation) = pool.reservation.take() else {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("no append reservation"),
+        );
+    };
+    let payload = pool.pool.reserved_payload_mut(&reservation);
+    let Some(payload) = payload.get(..payload_len) else {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("commit length exceeds reservation"),
+        );
+    };
+    if let Err(err) = crate::core::lite3::validate_bytes(payload) {
+        return fail(out_err, err);
+    }
+    let seq = match pool.pool.commit_reservation(reservation, payload_len) {
+        Ok(seq) => seq,
+        Err(err) => return fail(out_err, err),
+    };
+    unsafe {
+        *out_seq = seq;
+    }
+    0
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_pool_append_abort(pool: *mut plsm_pool) {
+    if pool.is_null() {
+        return;
+    }
+    unsafe {
+        (*pool).reservation = None;
+    }
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_pool_append_batch(
+    pool: *mut plsm_pool,
+    payloads: *const *const u8,
+    payload_lens: *const usize,
+    count: usize,
+    durability: u32,
+    out_first_seq: *mut u64,
+    out_count: *mut usize,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    if !out_count.is_null() {
+        unsafe {
+            *out_count = 0;
+        }
+    }
+    let pool = match borrow_pool(pool, out_err) {
+        Ok(pool) => pool,
+        Err(code) => return code,
+    };
+    if pool.reservation.is_some() {
+        return fail(out_err, reservation_outstanding());
+    }
+    if out_first_seq.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_first_seq is null"),
+        );
+    }
+    if count == 0 {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("batch is empty"),
+        );
+    }
+    if payloads.is_null() || payload_lens.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("payloads is null"),
+        );
+    }
+    let ptrs = unsafe { std::slice::from_raw_parts(payloads, count) };
+    let lens = unsafe { std::slice::from_raw_parts(payload_lens, count) };
+    let mut batch = Vec::with_capacity(count);
+    for (&ptr, &len) in ptrs.iter().zip(lens) {
+        if ptr.is_null() {
+            return fail(
+                out_err,
+                Error::new(ErrorKind::Usage).with_message("lite3_bytes is null"),
+            );
+        }
+        let payload = unsafe { std::slice::from_raw_parts(ptr, len) };
+        if let Err(err) = crate::core::lite3::validate_bytes(payload) {
+            return fail(out_err, err);
+        }
+        batch.push(payload);
+    }
+    let durability = match durability_from_code(durability) {
+        Ok(durability) => durability,
+        Err(err) => return fail(out_err, err),
+    };
+    let timestamp_ns = match now_ns() {
+        Ok(timestamp_ns) => timestamp_ns,
+        Err(err) => return fail(out_err, err),
+    };
+    let options = crate::api::AppendOptions::new(timestamp_ns, durability);
+    // A failure part-way leaves a committed prefix; report it so callers can resume after it.
+    let (seqs, result) = pool.pool.append_batch_partial(&batch, options);
+    if let Some(&first_seq) = seqs.first() {
+        unsafe {
+            *out_first_seq = first_seq;
+        }
+    }
+    if !out_count.is_null() {
+        unsafe {
+            *out_count = seqs.len();
+        }
+    }
+    match result {
+        Ok(()) => 0,
+        Err(err) => fail(out_err, err),
+    }
+}
+
 #[unsafe(no_mangle)]
 pub extern "C" fn plsm_pool_get_json(
     pool: *mut plsm_pool,
@@ -302,11 +618,11 @@ pub extern "C" fn plsm_pool_get_json(
         Ok(pool) => pool,
         Err(code) => return code,
     };
-    let message = match pool.pool.get_message(seq) {
-        Ok(message) => message,
+    let frame = match pool.pool.get_lite3(seq) {
+        Ok(frame) => frame,
         Err(err) => return fail(out_err, err),
     };
-    if let Err(err) = write_message_buf(out_message, message) {
+    if let Err(err) = write_frame_buf(out_message, &pool.pool, &frame) {
         return fail(out_err, err);
     }
     0
@@ -327,12 +643,167 @@ pub extern "C" fn plsm_pool_get_lite3(
         Ok(frame) => frame,
         Err(err) => return fail(out_err, err),
     };
-    if let Err(err) = write_lite3_frame(out_frame, frame) {
+    if let Err(err) = write_lite3_frame(out_frame, &pool.pool, frame) {
         return fail(out_err, err);
     }
     0
 }
 
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_pool_get_lite3_view(
+    pool: *mut plsm_pool,
+    seq: u64,
+    out_view: *mut plsm_lite3_view,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let pool = match borrow_pool(pool, out_err) {
+        Ok(pool) => pool,
+        Err(code) => return code,
+    };
+    if out_view.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_view is null"),
+        );
+    }
+    let frame = match pool.pool.get_lite3(seq) {
+        Ok(frame) => frame,
+        Err(err) => return fail(out_err, err),
+    };
+    if let Err(err) = write_lite3_view(out_view, pool.pool.mmap(), &frame) {
+        return fail(out_err, err);
+    }
+    0
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_view_still_valid(view: *const plsm_lite3_view) -> i32 {
+    if view.is_null() {
+        return 0;
+    }
+    let view = unsafe { &*view };
+    if view.map_base.is_null() {
+        return 0;
+    }
+    // The mapping outlives the view for as long as the producing handle is open.
+    let mmap = unsafe { std::slice::from_raw_parts(view.map_base, view.map_len) };
+    crate::core::pool::frame_view_valid(mmap, view.frame_offset as usize, view.seq, view.len) as i32
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_pool_metrics_json(
+    pool: *mut plsm_pool,
+    out_json: *mut plsm_buf,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let pool = match borrow_pool(pool, out_err) {
+        Ok(pool) => pool,
+        Err(code) => return code,
+    };
+    if out_json.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_json is null"),
+        );
+    }
+    let mut json = pool.pool.hot_metrics().to_json();
+    json["lite3"] = crate::api::lite3_codec_metrics().to_json();
+    match serde_json::to_vec(&json) {
+        Ok(bytes) => {
+            hand_off_buf(out_json, bytes);
+            0
+        }
+        Err(err) => fail(
+            out_err,
+            Error::new(ErrorKind::Internal)
+                .with_message("failed to encode metrics")
+                .with_source(err),
+        ),
+    }
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_lite3_path_compile(
+    path: *const c_char,
+    out_path: *mut *mut plsm_lite3_path,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    if out_path.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_path is null"),
+        );
+    }
+    if path.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("path is null"),
+        );
+    }
+    let dotted = match unsafe { CStr::from_ptr(path) }.to_str() {
+        Ok(dotted) => dotted,
+        Err(_) => {
+            return fail(
+                out_err,
+                Error::new(ErrorKind::Usage).with_message("path is not valid UTF-8"),
+            );
+        }
+    };
+    let path = match Lite3Path::parse(dotted) {
+        Ok(path) => path,
+        Err(err) => return fail(out_err, err),
+    };
+    unsafe {
+        *out_path = Box::into_raw(Box::new(plsm_lite3_path { path }));
+    }
+    0
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_lite3_path_get(
+    path: *const plsm_lite3_path,
+    data: *const u8,
+    len: usize,
+    out_offset: *mut u64,
+    out_type: *mut u8,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    if path.is_null() || data.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("path or data is null"),
+        );
+    }
+    let path = unsafe { &(*path).path };
+    let doc = Lite3DocRef::new(unsafe { std::slice::from_raw_parts(data, len) });
+    let offset = match doc.offset_at_path(0, path) {
+        Ok(Some(offset)) => offset,
+        Ok(None) => return 0,
+        Err(err) => return fail(out_err, err),
+    };
+    if !out_offset.is_null() {
+        unsafe {
+            *out_offset = offset as u64;
+        }
+    }
+    if !out_type.is_null() {
+        unsafe {
+            *out_type = doc.bytes()[offset];
+        }
+    }
+    1
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_lite3_path_free(path: *mut plsm_lite3_path) {
+    if path.is_null() {
+        return;
+    }
+    unsafe {
+        drop(Box::from_raw(path));
+    }
+}
+
 #[unsafe(no_mangle)]
 pub extern "C" fn plsm_stream_open(
     pool: *mut plsm_pool,
@@ -380,13 +851,7 @@ pub extern "C" fn plsm_stream_open(
         Err(err) => return fail(out_err, err),
     };
     let handle = Box::new(plsm_stream {
-        pool,
-        cursor: crate::api::Cursor::new(),
-        since_seq: since,
-        max_messages: max,
-        seen: 0,
-        poll_interval: Duration::from_millis(50),
-        deadline,
+        state: StreamState::new(pool, since, max, deadline),
     });
     unsafe {
         *out_stream = Box::into_raw(handle);
@@ -404,43 +869,75 @@ pub extern "C" fn plsm_stream_next(
         Ok(stream) => stream,
         Err(code) => return code,
     };
-    if let Some(max) = stream.max_messages {
-        if stream.seen >= max {
-            return 0;
-        }
+    if let Some(err) = stream.state.pending_error.take() {
+        return fail(out_err, err);
     }
+    let written = match stream.state.next_frame() {
+        Ok(Some((pool, frame))) => write_frame_buf(out_message, pool, &frame),
+        Ok(None) => return 0,
+        Err(err) => return fail(out_err, err),
+    };
+    if let Err(err) = written {
+        return fail(out_err, err);
+    }
+    1
+}
 
-    loop {
-        if let Some(deadline) = stream.deadline {
-            if Instant::now() >= deadline {
-                return 0;
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_stream_next_batch(
+    stream: *mut plsm_stream,
+    max_messages: usize,
+    out_arena: *mut plsm_buf,
+    out_offsets: *mut usize,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let stream = match borrow_stream(stream, out_err) {
+        Ok(stream) => stream,
+        Err(code) => return code,
+    };
+    if out_arena.is_null() || out_offsets.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_arena or out_offsets is null"),
+        );
+    }
+    if max_messages == 0 {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("max_messages must be positive"),
+        );
+    }
+    if let Some(err) = stream.state.pending_error.take() {
+        return fail(out_err, err);
+    }
+    let max_messages = max_messages.min(i32::MAX as usize);
+    let offsets = unsafe { std::slice::from_raw_parts_mut(out_offsets, max_messages + 1) };
+    let mut arena = Vec::new();
+    let mut count = 0usize;
+    offsets[0] = 0;
+    let failure = {
+        let (pool, frames, mut failure) = stream.state.next_frames(max_messages);
+        for frame in &frames {
+            let written = pool.frame_payload(frame).and_then(|payload| {
+                crate::api::Message::write_frame_json(&frame.with_payload(&payload), &mut arena)
+            });
+            if let Err(err) = written {
+                failure = Some(err);
+                break;
             }
+            count += 1;
+            offsets[count] = arena.len();
         }
-
-        match stream.cursor.next(&stream.pool) {
-            Ok(crate::api::CursorResult::Message(frame)) => {
-                if let Some(min_seq) = stream.since_seq {
-                    if frame.seq < min_seq {
-                        continue;
-                    }
-                }
-                let message = match message_from_frame(&frame) {
-                    Ok(message) => message,
-                    Err(err) => return fail(out_err, err),
-                };
-                stream.seen += 1;
-                if let Err(err) = write_message_buf(out_message, message) {
-                    return fail(out_err, err);
-                }
-                return 1;
-            }
-            Ok(crate::api::CursorResult::WouldBlock) => {
-                std::thread::sleep(stream.poll_interval);
-            }
-            Ok(crate::api::CursorResult::FellBehind) => continue,
-            Err(err) => return fail(out_err, err),
+        failure
+    };
+    if let Some(err) = failure {
+        if count == 0 {
+            return fail(out_err, err);
         }
+        stream.state.pending_error = Some(err);
     }
+    write_arena(out_arena, arena);
+    count as i32
 }
 
 #[unsafe(no_mangle)]
@@ -490,13 +987,7 @@ pub extern "C" fn plsm_lite3_stream_open(
         Err(err) => return fail(out_err, err),
     };
     let handle = Box::new(plsm_lite3_stream {
-        pool,
-        cursor: crate::api::Cursor::new(),
-        since_seq: since,
-        max_messages: max,
-        seen: 0,
-        poll_interval: Duration::from_millis(50),
-        deadline,
+        state: StreamState::new(pool, since, max, deadline),
     });
     unsafe {
         *out_stream = Box::into_raw(handle);
@@ -514,38 +1005,156 @@ pub extern "C" fn plsm_lite3_stream_next(
         Ok(stream) => stream,
         Err(code) => return code,
     };
-    if let Some(max) = stream.max_messages {
-        if stream.seen >= max {
-            return 0;
-        }
+    if let Some(err) = stream.state.pending_error.take() {
+        return fail(out_err, err);
+    }
+    let (pool, frame) = match stream.state.next_frame() {
+        Ok(Some(next)) => next,
+        Ok(None) => return 0,
+        Err(err) => return fail(out_err, err),
+    };
+    if let Err(err) = write_lite3_frame(out_frame, pool, frame) {
+        return fail(out_err, err);
     }
+    1
+}
 
-    loop {
-        if let Some(deadline) = stream.deadline {
-            if Instant::now() >= deadline {
-                return 0;
-            }
-        }
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_lite3_stream_next_view(
+    stream: *mut plsm_lite3_stream,
+    out_view: *mut plsm_lite3_view,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let stream = match borrow_lite3_stream(stream, out_err) {
+        Ok(stream) => stream,
+        Err(code) => return code,
+    };
+    if out_view.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_view is null"),
+        );
+    }
+    if let Some(err) = stream.state.pending_error.take() {
+        return fail(out_err, err);
+    }
+    let (pool, frame) = match stream.state.next_frame() {
+        Ok(Some(next)) => next,
+        Ok(None) => return 0,
+        Err(err) => return fail(out_err, err),
+    };
+    if let Err(err) = write_lite3_view(out_view, pool.mmap(), &frame) {
+        return fail(out_err, err);
+    }
+    1
+}
 
-        match stream.cursor.next(&stream.pool) {
-            Ok(crate::api::CursorResult::Message(frame)) => {
-                if let Some(min_seq) = stream.since_seq {
-                    if frame.seq < min_seq {
-                        continue;
-                    }
-                }
-                stream.seen += 1;
-                if let Err(err) = write_lite3_frame(out_frame, frame) {
-                    return fail(out_err, err);
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_lite3_stream_next_batch(
+    stream: *mut plsm_lite3_stream,
+    max_frames: usize,
+    out_frames: *mut plsm_lite3_frame,
+    out_arena: *mut plsm_buf,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let stream = match borrow_lite3_stream(stream, out_err) {
+        Ok(stream) => stream,
+        Err(code) => return code,
+    };
+    if out_frames.is_null() || out_arena.is_null() {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("out_frames or out_arena is null"),
+        );
+    }
+    if max_frames == 0 {
+        return fail(
+            out_err,
+            Error::new(ErrorKind::Usage).with_message("max_frames must be positive"),
+        );
+    }
+    if let Some(err) = stream.state.pending_error.take() {
+        return fail(out_err, err);
+    }
+    let max_frames = max_frames.min(i32::MAX as usize);
+    let frames = unsafe { std::slice::from_raw_parts_mut(out_frames, max_frames) };
+    let mut arena = Vec::new();
+    let mut spans = Vec::with_capacity(max_frames);
+    let failure = {
+        let (pool, batch, mut failure) = stream.state.next_frames(max_frames);
+        for frame in &batch {
+            let payload = match pool.frame_payload(frame) {
+                Ok(payload) => payload,
+                Err(err) => {
+                    failure = Some(err);
+                    break;
                 }
-                return 1;
-            }
-            Ok(crate::api::CursorResult::WouldBlock) => {
-                std::thread::sleep(stream.poll_interval);
-            }
-            Ok(crate::api::CursorResult::FellBehind) => continue,
-            Err(err) => return fail(out_err, err),
+            };
+            let start = arena.len();
+            arena.extend_from_slice(&payload);
+            spans.push((
+                frame.seq,
+                frame.timestamp_ns,
+                frame.with_payload(&payload).flags,
+                start,
+                payload.len(),
+            ));
         }
+        failure
+    };
+    if let Some(err) = failure {
+        if spans.is_empty() {
+            return fail(out_err, err);
+        }
+        stream.state.pending_error = Some(err);
+    }
+    // Payload pointers are only known once the arena stops growing.
+    let base = write_arena(out_arena, arena);
+    for (out, &(seq, timestamp_ns, flags, start, len)) in frames.iter_mut().zip(&spans) {
+        out.seq = seq;
+        out.timestamp_ns = timestamp_ns;
+        out.flags = flags;
+        out.payload = plsm_buf {
+            data: if len == 0 {
+                ptr::null_mut()
+            } else {
+                unsafe { base.add(start) }
+            },
+            len,
+        };
+    }
+    spans.len() as i32
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_stream_seek_time(
+    stream: *mut plsm_stream,
+    timestamp_ns: u64,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let stream = match borrow_stream(stream, out_err) {
+        Ok(stream) => stream,
+        Err(code) => return code,
+    };
+    match stream.state.seek_time(timestamp_ns) {
+        Ok(()) => 0,
+        Err(err) => fail(out_err, err),
+    }
+}
+
+#[unsafe(no_mangle)]
+pub extern "C" fn plsm_lite3_stream_seek_time(
+    stream: *mut plsm_lite3_stream,
+    timestamp_ns: u64,
+    out_err: *mut *mut plsm_error,
+) -> i32 {
+    let stream = match borrow_lite3_stream(stream, out_err) {
+        Ok(stream) => stream,
+        Err(code) => return code,
+    };
+    match stream.state.seek_time(timestamp_ns) {
+        Ok(()) => 0,
+        Err(err) => fail(out_err, err),
     }
 }
 
@@ -614,6 +1223,20 @@ pub extern "C" fn plsm_error_free(err: *mut plsm_error) {
     }
 }
 
+/// Durability for the `PLSM_DURABILITY_*` code passed to the `plsm_pool_append_*` calls.
+fn durability_from_code(code: u32) -> Result<crate::api::Durability, Error> {
+    match code {
+        0 => Ok(crate::api::Durability::Fast),
+        1 => Ok(crate::api::Durability::Flush),
+        2 => Ok(crate::api::Durability::group_commit()),
+        _ => Err(Error::new(ErrorKind::Usage).with_message("invalid durability")),
+    }
+}
+
+fn reservation_outstanding() -> Error {
+    Error::new(ErrorKind::Busy).with_message("append reservation outstanding on this pool handle")
+}
+
 fn borrow_client<'a>(
     client: *mut plsm_client,
     out_err: *mut *mut plsm_error,
@@ -726,93 +1349,113 @@ fn parse_tags(tags: *const *const c_char, len: usize) -> Result<Vec<String>, Err
     Ok(out)
 }
 
-fn message_from_frame(frame: &crate::api::FrameRef<'_>) -> Result<crate::api::Message, Error> {
-    let doc = crate::api::Lite3DocRef::new(frame.payload);
-    let meta_type = doc
-        .type_at_key(0, "meta")
-        .map_err(|err| err.with_message("missing meta"))?;
-    if meta_type != crate::api::lite3::sys::LITE3_TYPE_OBJECT {
-        return Err(Error::new(ErrorKind::Corrupt).with_message("meta is not object"));
-    }
-
-    let meta_ofs = doc
-        .key_offset("meta")
-        .map_err(|err| err.with_message("missing meta"))?;
-    let tags_ofs = doc
-        .key_offset_at(meta_ofs, "tags")
-        .map_err(|err| err.with_message("missing meta.tags"))?;
-    let tags_count = doc
-        .count_at(tags_ofs)
-        .map_err(|_| Error::new(ErrorKind::Corrupt).with_message("meta.tags must be array"))?;
-    let mut tags = Vec::with_capacity(tags_count as usize);
-    for index in 0..tags_count {
-        let item_type = doc.array_item_type(tags_ofs, index).map_err(|_| {
-            Error::new(ErrorKind::Corrupt).with_message("meta.tags must be string array")
-        })?;
-        if item_type != crate::api::lite3::sys::LITE3_TYPE_STRING {
-            return Err(
-                Error::new(ErrorKind::Corrupt).with_message("meta.tags must be string array")
-            );
-        }
-        let tag = doc.array_string_at(tags_ofs, index).map_err(|_| {
-            Error::new(ErrorKind::Corrupt).with_message("meta.tags must be string array")
-        })?;
-        tags.push(tag);
+fn write_message_buf(
+    out_message: *mut plsm_buf,
+    message: crate::api::Message,
+) -> Result<(), Error> {
+    if out_message.is_null() {
+        return Err(Error::new(ErrorKind::Usage).with_message("out_message is null"));
     }
-
-    let data_ofs = doc
-        .key_offset("data")
-        .map_err(|err| err.with_message("missing data"))?;
-    let data_json = doc.to_json_at(data_ofs, false)?;
-    let data: Value = serde_json::from_str(&data_json).map_err(|err| {
-        Error::new(ErrorKind::Corrupt)
-            .with_message("invalid payload json")
-            .with_source(err)
-    })?;
-
-    Ok(crate::api::Message {
-        seq: frame.seq,
-        time: format_ts(frame.timestamp_ns)?,
-        meta: crate::api::Meta { tags },
-        data,
-    })
+    let mut json_bytes = Vec::new();
+    encode_message_json(&mut json_bytes, message)?;
+    hand_off_buf(out_message, json_bytes);
+    Ok(())
 }
 
-fn write_message_buf(
+/// Frame counterpart of `write_message_buf`: JSON is streamed from the Lite3 payload.
+fn write_frame_buf(
     out_message: *mut plsm_buf,
-    message: crate::api::Message,
+    pool: &Pool,
+    frame: &crate::api::FrameRef<'_>,
 ) -> Result<(), Error> {
     if out_message.is_null() {
         return Err(Error::new(ErrorKind::Usage).with_message("out_message is null"));
     }
+    let payload = pool.frame_payload(frame)?;
+    let frame = frame.with_payload(&payload);
+    let mut json_bytes = Vec::with_capacity(frame.payload.len() + 128);
+    crate::api::Message::write_frame_json(&frame, &mut json_bytes)?;
+    hand_off_buf(out_message, json_bytes);
+    Ok(())
+}
+
+fn hand_off_buf(out_message: *mut plsm_buf, json_bytes: Vec<u8>) {
+    unsafe {
+        let buf = &mut *out_message;
+        let mut data = json_bytes.into_boxed_slice();
+        buf.len = data.len();
+        buf.data = data.as_mut_ptr();
+        std::mem::forget(data);
+    }
+}
+
+/// Append the JSON envelope of `message` to `out`.
+fn encode_message_json(out: &mut Vec<u8>, message: crate::api::Message) -> Result<(), Error> {
     let json = serde_json::json!({
         "seq": message.seq,
         "time": message.time,
         "meta": { "tags": message.meta.tags },
         "data": message.data,
     });
-    let json_bytes = serde_json::to_vec(&json).map_err(|err| {
+    serde_json::to_writer(out, &json).map_err(|err| {
         Error::new(ErrorKind::Internal)
             .with_message("failed to serialize message")
             .with_source(err)
-    })?;
+    })
+}
+
+/// Hand `arena` to the caller as one `plsm_buf_free`-able buffer; returns its base pointer.
+fn write_arena(out_arena: *mut plsm_buf, arena: Vec<u8>) -> *mut u8 {
+    let mut data = arena.into_boxed_slice();
+    let base = data.as_mut_ptr();
     unsafe {
-        let buf = &mut *out_message;
-        let mut data = json_bytes.into_boxed_slice();
+        let buf = &mut *out_arena;
         buf.len = data.len();
-        buf.data = data.as_mut_ptr();
-        std::mem::forget(data);
+        buf.data = if data.is_empty() {
+            ptr::null_mut()
+        } else {
+            base
+        };
+    }
+    std::mem::forget(data);
+    base
+}
+
+fn write_lite3_view(
+    out_view: *mut plsm_lite3_view,
+    mmap: &[u8],
+    frame: &crate::api::FrameRef<'_>,
+) -> Result<(), Error> {
+    let frame_offset =
+        crate::core::pool::frame_offset_in(mmap, frame.payload).ok_or_else(|| {
+            Error::new(ErrorKind::Internal).with_message("frame is not borrowed from the pool mmap")
+        })?;
+    unsafe {
+        *out_view = plsm_lite3_view {
+            seq: frame.seq,
+            timestamp_ns: frame.timestamp_ns,
+            flags: frame.flags,
+            data: frame.payload.as_ptr(),
+            len: frame.payload.len(),
+            map_base: mmap.as_ptr(),
+            map_len: mmap.len(),
+            frame_offset: frame_offset as u64,
+        };
     }
     Ok(())
 }
 
+/// Copy `frame` out with its payload decompressed; only views expose stored bytes.
 fn write_lite3_frame(
     out_frame: *mut plsm_lite3_frame,
+    pool: &Pool,
     frame: crate::api::FrameRef<'_>,
 ) -> Result<(), Error> {
     if out_frame.is_null() {
         return Err(Error::new(ErrorKind::Usage).with_message("out_frame is null"));
     }
+    let payload = pool.frame_payload(&frame)?;
+    let frame = frame.with_payload(&payload);
     unsafe {
         let out_frame = &mut *out_frame;
         let mut data = frame.payload.to_vec().into_boxed_slice();
@@ -867,19 +1510,15 @@ fn error_kind_code(kind: ErrorKind) -> i32 {
     }
 }
 
-fn format_ts(timestamp_ns: u64) -> Result<String, Error> {
-    use time::format_description::well_known::Rfc3339;
-    let ts =
-        time::OffsetDateTime::from_unix_timestamp_nanos(timestamp_ns as i128).map_err(|err| {
+fn now_ns() -> Result<u64, Error> {
+    let duration = SystemTime::now()
+        .duration_since(UNIX_EPOCH)
+        .map_err(|err| {
             Error::new(ErrorKind::Internal)
-                .with_message("invalid timestamp")
+                .with_message("time went backwards")
                 .with_source(err)
         })?;
-    ts.format(&Rfc3339).map_err(|err| {
-        Error::new(ErrorKind::Internal)
-            .with_message("timestamp format failed")
-            .with_source(err)
-    })
+    Ok(duration.as_nanos() as u64)
 }
 
 #[cfg(test)]
@@ -1062,6 +1701,394 @@ mod tests {
         }
     }
 
+    #[test]
+    fn abi_reserve_commit_appends_in_place() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let pool_dir = temp.path().join("pools");
+        std::fs::create_dir_all(&pool_dir).expect("mkdir");
+
+        let pool_dir_c = CString::new(pool_dir.to_string_lossy().as_ref()).expect("cstr");
+        let mut client: *mut plsm_client = std::ptr::null_mut();
+        let mut err: *mut plsm_error = std::ptr::null_mut();
+        let rc = plsm_client_new(pool_dir_c.as_ptr(), &mut client, &mut err);
+        assert_eq!(rc, 0, "client_new failed");
+
+        let pool_name = CString::new("abi-reserve").expect("cstr");
+        let mut pool: *mut plsm_pool = std::ptr::null_mut();
+        let rc = plsm_pool_create(client, pool_name.as_ptr(), 1024 * 1024, &mut pool, &mut err);
+        assert_eq!(rc, 0, "pool_create failed");
+
+        let payload =
+            crate::core::lite3::encode_message(&["tag".to_string()], &serde_json::json!({"x": 1}))
+                .expect("payload");
+        let mut buf: *mut u8 = std::ptr::null_mut();
+        let rc = plsm_pool_append_reserve(pool, 4096, 0, &mut buf, &mut err);
+        assert_eq!(rc, 0, "reserve failed");
+        assert!(!buf.is_null());
+
+        let mut seq: u64 = 0;
+        let rc = plsm_pool_append_lite3(
+            pool,
+            payload.as_slice().as_ptr(),
+            payload.len(),
+            0,
+            &mut seq,
+            &mut err,
+        );
+        assert_eq!(rc, -1);
+        let (kind, _message, _path, _seq, _offset) = take_error(err);
+        assert_eq!(kind, error_kind_code(ErrorKind::Busy));
+        err = std::ptr::null_mut();
+
+        unsafe {
+            std::ptr::copy_nonoverlapping(payload.as_slice().as_ptr(), buf, payload.len());
+        }
+        let rc = plsm_pool_append_commit(pool, payload.len(), &mut seq, &mut err);
+        assert_eq!(rc, 0, "commit failed");
+        assert_eq!(seq, 1);
+
+        let mut frame = plsm_lite3_frame {
+            seq: 0,
+            timestamp_ns: 0,
+            flags: 0,
+            payload: plsm_buf {
+                data: std::ptr::null_mut(),
+                len: 0,
+            },
+        };
+        let rc = plsm_pool_get_lite3(pool, 1, &mut frame, &mut err);
+        assert_eq!(rc, 0, "get lite3 failed");
+        assert_eq!(take_lite3_payload(&frame), payload.as_slice());
+        plsm_lite3_frame_free(&mut frame);
+
+        let rc = plsm_pool_append_reserve(pool, 4096, 0, &mut buf, &mut err);
+        assert_eq!(rc, 0, "second reserve failed");
+        plsm_pool_append_abort(pool);
+        let rc = plsm_pool_append_commit(pool, payload.len(), &mut seq, &mut err);
+        assert_eq!(rc, -1);
+        let (kind, message, _path, _seq, _offset) = take_error(err);
+        assert_eq!(kind, error_kind_code(ErrorKind::Usage));
+        assert_eq!(message, "no append reservation");
+
+        plsm_pool_free(pool);
+        plsm_client_free(client);
+    }
+
+    #[test]
+    fn abi_append_batch_assigns_contiguous_seqs() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let pool_dir = temp.path().join("pools");
+        std::fs::create_dir_all(&pool_dir).expect("mkdir");
+
+        let pool_dir_c = CString::new(pool_dir.to_string_lossy().as_ref()).expect("cstr");
+        let mut client: *mut plsm_client = std::ptr::null_mut();
+        let mut err: *mut plsm_error = std::ptr::null_mut();
+        let rc = plsm_client_new(pool_dir_c.as_ptr(), &mut client, &mut err);
+        assert_eq!(rc, 0, "client_new failed");
+
+        let pool_name = CString::new("abi-batch").expect("cstr");
+        let mut pool: *mut plsm_pool = std::ptr::null_mut();
+        let rc = plsm_pool_create(client, pool_name.as_ptr(), 1024 * 1024, &mut pool, &mut err);
+        assert_eq!(rc, 0, "pool_create failed");
+
+        let payloads: Vec<_> = (0..3)
+            .map(|i| {
+                crate::core::lite3::encode_message(&[], &serde_json::json!({ "i": i }))
+                    .expect("payload")
+            })
+            .collect();
+        let ptrs: Vec<*const u8> = payloads.iter().map(|p| p.as_slice().as_ptr()).collect();
+        let lens: Vec<usize> = payloads.iter().map(|p| p.len()).collect();
+        let mut first_seq: u64 = 0;
+        let mut count: usize = 0;
+        let rc = plsm_pool_append_batch(
+            pool,
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            ptrs.len(),
+            1,
+            &mut first_seq,
+            &mut count,
+            &mut err,
+        );
+        assert_eq!(rc, 0, "append batch failed");
+        assert_eq!((first_seq, count), (1, 3));
+
+        let mut frame = plsm_lite3_frame {
+            seq: 0,
+            timestamp_ns: 0,
+            flags: 0,
+            payload: plsm_buf {
+                data: std::ptr::null_mut(),
+                len: 0,
+            },
+        };
+        let rc = plsm_pool_get_lite3(pool, 3, &mut frame, &mut err);
+        assert_eq!(rc, 0, "get lite3 failed");
+        assert_eq!(take_lite3_payload(&frame), payloads[2].as_slice());
+        plsm_lite3_frame_free(&mut frame);
+
+        let invalid = [0x01u8];
+        let bad_ptrs = [ptrs[0], invalid.as_ptr()];
+        let bad_lens = [lens[0], invalid.len()];
+        let rc = plsm_pool_append_batch(
+            pool,
+            bad_ptrs.as_ptr(),
+            bad_lens.as_ptr(),
+            bad_ptrs.len(),
+            0,
+            &mut first_seq,
+            &mut count,
+            &mut err,
+        );
+        assert_eq!(rc, -1, "invalid payload must fail the batch");
+        assert_eq!(count, 0);
+        take_error(err);
+        err = std::ptr::null_mut();
+        let rc = plsm_pool_get_lite3(pool, 4, &mut frame, &mut err);
+        assert_eq!(rc, -1, "invalid batch must not append");
+        let (kind, _message, _path, _seq, _offset) = take_error(err);
+        assert_eq!(kind, error_kind_code(ErrorKind::NotFound));
+
+        plsm_pool_free(pool);
+        plsm_client_free(client);
+    }
+
+    #[test]
+    fn abi_stream_next_batch_drains_available_messages() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let pool_dir = temp.path().join("pools");
+        std::fs::create_dir_all(&pool_dir).expect("mkdir");
+
+        let pool_dir_c = CString::new(pool_dir.to_string_lossy().as_ref()).expect("cstr");
+        let mut client: *mut plsm_client = std::ptr::null_mut();
+        let mut err: *mut plsm_error = std::ptr::null_mut();
+        let rc = plsm_client_new(pool_dir_c.as_ptr(), &mut client, &mut err);
+        assert_eq!(rc, 0, "client_new failed");
+
+        let pool_name = CString::new("abi-stream-batch").expect("cstr");
+        let mut pool: *mut plsm_pool = std::ptr::null_mut();
+        let rc = plsm_pool_create(client, pool_name.as_ptr(), 1024 * 1024, &mut pool, &mut err);
+        assert_eq!(rc, 0, "pool_create failed");
+
+        let payloads: Vec<_> = (0..5)
+            .map(|i| {
+                crate::core::lite3::encode_message(&[], &serde_json::json!({ "i": i }))
+                    .expect("payload")
+            })
+            .collect();
+        let ptrs: Vec<*const u8> = payloads.iter().map(|p| p.as_slice().as_ptr()).collect();
+        let lens: Vec<usize> = payloads.iter().map(|p| p.len()).collect();
+        let mut first_seq: u64 = 0;
+        let rc = plsm_pool_append_batch(
+            pool,
+            ptrs.as_ptr(),
+            lens.as_ptr(),
+            ptrs.len(),
+            0,
+            &mut first_seq,
+            std::ptr::null_mut(),
+            &mut err,
+        );
+        assert_eq!(rc, 0, "append batch failed");
+
+        let mut stream: *mut plsm_stream = std::ptr::null_mut();
+        let rc = plsm_stream_open(pool, 2, 1, 0, 0, 0, 0, &mut stream, &mut err);
+        assert_eq!(rc, 0, "stream_open failed");
+        let mut arena = plsm_buf {
+            data: std::ptr::null_mut(),
+            len: 0,
+        };
+        let mut offsets = [0usize; 4];
+        let rc = plsm_stream_next_batch(stream, 3, &mut arena, offsets.as_mut_ptr(), &mut err);
+        assert_eq!(rc, 3, "first batch should fill");
+        let bytes = unsafe { std::slice::from_raw_parts(arena.data, arena.len) };
+        assert_eq!(offsets[3], arena.len);
+        let seqs: Vec<u64> = offsets
+            .windows(2)
+            .map(|span| {
+                let value: serde_json::Value =
+                    serde_json::from_slice(&bytes[span[0]..span[1]]).expect("json");
+                value["seq"].as_u64().expect("seq")
+            })
+            .collect();
+        assert_eq!(seqs, vec![2, 3, 4]);
+        plsm_buf_free(&mut arena);
+        plsm_stream_free(stream);
+
+        let mut lite3: *mut plsm_lite3_stream = std::ptr::null_mut();
+        let rc = plsm_lite3_stream_open(pool, 0, 0, 4, 1, 0, 0, &mut lite3, &mut err);
+        assert_eq!(rc, 0, "lite3_stream_open failed");
+        let mut frames: Vec<plsm_lite3_frame> = (0..8)
+            .map(|_| plsm_lite3_frame {
+                seq: 0,
+                timestamp_ns: 0,
+                flags: 0,
+                payload: plsm_buf {
+                    data: std::ptr::null_mut(),
+                    len: 0,
+                },
+            })
+            .collect();
+        let rc = plsm_lite3_stream_next_batch(
+            lite3,
+            frames.len(),
+            frames.as_mut_ptr(),
+            &mut arena,
+            &mut err,
+        );
+        assert_eq!(rc, 4, "batch stops at max_messages");
+        for (i, frame) in frames.iter().take(4).enumerate() {
+            assert_eq!(frame.seq, i as u64 + 1);
+            let payload =
+                unsafe { std::slice::from_raw_parts(frame.payload.data, frame.payload.len) };
+            assert_eq!(payload, payloads[i].as_slice());
+        }
+        plsm_buf_free(&mut arena);
+        let rc = plsm_lite3_stream_next_batch(
+            lite3,
+            frames.len(),
+            frames.as_mut_ptr(),
+            &mut arena,
+            &mut err,
+        );
+        assert_eq!(rc, 0, "stream is exhausted");
+        plsm_lite3_stream_free(lite3);
+
+        plsm_pool_free(pool);
+        plsm_client_free(client);
+    }
+
+    #[test]
+    fn abi_lite3_view_borrows_mmap_until_overwritten() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let pool_dir = temp.path().join("pools");
+        std::fs::create_dir_all(&pool_dir).expect("mkdir");
+
+        let pool_dir_c = CString::new(pool_dir.to_string_lossy().as_ref()).expect("cstr");
+        let mut client: *mut plsm_client = std::ptr::null_mut();
+        let mut err: *mut plsm_error = std::ptr::null_mut();
+        let rc = plsm_client_new(pool_dir_c.as_ptr(), &mut client, &mut err);
+        assert_eq!(rc, 0, "client_new failed");
+
+        let pool_name = CString::new("abi-view").expect("cstr");
+        let mut pool: *mut plsm_pool = std::ptr::null_mut();
+        let rc = plsm_pool_create(client, pool_name.as_ptr(), 64 * 1024, &mut pool, &mut err);
+        assert_eq!(rc, 0, "pool_create failed");
+
+        let payload = crate::core::lite3::encode_message(&[], &serde_json::json!({ "x": 1 }))
+            .expect("payload");
+        let mut seq: u64 = 0;
+        let rc = plsm_pool_append_lite3(
+            pool,
+            payload.as_slice().as_ptr(),
+            payload.len(),
+            0,
+            &mut seq,
+            &mut err,
+        );
+        assert_eq!(rc, 0, "append failed");
+
+        let mut view = plsm_lite3_view {
+            seq: 0,
+            timestamp_ns: 0,
+            flags: 0,
+            data: std::ptr::null(),
+            len: 0,
+            map_base: std::ptr::null(),
+            map_len: 0,
+            frame_offset: 0,
+        };
+        let rc = plsm_pool_get_lite3_view(pool, seq, &mut view, &mut err);
+        assert_eq!(rc, 0, "get view failed");
+        assert_eq!(view.seq, seq);
+        let bytes = unsafe { std::slice::from_raw_parts(view.data, view.len) };
+        assert_eq!(bytes, payload.as_slice());
+        assert_eq!(plsm_view_still_valid(&view), 1);
+
+        let mut appended = 0;
+        while plsm_view_still_valid(&view) == 1 {
+            let rc = plsm_pool_append_lite3(
+                pool,
+                payload.as_slice().as_ptr(),
+                payload.len(),
+                0,
+                &mut seq,
+                &mut err,
+            );
+            assert_eq!(rc, 0, "append failed");
+            appended += 1;
+            assert!(appended < 10_000, "view never invalidated");
+        }
+        let mut frame = plsm_lite3_frame {
+            seq: 0,
+            timestamp_ns: 0,
+            flags: 0,
+            payload: plsm_buf {
+                data: std::ptr::null_mut(),
+                len: 0,
+            },
+        };
+        let rc = plsm_pool_get_lite3(pool, view.seq, &mut frame, &mut err);
+        assert_eq!(rc, -1, "invalid view must mean the frame was evicted");
+        take_error(err);
+        assert_eq!(plsm_view_still_valid(std::ptr::null()), 0);
+
+        plsm_pool_free(pool);
+        plsm_client_free(client);
+    }
+
+    #[test]
+    fn abi_lite3_path_resolves_payload_fields() {
+        let payload = crate::core::lite3::encode_message(
+            &["ci".to_string()],
+            &serde_json::json!({"job": {"stage": "build"}}),
+        )
+        .expect("encode");
+        let bytes = payload.as_slice();
+
+        let mut err: *mut plsm_error = std::ptr::null_mut();
+        let mut path: *mut plsm_lite3_path = std::ptr::null_mut();
+        let dotted = CString::new("data.job.stage").expect("cstr");
+        let rc = plsm_lite3_path_compile(dotted.as_ptr(), &mut path, &mut err);
+        assert_eq!(rc, 0, "path_compile failed");
+
+        let mut offset = 0u64;
+        let mut value_type = 0u8;
+        let rc = plsm_lite3_path_get(
+            path,
+            bytes.as_ptr(),
+            bytes.len(),
+            &mut offset,
+            &mut value_type,
+            &mut err,
+        );
+        assert_eq!(rc, 1);
+        assert_eq!(value_type, crate::core::lite3::sys::LITE3_TYPE_STRING);
+        assert!((offset as usize) < bytes.len());
+        plsm_lite3_path_free(path);
+
+        let missing = CString::new("data.job.other").expect("cstr");
+        let rc = plsm_lite3_path_compile(missing.as_ptr(), &mut path, &mut err);
+        assert_eq!(rc, 0, "path_compile failed");
+        let rc = plsm_lite3_path_get(
+            path,
+            bytes.as_ptr(),
+            bytes.len(),
+            std::ptr::null_mut(),
+            std::ptr::null_mut(),
+            &mut err,
+        );
+        assert_eq!(rc, 0);
+        plsm_lite3_path_free(path);
+
+        let empty = CString::new("data..stage").expect("cstr");
+        let rc = plsm_lite3_path_compile(empty.as_ptr(), &mut path, &mut err);
+        assert_eq!(rc, -1);
+        let (kind, _message, _path, _seq, _offset) = take_error(err);
+        assert_eq!(kind, error_kind_code(ErrorKind::Usage));
+    }
+
     #[test]
     fn abi_errors_report_usage_on_null_pointers() {
         let mut err: *mut plsm_error = std::ptr::null_mut();
@@ -1,20 +1,22 @@
 //! Purpose: Define the public API client surface for local pool resolution.
-//! Exports: `PoolRef`, `LocalClient`, and local pool lifecycle operations.
+//! Exports: `PoolRef`, `LocalClient`, and local pool and pool-group lifecycle operations.
 //! Role: Stable boundary for bindings; mirrors CLI resolution rules.
 //! Invariants: Pool resolution matches `spec/v0/SPEC.md` and is additive-only in v0.
 //! Invariants: Remote pool refs are accepted but rejected at runtime in v0.
 #![allow(clippy::result_large_err)]
 
+use super::group::PoolGroup;
 use super::validation::validate_pool_state_report;
 use super::{ValidationIssue, ValidationReport};
 use crate::core::error::{Error, ErrorKind};
 use crate::core::pool::{Pool, PoolInfo, PoolOptions};
+use crate::core::residency::Residency;
 use crate::pool_paths::{PoolNameResolveError, default_pool_dir, resolve_named_pool_path};
 use std::path::{Path, PathBuf};
 
 pub type ApiResult<T> = Result<T, Error>;
 
-#[derive(Clone, Debug, Eq, PartialEq)]
+#[derive(Clone, Debug, Eq, Hash, PartialEq)]
 pub enum PoolRef {
     Name(String),
     Path(PathBuf),
@@ -84,6 +86,28 @@ impl LocalClient {
         Pool::open(&path)
     }
 
+    /// Open with residency tuning (read-ahead, release-behind, prefaulting) for this handle.
+    pub fn open_pool_with(&self, pool_ref: &PoolRef, residency: Residency) -> ApiResult<Pool> {
+        let path = pool_ref.resolve_local_path(&self.pool_dir)?;
+        Pool::open_with(&path, residency)
+    }
+
+    /// Create a pool group of `shards` pools, each sized by `options`, at the ref's path.
+    pub fn create_pool_group(
+        &self,
+        pool_ref: &PoolRef,
+        shards: usize,
+        options: PoolOptions,
+    ) -> ApiResult<Vec<PoolInfo>> {
+        let path = pool_ref.resolve_local_path(&self.pool_dir)?;
+        PoolGroup::create(&path, shards, options)?.info()
+    }
+
+    pub fn open_pool_group(&self, pool_ref: &PoolRef) -> ApiResult<PoolGroup> {
+        let path = pool_ref.resolve_local_path(&self.pool_dir)?;
+        PoolGroup::open(&path)
+    }
+
     pub fn pool_info(&self, pool_ref: &PoolRef) -> ApiResult<PoolInfo> {
         let path = pool_ref.resolve_local_path(&self.pool_dir)?;
         let pool = Pool::open(&path)?;
@@ -110,6 +134,10 @@ impl LocalClient {
             if path.extension().and_then(|ext| ext.to_str()) != Some("plasmite") {
                 continue;
             }
+            if PoolGroup::is_group(&path) {
+                pools.extend(PoolGroup::open(&path)?.info()?);
+                continue;
+            }
             let pool = Pool::open(&path)?;
             pools.push(pool.info()?);
         }
@@ -117,8 +145,12 @@ impl LocalClient {
         Ok(pools)
     }
 
+    /// Delete a pool file, or every shard of a pool group.
     pub fn delete_pool(&self, pool_ref: &PoolRef) -> ApiResult<()> {
         let path = pool_ref.resolve_local_path(&self.pool_dir)?;
+        if PoolGroup::is_group(&path) {
+            return PoolGroup::delete(&path);
+        }
         std::fs::remove_file(&path).map_err(|err| {
             Error::new(map_io_error_kind(&err))
                 .with_message("failed to delete pool")
@@ -154,7 +186,7 @@ impl LocalClient {
             Err(err) => return Err(err),
         };
         let header = pool.header_from_mmap()?;
-        let report = validate_pool_state_report(header, pool.mmap(), &path)
+        let report = validate_pool_state_report(header, pool.mmap(), pool.codec(), &path)
             .with_pool_ref(pool_ref.describe());
         Ok(report)
     }
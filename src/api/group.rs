@@ -0,0 +1,481 @@
+//! Purpose: Shard one logical pool across several pool files so writers stop sharing one lock.
+//! Exports: `PoolGroup`, `GroupTail`, `GroupMessage`.
+//! Role: API-level composition of ordinary pools; no new storage format or core changes.
+//! Invariants: A group is a directory of `shard-NNN.plasmite` pools numbered 0..N with no gaps.
+//! Invariants: Each shard keeps its own append lock, index, and seq space; seqs are per shard.
+//! Invariants: Shard choice is stable across processes (`id % N`, or FNV-1a of a key `% N`).
+//! Invariants: Merged tails emit per-shard order exactly and cross-shard order by
+//! Invariants: `(timestamp_ns, seq, shard)` among messages already committed when compared.
+#![allow(clippy::result_large_err)]
+
+use super::message::{
+    Message, PoolApiExt, TAIL_BATCH_FRAMES, TailOptions, has_required_tags, time_seeked_cursor,
+    wait_interval,
+};
+use crate::core::cursor::{BatchCursor, CursorResult};
+use crate::core::error::{Error, ErrorKind};
+use crate::core::frame;
+use crate::core::pool::{Pool, PoolInfo, PoolOptions};
+use std::path::{Path, PathBuf};
+use std::time::Instant;
+
+/// Most shards a group may have; keeps shard file names three digits wide.
+pub const POOL_GROUP_MAX_SHARDS: usize = 1000;
+
+const SHARD_PREFIX: &str = "shard-";
+const SHARD_EXTENSION: &str = "plasmite";
+
+/// An open pool group: every shard mapped, any of them appendable.
+pub struct PoolGroup {
+    path: PathBuf,
+    shards: Vec<Pool>,
+}
+
+/// A message read through a group, tagged with the shard whose seq it carries.
+#[derive(Clone, Debug, Eq, PartialEq)]
+pub struct GroupMessage {
+    pub shard: usize,
+    pub message: Message,
+}
+
+impl PoolGroup {
+    /// Create `shards` pools of `options` each under a new directory at `path`.
+    pub fn create(
+        path: impl AsRef<Path>,
+        shards: usize,
+        options: PoolOptions,
+    ) -> Result<Self, Error> {
+        let path = path.as_ref();
+        if shards == 0 || shards > POOL_GROUP_MAX_SHARDS {
+            return Err(Error::new(ErrorKind::Usage)
+                .with_message(format!(
+                    "pool group shard count must be between 1 and {POOL_GROUP_MAX_SHARDS}"
+                ))
+                .with_path(path));
+        }
+        if let Some(parent) = path
+            .parent()
+            .filter(|parent| !parent.as_os_str().is_empty())
+        {
+            std::fs::create_dir_all(parent).map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to create pool directory")
+                    .with_path(parent)
+                    .with_source(err)
+            })?;
+        }
+        std::fs::create_dir(path).map_err(|err| {
+            let kind = match err.kind() {
+                std::io::ErrorKind::AlreadyExists => ErrorKind::AlreadyExists,
+                std::io::ErrorKind::PermissionDenied => ErrorKind::Permission,
+                std::io::ErrorKind::NotFound => ErrorKind::NotFound,
+                _ => ErrorKind::Io,
+            };
+            Error::new(kind)
+                .with_message("failed to create pool group directory")
+                .with_path(path)
+                .with_source(err)
+        })?;
+        let mut pools = Vec::with_capacity(shards);
+        for shard in 0..shards {
+            match Pool::create(shard_path(path, shard), options.clone()) {
+                Ok(pool) => pools.push(pool),
+                Err(err) => {
+                    drop(pools);
+                    let _ = std::fs::remove_dir_all(path);
+                    return Err(err);
+                }
+            }
+        }
+        Ok(Self {
+            path: path.to_path_buf(),
+            shards: pools,
+        })
+    }
+
+    /// Open every shard of the group at `path`.
+    pub fn open(path: impl AsRef<Path>) -> Result<Self, Error> {
+        let path = path.as_ref();
+        let shards = shard_count(path)?;
+        let pools = (0..shards)
+            .map(|shard| Pool::open(shard_path(path, shard)))
+            .collect::<Result<Vec<_>, _>>()?;
+        Ok(Self {
+            path: path.to_path_buf(),
+            shards: pools,
+        })
+    }
+
+    /// Whether `path` looks like a pool group (a directory holding shard 0).
+    pub fn is_group(path: impl AsRef<Path>) -> bool {
+        let path = path.as_ref();
+        path.is_dir() && shard_path(path, 0).is_file()
+    }
+
+    /// Remove every shard file and then the group directory.
+    pub fn delete(path: impl AsRef<Path>) -> Result<(), Error> {
+        let path = path.as_ref();
+        let shards = shard_count(path)?;
+        for shard in 0..shards {
+            let shard_path = shard_path(path, shard);
+            std::fs::remove_file(&shard_path).map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to delete pool group shard")
+                    .with_path(&shard_path)
+                    .with_source(err)
+            })?;
+        }
+        std::fs::remove_dir(path).map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to delete pool group directory")
+                .with_path(path)
+                .with_source(err)
+        })
+    }
+
+    pub fn path(&self) -> &Path {
+        &self.path
+    }
+
+    pub fn shard_count(&self) -> usize {
+        self.shards.len()
+    }
+
+    pub fn shard(&self, shard: usize) -> Result<&Pool, Error> {
+        let count = self.shards.len();
+        self.shards
+            .get(shard)
+            .ok_or_else(|| shard_out_of_range(shard, count))
+    }
+
+    /// Mutable shard handle for appends through `Pool` or `PoolApiExt`.
+    pub fn shard_mut(&mut self, shard: usize) -> Result<&mut Pool, Error> {
+        let count = self.shards.len();
+        self.shards
+            .get_mut(shard)
+            .ok_or_else(|| shard_out_of_range(shard, count))
+    }
+
+    /// Shard for a writer with a stable numeric id (process slot, producer index, ...).
+    pub fn shard_for_writer(&self, writer_id: u64) -> usize {
+        (writer_id % self.shards.len() as u64) as usize
+    }
+
+    /// Shard for a routing key, so every message with that key lands in one shard in order.
+    pub fn shard_for_key(&self, key: &[u8]) -> usize {
+        (fnv1a64(key) % self.shards.len() as u64) as usize
+    }
+
+    /// Fetch one message by `(shard, seq)`.
+    pub fn get_message(&self, shard: usize, seq: u64) -> Result<GroupMessage, Error> {
+        let message = self.shard(shard)?.get_message(seq)?;
+        Ok(GroupMessage { shard, message })
+    }
+
+    /// Per-shard pool info, in shard order.
+    pub fn info(&self) -> Result<Vec<PoolInfo>, Error> {
+        self.shards.iter().map(Pool::info).collect()
+    }
+
+    /// Tail every shard at once, merged by timestamp. `since_seq` applies to each shard's seqs.
+    pub fn tail(&self, options: TailOptions) -> GroupTail<'_> {
+        GroupTail::new(self, options)
+    }
+}
+
+/// The next matching message of one shard, held until it is the oldest head.
+struct Head {
+    timestamp_ns: u64,
+    seq: u64,
+    message: Message,
+}
+
+/// K-way merge over per-shard cursors.
+///
+/// Each call tops up the head of every shard that has none, then emits the oldest head. While
+/// catching up every shard has a head, so history comes out fully merged; at the live edge a
+/// message is emitted as soon as it is the oldest one visible, and idle waits poll because one
+/// thread cannot block on several pools' notifications.
+pub struct GroupTail<'a> {
+    group: &'a PoolGroup,
+    cursors: Vec<BatchCursor<'a>>,
+    heads: Vec<Option<Head>>,
+    options: TailOptions,
+    seen: usize,
+    deadline: Option<Instant>,
+    // Bloom mask of `options.tags`, checked against frame headers before decoding.
+    tag_mask: u64,
+}
+
+impl<'a> GroupTail<'a> {
+    fn new(group: &'a PoolGroup, options: TailOptions) -> Self {
+        let deadline = options.timeout.map(|duration| Instant::now() + duration);
+        let tag_mask = frame::tag_bloom(options.tags.iter().map(String::as_str));
+        let cursors = group
+            .shards
+            .iter()
+            .map(|pool| {
+                BatchCursor::new(
+                    time_seeked_cursor(pool, options.since_ns),
+                    TAIL_BATCH_FRAMES,
+                )
+            })
+            .collect();
+        Self {
+            group,
+            cursors,
+            heads: group.shards.iter().map(|_| None).collect(),
+            options,
+            seen: 0,
+            deadline,
+            tag_mask,
+        }
+    }
+
+    pub fn next_message(&mut self) -> Result<Option<GroupMessage>, Error> {
+        if let Some(max) = self.options.max_messages {
+            if self.seen >= max {
+                return Ok(None);
+            }
+        }
+
+        loop {
+            if let Some(deadline) = self.deadline {
+                if Instant::now() >= deadline {
+                    return Ok(None);
+                }
+            }
+
+            for shard in 0..self.heads.len() {
+                if self.heads[shard].is_none() {
+                    self.heads[shard] = self.next_head(shard)?;
+                }
+            }
+            let oldest = self
+                .heads
+                .iter()
+                .enumerate()
+                .filter_map(|(shard, head)| {
+                    head.as_ref()
+                        .map(|head| ((head.timestamp_ns, head.seq, shard), shard))
+                })
+                .min()
+                .map(|(_, shard)| shard);
+            if let Some(shard) = oldest {
+                let head = self.heads[shard].take().expect("oldest head present");
+                self.seen += 1;
+                return Ok(Some(GroupMessage {
+                    shard,
+                    message: head.message,
+                }));
+            }
+            std::thread::sleep(wait_interval(self.deadline, self.options.poll_interval));
+        }
+    }
+
+    /// Read `shard` up to its next matching message, or `None` if it has nothing new yet.
+    fn next_head(&mut self, shard: usize) -> Result<Option<Head>, Error> {
+        let group = self.group;
+        let pool = &group.shards[shard];
+        loop {
+            match self.cursors[shard].next(pool)? {
+                CursorResult::Message(frame) => {
+                    if let Some(min_seq) = self.options.since_seq {
+                        if frame.seq < min_seq {
+                            continue;
+                        }
+                    }
+                    if let Some(since) = self.options.since_ns {
+                        if frame.timestamp_ns < since {
+                            continue;
+                        }
+                    }
+                    if !frame::tag_bloom_may_match(frame.tag_bloom, self.tag_mask) {
+                        continue;
+                    }
+                    let message = Message::from_pool_frame(pool, &frame)?;
+                    if !has_required_tags(&message.meta.tags, self.options.tags.as_slice()) {
+                        continue;
+                    }
+                    return Ok(Some(Head {
+                        timestamp_ns: frame.timestamp_ns,
+                        seq: frame.seq,
+                        message,
+                    }));
+                }
+                CursorResult::WouldBlock => return Ok(None),
+                CursorResult::FellBehind => continue,
+            }
+        }
+    }
+}
+
+fn shard_path(group: &Path, shard: usize) -> PathBuf {
+    group.join(format!("{SHARD_PREFIX}{shard:03}.{SHARD_EXTENSION}"))
+}
+
+/// Count shards in a group directory, rejecting gaps and stray shard names.
+fn shard_count(path: &Path) -> Result<usize, Error> {
+    let entries = std::fs::read_dir(path).map_err(|err| {
+        let kind = match err.kind() {
+            std::io::ErrorKind::NotFound => ErrorKind::NotFound,
+            std::io::ErrorKind::PermissionDenied => ErrorKind::Permission,
+            _ => ErrorKind::Io,
+        };
+        Error::new(kind)
+            .with_message("failed to read pool group directory")
+            .with_path(path)
+            .with_source(err)
+    })?;
+    let mut shards = Vec::new();
+    for entry in entries {
+        let entry = entry.map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to read pool group directory entry")
+                .with_path(path)
+                .with_source(err)
+        })?;
+        let name = entry.file_name();
+        let Some(index) = name
+            .to_str()
+            .and_then(|name| name.strip_prefix(SHARD_PREFIX))
+            .and_then(|name| name.strip_suffix(SHARD_EXTENSION))
+            .and_then(|name| name.strip_suffix('.'))
+        else {
+            continue;
+        };
+        let index = index.parse::<usize>().map_err(|_| {
+            Error::new(ErrorKind::Corrupt)
+                .with_message("pool group has a malformed shard file name")
+                .with_path(entry.path())
+        })?;
+        shards.push(index);
+    }
+    if shards.is_empty() {
+        return Err(Error::new(ErrorKind::NotFound)
+            .with_message("pool group has no shards")
+            .with_path(path));
+    }
+    shards.sort_unstable();
+    if let Some(missing) = shards
+        .iter()
+        .enumerate()
+        .find_map(|(expected, &found)| (expected != found).then_some(expected))
+    {
+        return Err(Error::new(ErrorKind::Corrupt)
+            .with_message(format!("pool group is missing shard {missing}"))
+            .with_path(path));
+    }
+    Ok(shards.len())
+}
+
+fn shard_out_of_range(shard: usize, count: usize) -> Error {
+    Error::new(ErrorKind::Usage).with_message(format!(
+        "shard {shard} is out of range for a group of {count}"
+    ))
+}
+
+fn fnv1a64(bytes: &[u8]) -> u64 {
+    bytes.iter().fold(0xcbf2_9ce4_8422_2325, |hash: u64, byte| {
+        (hash ^ u64::from(*byte)).wrapping_mul(0x0000_0100_0000_01b3)
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{PoolGroup, shard_path};
+    use crate::api::message::{PoolApiExt, TailOptions};
+    use crate::core::error::ErrorKind;
+    use crate::core::pool::{AppendOptions, Durability, PoolOptions};
+    use serde_json::json;
+    use std::time::Duration;
+    use tempfile::tempdir;
+
+    fn append_at(group: &mut PoolGroup, shard: usize, timestamp_ns: u64, value: i64) -> u64 {
+        group
+            .shard_mut(shard)
+            .expect("shard")
+            .append_json(
+                &json!({ "v": value }),
+                &[],
+                AppendOptions::new(timestamp_ns, Durability::Fast),
+            )
+            .expect("append")
+            .seq
+    }
+
+    #[test]
+    fn group_round_trips_shards_and_gets_by_shard_seq() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("telemetry.plasmite");
+        let mut group = PoolGroup::create(&path, 3, PoolOptions::new(1024 * 1024)).expect("create");
+        assert!(PoolGroup::is_group(&path));
+        let seq = append_at(&mut group, 2, 10, 7);
+
+        let group = PoolGroup::open(&path).expect("open");
+        assert_eq!(group.shard_count(), 3);
+        assert_eq!(group.info().expect("info").len(), 3);
+        let fetched = group.get_message(2, seq).expect("get");
+        assert_eq!(fetched.shard, 2);
+        assert_eq!(fetched.message.data["v"], 7);
+        assert!(group.get_message(0, seq).is_err());
+        assert_eq!(
+            group.get_message(3, seq).expect_err("range").kind(),
+            ErrorKind::Usage
+        );
+
+        assert_eq!(group.shard_for_writer(7), 1);
+        assert_eq!(
+            group.shard_for_key(b"host-a"),
+            group.shard_for_key(b"host-a")
+        );
+        assert!(group.shard_for_key(b"host-b") < 3);
+
+        PoolGroup::delete(&path).expect("delete");
+        assert!(!path.exists());
+    }
+
+    #[test]
+    fn group_open_rejects_missing_shards() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("gappy.plasmite");
+        PoolGroup::create(&path, 3, PoolOptions::new(64 * 1024)).expect("create");
+        std::fs::remove_file(shard_path(&path, 1)).expect("remove shard");
+        let err = PoolGroup::open(&path).expect_err("gap");
+        assert_eq!(err.kind(), ErrorKind::Corrupt);
+        let err = PoolGroup::create(&path, 2, PoolOptions::new(64 * 1024)).expect_err("exists");
+        assert_eq!(err.kind(), ErrorKind::AlreadyExists);
+    }
+
+    #[test]
+    fn group_tail_merges_shards_by_timestamp_then_seq() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("merged.plasmite");
+        let mut group = PoolGroup::create(&path, 2, PoolOptions::new(1024 * 1024)).expect("create");
+        append_at(&mut group, 0, 30, 3);
+        append_at(&mut group, 1, 10, 1);
+        append_at(&mut group, 0, 40, 4);
+        append_at(&mut group, 1, 30, 2);
+        append_at(&mut group, 1, 50, 5);
+
+        let mut tail = group.tail(TailOptions {
+            timeout: Some(Duration::from_millis(20)),
+            ..TailOptions::default()
+        });
+        let mut order = Vec::new();
+        while let Some(message) = tail.next_message().expect("next") {
+            order.push((message.shard, message.message.data["v"].as_i64().unwrap()));
+        }
+        // Both shards hold a message at t=30 with seq 1 vs 2; the lower seq goes first.
+        assert_eq!(order, vec![(1, 1), (0, 3), (1, 2), (0, 4), (1, 5)]);
+
+        let mut tail = group.tail(TailOptions {
+            since_ns: Some(35),
+            max_messages: Some(1),
+            ..TailOptions::default()
+        });
+        let first = tail.next_message().expect("next").expect("message");
+        assert_eq!(first.message.data["v"], 4);
+        assert!(tail.next_message().expect("max").is_none());
+    }
+}
@@ -0,0 +1,84 @@
+//! Purpose: Encode and decode the multi-frame Lite3 body used by batched remote appends.
+//! Exports: `LITE3_BATCH_CONTENT_TYPE`, `LITE3_BATCH_FRAME_HEADER_LEN`, `push_lite3_batch_frame`,
+//! Exports: `decode_lite3_batch`.
+//! Role: Shared wire format between `RemotePool` batch appends and `serve`'s `append_lite3`.
+//! Invariants: Body is `[u32be len][len bytes payload]` repeated; no trailer, no padding.
+//! Invariants: Decoding borrows payloads from the body and validates framing only, not Lite3.
+#![allow(clippy::result_large_err)]
+
+use crate::core::error::{Error, ErrorKind};
+
+/// Content type of a batched `append_lite3` request body.
+pub const LITE3_BATCH_CONTENT_TYPE: &str = "application/x-plasmite-lite3-batch";
+
+/// Bytes of framing in front of each payload.
+pub const LITE3_BATCH_FRAME_HEADER_LEN: usize = 4;
+
+/// Append one length-prefixed payload to a batch body.
+pub fn push_lite3_batch_frame(body: &mut Vec<u8>, payload: &[u8]) -> Result<(), Error> {
+    let len: u32 = payload.len().try_into().map_err(|_| {
+        Error::new(ErrorKind::Usage).with_message("lite3 payload exceeds max frame length")
+    })?;
+    body.reserve(LITE3_BATCH_FRAME_HEADER_LEN + payload.len());
+    body.extend_from_slice(&len.to_be_bytes());
+    body.extend_from_slice(payload);
+    Ok(())
+}
+
+/// Split a batch body into its payloads, in order.
+pub fn decode_lite3_batch(body: &[u8]) -> Result<Vec<&[u8]>, Error> {
+    let mut frames = Vec::new();
+    let mut rest = body;
+    while !rest.is_empty() {
+        let Some((header, tail)) = rest.split_first_chunk::<LITE3_BATCH_FRAME_HEADER_LEN>() else {
+            return Err(truncated(body.len() - rest.len()));
+        };
+        let len = u32::from_be_bytes(*header) as usize;
+        if len == 0 {
+            return Err(Error::new(ErrorKind::Usage)
+                .with_message("lite3 batch frame is empty")
+                .with_offset((body.len() - rest.len()) as u64));
+        }
+        if tail.len() < len {
+            return Err(truncated(body.len() - rest.len()));
+        }
+        let (payload, next) = tail.split_at(len);
+        frames.push(payload);
+        rest = next;
+    }
+    Ok(frames)
+}
+
+fn truncated(offset: usize) -> Error {
+    Error::new(ErrorKind::Usage)
+        .with_message("truncated lite3 batch frame")
+        .with_offset(offset as u64)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{decode_lite3_batch, push_lite3_batch_frame};
+    use crate::core::error::ErrorKind;
+
+    #[test]
+    fn batch_round_trips_in_order() {
+        let mut body = Vec::new();
+        push_lite3_batch_frame(&mut body, b"one").expect("push");
+        push_lite3_batch_frame(&mut body, b"second").expect("push");
+        let frames = decode_lite3_batch(&body).expect("decode");
+        assert_eq!(frames, vec![&b"one"[..], &b"second"[..]]);
+        assert!(decode_lite3_batch(&[]).expect("empty").is_empty());
+    }
+
+    #[test]
+    fn batch_rejects_truncated_and_empty_frames() {
+        let mut body = Vec::new();
+        push_lite3_batch_frame(&mut body, b"payload").expect("push");
+        let err = decode_lite3_batch(&body[..body.len() - 1]).expect_err("short payload");
+        assert_eq!(err.kind(), ErrorKind::Usage);
+        let err = decode_lite3_batch(&body[..2]).expect_err("short header");
+        assert_eq!(err.offset(), Some(0));
+        let err = decode_lite3_batch(&[0, 0, 0, 0]).expect_err("empty frame");
+        assert_eq!(err.kind(), ErrorKind::Usage);
+    }
+}
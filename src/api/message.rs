@@ -2,14 +2,19 @@
 //! Exports: `Message`, `Meta`, `TailOptions`, `Tail`, `Lite3Tail`, `ReplayOptions`, `Replay`.
 //! Role: Stable message envelope aligned with the CLI contract.
 //! Invariants: Message fields mirror CLI JSON; time is RFC3339 UTC.
-//! Invariants: Tail streams preserve ordering and avoid unbounded buffering.
+//! Invariants: Tail streams preserve ordering and buffer at most one cursor batch.
+//! Invariants: Tag-filtered tails skip frames by header tag bloom before decoding payloads.
 //! Invariants: Replay is bounded; all messages are collected up front.
+//! Invariants: Time-bounded tails/replays seek by timestamp, then still filter each frame.
+//! Invariants: Message readers decompress compressed frames; `Lite3Tail` hands them out as
+//! stored and decodes only when a tag filter needs their meta.
 #![allow(clippy::result_large_err)]
 
-use crate::core::cursor::{Cursor, CursorResult, FrameRef};
+use crate::core::cursor::{BatchCursor, Cursor, CursorResult, FrameRef};
 use crate::core::error::{Error, ErrorKind};
-use crate::core::lite3::{Lite3DocRef, sys, validate_bytes};
-use crate::core::notify::{NotifyError, PoolSemaphore, WaitOutcome, open_for_path};
+use crate::core::frame;
+use crate::core::lite3::{self, Lite3DocRef, sys, validate_bytes};
+use crate::core::notify::{NotifyError, PoolWaiter, WaitOutcome, open_for_path};
 use crate::core::pool::{AppendOptions, Durability, Pool};
 use serde_json::Value;
 use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
@@ -27,9 +32,59 @@ pub struct Message {
     pub data: Value,
 }
 
+impl Meta {
+    /// Decode only `meta` from an encoded `{meta, data}` payload.
+    pub fn from_lite3(payload: &[u8]) -> Result<Self, Error> {
+        decode_meta(&Lite3DocRef::new(payload))
+    }
+}
+
+impl Message {
+    /// Decode a frame returned by a `Cursor` into the CLI message envelope. Compressed frames
+    /// are rejected; use `from_pool_frame` with the pool they came from.
+    pub fn from_frame(frame: &FrameRef<'_>) -> Result<Self, Error> {
+        message_from_frame(frame)
+    }
+
+    /// Like `from_frame`, decompressing the payload through `pool` when it is stored
+    /// compressed.
+    pub fn from_pool_frame(pool: &Pool, frame: &FrameRef<'_>) -> Result<Self, Error> {
+        pool_message_from_frame(pool, frame)
+    }
+
+    /// Append `frame` to `out` as the compact JSON envelope — the same bytes `serde_json`
+    /// writes for `from_frame`'s JSON form — streaming `data` from Lite3 instead of building
+    /// a `Value`. Returns the decoded `meta` so callers can still filter on tags.
+    pub fn write_frame_json(frame: &FrameRef<'_>, out: &mut Vec<u8>) -> Result<Meta, Error> {
+        let start = out.len();
+        let written = write_envelope_json(frame, out);
+        if written.is_err() {
+            out.truncate(start);
+        }
+        written
+    }
+
+    /// Like `write_frame_json`, but appends only the `data` object (`--data-only` output).
+    pub fn write_frame_data_json(frame: &FrameRef<'_>, out: &mut Vec<u8>) -> Result<Meta, Error> {
+        ensure_raw(frame)?;
+        let doc = Lite3DocRef::new(frame.payload);
+        let meta = decode_meta(&doc)?;
+        let start = out.len();
+        let written = data_offset(&doc).and_then(|data_ofs| doc.write_json_at(data_ofs, out));
+        if let Err(err) = written {
+            out.truncate(start);
+            return Err(err);
+        }
+        Ok(meta)
+    }
+}
+
 #[derive(Clone, Debug)]
 pub struct TailOptions {
     pub since_seq: Option<u64>,
+    /// Skip messages stamped before this Unix-nanosecond time; the tail seeks via the pool's
+    /// time checkpoints first instead of walking from the oldest frame.
+    pub since_ns: Option<u64>,
     pub max_messages: Option<usize>,
     pub tags: Vec<String>,
     pub poll_interval: Duration,
@@ -41,6 +96,7 @@ impl TailOptions {
     pub fn new() -> Self {
         Self {
             since_seq: None,
+            since_ns: None,
             max_messages: None,
             tags: Vec::new(),
             poll_interval: Duration::from_millis(50),
@@ -56,22 +112,31 @@ impl Default for TailOptions {
     }
 }
 
+/// Frames a tail reads per header refresh while catching up.
+pub(super) const TAIL_BATCH_FRAMES: usize = 64;
+/// Replay drains the whole pool up front, so it reads larger batches.
+const REPLAY_BATCH_FRAMES: usize = 1024;
+
 pub struct Tail<'a> {
     pool: &'a Pool,
-    cursor: Cursor,
+    cursor: BatchCursor<'a>,
     options: TailOptions,
     seen: usize,
     deadline: Option<Instant>,
-    notify: Option<PoolSemaphore>,
+    notify: Option<PoolWaiter>,
+    // Bloom mask of `options.tags`, checked against frame headers before decoding.
+    tag_mask: u64,
 }
 
 pub struct Lite3Tail<'a> {
     pool: &'a Pool,
-    cursor: Cursor,
+    cursor: BatchCursor<'a>,
     options: TailOptions,
     seen: usize,
     deadline: Option<Instant>,
-    notify: Option<PoolSemaphore>,
+    notify: Option<PoolWaiter>,
+    // Bloom mask of `options.tags`, checked against frame headers before decoding.
+    tag_mask: u64,
 }
 
 #[derive(Clone, Debug)]
@@ -101,6 +166,10 @@ pub struct Replay {
 impl Replay {
     fn new(pool: &Pool, options: ReplayOptions) -> Result<Self, Error> {
         let mut cursor = Cursor::new();
+        if let Some(since) = options.since_ns {
+            cursor.seek_to_time(pool, since)?;
+        }
+        let mut cursor = BatchCursor::new(cursor, REPLAY_BATCH_FRAMES);
         let mut entries: Vec<(u64, Message)> = Vec::new();
 
         loop {
@@ -112,7 +181,7 @@ impl Replay {
                         }
                     }
                     let ts = frame.timestamp_ns;
-                    let msg = message_from_frame(&frame)?;
+                    let msg = pool_message_from_frame(pool, &frame)?;
                     entries.push((ts, msg));
                 }
                 CursorResult::WouldBlock => break,
@@ -168,13 +237,18 @@ impl<'a> Tail<'a> {
         } else {
             None
         };
+        let tag_mask = frame::tag_bloom(options.tags.iter().map(String::as_str));
         Self {
             pool,
-            cursor: Cursor::new(),
+            cursor: BatchCursor::new(
+                time_seeked_cursor(pool, options.since_ns),
+                TAIL_BATCH_FRAMES,
+            ),
             options,
             seen: 0,
             deadline,
             notify,
+            tag_mask,
         }
     }
 
@@ -199,7 +273,15 @@ impl<'a> Tail<'a> {
                             continue;
                         }
                     }
-                    let message = message_from_frame(&frame)?;
+                    if let Some(since) = self.options.since_ns {
+                        if frame.timestamp_ns < since {
+                            continue;
+                        }
+                    }
+                    if !frame::tag_bloom_may_match(frame.tag_bloom, self.tag_mask) {
+                        continue;
+                    }
+                    let message = pool_message_from_frame(self.pool, &frame)?;
                     if !has_required_tags(&message.meta.tags, self.options.tags.as_slice()) {
                         continue;
                     }
@@ -240,13 +322,18 @@ impl<'a> Lite3Tail<'a> {
         } else {
             None
         };
+        let tag_mask = frame::tag_bloom(options.tags.iter().map(String::as_str));
         Self {
             pool,
-            cursor: Cursor::new(),
+            cursor: BatchCursor::new(
+                time_seeked_cursor(pool, options.since_ns),
+                TAIL_BATCH_FRAMES,
+            ),
             options,
             seen: 0,
             deadline,
             notify,
+            tag_mask,
         }
     }
 
@@ -271,10 +358,21 @@ impl<'a> Lite3Tail<'a> {
                             continue;
                         }
                     }
-                    let (meta, _) = decode_payload(frame.payload)?;
-                    if !has_required_tags(&meta.tags, self.options.tags.as_slice()) {
+                    if let Some(since) = self.options.since_ns {
+                        if frame.timestamp_ns < since {
+                            continue;
+                        }
+                    }
+                    if !frame::tag_bloom_may_match(frame.tag_bloom, self.tag_mask) {
                         continue;
                     }
+                    // Compressed frames stay as stored unless a tag filter needs their meta.
+                    if !frame.is_compressed() || !self.options.tags.is_empty() {
+                        let meta = Meta::from_lite3(&self.pool.frame_payload(&frame)?)?;
+                        if !has_required_tags(&meta.tags, self.options.tags.as_slice()) {
+                            continue;
+                        }
+                    }
                     self.seen += 1;
                     return Ok(Some(frame));
                 }
@@ -304,13 +402,23 @@ impl<'a> Lite3Tail<'a> {
     }
 }
 
-fn has_required_tags(message_tags: &[String], required_tags: &[String]) -> bool {
+// A seek failure (e.g. a corrupt header) leaves the cursor at the start; `next` then
+// surfaces the same error to the caller.
+pub(super) fn time_seeked_cursor(pool: &Pool, since_ns: Option<u64>) -> Cursor {
+    let mut cursor = Cursor::new();
+    if let Some(since) = since_ns {
+        let _ = cursor.seek_to_time(pool, since);
+    }
+    cursor
+}
+
+pub(super) fn has_required_tags(message_tags: &[String], required_tags: &[String]) -> bool {
     required_tags
         .iter()
         .all(|required| message_tags.iter().any(|tag| tag == required))
 }
 
-fn wait_interval(deadline: Option<Instant>, poll_interval: Duration) -> Duration {
+pub(super) fn wait_interval(deadline: Option<Instant>, poll_interval: Duration) -> Duration {
     if let Some(deadline) = deadline {
         let now = Instant::now();
         if now >= deadline {
@@ -342,20 +450,47 @@ pub trait PoolApiExt {
         durability: Durability,
     ) -> Result<Message, Error>;
 
+    /// Append several `(data, tags)` messages under one append lock and a shared timestamp.
+    fn append_json_batch(
+        &mut self,
+        messages: &[(&Value, &[String])],
+        options: AppendOptions,
+    ) -> Result<Vec<Message>, Error>;
+
+    fn append_json_batch_now(
+        &mut self,
+        messages: &[(&Value, &[String])],
+        durability: Durability,
+    ) -> Result<Vec<Message>, Error>;
+
     /// Append a pre-encoded Lite3 payload without JSON encoding/decoding.
     fn append_lite3(&mut self, payload: &[u8], options: AppendOptions) -> Result<u64, Error>;
 
     /// Append a pre-encoded Lite3 payload with a generated timestamp.
     fn append_lite3_now(&mut self, payload: &[u8], durability: Durability) -> Result<u64, Error>;
 
+    /// Append pre-encoded Lite3 payloads under one lock (see `Pool::append_batch`).
+    fn append_lite3_batch(
+        &mut self,
+        payloads: &[&[u8]],
+        options: AppendOptions,
+    ) -> Result<Vec<u64>, Error>;
+
+    fn append_lite3_batch_now(
+        &mut self,
+        payloads: &[&[u8]],
+        durability: Durability,
+    ) -> Result<Vec<u64>, Error>;
+
     fn get_message(&self, seq: u64) -> Result<Message, Error>;
 
-    /// Fetch the raw Lite3 payload for a sequence number.
+    /// Fetch the stored frame for a sequence number without decoding it. In a compressed pool
+    /// the payload may be compressed; see `FrameRef::is_compressed` and `Pool::frame_payload`.
     fn get_lite3(&self, seq: u64) -> Result<FrameRef<'_>, Error>;
 
     fn tail(&self, options: TailOptions) -> Tail<'_>;
 
-    /// Tail frames without JSON decoding.
+    /// Tail frames without JSON decoding or decompression (as for `get_lite3`).
     fn tail_lite3(&self, options: TailOptions) -> Lite3Tail<'_>;
 
     fn replay(&self, options: ReplayOptions) -> Result<Replay, Error>;
@@ -368,8 +503,7 @@ impl PoolApiExt for Pool {
         tags: &[String],
         options: AppendOptions,
     ) -> Result<Message, Error> {
-        let payload = crate::core::lite3::encode_message(tags, data)?;
-        let seq = self.append_with_options(payload.as_slice(), options)?;
+        let seq = append_encoded(self, tags, data, options)?;
         Ok(Message {
             seq,
             time: format_ts(options.timestamp_ns)?,
@@ -391,6 +525,45 @@ impl PoolApiExt for Pool {
         self.append_json(data, tags, options)
     }
 
+    fn append_json_batch(
+        &mut self,
+        messages: &[(&Value, &[String])],
+        options: AppendOptions,
+    ) -> Result<Vec<Message>, Error> {
+        let mut payloads = Vec::with_capacity(messages.len());
+        for (data, tags) in messages {
+            if !matches!(data, Value::Object(_)) {
+                return Err(Error::new(ErrorKind::Usage).with_message("data must be object"));
+            }
+            payloads.push(lite3::encode_message(tags, data)?);
+        }
+        let slices: Vec<&[u8]> = payloads.iter().map(|payload| payload.as_slice()).collect();
+        let seqs = self.append_batch(&slices, options)?;
+        let time = format_ts(options.timestamp_ns)?;
+        Ok(seqs
+            .into_iter()
+            .zip(messages)
+            .map(|(seq, (data, tags))| Message {
+                seq,
+                time: time.clone(),
+                meta: Meta {
+                    tags: tags.to_vec(),
+                },
+                data: (*data).clone(),
+            })
+            .collect())
+    }
+
+    fn append_json_batch_now(
+        &mut self,
+        messages: &[(&Value, &[String])],
+        durability: Durability,
+    ) -> Result<Vec<Message>, Error> {
+        let timestamp_ns = now_ns()?;
+        let options = AppendOptions::new(timestamp_ns, durability);
+        self.append_json_batch(messages, options)
+    }
+
     fn append_lite3(&mut self, payload: &[u8], options: AppendOptions) -> Result<u64, Error> {
         validate_bytes(payload)?;
         self.append_with_options(payload, options)
@@ -402,9 +575,31 @@ impl PoolApiExt for Pool {
         self.append_lite3(payload, options)
     }
 
+    fn append_lite3_batch(
+        &mut self,
+        payloads: &[&[u8]],
+        options: AppendOptions,
+    ) -> Result<Vec<u64>, Error> {
+        // Validate the whole batch first so a bad payload never leaves a partial commit.
+        for payload in payloads {
+            validate_bytes(payload)?;
+        }
+        self.append_batch(payloads, options)
+    }
+
+    fn append_lite3_batch_now(
+        &mut self,
+        payloads: &[&[u8]],
+        durability: Durability,
+    ) -> Result<Vec<u64>, Error> {
+        let timestamp_ns = now_ns()?;
+        let options = AppendOptions::new(timestamp_ns, durability);
+        self.append_lite3_batch(payloads, options)
+    }
+
     fn get_message(&self, seq: u64) -> Result<Message, Error> {
         let frame = self.get(seq)?;
-        message_from_frame(&frame)
+        pool_message_from_frame(self, &frame)
     }
 
     fn get_lite3(&self, seq: u64) -> Result<FrameRef<'_>, Error> {
@@ -424,7 +619,58 @@ impl PoolApiExt for Pool {
     }
 }
 
+/// Encode straight into a reserved ring slot. When the size hint comes up short, the message
+/// is encoded on the heap and the slot grown to its exact length under the same lock, so the
+/// only frames evicted are the ones the committed frame needs. A hint larger than one frame
+/// can hold goes straight to the heap path, as does every append to a compressed pool:
+/// reserved frames are committed raw, so those must go through the pool's codec.
+fn append_encoded(
+    pool: &mut Pool,
+    tags: &[String],
+    data: &Value,
+    options: AppendOptions,
+) -> Result<u64, Error> {
+    if !matches!(data, Value::Object(_)) {
+        return Err(Error::new(ErrorKind::Usage).with_message("data must be object"));
+    }
+    append_encoded_with_hint(
+        pool,
+        tags,
+        data,
+        options,
+        lite3::encoded_len_hint(tags, data),
+    )
+}
+
+fn append_encoded_with_hint(
+    pool: &mut Pool,
+    tags: &[String],
+    data: &Value,
+    options: AppendOptions,
+    hint: usize,
+) -> Result<u64, Error> {
+    if pool.compression().is_none() && hint <= pool.max_payload_len() {
+        let mut reserved = pool.append_reserve_with_options(hint, options)?;
+        if let Some(len) = lite3::encode_message_into(tags, data, reserved.payload_mut())? {
+            return reserved.commit(len);
+        }
+        let payload = lite3::encode_message(tags, data)?;
+        let len = payload.as_slice().len();
+        reserved.grow(len)?;
+        reserved.payload_mut()[..len].copy_from_slice(payload.as_slice());
+        return reserved.commit(len);
+    }
+    let payload = lite3::encode_message(tags, data)?;
+    pool.append_with_options(payload.as_slice(), options)
+}
+
+fn pool_message_from_frame(pool: &Pool, frame: &FrameRef<'_>) -> Result<Message, Error> {
+    let payload = pool.frame_payload(frame)?;
+    message_from_frame(&frame.with_payload(&payload))
+}
+
 fn message_from_frame(frame: &FrameRef<'_>) -> Result<Message, Error> {
+    ensure_raw(frame)?;
     let (meta, data) = decode_payload(frame.payload)?;
     Ok(Message {
         seq: frame.seq,
@@ -434,21 +680,72 @@ fn message_from_frame(frame: &FrameRef<'_>) -> Result<Message, Error> {
     })
 }
 
+/// Frame decoders read Lite3 in place; a compressed payload must go through
+/// `Pool::frame_payload` first.
+fn ensure_raw(frame: &FrameRef<'_>) -> Result<(), Error> {
+    if frame.is_compressed() {
+        return Err(Error::new(ErrorKind::Usage)
+            .with_message("frame payload is compressed")
+            .with_seq(frame.seq)
+            .with_hint("Decode it with Pool::frame_payload (or Message::from_pool_frame)."));
+    }
+    Ok(())
+}
+
 fn decode_payload(payload: &[u8]) -> Result<(Meta, Value), Error> {
     let doc = Lite3DocRef::new(payload);
-    let meta_type = doc
-        .type_at_key(0, "meta")
-        .map_err(|err| err.with_message("missing meta"))?;
-    if meta_type != sys::LITE3_TYPE_OBJECT {
-        return Err(Error::new(ErrorKind::Corrupt).with_message("meta is not object"));
+    let meta = decode_meta(&doc)?;
+    let data = doc.to_value_at(data_offset(&doc)?)?;
+
+    Ok((meta, data))
+}
+
+fn data_offset(doc: &Lite3DocRef<'_>) -> Result<usize, Error> {
+    doc.key_offset("data")
+        .map_err(|err| err.with_message("missing data"))
+}
+
+// Keys in `serde_json::Map` order (sorted), matching `json!({seq, time, meta, data})` output.
+fn write_envelope_json(frame: &FrameRef<'_>, out: &mut Vec<u8>) -> Result<Meta, Error> {
+    ensure_raw(frame)?;
+    let doc = Lite3DocRef::new(frame.payload);
+    let meta = decode_meta(&doc)?;
+    let data_ofs = data_offset(&doc)?;
+    let time = format_ts(frame.timestamp_ns)?;
+    out.extend_from_slice(b"{\"data\":");
+    doc.write_json_at(data_ofs, out)?;
+    out.extend_from_slice(b",\"meta\":{\"tags\":");
+    write_json_string_array(out, &meta.tags);
+    out.extend_from_slice(b"},\"seq\":");
+    write_json_scalar(out, &frame.seq);
+    out.extend_from_slice(b",\"time\":");
+    write_json_scalar(out, &time);
+    out.push(b'}');
+    Ok(meta)
+}
+
+fn write_json_string_array(out: &mut Vec<u8>, items: &[String]) {
+    out.push(b'[');
+    for (index, item) in items.iter().enumerate() {
+        if index > 0 {
+            out.push(b',');
+        }
+        write_json_scalar(out, item.as_str());
     }
+    out.push(b']');
+}
 
-    let meta_ofs = doc
-        .key_offset("meta")
-        .map_err(|err| err.with_message("missing meta"))?;
-    let tags_ofs = doc
-        .key_offset_at(meta_ofs, "tags")
-        .map_err(|err| err.with_message("missing meta.tags"))?;
+fn write_json_scalar<T: serde::Serialize + ?Sized>(out: &mut Vec<u8>, value: &T) {
+    // Strings and integers serialize infallibly into a `Vec`.
+    let _ = serde_json::to_writer(&mut *out, value);
+}
+
+fn decode_meta(doc: &Lite3DocRef<'_>) -> Result<Meta, Error> {
+    let tags_ofs = match doc.offset_at_path(0, lite3::meta_tags_path()) {
+        Ok(Some(tags_ofs)) => tags_ofs,
+        // Key-by-key walk only to report which part of the envelope is wrong.
+        _ => meta_tags_offset(doc)?,
+    };
     let tags_count = doc
         .count_at(tags_ofs)
         .map_err(|_| Error::new(ErrorKind::Corrupt).with_message("meta.tags must be array"))?;
@@ -467,18 +764,21 @@ fn decode_payload(payload: &[u8]) -> Result<(Meta, Value), Error> {
         })?;
         tags.push(tag);
     }
+    Ok(Meta { tags })
+}
 
-    let data_ofs = doc
-        .key_offset("data")
-        .map_err(|err| err.with_message("missing data"))?;
-    let data_json = doc.to_json_at(data_ofs, false)?;
-    let data: Value = serde_json::from_str(&data_json).map_err(|err| {
-        Error::new(ErrorKind::Corrupt)
-            .with_message("invalid payload json")
-            .with_source(err)
-    })?;
-
-    Ok((Meta { tags }, data))
+fn meta_tags_offset(doc: &Lite3DocRef<'_>) -> Result<usize, Error> {
+    let meta_type = doc
+        .type_at_key(0, "meta")
+        .map_err(|err| err.with_message("missing meta"))?;
+    if meta_type != sys::LITE3_TYPE_OBJECT {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("meta is not object"));
+    }
+    let meta_ofs = doc
+        .key_offset("meta")
+        .map_err(|err| err.with_message("missing meta"))?;
+    doc.key_offset_at(meta_ofs, "tags")
+        .map_err(|err| err.with_message("missing meta.tags"))
 }
 
 fn now_ns() -> Result<u64, Error> {
@@ -510,8 +810,11 @@ fn format_ts(timestamp_ns: u64) -> Result<String, Error> {
 #[cfg(test)]
 mod tests {
     use super::{Meta, PoolApiExt, ReplayOptions, TailOptions, decode_payload};
-    use crate::core::lite3::{encode_message, json_counter_snapshot, reset_json_counters};
-    use crate::core::pool::{Pool, PoolOptions};
+    use crate::core::error::ErrorKind;
+    use crate::core::lite3::{
+        encode_message, json_counter_snapshot, reset_json_counters, value_counter_snapshot,
+    };
+    use crate::core::pool::{Durability, Pool, PoolOptions};
     use serde_json::json;
     use tempfile::tempdir;
 
@@ -530,14 +833,51 @@ mod tests {
     }
 
     #[test]
-    fn decode_payload_avoids_full_doc_json() {
+    fn write_frame_json_matches_serialized_message() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let data = json!({"zeta": [1, 2.5, null], "alpha": {"msg": "tab\there \"q\" é"}});
+        let appended = pool
+            .append_json_now(
+                &data,
+                &["b".to_string(), "a\n".to_string()],
+                Durability::Fast,
+            )
+            .expect("append");
+        let frame = pool.get_lite3(appended.seq).expect("frame");
+        let message = super::Message::from_frame(&frame).expect("message");
+
+        let mut out = b"prefix:".to_vec();
+        reset_json_counters();
+        let meta = super::Message::write_frame_json(&frame, &mut out).expect("write");
+        assert_eq!(value_counter_snapshot(), 0);
+        assert_eq!(meta, message.meta);
+        let expected = serde_json::to_vec(&json!({
+            "seq": message.seq,
+            "time": message.time,
+            "meta": {"tags": message.meta.tags},
+            "data": message.data,
+        }))
+        .expect("serialize");
+        assert_eq!(&out[..7], b"prefix:");
+        assert_eq!(&out[7..], expected.as_slice());
+
+        out.clear();
+        super::Message::write_frame_data_json(&frame, &mut out).expect("write data");
+        assert_eq!(out, serde_json::to_vec(&data).expect("serialize"));
+    }
+
+    #[test]
+    fn decode_payload_avoids_json_text() {
         let data = json!({"x": 1});
         let payload = encode_message(&["tag".to_string()], &data).expect("encode");
         reset_json_counters();
         let _ = decode_payload(payload.as_slice()).expect("decode");
         let (full, partial) = json_counter_snapshot();
         assert_eq!(full, 0);
-        assert_eq!(partial, 1);
+        assert_eq!(partial, 0);
+        assert_eq!(value_counter_snapshot(), 1);
     }
 
     #[test]
@@ -567,6 +907,148 @@ mod tests {
         assert_eq!(frame.payload, payload.as_slice());
     }
 
+    #[test]
+    fn append_json_encodes_in_place() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let tags = vec!["tag".to_string()];
+        let data = json!({"x": 1, "items": ["a", "b"], "nested": {"ok": true}});
+
+        let message = pool
+            .append_json(&data, &tags, crate::core::pool::AppendOptions::default())
+            .expect("append");
+
+        let expected = encode_message(&tags, &data).expect("payload");
+        let frame = pool.get_lite3(message.seq).expect("get");
+        assert_eq!(frame.payload, expected.as_slice());
+        assert_eq!(pool.get_message(message.seq).expect("message").data, data);
+    }
+
+    #[test]
+    fn append_json_compresses_in_a_compressed_pool() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let options = PoolOptions::new(1024 * 1024)
+            .with_compression(crate::core::compress::Compression::zstd());
+        let mut pool = Pool::create(&path, options).expect("create");
+        let tags = vec!["tag".to_string()];
+        let data = json!({"note": "x".repeat(2048)});
+
+        let message = pool
+            .append_json(&data, &tags, crate::core::pool::AppendOptions::default())
+            .expect("append");
+
+        let frame = pool.get_lite3(message.seq).expect("get");
+        assert!(frame.is_compressed());
+        let stored = pool.get_message(message.seq).expect("message");
+        assert_eq!(stored.data, data);
+        assert_eq!(stored.meta.tags, tags);
+    }
+
+    #[test]
+    fn append_json_hint_miss_evicts_only_what_the_frame_needs() {
+        let dir = tempdir().expect("tempdir");
+        let options = crate::core::pool::AppendOptions::default();
+        let tags = vec!["tag".to_string()];
+        let mut hinted = Pool::create(
+            dir.path().join("hinted.plasmite"),
+            PoolOptions::new(1024 * 1024),
+        )
+        .expect("create");
+        let mut plain = Pool::create(
+            dir.path().join("plain.plasmite"),
+            PoolOptions::new(1024 * 1024),
+        )
+        .expect("create");
+        for idx in 0..4 {
+            let data = json!({"idx": idx, "blob": "x".repeat(200_000)});
+            hinted.append_json(&data, &tags, options).expect("append");
+            plain.append_json(&data, &tags, options).expect("append");
+        }
+
+        // A hint far below the encoded size forces the grow path on `hinted`.
+        let data = json!({"idx": 4, "blob": "y".repeat(300_000)});
+        let seq = super::append_encoded_with_hint(&mut hinted, &tags, &data, options, 64)
+            .expect("append with short hint");
+        let payload = encode_message(&tags, &data).expect("payload");
+        let plain_seq = plain
+            .append_with_options(payload.as_slice(), options)
+            .expect("append payload");
+
+        assert_eq!(seq, plain_seq);
+        let bounds = hinted.bounds().expect("bounds");
+        assert_eq!(bounds, plain.bounds().expect("bounds"));
+        assert!(
+            bounds.oldest_seq > Some(1),
+            "the large frame must evict something"
+        );
+        for kept in bounds.oldest_seq.expect("oldest")..seq {
+            assert_eq!(
+                hinted.get_message(kept).expect("kept frame").data["idx"],
+                json!(kept - 1)
+            );
+        }
+        assert_eq!(
+            hinted.get_lite3(seq).expect("frame").payload,
+            payload.as_slice()
+        );
+    }
+
+    #[test]
+    fn append_json_batch_assigns_contiguous_seqs() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let tags = vec!["tag".to_string()];
+        let first = json!({"x": 1});
+        let second = json!({"x": 2});
+        let no_tags: &[String] = &[];
+        let options = crate::core::pool::AppendOptions::default();
+
+        let messages = pool
+            .append_json_batch(&[(&first, tags.as_slice()), (&second, no_tags)], options)
+            .expect("append batch");
+        assert_eq!(
+            messages
+                .iter()
+                .map(|message| message.seq)
+                .collect::<Vec<_>>(),
+            vec![1, 2]
+        );
+        let stored = pool.get_message(2).expect("message");
+        assert_eq!(stored.data, second);
+        assert!(stored.meta.tags.is_empty());
+        assert_eq!(pool.get_message(1).expect("message").meta.tags, tags);
+
+        let err = pool
+            .append_json_batch(&[(&first, no_tags), (&json!([1]), no_tags)], options)
+            .expect_err("non-object data");
+        assert_eq!(err.kind(), ErrorKind::Usage);
+        assert_eq!(pool.bounds().expect("bounds").newest_seq, Some(2));
+    }
+
+    #[test]
+    fn append_lite3_batch_validates_before_writing() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let first = encode_message(&[], &json!({"x": 1})).expect("payload");
+        let second = encode_message(&[], &json!({"x": 2})).expect("payload");
+
+        let seqs = pool
+            .append_lite3_batch_now(&[first.as_slice(), second.as_slice()], Durability::Fast)
+            .expect("append batch");
+        assert_eq!(seqs, vec![1, 2]);
+        assert_eq!(pool.get_lite3(2).expect("get").payload, second.as_slice());
+
+        let err = pool
+            .append_lite3_batch_now(&[first.as_slice(), &[0x01]], Durability::Fast)
+            .expect_err("invalid payload");
+        assert_eq!(err.kind(), ErrorKind::Corrupt);
+        assert_eq!(pool.bounds().expect("bounds").newest_seq, Some(2));
+    }
+
     #[test]
     fn tail_notify_opt_out_disables_notify() {
         let dir = tempdir().expect("tempdir");
@@ -579,6 +1061,28 @@ mod tests {
         assert!(tail.notify.is_none());
     }
 
+    #[test]
+    fn tail_since_ns_skips_older_messages() {
+        let dir = tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        for n in 1..=4u64 {
+            let options = crate::core::pool::AppendOptions::new(n * 1000, Durability::Fast);
+            pool.append_json(&json!({"n": n}), &[], options)
+                .expect("append");
+        }
+
+        let mut options = TailOptions::new();
+        options.since_ns = Some(2500);
+        options.timeout = Some(std::time::Duration::from_millis(20));
+        let mut tail = pool.tail(options);
+        let mut seqs = Vec::new();
+        while let Some(message) = tail.next_message().expect("tail") {
+            seqs.push(message.seq);
+        }
+        assert_eq!(seqs, vec![3, 4]);
+    }
+
     #[test]
     fn tail_filters_by_required_tags() {
         let dir = tempdir().expect("tempdir");
@@ -5,21 +5,42 @@
 //! Invariants: Internal modules remain private and are not directly exposed.
 
 mod client;
+mod group;
+mod lite3_batch;
 mod message;
 pub mod notify;
 mod remote;
 mod validation;
 
-pub use crate::core::cursor::{Cursor, CursorResult, FrameRef};
+pub use crate::core::commit::{
+    CommitHandle, DEFAULT_GROUP_COMMIT_BYTES, DEFAULT_GROUP_COMMIT_DELAY,
+};
+pub use crate::core::compress::{
+    Compression, DEFAULT_MIN_FRAME_LEN, MAX_DICTIONARY_LEN, ZSTD_DEFAULT_LEVEL, train_dictionary,
+};
+pub use crate::core::cursor::{BatchCursor, BatchResult, Cursor, CursorResult, FrameRef};
 #[doc(hidden)]
 pub use crate::core::error::to_exit_code;
 pub use crate::core::error::{Error, ErrorKind};
+pub use crate::core::frame::{FRAME_FLAG_ZSTD, tag_bloom, tag_bloom_may_match};
 pub use crate::core::lite3::{self, Lite3DocRef};
+pub use crate::core::metrics::{
+    HISTOGRAM_BUCKETS, HotMetrics, Lite3CodecMetrics, LogHistogram, lite3_codec_metrics,
+};
 pub use crate::core::pool::{
     AppendOptions, Bounds, Durability, Pool, PoolAgeMetrics, PoolInfo, PoolMetrics, PoolOptions,
-    PoolUtilization, SeqOffsetCache,
+    PoolUtilization, ReservedFrame, SeqOffsetCache,
 };
+pub use crate::core::residency::{DEFAULT_RELEASE_WINDOW_BYTES, ReleaseAdvice, Residency};
 pub use client::{LocalClient, PoolRef};
+pub use group::{GroupMessage, GroupTail, POOL_GROUP_MAX_SHARDS, PoolGroup};
+pub use lite3_batch::{
+    LITE3_BATCH_CONTENT_TYPE, LITE3_BATCH_FRAME_HEADER_LEN, decode_lite3_batch,
+    push_lite3_batch_frame,
+};
 pub use message::{Lite3Tail, Message, Meta, PoolApiExt, Replay, ReplayOptions, Tail, TailOptions};
-pub use remote::{RemoteClient, RemoteLite3Frame, RemoteLite3Tail, RemotePool, RemoteTail};
+pub use remote::{
+    RemoteClient, RemoteLite3Appender, RemoteLite3AppenderOptions, RemoteLite3Frame,
+    RemoteLite3Tail, RemotePool, RemoteTail,
+};
 pub use validation::{ValidationIssue, ValidationReport, ValidationStatus};
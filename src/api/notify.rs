@@ -16,7 +16,7 @@ pub enum NotifyWait {
 }
 
 pub struct NotifyHandle {
-    inner: crate::core::notify::PoolSemaphore,
+    inner: crate::core::notify::PoolWaiter,
 }
 
 impl NotifyHandle {
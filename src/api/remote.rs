@@ -1,11 +1,17 @@
 //! Purpose: Provide an HTTP client for the Plasmite v0 protocol (JSON + Lite3 bytes).
 //! Exports: `RemoteClient`, `RemotePool`, `RemoteTail`, `RemoteLite3Tail`, `RemoteLite3Frame`.
+//! Exports: `RemoteLite3Appender`, `RemoteLite3AppenderOptions`.
 //! Role: Transport-agnostic client that mirrors local pool operations remotely.
 //! Invariants: Requests/response envelopes align with spec/remote/v0/SPEC.md.
 //! Invariants: Pool refs resolve to a base URL + pool identifier (name only).
 //! Invariants: Tail streams are JSONL (messages) or framed Lite3 bytes (fast path).
+//! Invariants: One `ureq::Agent` per client keeps idle connections alive for reuse.
+//! Invariants: Appender batches commit in submission order only while `in_flight` is 1.
 #![allow(clippy::result_large_err)]
 
+use super::lite3_batch::{
+    LITE3_BATCH_CONTENT_TYPE, LITE3_BATCH_FRAME_HEADER_LEN, push_lite3_batch_frame,
+};
 use super::{Message, Meta, PoolRef, TailOptions};
 use crate::core::error::{Error, ErrorKind};
 use crate::core::pool::{
@@ -15,9 +21,11 @@ use crate::core::pool::{
 use serde::de::DeserializeOwned;
 use serde::{Deserialize, Serialize};
 use serde_json::Value;
+use std::collections::VecDeque;
 use std::io::{BufRead, BufReader, Read};
 use std::path::{Path, PathBuf};
 use std::sync::Arc;
+use std::thread::JoinHandle;
 use ureq::rustls::client::danger::{
     HandshakeSignatureValid, ServerCertVerified, ServerCertVerifier,
 };
@@ -28,15 +36,26 @@ use url::Url;
 
 type ApiResult<T> = Result<T, Error>;
 
+/// Idle keep-alive connections kept per host; covers a full appender window plus a tail.
+const IDLE_CONNECTIONS_PER_HOST: usize = 8;
+/// zstd level for compressed append bodies.
+const BATCH_ZSTD_LEVEL: i32 = 3;
+/// Read buffer for Lite3 tails; `next_batch` returns whatever whole frames it holds.
+const LITE3_TAIL_BUFFER_BYTES: usize = 64 * 1024;
+/// `[u64be seq][u64be timestamp_ns][u32be len]` in front of each Lite3 tail payload.
+const LITE3_TAIL_FRAME_HEADER_LEN: usize = 20;
+
 #[derive(Clone)]
 pub struct RemoteClient {
     inner: Arc<RemoteClientInner>,
 }
 
+#[derive(Clone)]
 struct RemoteClientInner {
     base_url: Url,
     token: Option<String>,
     agent: ureq::Agent,
+    zstd: bool,
 }
 
 #[derive(Debug)]
@@ -95,6 +114,39 @@ pub struct RemoteLite3Tail {
     reader: Option<BufReader<Box<dyn std::io::Read + Send + Sync>>>,
 }
 
+/// Tuning for `RemotePool::lite3_appender`.
+#[derive(Clone, Copy, Debug)]
+pub struct RemoteLite3AppenderOptions {
+    /// Frames per request before a batch is sent.
+    pub max_batch_frames: usize,
+    /// Request body bytes before a batch is sent; keep below the server's `--max-body-bytes`.
+    pub max_batch_bytes: usize,
+    /// Batch requests allowed in flight. Above 1, batches may commit out of submission order.
+    pub in_flight: usize,
+    pub durability: Durability,
+}
+
+impl Default for RemoteLite3AppenderOptions {
+    fn default() -> Self {
+        Self {
+            max_batch_frames: 1024,
+            max_batch_bytes: 512 * 1024,
+            in_flight: 1,
+            durability: Durability::Fast,
+        }
+    }
+}
+
+/// Pipelined Lite3 writer: `push` fills a batch while earlier batches are still in flight.
+pub struct RemoteLite3Appender {
+    pool: RemotePool,
+    options: RemoteLite3AppenderOptions,
+    body: Vec<u8>,
+    frames: usize,
+    in_flight: VecDeque<JoinHandle<ApiResult<Vec<u64>>>>,
+    acked: Vec<u64>,
+}
+
 #[derive(Clone, Debug)]
 pub struct RemoteLite3Frame {
     pub seq: u64,
@@ -133,6 +185,11 @@ struct Lite3AppendMessage {
     seq: u64,
 }
 
+#[derive(Deserialize)]
+struct Lite3BatchEnvelope {
+    seqs: Vec<u64>,
+}
+
 #[derive(Deserialize)]
 struct RemoteMessage {
     seq: u64,
@@ -230,26 +287,25 @@ struct AppendRequest<'a> {
 impl RemoteClient {
     pub fn new(base_url: impl Into<String>) -> ApiResult<Self> {
         let base_url = normalize_base_url(base_url.into())?;
-        let agent = ureq::AgentBuilder::new().build();
+        let agent = agent_builder().build();
         Ok(Self {
             inner: Arc::new(RemoteClientInner {
                 base_url,
                 token: None,
                 agent,
+                zstd: false,
             }),
         })
     }
 
     pub fn with_token(mut self, token: impl Into<String>) -> Self {
-        if let Some(inner) = Arc::get_mut(&mut self.inner) {
-            inner.token = Some(token.into());
-        } else {
-            self.inner = Arc::new(RemoteClientInner {
-                base_url: self.inner.base_url.clone(),
-                token: Some(token.into()),
-                agent: self.inner.agent.clone(),
-            });
-        }
+        Arc::make_mut(&mut self.inner).token = Some(token.into());
+        self
+    }
+
+    /// Compress Lite3 batch appends and ask for zstd-compressed Lite3 tails.
+    pub fn with_zstd(mut self) -> Self {
+        Arc::make_mut(&mut self.inner).zstd = true;
         self
     }
 
@@ -287,7 +343,7 @@ impl RemoteClient {
         let tls_config = ureq::rustls::ClientConfig::builder()
             .with_root_certificates(root_store)
             .with_no_client_auth();
-        let agent = ureq::builder().tls_config(Arc::new(tls_config)).build();
+        let agent = agent_builder().tls_config(Arc::new(tls_config)).build();
         self = self.with_agent(agent);
         Ok(self)
     }
@@ -298,7 +354,7 @@ impl RemoteClient {
             .dangerous()
             .with_custom_certificate_verifier(Arc::new(AcceptAllServerCertVerifier))
             .with_no_client_auth();
-        let agent = ureq::builder().tls_config(Arc::new(tls_config)).build();
+        let agent = agent_builder().tls_config(Arc::new(tls_config)).build();
         self = self.with_agent(agent);
         self
     }
@@ -438,10 +494,13 @@ impl RemoteClient {
     }
 
     fn request_stream_lite3(&self, url: &Url) -> ApiResult<ureq::Response> {
-        let response = self
+        let mut request = self
             .request("GET", url)
-            .set("Accept", "application/x-plasmite-lite3-stream")
-            .call();
+            .set("Accept", "application/x-plasmite-lite3-stream");
+        if self.inner.zstd {
+            request = request.set("Accept-Encoding", "zstd");
+        }
+        let response = request.call();
         match response {
             Ok(resp) => Ok(resp),
             Err(ureq::Error::Status(code, resp)) => Err(parse_error_response(code, resp)),
@@ -452,15 +511,7 @@ impl RemoteClient {
     }
 
     fn with_agent(mut self, agent: ureq::Agent) -> Self {
-        if let Some(inner) = Arc::get_mut(&mut self.inner) {
-            inner.agent = agent;
-        } else {
-            self.inner = Arc::new(RemoteClientInner {
-                base_url: self.inner.base_url.clone(),
-                token: self.inner.token.clone(),
-                agent,
-            });
-        }
+        Arc::make_mut(&mut self.inner).agent = agent;
         self
     }
 }
@@ -524,7 +575,7 @@ impl RemotePool {
                 .with_message("remote append does not support explicit timestamps"));
         }
         let mut url = build_url(&self.base_url, &["v0", "pools", &self.pool, "append_lite3"])?;
-        if options.durability == Durability::Flush {
+        if options.durability != Durability::Fast {
             url.query_pairs_mut()
                 .append_pair("durability", durability_to_str(options.durability));
         }
@@ -557,6 +608,72 @@ impl RemotePool {
         )
     }
 
+    /// Append pre-encoded Lite3 payloads in one request; returns their (contiguous) seqs.
+    pub fn append_lite3_batch(
+        &self,
+        payloads: &[&[u8]],
+        durability: Durability,
+    ) -> ApiResult<Vec<u64>> {
+        if payloads.is_empty() {
+            return Ok(Vec::new());
+        }
+        let mut body = Vec::new();
+        for payload in payloads {
+            push_lite3_batch_frame(&mut body, payload)?;
+        }
+        self.send_lite3_batch(&body, durability)
+    }
+
+    /// Start a pipelined batch writer for this pool.
+    pub fn lite3_appender(&self, options: RemoteLite3AppenderOptions) -> RemoteLite3Appender {
+        RemoteLite3Appender {
+            pool: self.clone(),
+            options,
+            body: Vec::new(),
+            frames: 0,
+            in_flight: VecDeque::new(),
+            acked: Vec::new(),
+        }
+    }
+
+    fn send_lite3_batch(&self, body: &[u8], durability: Durability) -> ApiResult<Vec<u64>> {
+        let mut url = build_url(&self.base_url, &["v0", "pools", &self.pool, "append_lite3"])?;
+        if durability != Durability::Fast {
+            url.query_pairs_mut()
+                .append_pair("durability", durability_to_str(durability));
+        }
+        let request = self
+            .client
+            .request("POST", &url)
+            .set("Accept", "application/json")
+            .set("Content-Type", LITE3_BATCH_CONTENT_TYPE);
+        let response = if self.client.inner.zstd {
+            let compressed = zstd::bulk::compress(body, BATCH_ZSTD_LEVEL).map_err(|err| {
+                Error::new(ErrorKind::Internal)
+                    .with_message("failed to compress lite3 batch")
+                    .with_source(err)
+            })?;
+            request
+                .set("Content-Encoding", "zstd")
+                .send_bytes(&compressed)
+        } else {
+            request.send_bytes(body)
+        };
+
+        match response {
+            Ok(resp) => {
+                let envelope: Lite3BatchEnvelope = read_json_response(resp)?;
+                Ok(envelope.seqs)
+            }
+            Err(ureq::Error::Status(code, resp)) => {
+                Err(parse_error_response(code, resp).with_path(self.pool.clone()))
+            }
+            Err(ureq::Error::Transport(err)) => Err(Error::new(ErrorKind::Io)
+                .with_message("request failed")
+                .with_source(err)),
+        }
+    }
+
     pub fn get_message(&self, seq: u64) -> ApiResult<Message> {
         let url = build_url(
             &self.base_url,
@@ -611,6 +728,9 @@ impl RemotePool {
             if let Some(since) = options.since_seq {
                 pairs.append_pair("since_seq", &since.to_string());
             }
+            if let Some(since) = options.since_ns {
+                pairs.append_pair("since_time", &since.to_string());
+            }
             if let Some(max) = options.max_messages {
                 pairs.append_pair("max", &max.to_string());
             }
@@ -638,6 +758,9 @@ impl RemotePool {
             if let Some(since) = options.since_seq {
                 pairs.append_pair("since_seq", &since.to_string());
             }
+            if let Some(since) = options.since_ns {
+                pairs.append_pair("since_time", &since.to_string());
+            }
             if let Some(max) = options.max_messages {
                 pairs.append_pair("max", &max.to_string());
             }
@@ -653,8 +776,19 @@ impl RemotePool {
             .client
             .request_stream_lite3(&url)
             .map_err(|err| err.with_path(self.pool.clone()))?;
+        let zstd = response
+            .header("Content-Encoding")
+            .is_some_and(|value| value.trim().eq_ignore_ascii_case("zstd"));
+        let mut reader: Box<dyn Read + Send + Sync> = response.into_reader();
+        if zstd {
+            reader = Box::new(zstd::stream::read::Decoder::new(reader).map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to start zstd tail decoder")
+                    .with_source(err)
+            })?);
+        }
         Ok(RemoteLite3Tail {
-            reader: Some(BufReader::new(response.into_reader())),
+            reader: Some(BufReader::with_capacity(LITE3_TAIL_BUFFER_BYTES, reader)),
         })
     }
 }
@@ -696,7 +830,7 @@ impl RemoteLite3Tail {
         let Some(reader) = self.reader.as_mut() else {
             return Ok(None);
         };
-        let mut header = [0u8; 20];
+        let mut header = [0u8; LITE3_TAIL_FRAME_HEADER_LEN];
         if !read_exact_or_eof(reader, &mut header)? {
             return Ok(None);
         }
@@ -716,9 +850,119 @@ impl RemoteLite3Tail {
         }))
     }
 
+    /// Wait for one frame, then take up to `max_frames` total from what is already buffered.
+    /// An empty batch means the stream ended.
+    pub fn next_batch(&mut self, max_frames: usize) -> ApiResult<Vec<RemoteLite3Frame>> {
+        let mut frames = Vec::new();
+        let Some(first) = self.next_frame()? else {
+            return Ok(frames);
+        };
+        frames.push(first);
+        while frames.len() < max_frames && self.buffered_frame_ready() {
+            match self.next_frame()? {
+                Some(frame) => frames.push(frame),
+                None => break,
+            }
+        }
+        Ok(frames)
+    }
+
     pub fn cancel(&mut self) {
         self.reader = None;
     }
+
+    fn buffered_frame_ready(&self) -> bool {
+        let Some(buffered) = self.reader.as_ref().map(BufReader::buffer) else {
+            return false;
+        };
+        let Some(header) = buffered.first_chunk::<LITE3_TAIL_FRAME_HEADER_LEN>() else {
+            return false;
+        };
+        let len = u32::from_be_bytes(header[16..20].try_into().expect("len header")) as usize;
+        buffered.len() >= LITE3_TAIL_FRAME_HEADER_LEN + len
+    }
+}
+
+impl RemoteLite3Appender {
+    /// Queue one Lite3 payload, sending the current batch once it reaches the size limits.
+    /// Blocks only while a full batch waits for the in-flight window.
+    pub fn push(&mut self, payload: &[u8]) -> ApiResult<()> {
+        let frame_len = LITE3_BATCH_FRAME_HEADER_LEN + payload.len();
+        if self.frames > 0 && self.body.len() + frame_len > self.options.max_batch_bytes {
+            self.send_batch()?;
+        }
+        push_lite3_batch_frame(&mut self.body, payload)?;
+        self.frames += 1;
+        if self.frames >= self.options.max_batch_frames
+            || self.body.len() >= self.options.max_batch_bytes
+        {
+            self.send_batch()?;
+        }
+        Ok(())
+    }
+
+    /// Send the pending batch and wait for every in-flight one. Returns the seqs acknowledged
+    /// since the previous flush, batch by batch in submission order.
+    pub fn flush(&mut self) -> ApiResult<Vec<u64>> {
+        self.send_batch()?;
+        while !self.in_flight.is_empty() {
+            self.join_oldest()?;
+        }
+        Ok(std::mem::take(&mut self.acked))
+    }
+
+    /// Frames queued but not yet sent.
+    pub fn pending(&self) -> usize {
+        self.frames
+    }
+
+    fn send_batch(&mut self) -> ApiResult<()> {
+        if self.frames == 0 {
+            return Ok(());
+        }
+        while self.in_flight.len() >= self.options.in_flight.max(1) {
+            self.join_oldest()?;
+        }
+        let capacity = self.body.capacity();
+        let body = std::mem::replace(&mut self.body, Vec::with_capacity(capacity));
+        self.frames = 0;
+        let pool = self.pool.clone();
+        let durability = self.options.durability;
+        let handle = std::thread::Builder::new()
+            .name("plasmite-remote-append".to_string())
+            .spawn(move || pool.send_lite3_batch(&body, durability))
+            .map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to start remote append worker")
+                    .with_source(err)
+            })?;
+        self.in_flight.push_back(handle);
+        Ok(())
+    }
+
+    fn join_oldest(&mut self) -> ApiResult<()> {
+        let Some(handle) = self.in_flight.pop_front() else {
+            return Ok(());
+        };
+        let seqs = handle.join().map_err(|_| {
+            Error::new(ErrorKind::Internal).with_message("remote append worker panicked")
+        })??;
+        self.acked.extend(seqs);
+        Ok(())
+    }
+}
+
+impl Drop for RemoteLite3Appender {
+    /// Unsent frames are dropped; in-flight requests are waited for so none outlive the pool.
+    fn drop(&mut self) {
+        for handle in self.in_flight.drain(..) {
+            let _ = handle.join();
+        }
+    }
+}
+
+fn agent_builder() -> ureq::AgentBuilder {
+    ureq::AgentBuilder::new().max_idle_connections_per_host(IDLE_CONNECTIONS_PER_HOST)
 }
 
 fn normalize_base_url(raw: String) -> ApiResult<Url> {
@@ -923,6 +1167,7 @@ fn pool_info_from_remote(pool_ref: &str, pool: RemotePoolInfo) -> PoolInfo {
             newest_seq: pool.bounds.newest,
         },
         metrics: pool.metrics.map(pool_metrics_from_remote),
+        hot_metrics: None,
     }
 }
 
@@ -965,6 +1210,8 @@ fn durability_to_str(durability: Durability) -> &'static str {
     match durability {
         Durability::Fast => "fast",
         Durability::Flush => "flush",
+        // The server applies its own group-commit window; the local thresholds stay local.
+        Durability::GroupCommit { .. } => "group",
     }
 }
 
@@ -3,9 +3,14 @@
 //! Role: Shared contract for CLI diagnostics, API users, and future servers.
 //! Invariants: Reports are additive-only in v0; no heavy payloads are embedded.
 //! Invariants: Snapshot paths are optional and only provided on request.
+//! Invariants: Ring walks go through the chunked parallel scanner and validate Lite3 payloads.
+//! Invariants: Compressed frames are decompressed through the pool's codec and validated too.
 
+use crate::core::compress::FrameCodec;
 use crate::core::frame::{self, FRAME_HEADER_LEN, FrameHeader, FrameState};
 use crate::core::pool::PoolHeader;
+use crate::core::scan::{self, ScanOptions};
+use std::ops::ControlFlow;
 use std::path::{Path, PathBuf};
 
 #[derive(Clone, Debug, Eq, PartialEq)]
@@ -94,6 +99,7 @@ impl ValidationReport {
 pub(crate) fn validate_pool_state_report(
     header: PoolHeader,
     mmap: &[u8],
+    codec: &FrameCodec,
     path: &Path,
 ) -> ValidationReport {
     let ring_offset = header.ring_offset as usize;
@@ -140,150 +146,60 @@ pub(crate) fn validate_pool_state_report(
         );
     }
 
-    let mut offset = tail;
-    let mut expected_seq = header.oldest_seq;
-    let max_frames = ring_size / FRAME_HEADER_LEN + 1;
-    let mut steps = 0usize;
-    let mut last_good_seq = None;
-
-    loop {
-        if steps > max_frames {
-            return ValidationReport::corrupt(
-                path.to_path_buf(),
-                issue(
-                    "corrupt",
-                    "scan exceeded ring capacity",
-                    last_good_seq,
-                    None,
-                ),
-                last_good_seq,
-            );
-        }
-        if ring_size - offset < FRAME_HEADER_LEN {
-            offset = 0;
-            steps += 1;
-            continue;
-        }
-        let frame = match read_frame_header(mmap, ring_offset, offset) {
-            Ok(frame) => frame,
-            Err(err) => {
-                return ValidationReport::corrupt(
-                    path.to_path_buf(),
-                    issue(
-                        "corrupt",
-                        &format!("frame header decode failed: {err}"),
-                        last_good_seq,
-                        Some(offset as u64),
-                    ),
-                    last_good_seq,
-                );
+    // (first seq, count) of frames whose recorded tag bloom disagrees with their payload.
+    let options = ScanOptions::new().with_payload_validation(true);
+    // Compressed frames reach the visitor decoded, so their blooms are checked too.
+    let scan = scan::scan_ring_with_codec(
+        mmap,
+        header,
+        &options,
+        codec,
+        || None,
+        |mismatch: &mut Option<(u64, usize)>, _offset, frame| {
+            if frame.tag_bloom != 0 && frame::payload_tag_bloom(frame.payload) != frame.tag_bloom {
+                mismatch.get_or_insert((frame.seq, 0)).1 += 1;
             }
-        };
-        if let Err(err) = frame.validate(ring_size) {
+            ControlFlow::Continue(())
+        },
+    );
+    let scan = match scan {
+        Ok(scan) => scan,
+        Err(err) => {
             return ValidationReport::corrupt(
                 path.to_path_buf(),
-                issue(
-                    "corrupt",
-                    &format!("frame header invalid: {err}"),
-                    last_good_seq,
-                    Some(offset as u64),
-                ),
-                last_good_seq,
-            );
-        }
-        match frame.state {
-            FrameState::Wrap => {
-                offset = 0;
-                steps += 1;
-                continue;
-            }
-            FrameState::Committed => {}
-            _ => {
-                return ValidationReport::corrupt(
-                    path.to_path_buf(),
-                    issue(
-                        "corrupt",
-                        "unexpected frame state",
-                        last_good_seq,
-                        Some(offset as u64),
-                    ),
-                    last_good_seq,
-                );
-            }
-        }
-
-        if frame.seq != expected_seq {
-            return ValidationReport::corrupt(
-                path.to_path_buf(),
-                issue(
-                    "corrupt",
-                    "seq mismatch",
-                    last_good_seq,
-                    Some(offset as u64),
-                ),
-                last_good_seq,
+                issue("corrupt", err.message().unwrap_or("corrupt"), None, None),
+                None,
             );
         }
-
-        let frame_len = match frame::frame_total_len(FRAME_HEADER_LEN, frame.payload_len as usize) {
-            Some(len) => len,
-            None => {
-                return ValidationReport::corrupt(
-                    path.to_path_buf(),
-                    issue(
-                        "corrupt",
-                        "frame length overflow",
-                        last_good_seq,
-                        Some(offset as u64),
-                    ),
-                    last_good_seq,
-                );
-            }
-        };
-        if offset + frame_len > ring_size {
-            return ValidationReport::corrupt(
-                path.to_path_buf(),
-                issue(
-                    "corrupt",
-                    "frame exceeds ring",
-                    last_good_seq,
-                    Some(offset as u64),
-                ),
+    };
+    let last_good_seq = scan.last_good_seq;
+    if let Some(fault) = scan.fault {
+        return ValidationReport::corrupt(
+            path.to_path_buf(),
+            issue(
+                "corrupt",
+                &fault.message,
                 last_good_seq,
-            );
-        }
-        let mut next_off = offset + frame_len;
-        if next_off == ring_size {
-            next_off = 0;
-        }
-
-        last_good_seq = Some(frame.seq);
-
-        if expected_seq == header.newest_seq {
-            if next_off != head {
-                return ValidationReport::corrupt(
-                    path.to_path_buf(),
-                    issue(
-                        "corrupt",
-                        "head offset mismatch",
-                        last_good_seq,
-                        Some(offset as u64),
-                    ),
-                    last_good_seq,
-                );
-            }
-            break;
-        }
-
-        expected_seq += 1;
-        offset = next_off;
-        steps += 1;
+                Some(fault.offset as u64),
+            ),
+            last_good_seq,
+        );
     }
+    let tag_bloom_mismatch = scan
+        .chunks
+        .into_iter()
+        .flatten()
+        .reduce(|(first_seq, count), (_, more)| (first_seq, count + more));
 
     let mut report = ValidationReport::ok(path.to_path_buf()).set_last_good(last_good_seq);
     for warning in spot_check_index_warnings(header, mmap) {
         report.remediation_hints.push(format!("warning: {warning}"));
     }
+    if let Some((first_seq, count)) = tag_bloom_mismatch {
+        report.remediation_hints.push(format!(
+            "warning: tag bloom mismatch on {count} frame(s) starting at seq {first_seq}; tag filters may skip them"
+        ));
+    }
     report
 }
 
@@ -355,6 +271,8 @@ fn spot_check_index_warnings(header: PoolHeader, mmap: &[u8]) -> Vec<String> {
 #[cfg(test)]
 mod tests {
     use super::{ValidationStatus, validate_pool_state_report};
+    use crate::core::frame;
+    use crate::core::lite3;
     use crate::core::pool::{Pool, PoolOptions};
 
     #[test]
@@ -364,7 +282,7 @@ mod tests {
         let pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
         let header = pool.header_from_mmap().expect("header");
 
-        let report = validate_pool_state_report(header, pool.mmap(), &path);
+        let report = validate_pool_state_report(header, pool.mmap(), pool.codec(), &path);
         assert_eq!(report.status, ValidationStatus::Ok);
         assert_eq!(report.issue_count, 0);
         assert!(report.issues.is_empty());
@@ -372,6 +290,78 @@ mod tests {
         assert_eq!(report.path, path);
     }
 
+    #[test]
+    fn validation_report_warns_on_tag_bloom_mismatch() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let path = temp.path().join("bloom.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let payload = lite3::encode_message(&["ops".to_string()], &serde_json::json!({"x": 1}))
+            .expect("payload");
+        pool.append(payload.as_slice()).expect("append");
+        let header = pool.header_from_mmap().expect("header");
+
+        let report = validate_pool_state_report(header, pool.mmap(), pool.codec(), &path);
+        assert!(report.remediation_hints.is_empty());
+
+        let mut bytes = pool.mmap().to_vec();
+        let bloom_off = header.ring_offset as usize + 44;
+        let stale = frame::tag_bloom(["billing"]).to_le_bytes();
+        bytes[bloom_off..bloom_off + 8].copy_from_slice(&stale);
+        let report = validate_pool_state_report(header, &bytes, pool.codec(), &path);
+        assert_eq!(report.status, ValidationStatus::Ok);
+        assert!(report.remediation_hints[0].contains("tag bloom mismatch"));
+    }
+
+    #[test]
+    fn validation_report_flags_invalid_lite3_payload() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let path = temp.path().join("payload.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        pool.append(payload.as_slice()).expect("append");
+        pool.append(b"not lite3").expect("append raw");
+        let header = pool.header_from_mmap().expect("header");
+
+        let report = validate_pool_state_report(header, pool.mmap(), pool.codec(), &path);
+        assert_eq!(report.status, ValidationStatus::Corrupt);
+        assert_eq!(report.last_good_seq, Some(1));
+        assert!(
+            report.issues[0]
+                .message
+                .starts_with("invalid lite3 payload")
+        );
+        assert_eq!(report.issues[0].seq, Some(1));
+    }
+
+    #[test]
+    fn validation_report_checks_compressed_payloads() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let path = temp.path().join("compressed.plasmite");
+        let options = PoolOptions::new(1024 * 1024)
+            .with_compression(crate::core::compress::Compression::zstd());
+        let mut pool = Pool::create(&path, options).expect("create");
+        let payload = lite3::encode_message(
+            &["ops".to_string()],
+            &serde_json::json!({"note": "x".repeat(1024)}),
+        )
+        .expect("payload");
+        pool.append(payload.as_slice()).expect("append");
+        pool.append(&b"not lite3 ".repeat(64)).expect("append raw");
+        for seq in [1, 2] {
+            assert!(pool.get(seq).expect("get").is_compressed());
+        }
+        let header = pool.header_from_mmap().expect("header");
+
+        let report = validate_pool_state_report(header, pool.mmap(), pool.codec(), &path);
+        assert_eq!(report.status, ValidationStatus::Corrupt);
+        assert_eq!(report.last_good_seq, Some(1));
+        assert!(
+            report.issues[0]
+                .message
+                .starts_with("invalid lite3 payload")
+        );
+    }
+
     #[test]
     fn validation_report_marks_corrupt_header() {
         let temp = tempfile::tempdir().expect("tempdir");
@@ -380,7 +370,7 @@ mod tests {
         let mut header = pool.header_from_mmap().expect("header");
         header.ring_size = 0;
 
-        let report = validate_pool_state_report(header, pool.mmap(), &path);
+        let report = validate_pool_state_report(header, pool.mmap(), pool.codec(), &path);
         assert_eq!(report.status, ValidationStatus::Corrupt);
         assert_eq!(report.issue_count, 1);
         assert_eq!(report.issues.len(), 1);
@@ -1,23 +1,40 @@
 //! Purpose: Benchmark harness for core operations and multi-process contention scenarios.
 //! Exports: `run_bench`, `run_worker`, `BenchArgs`, `BenchFormat`, `WorkerArgs`, `WorkerRole`.
+//! Exports: `RegressionThresholds`, `SCENARIOS`.
 //! Role: Dev-only runner used by the `plasmite-bench` binary (not shipped to end users).
 //! Invariants: Uses child processes to exercise cross-process file locking and follow semantics.
 //! Invariants: Intended for trend tracking; not lab-grade profiling.
+//! Invariants: Latencies go through HDR-style histograms; paced writers stamp intended send
+//! times so follow latency is corrected for coordinated omission.
+//! Invariants: Serve and CLI scenarios drive the real `plasmite` binary; absent binary = skipped.
 #![allow(clippy::result_large_err)]
 
+#[path = "bench_baseline.rs"]
+mod baseline;
+#[path = "bench_hdr.rs"]
+mod hdr;
+
 use std::collections::BTreeMap;
+use std::ffi::{CStr, CString, c_char};
 use std::fmt;
-use std::io::{self, Write};
+use std::io::{self, BufRead, BufReader, Write};
+use std::net::TcpListener;
 use std::path::{Path, PathBuf};
-use std::process::{Command, Stdio};
+use std::process::{Child, Command, Stdio};
+use std::sync::{Arc, Barrier};
 use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 
 use serde_json::{Value, json};
 
 use plasmite::api::{
-    AppendOptions, Cursor, CursorResult, Durability, Error, ErrorKind, Pool, PoolOptions, lite3,
+    AppendOptions, Cursor, CursorResult, Durability, Error, ErrorKind, Pool, PoolOptions, PoolRef,
+    RemoteClient, TailOptions, lite3,
 };
 
+pub use baseline::RegressionThresholds;
+use baseline::{BaselineReport, compare_to_baseline};
+use hdr::LatencyHistogram;
+
 #[derive(Clone, Debug)]
 pub struct BenchArgs {
     pub work_dir: Option<PathBuf>,
@@ -27,6 +44,19 @@ pub struct BenchArgs {
     pub writers: Vec<usize>,
     pub format: BenchFormat,
     pub durabilities: Vec<Durability>,
+    /// Scenario names to run (see `SCENARIOS`); empty runs all of them.
+    pub scenarios: Vec<String>,
+    /// Subscriber counts for the `tail_fanout` scenario.
+    pub subscribers: Vec<usize>,
+    /// Paced writer rate (messages/second) for `follow_paced` and `tail_fanout`.
+    pub follow_rate: u64,
+    pub large_payload_sizes: Vec<usize>,
+    pub large_messages: u64,
+    /// `plasmite` binary for serve/CLI scenarios (default: next to the bench executable).
+    pub plasmite_bin: Option<PathBuf>,
+    pub baseline: Option<PathBuf>,
+    pub save_baseline: Option<PathBuf>,
+    pub thresholds: RegressionThresholds,
 }
 
 #[derive(Clone, Copy, Debug, Eq, PartialEq)]
@@ -58,6 +88,8 @@ pub struct WorkerArgs {
     pub payload_bytes: usize,
     pub out_json: PathBuf,
     pub durability: Durability,
+    /// Writer pacing in messages/second; 0 appends as fast as possible.
+    pub rate: u64,
 }
 
 #[derive(Clone, Copy, Debug, Eq, PartialEq)]
@@ -77,15 +109,43 @@ impl WorkerRole {
     }
 }
 
+/// Scenario names accepted by `--scenario`, in run order.
+pub const SCENARIOS: &[&str] = &[
+    "append",
+    "follow",
+    "follow_paced",
+    "get",
+    "multi_writer",
+    "field_lookup",
+    "tail_fanout",
+    "tail_filtered",
+    "large_payload",
+    "cold_get",
+    "abi_stream",
+];
+
 pub fn run_bench(args: BenchArgs, program_version: &str) -> Result<(), Error> {
     let start = SystemTime::now();
     warn_if_debug_build()?;
+    for scenario in &args.scenarios {
+        if !SCENARIOS.contains(&scenario.as_str()) {
+            return Err(Error::new(ErrorKind::Usage)
+                .with_message(format!("unknown scenario: {scenario}"))
+                .with_hint(format!("Known scenarios: {}.", SCENARIOS.join(", "))));
+        }
+    }
+    let wants = |name: &str| args.scenarios.is_empty() || args.scenarios.iter().any(|s| s == name);
     let work_dir = args.work_dir.clone().unwrap_or_else(default_work_dir);
     std::fs::create_dir_all(&work_dir).map_err(|err| {
         Error::new(ErrorKind::Io)
             .with_path(&work_dir)
             .with_source(err)
     })?;
+    let baseline = args
+        .baseline
+        .as_deref()
+        .map(read_baseline_file)
+        .transpose()?;
 
     let rep_pool = *args
         .pool_sizes
@@ -115,58 +175,76 @@ pub fn run_bench(args: BenchArgs, program_version: &str) -> Result<(), Error> {
                 let base_name = format!("bench-{pool_size}-{payload_bytes}-{durability_label}");
                 let pool_path = work_dir.join(format!("{base_name}.plasmite"));
 
-                let append = bench_append(
-                    &pool_path,
-                    *pool_size,
-                    *payload_bytes,
-                    args.messages,
-                    *durability,
-                )?;
-                results.extend(append);
-
-                let follow_local = bench_follow_local(
-                    &pool_path,
-                    *pool_size,
-                    *payload_bytes,
-                    args.messages,
-                    *durability,
-                )?;
-                results.push(follow_local);
-
-                let follow = bench_follow(
-                    &work_dir,
-                    &pool_path,
-                    *pool_size,
-                    *payload_bytes,
-                    args.messages,
-                    *durability,
-                )?;
-                results.push(follow);
-
-                let get_indexed = bench_get_scan(
-                    &pool_path,
-                    *pool_size,
-                    *payload_bytes,
-                    args.messages,
-                    *durability,
-                    None,
-                    "indexed",
-                )?;
-                results.extend(get_indexed);
-
-                let get_scan_only = bench_get_scan(
-                    &pool_path,
-                    *pool_size,
-                    *payload_bytes,
-                    args.messages,
-                    *durability,
-                    Some(0),
-                    "scan_only",
-                )?;
-                results.extend(get_scan_only);
+                if wants("append") {
+                    let append = bench_append(
+                        &pool_path,
+                        *pool_size,
+                        *payload_bytes,
+                        args.messages,
+                        *durability,
+                    )?;
+                    results.extend(append);
+                }
+
+                if wants("follow") {
+                    let follow_local = bench_follow_local(
+                        &pool_path,
+                        *pool_size,
+                        *payload_bytes,
+                        args.messages,
+                        *durability,
+                    )?;
+                    results.push(follow_local);
+
+                    let follow = bench_follow(
+                        &work_dir,
+                        &pool_path,
+                        (*pool_size, *payload_bytes),
+                        args.messages,
+                        *durability,
+                        0,
+                    )?;
+                    results.push(follow);
+                }
+
+                if wants("follow_paced") && args.follow_rate > 0 {
+                    let follow_paced = bench_follow(
+                        &work_dir,
+                        &pool_path,
+                        (*pool_size, *payload_bytes),
+                        args.messages,
+                        *durability,
+                        args.follow_rate,
+                    )?;
+                    results.push(follow_paced);
+                }
+
+                if wants("get") {
+                    let get_indexed = bench_get_scan(
+                        &pool_path,
+                        *pool_size,
+                        *payload_bytes,
+                        args.messages,
+                        *durability,
+                        None,
+                        "indexed",
+                    )?;
+                    results.extend(get_indexed);
+
+                    let get_scan_only = bench_get_scan(
+                        &pool_path,
+                        *pool_size,
+                        *payload_bytes,
+                        args.messages,
+                        *durability,
+                        Some(0),
+                        "scan_only",
+                    )?;
+                    results.extend(get_scan_only);
+                }
 
                 for writers in &args.writers {
-                    if *writers <= 1 {
+                    if !wants("multi_writer") || *writers <= 1 {
                         continue;
                     }
                     if *durability == Durability::Flush && rep_writers != Some(*writers) {
@@ -187,7 +265,72 @@ pub fn run_bench(args: BenchArgs, program_version: &str) -> Result<(), Error> {
         }
     }
 
-    let output = json!({
+    if wants("field_lookup") {
+        results.extend(bench_field_lookup(rep_pool, args.messages)?);
+    }
+
+    // Workload scenarios run once, at the representative pool/payload size.
+    let mut skipped = Vec::new();
+    let plasmite_bin = resolve_plasmite_bin(args.plasmite_bin.as_deref())?;
+    for scenario in ["tail_fanout", "tail_filtered"] {
+        if !wants(scenario) {
+            continue;
+        }
+        let Some(bin) = plasmite_bin.as_deref() else {
+            skipped.push(json!({
+                "scenario": scenario,
+                "reason": "plasmite binary not found (build it or pass --plasmite-bin)",
+            }));
+            continue;
+        };
+        if scenario == "tail_fanout" {
+            let serve = ServeProcess::start(bin, &work_dir.join("serve"))?;
+            for subscribers in &args.subscribers {
+                results.push(bench_tail_fanout(
+                    &serve,
+                    (rep_pool, rep_payload),
+                    args.messages,
+                    *subscribers,
+                    args.follow_rate,
+                )?);
+            }
+        } else {
+            results.extend(bench_tail_filtered(
+                &work_dir,
+                bin,
+                (rep_pool, rep_payload),
+                args.messages,
+            )?);
+        }
+    }
+    if !skipped.is_empty() {
+        warn_skipped(&skipped)?;
+    }
+    if wants("large_payload") {
+        results.extend(bench_large_payload(
+            &work_dir,
+            &args.large_payload_sizes,
+            args.large_messages,
+        )?);
+    }
+    if wants("cold_get") {
+        results.push(bench_cold_get(
+            &work_dir.join("cold-get.plasmite"),
+            rep_pool,
+            rep_payload,
+            args.messages,
+        )?);
+    }
+    if wants("abi_stream") {
+        results.push(bench_abi_stream(
+            &work_dir,
+            rep_pool,
+            rep_payload,
+            args.messages,
+        )?);
+    }
+
+    let mut output = json!({
         "name": "plasmite",
         "version": program_version,
         "ts": rfc3339_now(start),
@@ -207,14 +350,46 @@ pub fn run_bench(args: BenchArgs, program_version: &str) -> Result<(), Error> {
                 "payload_bytes": rep_payload,
                 "multi_writer_writers": rep_writers.map(|value| value as u64),
             },
+            "scenarios": if args.scenarios.is_empty() {
+                SCENARIOS.iter().map(|name| name.to_string()).collect::<Vec<_>>()
+            } else {
+                args.scenarios.clone()
+            },
+            "subscribers": args.subscribers,
+            "follow_rate": args.follow_rate,
+            "large_payload_sizes": args.large_payload_sizes,
+            "large_messages": args.large_messages,
             "work_dir": work_dir.display().to_string(),
             "debug_build": cfg!(debug_assertions),
             "build_profile": if cfg!(debug_assertions) { "debug" } else { "release" },
         },
         "results": results,
+        "skipped": skipped,
     });
 
-    emit_bench_output(output, args.format)
+    if let Some(path) = &args.save_baseline {
+        write_json_file(path, &output)?;
+    }
+    let Some(baseline) = baseline else {
+        return emit_bench_output(output, args.format);
+    };
+    let report = compare_to_baseline(&output, &baseline, args.thresholds)?;
+    if let Value::Object(map) = &mut output {
+        map.insert("baseline".to_string(), report.value.clone());
+    }
+    emit_bench_output(output, args.format)?;
+    if args.format != BenchFormat::Json {
+        emit_baseline_table(&report)?;
+    }
+    if report.regressions.is_empty() {
+        return Ok(());
+    }
+    Err(Error::new(ErrorKind::Internal)
+        .with_message(format!(
+            "{} benchmark regression(s) exceed thresholds",
+            report.regressions.len()
+        ))
+        .with_hint(report.regressions.join("; ")))
 }
 
 fn warn_if_debug_build() -> Result<(), Error> {
@@ -336,8 +511,8 @@ fn emit_table(value: &Value) -> Result<(), Error> {
             })?;
             writeln!(
                 stderr,
-                "{:>16}  {:>6}  {:>7}  {:>10}  {:>10}  {:>8}  notes",
-                "scenario", "dur", "writers", "ms/msg", "msgs/s", "x_fast"
+                "{:>16}  {:>6}  {:>7}  {:>10}  {:>10}  {:>8}  {:>9}  notes",
+                "scenario", "dur", "writers", "ms/msg", "msgs/s", "x_fast", "p99_ms"
             )
             .map_err(|err| {
                 Error::new(ErrorKind::Io)
@@ -360,15 +535,20 @@ fn emit_table(value: &Value) -> Result<(), Error> {
             .unwrap_or_else(|| "-".to_string());
 
         let (ms_display, msgs_display) = format_rate(row.ms_per_msg, row.msgs_per_sec);
+        let p99_display = row
+            .p99_ms
+            .map(|p99| format!("{p99:.3}"))
+            .unwrap_or_else(|| "-".to_string());
         writeln!(
             stderr,
-            "{:>16}  {:>6}  {:>7}  {:>10}  {:>10}  {:>8}  {}",
+            "{:>16}  {:>6}  {:>7}  {:>10}  {:>10}  {:>8}  {:>9}  {}",
             row.scenario(),
             row.durability,
             row.writers,
             ms_display,
             msgs_display,
             rel,
+            p99_display,
             row.notes_label()
         )
         .map_err(|err| {
@@ -390,6 +570,7 @@ struct BenchRow {
     durability: String,
     ms_per_msg: f64,
     msgs_per_sec: f64,
+    p99_ms: Option<f64>,
     notes: String,
 }
 
@@ -403,6 +584,10 @@ impl BenchRow {
             durability: value.get("durability")?.as_str()?.to_string(),
             ms_per_msg: value.get("ms_per_msg")?.as_f64()?,
             msgs_per_sec: value.get("msgs_per_sec")?.as_f64()?,
+            p99_ms: value
+                .get("latency_ms")
+                .and_then(|latency| latency.get("p99"))
+                .and_then(|v| v.as_f64()),
             notes: value
                 .get("notes")
                 .and_then(|v| v.as_str())
@@ -442,12 +627,18 @@ impl BenchRow {
             "follow" => {
                 if self.notes.contains("single-process") {
                     "follow:local".to_string()
+                } else if self.notes.contains("paced") {
+                    "follow:paced".to_string()
                 } else if self.notes.contains("cross-process") {
                     "follow:xproc".to_string()
                 } else {
                     "follow".to_string()
                 }
             }
+            "tail_fanout" => format!("fanout:{}", self.notes_label()),
+            "tail_filtered" => format!("tail:{}", self.notes_label()),
+            "large_payload" => format!("large:{}", self.notes_label()),
+            "cold_get" => format!("cold_get:{}", self.notes_label()),
             other => other.to_string(),
         }
     }
@@ -481,6 +672,14 @@ impl BenchRow {
                     self.notes.clone()
                 }
             }
+            // `key=value, ...` notes: the first value names the variant.
+            "tail_fanout" | "tail_filtered" | "large_payload" | "cold_get" => self
+                .notes
+                .split(',')
+                .next()
+                .and_then(|part| part.split_once('='))
+                .map(|(_, value)| value.trim().to_string())
+                .unwrap_or_else(|| self.notes.clone()),
             _ => self.notes.clone(),
         }
     }
@@ -559,6 +758,35 @@ fn bench_append(
         "append",
     );
 
+    let _ = std::fs::remove_file(pool_path);
+    let mut pool = Pool::create(pool_path, PoolOptions::new(pool_size))?;
+    pool.acquire_writer_lease()?;
+
+    let start = Instant::now();
+    for _ in 0..messages {
+        append_with_durability(&mut pool, payload_once.as_slice(), durability)?;
+    }
+    let dur = start.elapsed();
+    drop(pool);
+    let leased = result_entry(
+        "append",
+        pool_size,
+        payload_bytes,
+        messages,
+        1,
+        dur,
+        durability,
+        Some("core payload reused, exclusive writer lease"),
+    );
+    let leased = with_runtime_metadata(
+        leased,
+        "feed_append_core_leased",
+        "single_process",
+        "payload_reused",
+        "none",
+        "append",
+    );
+
     let _ = std::fs::remove_file(pool_path);
     let mut pool = Pool::create(pool_path, PoolOptions::new(pool_size))?;
 
@@ -588,7 +816,7 @@ fn bench_append(
         "append",
     );
 
-    Ok(vec![core, end_to_end])
+    Ok(vec![core, leased, end_to_end])
 }
 
 fn bench_follow_local(
@@ -608,16 +836,14 @@ fn bench_follow_local(
 
     let mut cursor = Cursor::new();
     let start = Instant::now();
-    let mut latencies_ms = Vec::new();
+    let mut latency = LatencyHistogram::new();
     let mut seen = 0u64;
     loop {
         match cursor.next(&pool)? {
             CursorResult::Message(frame) => {
                 let data = decode_payload_data(frame.payload)?;
                 if let Some(sent_ns) = data.sent_ns {
-                    let now = now_ns()?;
-                    let delta = now.saturating_sub(sent_ns);
-                    latencies_ms.push(delta as f64 / 1_000_000.0);
+                    latency.record(now_ns()?.saturating_sub(sent_ns));
                 }
                 seen += 1;
                 if data.done {
@@ -630,7 +856,6 @@ fn bench_follow_local(
     }
 
     let dur = start.elapsed();
-    latencies_ms.sort_by(|a, b| a.partial_cmp(b).unwrap_or(std::cmp::Ordering::Equal));
     let dur_secs = dur.as_secs_f64().max(1e-9);
     let dur_ms = dur_secs * 1000.0;
     let ms_per_msg = if seen == 0 { 0.0 } else { dur_ms / seen as f64 };
@@ -664,10 +889,7 @@ fn bench_follow_local(
     entry.insert("ms_per_msg".to_string(), json!(ms_per_msg));
     entry.insert("msgs_per_sec".to_string(), json!(msgs_per_sec));
     entry.insert("mb_per_sec".to_string(), json!(mb_per_sec));
-    entry.insert(
-        "latency_ms".to_string(),
-        json!(latency_summary(&latencies_ms)),
-    );
+    entry.insert("latency_ms".to_string(), latency.summary_ms());
     entry.insert(
         "notes".to_string(),
         json!("single-process: prewritten decode"),
@@ -676,20 +898,21 @@ fn bench_follow_local(
     Ok(Value::Object(entry.into_iter().collect()))
 }
 
+/// Cross-process follow; `rate > 0` paces the writer and measures from intended send times.
 fn bench_follow(
     work_dir: &Path,
     pool_path: &Path,
-    pool_size: u64,
-    payload_bytes: usize,
+    (pool_size, payload_bytes): (u64, usize),
     messages: u64,
     durability: Durability,
+    rate: u64,
 ) -> Result<Value, Error> {
     let _ = std::fs::remove_file(pool_path);
     Pool::create(pool_path, PoolOptions::new(pool_size))?;
 
     let durability_tag = durability_label(durability);
-    let follower_out = work_dir.join(format!("follow-follower-{durability_tag}.json"));
-    let writer_out = work_dir.join(format!("follow-writer-{durability_tag}.json"));
+    let follower_out = work_dir.join(format!("follow-follower-{durability_tag}-{rate}.json"));
+    let writer_out = work_dir.join(format!("follow-writer-{durability_tag}-{rate}.json"));
 
     let mut follower = spawn_worker(WorkerArgs {
         pool_path: pool_path.to_path_buf(),
@@ -698,6 +921,7 @@ fn bench_follow(
         payload_bytes,
         out_json: follower_out.clone(),
         durability,
+        rate: 0,
     })?;
 
     let mut writer = spawn_worker(WorkerArgs {
@@ -707,6 +931,7 @@ fn bench_follow(
         payload_bytes,
         out_json: writer_out.clone(),
         durability,
+        rate,
     })?;
 
     let writer_status = writer.wait().map_err(|err| {
@@ -754,7 +979,14 @@ fn bench_follow(
 
     let mut entry = BTreeMap::new();
     entry.insert("bench".to_string(), json!("follow"));
-    entry.insert("lane".to_string(), json!("follow_cross_process"));
+    entry.insert(
+        "lane".to_string(),
+        json!(if rate > 0 {
+            "follow_cross_process_paced"
+        } else {
+            "follow_cross_process"
+        }),
+    );
     entry.insert("runtime_path".to_string(), json!("follow_cursor"));
     entry.insert("process_mode".to_string(), json!("cross_process"));
     entry.insert("encode_mode".to_string(), json!("lite3_encode_per_msg"));
@@ -771,14 +1003,25 @@ fn bench_follow(
     entry.insert("ms_per_msg".to_string(), json!(ms_per_msg));
     entry.insert("msgs_per_sec".to_string(), json!(msgs_per_sec));
     entry.insert("mb_per_sec".to_string(), json!(mb_per_sec));
-    entry.insert(
-        "latency_ms".to_string(),
-        follower_json
-            .get("latency_ms")
-            .cloned()
-            .unwrap_or(json!({})),
-    );
-    entry.insert("notes".to_string(), json!("cross-process: writer+follower"));
+    for key in ["latency_ms", "latency_ms_raw"] {
+        if let Some(summary) = follower_json.get(key) {
+            entry.insert(key.to_string(), summary.clone());
+        }
+    }
+    if rate > 0 {
+        entry.insert("rate".to_string(), json!(rate));
+        entry.insert(
+            "coordinated_omission".to_string(),
+            json!("intended_send_time"),
+        );
+        entry.insert(
+            "notes".to_string(),
+            json!(format!("cross-process: paced writer {rate}/s")),
+        );
+    } else {
+        entry.insert("coordinated_omission".to_string(), json!("uncorrected"));
+        entry.insert("notes".to_string(), json!("cross-process: writer+follower"));
+    }
     entry.insert("writer".to_string(), writer_json);
 
     Ok(Value::Object(entry.into_iter().collect()))
@@ -852,6 +1095,58 @@ fn bench_get_scan(
     Ok(out)
 }
 
+/// Lookups per benchmark message for `field_lookup`; single lookups are too short to time.
+const FIELD_LOOKUPS_PER_MESSAGE: u64 = 64;
+
+fn bench_field_lookup(pool_size: u64, messages: u64) -> Result<Vec<Value>, Error> {
+    let lookups = messages.max(1) * FIELD_LOOKUPS_PER_MESSAGE;
+    let kernel = lite3::node_search_kernel();
+    let mut out = Vec::new();
+    // 7 keys fill exactly one B-tree node; 64 keys force multi-level node walks.
+    for key_count in [7usize, 64] {
+        let keys = (0..key_count)
+            .map(|index| format!("field_{index:02}"))
+            .collect::<Vec<_>>();
+        let data = keys
+            .iter()
+            .enumerate()
+            .map(|(index, key)| (key.clone(), json!(index)))
+            .collect::<serde_json::Map<_, _>>();
+        let payload = lite3::encode_message(&["bench".to_string()], &Value::Object(data))?;
+        let doc = payload.as_doc();
+        let data_ofs = doc.key_offset("data")?;
+
+        let start = Instant::now();
+        let mut checksum = 0i64;
+        for step in 0..lookups {
+            let key = &keys[step as usize % key_count];
+            checksum = checksum.wrapping_add(doc.i64_at_key(data_ofs, key)?);
+        }
+        std::hint::black_box(checksum);
+        let dur = start.elapsed();
+
+        let entry = result_entry(
+            "field_lookup",
+            pool_size,
+            payload.len(),
+            lookups,
+            1,
+            dur,
+            Durability::Fast,
+            Some(&format!("{kernel}:keys={key_count}")),
+        );
+        out.push(with_runtime_metadata(
+            entry,
+            "lite3_field_lookup",
+            "single_process",
+            "none",
+            "lite3_native",
+            "node_search",
+        ));
+    }
+    Ok(out)
+}
+
 fn bench_multi_writer(
     work_dir: &Path,
     pool_path: &Path,
@@ -877,6 +1172,7 @@ fn bench_multi_writer(
             payload_bytes,
             out_json,
             durability,
+            rate: 0,
         })?);
     }
 
@@ -912,14 +1208,729 @@ fn bench_multi_writer(
     ))
 }
 
+/// `plasmite serve` child bound to a free loopback port; killed on drop.
+struct ServeProcess {
+    child: Child,
+    base_url: String,
+    pool_dir: PathBuf,
+}
+
+impl ServeProcess {
+    fn start(bin: &Path, pool_dir: &Path) -> Result<Self, Error> {
+        std::fs::create_dir_all(pool_dir).map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_path(pool_dir)
+                .with_source(err)
+        })?;
+        let port = TcpListener::bind("127.0.0.1:0")
+            .and_then(|listener| listener.local_addr())
+            .map(|addr| addr.port())
+            .map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to pick a serve port")
+                    .with_source(err)
+            })?;
+        let bind = format!("127.0.0.1:{port}");
+        let child = Command::new(bin)
+            .arg("--dir")
+            .arg(pool_dir)
+            .arg("serve")
+            .arg("--bind")
+            .arg(&bind)
+            .stdin(Stdio::null())
+            .stdout(Stdio::null())
+            .stderr(Stdio::null())
+            .spawn()
+            .map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to spawn plasmite serve")
+                    .with_path(bin)
+                    .with_source(err)
+            })?;
+        let mut serve = Self {
+            child,
+            base_url: format!("http://{bind}"),
+            pool_dir: pool_dir.to_path_buf(),
+        };
+        serve.wait_ready()?;
+        Ok(serve)
+    }
+
+    fn wait_ready(&mut self) -> Result<(), Error> {
+        let url = format!("{}/healthz", self.base_url);
+        let deadline = Instant::now() + Duration::from_secs(10);
+        loop {
+            if ureq::get(&url)
+                .call()
+                .is_ok_and(|response| response.status() == 200)
+            {
+                return Ok(());
+            }
+            let exited = self.child.try_wait().map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("serve wait failed")
+                    .with_source(err)
+            })?;
+            if exited.is_some() || Instant::now() > deadline {
+                return Err(
+                    Error::new(ErrorKind::Internal).with_message("plasmite serve did not start")
+                );
+            }
+            std::thread::sleep(Duration::from_millis(20));
+        }
+    }
+}
+
+impl Drop for ServeProcess {
+    fn drop(&mut self) {
+        let _ = self.child.kill();
+        let _ = self.child.wait();
+    }
+}
+
+/// HTTP JSON tail fan-out: one local writer, `subscribers` remote tails through `serve`.
+fn bench_tail_fanout(
+    serve: &ServeProcess,
+    (pool_size, payload_bytes): (u64, usize),
+    messages: u64,
+    subscribers: usize,
+    rate: u64,
+) -> Result<Value, Error> {
+    let name = format!("fanout-{subscribers}");
+    let pool_path = serve.pool_dir.join(format!("{name}.plasmite"));
+    let _ = std::fs::remove_file(&pool_path);
+    let mut pool = Pool::create(&pool_path, PoolOptions::new(pool_size))?;
+    let remote = RemoteClient::new(serve.base_url.clone())?.open_pool(&PoolRef::name(name))?;
+
+    // Every subscriber holds an open tail before the first append.
+    let ready = Arc::new(Barrier::new(subscribers + 1));
+    let mut handles = Vec::new();
+    for _ in 0..subscribers {
+        let remote = remote.clone();
+        let ready = ready.clone();
+        handles.push(std::thread::spawn(move || {
+            let mut options = TailOptions::new();
+            options.max_messages = Some(messages as usize);
+            options.timeout = Some(Duration::from_secs(300));
+            let tail = remote.tail(options);
+            ready.wait();
+            let mut tail = tail?;
+            let mut latency = LatencyHistogram::new();
+            while let Some(message) = tail.next_message()? {
+                let now = now_ns()?;
+                if let Some(sent_ns) = message.data.get("sent_ns").and_then(Value::as_u64) {
+                    latency.record(now.saturating_sub(sent_ns));
+                }
+                if message.data.get("done").and_then(Value::as_bool) == Some(true) {
+                    break;
+                }
+            }
+            Ok::<_, Error>((latency, Instant::now()))
+        }));
+    }
+    ready.wait();
+
+    let start = Instant::now();
+    let mut pacer = (rate > 0).then(|| Pacer::new(rate)).transpose()?;
+    for i in 0..messages {
+        let is_done = i + 1 == messages;
+        let payload = match pacer.as_mut() {
+            Some(pacer) => {
+                let intended_ns = pacer.wait_next()?;
+                paced_payload_for_bytes(payload_bytes, intended_ns, now_ns()?, is_done)?
+            }
+            None => payload_for_bytes(payload_bytes, Some(now_ns()?), is_done)?,
+        };
+        append_with_durability(&mut pool, payload.as_slice(), Durability::Fast)?;
+    }
+
+    let mut latency = LatencyHistogram::new();
+    let mut finished = Instant::now();
+    for handle in handles {
+        let (subscriber_latency, done_at) = handle.join().map_err(|_| {
+            Error::new(ErrorKind::Internal).with_message("fanout subscriber panicked")
+        })??;
+        latency.merge(&subscriber_latency);
+        finished = finished.max(done_at);
+    }
+
+    let notes = if rate > 0 {
+        format!("subscribers={subscribers}, paced {rate}/s")
+    } else {
+        format!("subscribers={subscribers}, unpaced")
+    };
+    let entry = result_entry(
+        "tail_fanout",
+        pool_size,
+        payload_bytes,
+        latency.count(),
+        1,
+        finished - start,
+        Durability::Fast,
+        Some(&notes),
+    );
+    let mut entry = with_runtime_metadata(
+        entry,
+        "tail_http_fanout",
+        "cross_process",
+        "lite3_encode_per_msg",
+        "json_lines",
+        "serve_tail",
+    );
+    entry["subscribers"] = json!(subscribers);
+    entry["latency_ms"] = latency.summary_ms();
+    entry["coordinated_omission"] = json!(if rate > 0 {
+        "intended_send_time"
+    } else {
+        "uncorrected"
+    });
+    Ok(entry)
+}
+
+/// Filters run by `tail_filtered`: label plus extra `plasmite follow` arguments.
+const TAIL_FILTERS: &[(&str, &[&str])] = &[
+    ("none", &[]),
+    ("tag", &["--tag", "hit"]),
+    ("jq", &["--where", ".data.level == \"error\""]),
+    (
+        "tag+jq",
+        &["--tag", "hit", "--where", ".data.level == \"error\""],
+    ),
+];
+
+/// One message in this many matches the `tail_filtered` filters.
+const TAIL_FILTER_HIT_EVERY: u64 = 10;
+
+/// CLI `follow --since` over a prewritten pool, per filter; timing includes process startup.
+fn bench_tail_filtered(
+    work_dir: &Path,
+    plasmite_bin: &Path,
+    (pool_size, payload_bytes): (u64, usize),
+    messages: u64,
+) -> Result<Vec<Value>, Error> {
+    let pool_path = work_dir.join("tail-filtered.plasmite");
+    let _ = std::fs::remove_file(&pool_path);
+    let mut pool = Pool::create(&pool_path, PoolOptions::new(pool_size))?;
+    // Start a little before the first append so `--since` covers every frame.
+    let since = rfc3339_now(SystemTime::now() - Duration::from_secs(1));
+    let filler = filler_for_bytes(payload_bytes);
+    for i in 0..messages {
+        let is_done = i + 1 == messages;
+        let hit = is_done || i % TAIL_FILTER_HIT_EVERY == 0;
+        let tag = if hit { "hit" } else { "miss" };
+        let data = json!({
+            "level": if hit { "error" } else { "info" },
+            "n": i,
+            "done": is_done,
+            "filler": filler,
+        });
+        let payload = lite3::encode_message(&[tag.to_string()], &data)?;
+        append_with_durability(&mut pool, payload.as_slice(), Durability::Fast)?;
+    }
+    let bounds = pool.bounds()?;
+    let frames = match (bounds.oldest_seq, bounds.newest_seq) {
+        (Some(oldest), Some(newest)) => newest - oldest + 1,
+        _ => 0,
+    };
+    drop(pool);
+
+    let mut out = Vec::new();
+    for (label, filter_args) in TAIL_FILTERS {
+        let start = Instant::now();
+        let mut child = Command::new(plasmite_bin)
+            .arg("follow")
+            .arg(&pool_path)
+            .arg("--since")
+            .arg(&since)
+            .arg("--jsonl")
+            .arg("--timeout")
+            .arg("30s")
+            .args(*filter_args)
+            .stdin(Stdio::null())
+            .stdout(Stdio::piped())
+            .stderr(Stdio::null())
+            .spawn()
+            .map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to spawn plasmite follow")
+                    .with_path(plasmite_bin)
+                    .with_source(err)
+            })?;
+        let matched = match child.stdout.take() {
+            Some(stdout) => read_lines_until_done(stdout),
+            None => Err(Error::new(ErrorKind::Internal).with_message("follow stdout missing")),
+        };
+        let dur = start.elapsed();
+        let _ = child.kill();
+        let _ = child.wait();
+        let matched = matched?;
+
+        let entry = result_entry(
+            "tail_filtered",
+            pool_size,
+            payload_bytes,
+            frames,
+            1,
+            dur,
+            Durability::Fast,
+            Some(&format!("filter={label}")),
+        );
+        let mut entry = with_runtime_metadata(
+            entry,
+            "tail_filtered_cli",
+            "cross_process",
+            "lite3_encode_per_msg_setup",
+            "cli_jsonl",
+            "follow_since_scan",
+        );
+        entry["matched"] = json!(matched);
+        entry["filter_args"] = json!(filter_args);
+        out.push(entry);
+    }
+    let _ = std::fs::remove_file(&pool_path);
+    Ok(out)
+}
+
+/// Count output lines up to and including the one carrying `"done":true`.
+fn read_lines_until_done(stdout: impl io::Read) -> Result<u64, Error> {
+    const DONE_MARKERS: [&[u8]; 2] = [b"\"done\":true", b"\"done\": true"];
+    let mut reader = BufReader::new(stdout);
+    let mut line = Vec::new();
+    let mut lines = 0u64;
+    loop {
+        line.clear();
+        let read = reader.read_until(b'\n', &mut line).map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to read follow output")
+                .with_source(err)
+        })?;
+        if read == 0 {
+            return Err(Error::new(ErrorKind::Internal)
+                .with_message("plasmite follow exited before the final message"));
+        }
+        lines += 1;
+        let done = DONE_MARKERS
+            .iter()
+            .any(|marker| line.windows(marker.len()).any(|window| window == *marker));
+        if done {
+            return Ok(lines);
+        }
+    }
+}
+
+/// Pool capacity for `large_payload`, in frames of the payload size under test.
+const LARGE_PAYLOAD_POOL_FRAMES: u64 = 8;
+
+fn bench_large_payload(
+    work_dir: &Path,
+    payload_sizes: &[usize],
+    messages: u64,
+) -> Result<Vec<Value>, Error> {
+    let messages = messages.max(1);
+    let mut out = Vec::new();
+    for payload_bytes in payload_sizes {
+        let pool_path = work_dir.join(format!("large-{payload_bytes}.plasmite"));
+        let pool_size = (*payload_bytes as u64 * LARGE_PAYLOAD_POOL_FRAMES).max(1024 * 1024);
+        let _ = std::fs::remove_file(&pool_path);
+        let mut pool = Pool::create(&pool_path, PoolOptions::new(pool_size))?;
+        let payload = payload_for_bytes(*payload_bytes, None, false)?;
+
+        let start = Instant::now();
+        for _ in 0..messages {
+            append_with_durability(&mut pool, payload.as_slice(), Durability::Fast)?;
+        }
+        let dur = start.elapsed();
+        let entry = result_entry(
+            "large_payload",
+            pool_size,
+            *payload_bytes,
+            messages,
+            1,
+            dur,
+            Durability::Fast,
+            Some("op=append"),
+        );
+        out.push(with_runtime_metadata(
+            entry,
+            "feed_append_large",
+            "single_process",
+            "payload_reused",
+            "none",
+            "append",
+        ));
+
+        // Every retained frame, rendered to JSON the way `get` and text tails emit it.
+        let bounds = pool.bounds()?;
+        let (Some(oldest), Some(newest)) = (bounds.oldest_seq, bounds.newest_seq) else {
+            continue;
+        };
+        let mut scratch = Vec::new();
+        let start = Instant::now();
+        for seq in oldest..=newest {
+            let frame = pool.get(seq)?;
+            scratch.clear();
+            lite3::Lite3DocRef::new(frame.payload).write_json_at(0, &mut scratch)?;
+            std::hint::black_box(scratch.len());
+        }
+        let dur = start.elapsed();
+        let entry = result_entry(
+            "large_payload",
+            pool_size,
+            *payload_bytes,
+            newest - oldest + 1,
+            1,
+            dur,
+            Durability::Fast,
+            Some("op=get_json"),
+        );
+        out.push(with_runtime_metadata(
+            entry,
+            "fetch_get_large",
+            "single_process",
+            "none",
+            "lite3_to_json",
+            "index_lookup",
+        ));
+        drop(pool);
+        let _ = std::fs::remove_file(&pool_path);
+    }
+    Ok(out)
+}
+
+/// Direct-index slots for `cold_get`; targets sit before this window so every get scans.
+const COLD_GET_INDEX_CAPACITY: u32 = 64;
+const COLD_GET_SAMPLES: u64 = 16;
+
+/// Gets past the index, each from a freshly opened handle with the file evicted from cache.
+fn bench_cold_get(
+    pool_path: &Path,
+    pool_size: u64,
+    payload_bytes: usize,
+    messages: u64,
+) -> Result<Value, Error> {
+    let _ = std::fs::remove_file(pool_path);
+    let options = PoolOptions::new(pool_size).with_index_capacity(COLD_GET_INDEX_CAPACITY);
+    let mut pool = Pool::create(pool_path, options)?;
+    let payload_once = payload_for_bytes(payload_bytes, None, false)?;
+    for _ in 0..messages {
+        append_with_durability(&mut pool, payload_once.as_slice(), Durability::Fast)?;
+    }
+    let bounds = pool.bounds()?;
+    drop(pool);
+    let (Some(oldest), Some(newest)) = (bounds.oldest_seq, bounds.newest_seq) else {
+        return Err(Error::new(ErrorKind::Internal).with_message("cold_get pool is empty"));
+    };
+
+    let unindexed = newest
+        .saturating_sub(u64::from(COLD_GET_INDEX_CAPACITY))
+        .max(oldest)
+        - oldest;
+    let samples = COLD_GET_SAMPLES.min(unindexed.max(1));
+    let mut latency = LatencyHistogram::new();
+    let mut total = Duration::ZERO;
+    let mut dropped = true;
+    for step in 0..samples {
+        let seq = oldest + unindexed * step / samples;
+        dropped &= drop_page_cache(pool_path)?;
+        let pool = Pool::open(pool_path)?;
+        let start = Instant::now();
+        let frame = pool.get(seq)?;
+        std::hint::black_box(frame.payload.len());
+        let elapsed = start.elapsed();
+        total += elapsed;
+        latency.record(elapsed.as_nanos() as u64);
+    }
+
+    let cache = if dropped { "dropped" } else { "warm" };
+    let entry = result_entry(
+        "cold_get",
+        pool_size,
+        payload_bytes,
+        samples,
+        1,
+        total,
+        Durability::Fast,
+        Some(&format!("cache={cache}, index={COLD_GET_INDEX_CAPACITY}")),
+    );
+    let mut entry = with_runtime_metadata(
+        entry,
+        "fetch_get_cold",
+        "single_process",
+        "none",
+        "none",
+        "scan_lookup",
+    );
+    entry["latency_ms"] = latency.summary_ms();
+    Ok(entry)
+}
+
+/// Evict the pool file from the page cache; `false` where the platform cannot.
+#[cfg(target_os = "linux")]
+fn drop_page_cache(path: &Path) -> Result<bool, Error> {
+    use std::os::fd::AsRawFd;
+
+    let file = std::fs::File::open(path)
+        .map_err(|err| Error::new(ErrorKind::Io).with_path(path).with_source(err))?;
+    // Only clean pages are dropped, so write back what the appends dirtied first.
+    file.sync_all()
+        .map_err(|err| Error::new(ErrorKind::Io).with_path(path).with_source(err))?;
+    let rc = unsafe { libc::posix_fadvise(file.as_raw_fd(), 0, 0, libc::POSIX_FADV_DONTNEED) };
+    Ok(rc == 0)
+}
+
+#[cfg(not(target_os = "linux"))]
+fn drop_page_cache(_path: &Path) -> Result<bool, Error> {
+    Ok(false)
+}
+
+// C ABI mirrors of include/plasmite.h, limited to what `abi_stream` calls.
+#[repr(C)]
+struct PlsmClient {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+struct PlsmPool {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+struct PlsmLite3Stream {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+struct PlsmBuf {
+    data: *mut u8,
+    len: usize,
+}
+
+#[repr(C)]
+struct PlsmLite3Frame {
+    seq: u64,
+    timestamp_ns: u64,
+    flags: u32,
+    payload: PlsmBuf,
+}
+
+/// Leading fields of `plsm_error_t`; only ever read through ABI-owned pointers.
+#[repr(C)]
+struct PlsmError {
+    kind: i32,
+    message: *mut c_char,
+}
+
+unsafe extern "C" {
+    fn plsm_client_new(
+        pool_dir: *const c_char,
+        out_client: *mut *mut PlsmClient,
+        out_err: *mut *mut PlsmError,
+    ) -> i32;
+    fn plsm_client_free(client: *mut PlsmClient);
+    fn plsm_pool_open(
+        client: *mut PlsmClient,
+        pool_ref: *const c_char,
+        out_pool: *mut *mut PlsmPool,
+        out_err: *mut *mut PlsmError,
+    ) -> i32;
+    fn plsm_pool_free(pool: *mut PlsmPool);
+    fn plsm_lite3_stream_open(
+        pool: *mut PlsmPool,
+        since_seq: u64,
+        has_since: u32,
+        max_messages: u64,
+        has_max: u32,
+        timeout_ms: u64,
+        has_timeout: u32,
+        out_stream: *mut *mut PlsmLite3Stream,
+        out_err: *mut *mut PlsmError,
+    ) -> i32;
+    fn plsm_lite3_stream_next(
+        stream: *mut PlsmLite3Stream,
+        out_frame: *mut PlsmLite3Frame,
+        out_err: *mut *mut PlsmError,
+    ) -> i32;
+    fn plsm_lite3_stream_free(stream: *mut PlsmLite3Stream);
+    fn plsm_lite3_frame_free(frame: *mut PlsmLite3Frame);
+    fn plsm_error_free(err: *mut PlsmError);
+}
+
+/// ABI handles opened by `abi_stream`, released in reverse order on drop.
+struct AbiHandles {
+    client: *mut PlsmClient,
+    pool: *mut PlsmPool,
+    stream: *mut PlsmLite3Stream,
+}
+
+impl Drop for AbiHandles {
+    fn drop(&mut self) {
+        unsafe {
+            plsm_lite3_stream_free(self.stream);
+            plsm_pool_free(self.pool);
+            plsm_client_free(self.client);
+        }
+    }
+}
+
+/// Turn a negative ABI return code into an `Error`, consuming `*err`.
+fn abi_result(rc: i32, err: &mut *mut PlsmError, call: &str) -> Result<i32, Error> {
+    if rc >= 0 {
+        return Ok(rc);
+    }
+    let (kind, message) = if err.is_null() {
+        (ErrorKind::Internal, String::new())
+    } else {
+        let detail = unsafe {
+            let raw = &**err;
+            let message = if raw.message.is_null() {
+                String::new()
+            } else {
+                CStr::from_ptr(raw.message).to_string_lossy().into_owned()
+            };
+            (error_kind_from_abi(raw.kind), message)
+        };
+        unsafe { plsm_error_free(*err) };
+        *err = std::ptr::null_mut();
+        detail
+    };
+    Err(Error::new(kind).with_message(format!("{call} failed: {message}")))
+}
+
+fn error_kind_from_abi(code: i32) -> ErrorKind {
+    match code {
+        2 => ErrorKind::Usage,
+        3 => ErrorKind::NotFound,
+        4 => ErrorKind::AlreadyExists,
+        5 => ErrorKind::Busy,
+        6 => ErrorKind::Permission,
+        7 => ErrorKind::Corrupt,
+        8 => ErrorKind::Io,
+        _ => ErrorKind::Internal,
+    }
+}
+
+/// Prewritten pool drained through `plsm_lite3_stream_next`, one owned copy per frame.
+fn bench_abi_stream(
+    work_dir: &Path,
+    pool_size: u64,
+    payload_bytes: usize,
+    messages: u64,
+) -> Result<Value, Error> {
+    const POOL_NAME: &str = "abi-stream";
+    let pool_dir = work_dir.join("abi");
+    std::fs::create_dir_all(&pool_dir).map_err(|err| {
+        Error::new(ErrorKind::Io)
+            .with_path(&pool_dir)
+            .with_source(err)
+    })?;
+    let pool_path = pool_dir.join(format!("{POOL_NAME}.plasmite"));
+    let _ = std::fs::remove_file(&pool_path);
+    let mut pool = Pool::create(&pool_path, PoolOptions::new(pool_size))?;
+    let payload_once = payload_for_bytes(payload_bytes, None, false)?;
+    for _ in 0..messages {
+        append_with_durability(&mut pool, payload_once.as_slice(), Durability::Fast)?;
+    }
+    let bounds = pool.bounds()?;
+    drop(pool);
+    let retained = match (bounds.oldest_seq, bounds.newest_seq) {
+        (Some(oldest), Some(newest)) => newest - oldest + 1,
+        _ => 0,
+    };
+
+    let dir = CString::new(pool_dir.to_string_lossy().into_owned()).map_err(|err| {
+        Error::new(ErrorKind::Usage)
+            .with_message("work dir contains a NUL byte")
+            .with_source(err)
+    })?;
+    let name = CString::new(POOL_NAME).expect("pool name has no NUL");
+    let mut handles = AbiHandles {
+        client: std::ptr::null_mut(),
+        pool: std::ptr::null_mut(),
+        stream: std::ptr::null_mut(),
+    };
+    let mut err = std::ptr::null_mut();
+    let rc = unsafe { plsm_client_new(dir.as_ptr(), &mut handles.client, &mut err) };
+    abi_result(rc, &mut err, "plsm_client_new")?;
+    let rc = unsafe { plsm_pool_open(handles.client, name.as_ptr(), &mut handles.pool, &mut err) };
+    abi_result(rc, &mut err, "plsm_pool_open")?;
+    let rc = unsafe {
+        plsm_lite3_stream_open(
+            handles.pool,
+            0,
+            0,
+            retained,
+            1,
+            0,
+            0,
+            &mut handles.stream,
+            &mut err,
+        )
+    };
+    abi_result(rc, &mut err, "plsm_lite3_stream_open")?;
+
+    let mut frame = PlsmLite3Frame {
+        seq: 0,
+        timestamp_ns: 0,
+        flags: 0,
+        payload: PlsmBuf {
+            data: std::ptr::null_mut(),
+            len: 0,
+        },
+    };
+    let mut seen = 0u64;
+    let start = Instant::now();
+    loop {
+        let rc = unsafe { plsm_lite3_stream_next(handles.stream, &mut frame, &mut err) };
+        if abi_result(rc, &mut err, "plsm_lite3_stream_next")? == 0 {
+            break;
+        }
+        std::hint::black_box((frame.seq, frame.timestamp_ns, frame.flags));
+        std::hint::black_box((frame.payload.data, frame.payload.len));
+        seen += 1;
+        unsafe { plsm_lite3_frame_free(&mut frame) };
+    }
+    let dur = start.elapsed();
+    drop(handles);
+
+    let entry = result_entry(
+        "abi_stream",
+        pool_size,
+        payload_bytes,
+        seen,
+        1,
+        dur,
+        Durability::Fast,
+        Some("plsm_lite3_stream_next"),
+    );
+    Ok(with_runtime_metadata(
+        entry,
+        "abi_lite3_stream",
+        "single_process",
+        "none",
+        "none",
+        "abi_stream_next",
+    ))
+}
+
 fn run_writer_worker(args: WorkerArgs) -> Result<(), Error> {
     let mut pool = Pool::open(&args.pool_path)?;
 
     let start = Instant::now();
-    for i in 0..args.messages {
-        let is_done = i + 1 == args.messages;
-        let payload = payload_for_bytes(args.payload_bytes, Some(now_ns()? ^ i), is_done)?;
-        append_with_durability(&mut pool, payload.as_slice(), args.durability)?;
+    if args.rate > 0 {
+        let mut pacer = Pacer::new(args.rate)?;
+        for i in 0..args.messages {
+            let is_done = i + 1 == args.messages;
+            let intended_ns = pacer.wait_next()?;
+            let payload =
+                paced_payload_for_bytes(args.payload_bytes, intended_ns, now_ns()?, is_done)?;
+            append_with_durability(&mut pool, payload.as_slice(), args.durability)?;
+        }
+    } else {
+        for i in 0..args.messages {
+            let is_done = i + 1 == args.messages;
+            let payload = payload_for_bytes(args.payload_bytes, Some(now_ns()? ^ i), is_done)?;
+            append_with_durability(&mut pool, payload.as_slice(), args.durability)?;
+        }
     }
     let dur = start.elapsed();
 
@@ -929,6 +1940,7 @@ fn run_writer_worker(args: WorkerArgs) -> Result<(), Error> {
         "payload_bytes": args.payload_bytes,
         "duration_ms": dur.as_millis() as u64,
         "durability": durability_label(args.durability),
+        "rate": args.rate,
     });
     write_json_file(&args.out_json, &output)?;
     Ok(())
@@ -939,7 +1951,8 @@ fn run_follower_worker(args: WorkerArgs) -> Result<(), Error> {
 
     let mut cursor = Cursor::new();
     let start = Instant::now();
-    let mut latencies_ms = Vec::new();
+    let mut latency = LatencyHistogram::new();
+    let mut latency_raw = LatencyHistogram::new();
     let mut seen = 0u64;
     let deadline = start + Duration::from_secs(300);
 
@@ -950,10 +1963,12 @@ fn run_follower_worker(args: WorkerArgs) -> Result<(), Error> {
         match cursor.next(&pool)? {
             CursorResult::Message(frame) => {
                 let data = decode_payload_data(frame.payload)?;
+                let now = now_ns()?;
                 if let Some(sent_ns) = data.sent_ns {
-                    let now = now_ns()?;
-                    let delta = now.saturating_sub(sent_ns);
-                    latencies_ms.push(delta as f64 / 1_000_000.0);
+                    latency.record(now.saturating_sub(sent_ns));
+                }
+                if let Some(actual_ns) = data.actual_ns {
+                    latency_raw.record(now.saturating_sub(actual_ns));
                 }
                 seen += 1;
                 if data.done {
@@ -971,15 +1986,18 @@ fn run_follower_worker(args: WorkerArgs) -> Result<(), Error> {
     }
 
     let dur = start.elapsed();
-    latencies_ms.sort_by(|a, b| a.partial_cmp(b).unwrap_or(std::cmp::Ordering::Equal));
-    let output = json!({
+    let mut output = json!({
         "role": "follower",
         "messages_upper_bound": args.messages,
         "messages_seen": seen,
         "payload_bytes": args.payload_bytes,
         "duration_ms": dur.as_millis() as u64,
-        "latency_ms": latency_summary(&latencies_ms),
+        "latency_ms": latency.summary_ms(),
     });
+    // Paced writers stamp both times: `latency_ms` then counts from the intended send.
+    if latency_raw.count() > 0 {
+        output["latency_ms_raw"] = latency_raw.summary_ms();
+    }
     write_json_file(&args.out_json, &output)?;
     Ok(())
 }
@@ -987,6 +2005,8 @@ fn run_follower_worker(args: WorkerArgs) -> Result<(), Error> {
 #[derive(Clone, Copy, Debug, Default)]
 struct BenchPayloadData {
     sent_ns: Option<u64>,
+    /// Set by paced writers: when the append really started (`sent_ns` is the schedule).
+    actual_ns: Option<u64>,
     done: bool,
 }
 
@@ -1002,25 +2022,8 @@ fn decode_payload_data(payload: &[u8]) -> Result<BenchPayloadData, Error> {
         .key_offset("data")
         .map_err(|err| err.with_message("payload data missing"))?;
 
-    let sent_ns = match doc.type_at_key(data_ofs, "sent_ns") {
-        Ok(ty) if ty == lite3::sys::LITE3_TYPE_I64 => {
-            let value = doc
-                .i64_at_key(data_ofs, "sent_ns")
-                .map_err(|err| err.with_message("payload data.sent_ns must be i64"))?;
-            if value < 0 {
-                return Err(
-                    Error::new(ErrorKind::Corrupt).with_message("payload data.sent_ns must be u64")
-                );
-            }
-            Some(value as u64)
-        }
-        Ok(_) => {
-            return Err(
-                Error::new(ErrorKind::Corrupt).with_message("payload data.sent_ns must be u64")
-            );
-        }
-        Err(_) => None,
-    };
+    let sent_ns = optional_u64_at_key(&doc, data_ofs, "sent_ns")?;
+    let actual_ns = optional_u64_at_key(&doc, data_ofs, "actual_ns")?;
 
     let done = match doc.type_at_key(data_ofs, "done") {
         Ok(ty) if ty == lite3::sys::LITE3_TYPE_BOOL => doc
@@ -1034,7 +2037,35 @@ fn decode_payload_data(payload: &[u8]) -> Result<BenchPayloadData, Error> {
         Err(_) => false,
     };
 
-    Ok(BenchPayloadData { sent_ns, done })
+    Ok(BenchPayloadData {
+        sent_ns,
+        actual_ns,
+        done,
+    })
+}
+
+fn optional_u64_at_key(
+    doc: &lite3::Lite3DocRef<'_>,
+    data_ofs: usize,
+    key: &str,
+) -> Result<Option<u64>, Error> {
+    match doc.type_at_key(data_ofs, key) {
+        Ok(ty) if ty == lite3::sys::LITE3_TYPE_I64 => {
+            let value = doc
+                .i64_at_key(data_ofs, key)
+                .map_err(|err| err.with_message(format!("payload data.{key} must be i64")))?;
+            if value < 0 {
+                return Err(Error::new(ErrorKind::Corrupt)
+                    .with_message(format!("payload data.{key} must be u64")));
+            }
+            Ok(Some(value as u64))
+        }
+        Ok(_) => {
+            Err(Error::new(ErrorKind::Corrupt)
+                .with_message(format!("payload data.{key} must be u64")))
+        }
+        Err(_) => Ok(None),
+    }
 }
 
 fn payload_for_bytes(
@@ -1042,11 +2073,7 @@ fn payload_for_bytes(
     sent_ns: Option<u64>,
     done: bool,
 ) -> Result<lite3::Lite3Buf, Error> {
-    let mut filler = "x".repeat(payload_bytes.saturating_sub(32));
-    if filler.is_empty() {
-        filler = "x".to_string();
-    }
-
+    let filler = filler_for_bytes(payload_bytes);
     let data = match sent_ns {
         Some(ns) => json!({"sent_ns": ns, "done": done, "filler": filler}),
         None => json!({"filler": filler}),
@@ -1054,6 +2081,61 @@ fn payload_for_bytes(
     lite3::encode_message(&["bench".to_string()], &data)
 }
 
+fn paced_payload_for_bytes(
+    payload_bytes: usize,
+    intended_ns: u64,
+    actual_ns: u64,
+    done: bool,
+) -> Result<lite3::Lite3Buf, Error> {
+    let data = json!({
+        "sent_ns": intended_ns,
+        "actual_ns": actual_ns,
+        "done": done,
+        "filler": filler_for_bytes(payload_bytes),
+    });
+    lite3::encode_message(&["bench".to_string()], &data)
+}
+
+fn filler_for_bytes(payload_bytes: usize) -> String {
+    "x".repeat(payload_bytes.saturating_sub(32).max(1))
+}
+
+/// Open-loop schedule: message `i` is due at `start + i * interval`, whether or not the
+/// previous append was late, so writer stalls show up as latency instead of vanishing.
+struct Pacer {
+    start_ns: u64,
+    interval_ns: u64,
+    next: u64,
+}
+
+impl Pacer {
+    fn new(rate: u64) -> Result<Self, Error> {
+        Ok(Self {
+            start_ns: now_ns()?,
+            interval_ns: 1_000_000_000 / rate.max(1),
+            next: 0,
+        })
+    }
+
+    /// Block until the next slot is due and return its intended time.
+    fn wait_next(&mut self) -> Result<u64, Error> {
+        let intended_ns = self.start_ns + self.next * self.interval_ns;
+        self.next += 1;
+        loop {
+            let now = now_ns()?;
+            if now >= intended_ns {
+                return Ok(intended_ns);
+            }
+            let remaining = intended_ns - now;
+            if remaining > 2_000_000 {
+                std::thread::sleep(Duration::from_nanos(remaining - 1_000_000));
+            } else {
+                std::thread::yield_now();
+            }
+        }
+    }
+}
+
 fn spawn_worker(args: WorkerArgs) -> Result<std::process::Child, Error> {
     let exe = std::env::current_exe().map_err(|err| {
         Error::new(ErrorKind::Io)
@@ -1072,6 +2154,8 @@ fn spawn_worker(args: WorkerArgs) -> Result<std::process::Child, Error> {
         .arg(args.payload_bytes.to_string())
         .arg("--durability")
         .arg(durability_label(args.durability))
+        .arg("--rate")
+        .arg(args.rate.to_string())
         .arg("--out-json")
         .arg(&args.out_json)
         .stdin(Stdio::null())
@@ -1168,30 +2252,6 @@ fn result_entry(
     Value::Object(map.into_iter().collect())
 }
 
-fn latency_summary(sorted_ms: &[f64]) -> Value {
-    if sorted_ms.is_empty() {
-        return json!({});
-    }
-    json!({
-        "min": sorted_ms.first().copied().unwrap_or(0.0),
-        "p50": quantile(sorted_ms, 0.50),
-        "p95": quantile(sorted_ms, 0.95),
-        "max": sorted_ms.last().copied().unwrap_or(0.0),
-    })
-}
-
-fn quantile(sorted: &[f64], q: f64) -> f64 {
-    if sorted.is_empty() {
-        return 0.0;
-    }
-    let clamped = q.clamp(0.0, 1.0);
-    let idx = ((sorted.len() - 1) as f64 * clamped).round() as usize;
-    sorted
-        .get(idx)
-        .copied()
-        .unwrap_or_else(|| sorted[sorted.len() - 1])
-}
-
 fn system_json() -> Value {
     let cpus = std::thread::available_parallelism()
         .map(|n| n.get())
@@ -1212,6 +2272,84 @@ fn default_work_dir() -> PathBuf {
     PathBuf::from(".scratch").join(format!("plasmite-bench-{pid}-{ts}"))
 }
 
+/// Explicit `--plasmite-bin`, else `plasmite` beside the bench's target dir
+/// (`target/<profile>/examples/plasmite-bench` -> `target/<profile>/plasmite`).
+fn resolve_plasmite_bin(explicit: Option<&Path>) -> Result<Option<PathBuf>, Error> {
+    if let Some(path) = explicit {
+        if !path.is_file() {
+            return Err(Error::new(ErrorKind::NotFound)
+                .with_message("plasmite binary not found")
+                .with_path(path)
+                .with_hint("Build it with `cargo build --release --bin plasmite`."));
+        }
+        return Ok(Some(path.to_path_buf()));
+    }
+    let candidate = std::env::current_exe().ok().and_then(|exe| {
+        let profile_dir = exe.parent()?.parent()?;
+        Some(profile_dir.join(format!("plasmite{}", std::env::consts::EXE_SUFFIX)))
+    });
+    Ok(candidate.filter(|path| path.is_file()))
+}
+
+fn warn_skipped(skipped: &[Value]) -> Result<(), Error> {
+    let mut stderr = io::stderr().lock();
+    for item in skipped {
+        writeln!(
+            stderr,
+            "plasmite-bench: skipped {}: {}",
+            item["scenario"].as_str().unwrap_or("?"),
+            item["reason"].as_str().unwrap_or("")
+        )
+        .map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to write skipped scenario notice")
+                .with_source(err)
+        })?;
+    }
+    Ok(())
+}
+
+fn read_baseline_file(path: &Path) -> Result<Value, Error> {
+    let bytes = std::fs::read(path)
+        .map_err(|err| Error::new(ErrorKind::Io).with_path(path).with_source(err))?;
+    serde_json::from_slice(&bytes).map_err(|err| {
+        Error::new(ErrorKind::Usage)
+            .with_message("invalid baseline json")
+            .with_path(path)
+            .with_source(err)
+    })
+}
+
+fn emit_baseline_table(report: &BaselineReport) -> Result<(), Error> {
+    let compared = report
+        .value
+        .get("comparisons")
+        .and_then(|v| v.as_array())
+        .map_or(0, Vec::len);
+    let mut lines = vec![format!(
+        "baseline: {compared} comparisons, {} regression(s)",
+        report.regressions.len()
+    )];
+    lines.extend(
+        report
+            .regressions
+            .iter()
+            .map(|regression| format!("  REGRESSION {regression}")),
+    );
+    if report.value.get("params_match") == Some(&Value::Bool(false)) {
+        lines.push("  note: bench params differ from the baseline run".to_string());
+    }
+    let mut stderr = io::stderr().lock();
+    for line in lines {
+        writeln!(stderr, "{line}").map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to write baseline comparison")
+                .with_source(err)
+        })?;
+    }
+    Ok(())
+}
+
 fn now_ns() -> Result<u64, Error> {
     SystemTime::now()
         .duration_since(UNIX_EPOCH)
@@ -1263,6 +2401,7 @@ fn durability_label(durability: Durability) -> &'static str {
     match durability {
         Durability::Fast => "fast",
         Durability::Flush => "flush",
+        Durability::GroupCommit { .. } => "group",
     }
 }
 
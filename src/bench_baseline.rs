@@ -0,0 +1,183 @@
+//! Purpose: Compare a benchmark run against a stored baseline and flag regressions.
+//! Exports: `RegressionThresholds`, `BaselineReport`, `compare_to_baseline`.
+//! Role: Release-qualification gate behind `plasmite-bench --baseline`.
+//! Invariants: Rows match on scenario identity (bench, lane, sizes, writers, durability, notes).
+//! Invariants: Per-message time and p99 latency only fail when they get worse past a threshold.
+//! Invariants: Rows shorter than the noise floor in either run are reported, never failed.
+
+use std::collections::BTreeMap;
+
+use serde_json::{Value, json};
+
+use plasmite::api::{Error, ErrorKind};
+
+#[derive(Clone, Copy, Debug)]
+pub struct RegressionThresholds {
+    /// Allowed `ms_per_msg` increase, in percent.
+    pub max_time_pct: f64,
+    /// Allowed `latency_ms.p99` increase, in percent.
+    pub max_p99_pct: f64,
+    /// Rows whose `duration_ms` falls below this in either run are too short to judge.
+    pub noise_floor_ms: f64,
+}
+
+impl Default for RegressionThresholds {
+    fn default() -> Self {
+        Self {
+            max_time_pct: 10.0,
+            max_p99_pct: 25.0,
+            noise_floor_ms: 5.0,
+        }
+    }
+}
+
+#[derive(Clone, Debug)]
+pub struct BaselineReport {
+    pub value: Value,
+    pub regressions: Vec<String>,
+}
+
+pub fn compare_to_baseline(
+    current: &Value,
+    baseline: &Value,
+    thresholds: RegressionThresholds,
+) -> Result<BaselineReport, Error> {
+    let current_rows = rows_by_key(current)?;
+    let mut baseline_rows = rows_by_key(baseline)?;
+
+    let mut comparisons = Vec::new();
+    let mut regressions = Vec::new();
+    let mut new_rows = Vec::new();
+    for (key, row) in &current_rows {
+        let Some(base) = baseline_rows.remove(key) else {
+            new_rows.push(json!(key));
+            continue;
+        };
+        let noisy = [row, base].iter().any(|row| {
+            row.get("duration_ms")
+                .and_then(Value::as_f64)
+                .is_some_and(|ms| ms < thresholds.noise_floor_ms)
+        });
+        let metrics = [
+            (
+                "ms_per_msg",
+                metric(row, base, &["ms_per_msg"]),
+                thresholds.max_time_pct,
+            ),
+            (
+                "p99_ms",
+                metric(row, base, &["latency_ms", "p99"]),
+                thresholds.max_p99_pct,
+            ),
+        ];
+        for (name, values, limit) in metrics {
+            let Some((current_value, baseline_value)) = values else {
+                continue;
+            };
+            let change_pct = if baseline_value > 0.0 {
+                (current_value - baseline_value) / baseline_value * 100.0
+            } else {
+                0.0
+            };
+            let status = if noisy {
+                "noise"
+            } else if change_pct > limit {
+                regressions.push(format!("{key} {name} {change_pct:+.1}% (limit {limit}%)"));
+                "regressed"
+            } else if change_pct < -limit {
+                "improved"
+            } else {
+                "ok"
+            };
+            comparisons.push(json!({
+                "key": key,
+                "metric": name,
+                "baseline": baseline_value,
+                "current": current_value,
+                "change_pct": change_pct,
+                "status": status,
+            }));
+        }
+    }
+
+    let params_match = current.get("params").map(comparable_params)
+        == baseline.get("params").map(comparable_params);
+    let value = json!({
+        "baseline_version": baseline.get("version").cloned().unwrap_or(Value::Null),
+        "baseline_ts": baseline.get("ts").cloned().unwrap_or(Value::Null),
+        "params_match": params_match,
+        "thresholds": {
+            "max_time_pct": thresholds.max_time_pct,
+            "max_p99_pct": thresholds.max_p99_pct,
+            "noise_floor_ms": thresholds.noise_floor_ms,
+        },
+        "regressions": regressions.len(),
+        "comparisons": comparisons,
+        "missing": baseline_rows.keys().collect::<Vec<_>>(),
+        "new": new_rows,
+    });
+    Ok(BaselineReport { value, regressions })
+}
+
+fn rows_by_key(run: &Value) -> Result<BTreeMap<String, &Value>, Error> {
+    let results = run
+        .get("results")
+        .and_then(Value::as_array)
+        .ok_or_else(|| {
+            Error::new(ErrorKind::Usage)
+                .with_message("baseline json has no results array")
+                .with_hint(
+                    "Pass a file written by `plasmite-bench --format json` or --save-baseline.",
+                )
+        })?;
+    let mut out = BTreeMap::new();
+    for row in results {
+        if let Some(key) = row_key(row) {
+            out.insert(key, row);
+        }
+    }
+    Ok(out)
+}
+
+fn row_key(row: &Value) -> Option<String> {
+    let text = |field: &str| {
+        row.get(field)
+            .map(|value| match value {
+                Value::String(text) => text.clone(),
+                other => other.to_string(),
+            })
+            .unwrap_or_default()
+    };
+    row.get("bench")?;
+    Some(
+        [
+            "bench",
+            "lane",
+            "pool_size",
+            "payload_bytes",
+            "writers",
+            "durability",
+            "notes",
+        ]
+        .map(text)
+        .join("|"),
+    )
+}
+
+fn metric(row: &Value, base: &Value, path: &[&str]) -> Option<(f64, f64)> {
+    let lookup = |value: &Value| {
+        path.iter()
+            .try_fold(value, |value, key| value.get(*key))
+            .and_then(Value::as_f64)
+    };
+    Some((lookup(row)?, lookup(base)?))
+}
+
+/// Params that change what a row measures; the work dir differs on every run.
+fn comparable_params(params: &Value) -> Value {
+    let mut params = params.clone();
+    if let Value::Object(map) = &mut params {
+        map.remove("work_dir");
+    }
+    params
+}
@@ -0,0 +1,120 @@
+//! Purpose: HDR-style latency histogram for the benchmark harness.
+//! Exports: `LatencyHistogram`.
+//! Role: Fixed-memory replacement for sorted sample vectors in `bench.rs` latency reporting.
+//! Invariants: Values are nanoseconds; bucket widths keep relative error below 1/64 (~1.6%).
+//! Invariants: Quantiles report the highest value equivalent to the selected bucket (HDR rule).
+//! Invariants: Coordinated omission is the caller's job: paced writers stamp intended send times.
+
+use serde_json::{Value, json};
+
+/// Sub-buckets per power of two; values below this are recorded exactly.
+const SUB_BUCKETS: u64 = 128;
+const HALF_SUB_BUCKETS: u64 = SUB_BUCKETS / 2;
+const SUB_BUCKET_BITS: u32 = SUB_BUCKETS.trailing_zeros();
+
+#[derive(Clone, Debug, Default)]
+pub struct LatencyHistogram {
+    counts: Vec<u64>,
+    total: u64,
+    sum_ns: u128,
+    min_ns: u64,
+    max_ns: u64,
+}
+
+impl LatencyHistogram {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    pub fn record(&mut self, value_ns: u64) {
+        let index = bucket_index(value_ns);
+        if index >= self.counts.len() {
+            self.counts.resize(index + 1, 0);
+        }
+        self.counts[index] += 1;
+        if self.total == 0 || value_ns < self.min_ns {
+            self.min_ns = value_ns;
+        }
+        self.max_ns = self.max_ns.max(value_ns);
+        self.total += 1;
+        self.sum_ns += u128::from(value_ns);
+    }
+
+    pub fn merge(&mut self, other: &Self) {
+        if other.total == 0 {
+            return;
+        }
+        if other.counts.len() > self.counts.len() {
+            self.counts.resize(other.counts.len(), 0);
+        }
+        for (slot, count) in self.counts.iter_mut().zip(&other.counts) {
+            *slot += count;
+        }
+        if self.total == 0 || other.min_ns < self.min_ns {
+            self.min_ns = other.min_ns;
+        }
+        self.max_ns = self.max_ns.max(other.max_ns);
+        self.total += other.total;
+        self.sum_ns += other.sum_ns;
+    }
+
+    pub fn count(&self) -> u64 {
+        self.total
+    }
+
+    pub fn value_at_quantile(&self, q: f64) -> u64 {
+        if self.total == 0 {
+            return 0;
+        }
+        let rank = ((q.clamp(0.0, 1.0) * self.total as f64).ceil() as u64).max(1);
+        let mut seen = 0u64;
+        for (index, count) in self.counts.iter().enumerate() {
+            seen += count;
+            if seen >= rank {
+                return bucket_highest(index).clamp(self.min_ns, self.max_ns);
+            }
+        }
+        self.max_ns
+    }
+
+    /// Millisecond summary; keeps the `min/p50/p95/max` keys earlier bench output used.
+    pub fn summary_ms(&self) -> Value {
+        if self.total == 0 {
+            return json!({});
+        }
+        let ms = |ns: u64| ns as f64 / 1_000_000.0;
+        json!({
+            "count": self.total,
+            "min": ms(self.min_ns),
+            "mean": self.sum_ns as f64 / self.total as f64 / 1_000_000.0,
+            "p50": ms(self.value_at_quantile(0.50)),
+            "p90": ms(self.value_at_quantile(0.90)),
+            "p95": ms(self.value_at_quantile(0.95)),
+            "p99": ms(self.value_at_quantile(0.99)),
+            "p999": ms(self.value_at_quantile(0.999)),
+            "max": ms(self.max_ns),
+        })
+    }
+}
+
+/// Values below `SUB_BUCKETS` map to themselves; above, each power of two splits into 64
+/// equal sub-buckets indexed by the value's top seven bits.
+fn bucket_index(value: u64) -> usize {
+    let bits = u64::BITS - value.leading_zeros();
+    if bits <= SUB_BUCKET_BITS {
+        return value as usize;
+    }
+    let shift = bits - SUB_BUCKET_BITS;
+    (u64::from(shift) * HALF_SUB_BUCKETS + (value >> shift)) as usize
+}
+
+fn bucket_highest(index: usize) -> u64 {
+    let index = index as u64;
+    if index < SUB_BUCKETS {
+        return index;
+    }
+    let shift = index / HALF_SUB_BUCKETS - 1;
+    let mantissa = index - shift * HALF_SUB_BUCKETS;
+    // The top bucket's bound is 2^64, which wraps to u64::MAX after the subtraction.
+    ((mantissa + 1) << shift).wrapping_sub(1)
+}
@@ -137,6 +137,12 @@ pub(super) fn dispatch_command(
                 names,
                 size,
                 index_capacity,
+                shards,
+                compress,
+                compress_dict,
+                preallocate,
+                prefault,
+                huge_pages,
                 json,
             } => {
                 let client = LocalClient::new().with_pool_dir(&pool_dir);
@@ -145,6 +151,29 @@ pub(super) fn dispatch_command(
                     .map(parse_size)
                     .transpose()?
                     .unwrap_or(DEFAULT_POOL_SIZE);
+                let compression = match (compress, compress_dict) {
+                    (false, _) => None,
+                    (true, None) => Some(Compression::zstd()),
+                    (true, Some(dict_path)) => {
+                        let dictionary = std::fs::read(&dict_path).map_err(|err| {
+                            Error::new(ErrorKind::Io)
+                                .with_message("failed to read compression dictionary")
+                                .with_path(&dict_path)
+                                .with_source(err)
+                        })?;
+                        Some(Compression::zstd().with_dictionary(dictionary))
+                    }
+                };
+                let mut residency = Residency::new();
+                if preallocate {
+                    residency = residency.with_preallocation();
+                }
+                if prefault {
+                    residency = residency.with_prefault();
+                }
+                if huge_pages {
+                    residency = residency.with_huge_pages();
+                }
                 ensure_pool_dir(&pool_dir)?;
                 let mut results = Vec::new();
                 for name in names {
@@ -157,7 +186,7 @@ pub(super) fn dispatch_command(
                                 "Choose a different name or remove the existing pool file.",
                             ));
                     }
-                    let mut options = PoolOptions::new(size);
+                    let mut options = PoolOptions::new(size).with_residency(residency);
                     if let Some(index_capacity) = index_capacity {
                         let index_size_bytes = index_capacity as u64 * 16;
                         if index_size_bytes > size / 2 {
@@ -169,7 +198,18 @@ pub(super) fn dispatch_command(
                         }
                         options = options.with_index_capacity(index_capacity);
                     }
+                    if let Some(compression) = &compression {
+                        options = options.with_compression(compression.clone());
+                    }
                     let pool_ref = PoolRef::path(path.clone());
+                    if let Some(shards) = shards {
+                        let infos = client.create_pool_group(&pool_ref, shards, options)?;
+                        for (shard, info) in infos.iter().enumerate() {
+                            let label = pool_group_shard_label(&name, shard);
+                            results.push(pool_info_json(&label, info));
+                        }
+                        continue;
+                    }
                     let info = client.create_pool(&pool_ref, options)?;
                     results.push(pool_info_json(&name, &info));
                 }
@@ -183,7 +223,16 @@ pub(super) fn dispatch_command(
             PoolCommand::Info { name, json } => {
                 let client = LocalClient::new().with_pool_dir(&pool_dir);
                 let path = resolve_poolref(&name, &pool_dir)?;
-                let pool_ref = PoolRef::path(path);
+                let pool_ref = PoolRef::path(path.clone());
+                if PoolGroup::is_group(&path) {
+                    let shards = client.open_pool_group(&pool_ref)?.info()?;
+                    if json {
+                        emit_json(pool_group_info_json(&name, &path, &shards), color_mode);
+                    } else {
+                        emit_pool_group_info_pretty(&name, &shards);
+                    }
+                    return Ok(RunOutcome::ok());
+                }
                 let info = client.pool_info(&pool_ref).map_err(|err| {
                     if err.kind() == ErrorKind::NotFound {
                         let base = Error::new(ErrorKind::NotFound).with_message("not found");
@@ -386,6 +435,7 @@ pub(super) fn dispatch_command(
             retry_delay,
             input,
             errors,
+            workers,
             token,
             token_file,
             tls_ca,
@@ -404,6 +454,16 @@ pub(super) fn dispatch_command(
                     .with_message("--retry-delay requires --retry")
                     .with_hint("Add --retry or remove --retry-delay."));
             }
+            if workers == 0 {
+                return Err(Error::new(ErrorKind::Usage)
+                    .with_message("--workers must be at least 1")
+                    .with_hint("Use --workers 1 for sequential ingest."));
+            }
+            if workers > 1 && input != InputMode::Jsonl {
+                return Err(Error::new(ErrorKind::Usage)
+                    .with_message("--workers requires --in jsonl")
+                    .with_hint("Add --in jsonl, or remove --workers for other input modes."));
+            }
             let durability = parse_durability(&durability)?;
             let retry_config = parse_retry_config(retry, retry_delay.as_deref())?;
             if data_arg.is_some() && file_arg.is_some() {
@@ -486,12 +546,13 @@ pub(super) fn dispatch_command(
                                     color_mode,
                                     input,
                                     errors,
+                                    workers,
                                 },
                                 true,
                             )?
                         } else if stdin_stream {
                             ingest_from_stdin(
-                                io::stdin().lock(),
+                                io::stdin(),
                                 FeedIngestContext {
                                     pool_ref: &pool,
                                     pool_path_label: &pool_path_label,
@@ -502,6 +563,7 @@ pub(super) fn dispatch_command(
                                     color_mode,
                                     input,
                                     errors,
+                                    workers,
                                 },
                                 true,
                             )?
@@ -525,6 +587,11 @@ pub(super) fn dispatch_command(
                             .with_message("remote feed does not support --create")
                             .with_hint("Create remote pools with server-side tooling, not feed."));
                     }
+                    if workers > 1 {
+                        return Err(Error::new(ErrorKind::Usage)
+                            .with_message("remote feed does not support --workers")
+                            .with_hint("Remove --workers; it applies to local pools only."));
+                    }
                     let token_value = resolve_token_value(token, token_file)?;
                     let mut client = RemoteClient::new(base_url)?;
                     if let Some(token_value) = token_value {
@@ -604,7 +671,11 @@ pub(super) fn dispatch_command(
             let frame = pool_handle
                 .get(seq)
                 .map_err(|err| add_missing_seq_hint(err, &pool))?;
-            emit_json(message_from_frame(&frame)?, color_mode);
+            let payload = pool_handle.frame_payload(&frame)?;
+            emit_json(
+                message_from_frame(&frame.with_payload(&payload))?,
+                color_mode,
+            );
             Ok(RunOutcome::ok())
         }
         Command::Tap {
@@ -692,10 +763,18 @@ pub(super) fn dispatch_command(
             }
 
             let start_time = Instant::now();
-            let (event_tx, event_rx) = mpsc::channel();
-            let stdout_reader =
-                tap_spawn_reader(child_stdout, TapStream::Stdout, !quiet, event_tx.clone());
-            let stderr_reader = tap_spawn_reader(child_stderr, TapStream::Stderr, !quiet, event_tx);
+            // The reader threads encode their own lines; this thread commits them in arrival
+            // order, appending whatever is already queued under one lock.
+            let (event_tx, event_rx) = mpsc::sync_channel(TAP_QUEUE_LINES);
+            let stdout_reader = tap_spawn_reader(
+                child_stdout,
+                TapStream::Stdout,
+                !quiet,
+                tag.clone(),
+                event_tx.clone(),
+            );
+            let stderr_reader =
+                tap_spawn_reader(child_stderr, TapStream::Stderr, !quiet, tag, event_tx);
 
             let mut reader_error: Option<Error> = None;
             let mut child_status = None;
@@ -703,25 +782,19 @@ pub(super) fn dispatch_command(
 
             while child_status.is_none() {
                 match event_rx.recv_timeout(Duration::from_millis(25)) {
-                    Ok(TapEvent::Line { stream, raw_line }) => {
-                        line_count = line_count.saturating_add(1);
-                        if let Err(err) = tap_append_message(
+                    Ok(event) => {
+                        match tap_commit_events(
                             &mut pool_handle,
                             durability,
-                            &tag,
-                            &json!({
-                                "kind": "line",
-                                "stream": stream.as_str(),
-                                "line": trim_tap_line_endings(&raw_line),
-                            }),
+                            event,
+                            &event_rx,
+                            &mut reader_error,
                         ) {
-                            tap_terminate_child(&mut child);
-                            return Err(err);
-                        }
-                    }
-                    Ok(TapEvent::ReaderError(err)) => {
-                        if reader_error.is_none() {
-                            reader_error = Some(err);
+                            Ok(lines) => line_count = line_count.saturating_add(lines),
+                            Err(err) => {
+                                tap_terminate_child(&mut child);
+                                return Err(err);
+                            }
                         }
                     }
                     Err(mpsc::RecvTimeoutError::Timeout) => {}
@@ -735,6 +808,18 @@ pub(super) fn dispatch_command(
             }
 
             let child_status = child_status.expect("status set once loop exits");
+            // Readers block on the bounded queue, so drain it until both have hung up before
+            // joining them.
+            while let Ok(event) = event_rx.recv() {
+                let lines = tap_commit_events(
+                    &mut pool_handle,
+                    durability,
+                    event,
+                    &event_rx,
+                    &mut reader_error,
+                )?;
+                line_count = line_count.saturating_add(lines);
+            }
             if stdout_reader.join().is_err() && reader_error.is_none() {
                 reader_error = Some(
                     Error::new(ErrorKind::Internal).with_message("tap stdout reader panicked"),
@@ -746,29 +831,6 @@ pub(super) fn dispatch_command(
                 );
             }
 
-            while let Ok(event) = event_rx.try_recv() {
-                match event {
-                    TapEvent::Line { stream, raw_line } => {
-                        line_count = line_count.saturating_add(1);
-                        tap_append_message(
-                            &mut pool_handle,
-                            durability,
-                            &tag,
-                            &json!({
-                                "kind": "line",
-                                "stream": stream.as_str(),
-                                "line": trim_tap_line_endings(&raw_line),
-                            }),
-                        )?;
-                    }
-                    TapEvent::ReaderError(err) => {
-                        if reader_error.is_none() {
-                            reader_error = Some(err);
-                        }
-                    }
-                }
-            }
-
             if let Some(err) = reader_error {
                 return Err(err);
             }
@@ -1004,7 +1066,7 @@ pub(super) fn dispatch_command(
                             let pool_path_label = path.display().to_string();
                             let mut send_pool = send_pool;
                             let outcome = ingest_from_stdin(
-                                io::stdin().lock(),
+                                io::stdin(),
                                 FeedIngestContext {
                                     pool_ref: &pool_ref,
                                     pool_path_label: &pool_path_label,
@@ -1015,6 +1077,7 @@ pub(super) fn dispatch_command(
                                     color_mode,
                                     input: InputMode::Auto,
                                     errors: ErrorPolicyCli::Stop,
+                                    workers: 1,
                                 },
                                 false,
                             );
@@ -1170,6 +1233,8 @@ pub(super) fn dispatch_command(
             since,
             where_expr,
             tags,
+            readahead,
+            release_behind,
             replay,
             token,
             token_file,
@@ -1195,6 +1260,8 @@ pub(super) fn dispatch_command(
                 .transpose()?;
             let timeout_input = timeout.as_deref();
             let timeout = timeout_input.map(parse_duration).transpose()?;
+            let residency =
+                parse_follow_residency(readahead.as_deref(), release_behind.as_deref())?;
             let exact_follow_create_hint = follow_exact_create_command_hint(
                 &pool,
                 tail,
@@ -1256,11 +1323,14 @@ pub(super) fn dispatch_command(
                                 ));
                         }
                     }
-                    let pool_handle = match Pool::open(&path) {
+                    let pool_handle = match Pool::open_with(&path, residency) {
                         Ok(pool_handle) => pool_handle,
                         Err(err) if create && err.kind() == ErrorKind::NotFound => {
                             ensure_pool_dir(&pool_dir)?;
-                            Pool::create(&path, PoolOptions::new(DEFAULT_POOL_SIZE))?
+                            Pool::create(
+                                &path,
+                                PoolOptions::new(DEFAULT_POOL_SIZE).with_residency(residency),
+                            )?
                         }
                         Err(err) => {
                             return Err(add_missing_pool_create_hint(
@@ -1293,6 +1363,15 @@ pub(super) fn dispatch_command(
                                 "Create remote pools with server-side tooling, then rerun follow.",
                             ));
                     }
+                    if residency != Residency::default() {
+                        return Err(Error::new(ErrorKind::Usage)
+                            .with_message(
+                                "remote follow does not support --readahead or --release-behind",
+                            )
+                            .with_hint(
+                                "Residency flags tune a local mapping; drop them for remote refs.",
+                            ));
+                    }
                     let token_value = resolve_token_value(token, token_file)?;
                     let mut client = RemoteClient::new(base_url)?;
                     if let Some(token_value) = token_value {
@@ -1335,8 +1414,14 @@ impl TapStream {
     }
 }
 
+/// Lines a tap reader may queue ahead of the committing thread before it blocks.
+const TAP_QUEUE_LINES: usize = 1024;
+/// Most lines `tap_commit_events` appends under one lock.
+const TAP_MAX_BATCH_LINES: usize = 256;
+
 enum TapEvent {
-    Line { stream: TapStream, raw_line: String },
+    /// One output line, already encoded as a tap `line` message.
+    Line(Result<lite3::Lite3Buf, Error>),
     ReaderError(Error),
 }
 
@@ -1353,6 +1438,45 @@ fn tap_append_message(
     Ok(())
 }
 
+/// Appends `first` plus the lines already queued behind it (up to `TAP_MAX_BATCH_LINES`) with
+/// one `append_batch`, returning how many lines were committed. Reader errors are kept in
+/// `reader_error`; an encode error is returned after the lines before it are committed.
+fn tap_commit_events(
+    pool: &mut Pool,
+    durability: Durability,
+    first: TapEvent,
+    events: &mpsc::Receiver<TapEvent>,
+    reader_error: &mut Option<Error>,
+) -> Result<u64, Error> {
+    let mut payloads = Vec::new();
+    let mut encode_error = None;
+    let mut next = Some(first);
+    while let Some(event) = next.take() {
+        match event {
+            TapEvent::Line(Ok(payload)) => payloads.push(payload),
+            TapEvent::Line(Err(err)) => {
+                encode_error = Some(err);
+                break;
+            }
+            TapEvent::ReaderError(err) => {
+                reader_error.get_or_insert(err);
+            }
+        }
+        if payloads.len() < TAP_MAX_BATCH_LINES {
+            next = events.try_recv().ok();
+        }
+    }
+    if !payloads.is_empty() {
+        let slices: Vec<&[u8]> = payloads.iter().map(lite3::Lite3Buf::as_slice).collect();
+        let options = AppendOptions::new(now_ns()?, durability);
+        pool.append_batch(&slices, options)?;
+    }
+    match encode_error {
+        Some(err) => Err(err),
+        None => Ok(payloads.len() as u64),
+    }
+}
+
 fn trim_tap_line_endings(raw_line: &str) -> String {
     raw_line.trim_end_matches(['\r', '\n']).to_string()
 }
@@ -1361,7 +1485,8 @@ fn tap_spawn_reader<R>(
     reader: R,
     stream: TapStream,
     passthrough: bool,
-    tx: mpsc::Sender<TapEvent>,
+    tags: Vec<String>,
+    tx: mpsc::SyncSender<TapEvent>,
 ) -> std::thread::JoinHandle<()>
 where
     R: Read + Send + 'static,
@@ -1402,10 +1527,15 @@ where
                             }
                         }
                     }
-                    let _ = tx.send(TapEvent::Line {
-                        stream,
-                        raw_line: line.clone(),
-                    });
+                    let payload = lite3::encode_message(
+                        &tags,
+                        &json!({
+                            "kind": "line",
+                            "stream": stream.as_str(),
+                            "line": trim_tap_line_endings(&line),
+                        }),
+                    );
+                    let _ = tx.send(TapEvent::Line(payload));
                 }
                 Err(err) => {
                     let _ = tx.send(TapEvent::ReaderError(
@@ -0,0 +1,446 @@
+//! Purpose: Group commit: a background thread per pool file msyncs the ranges that concurrent
+//! `Durability::GroupCommit` appends dirtied, coalesced into one pass per batch.
+//! Exports: `CommitHandle`, `DEFAULT_GROUP_COMMIT_DELAY`, `DEFAULT_GROUP_COMMIT_BYTES`.
+//! Role: `Pool` submits an append's dirty spans before releasing the append lock and waits on
+//! the returned handle after, so appenders queue behind one shared flush, not behind the lock.
+//! Invariants: One committer per pool file (device and inode) per process, shared by every
+//! Invariants: handle on it; appenders in other processes flush through their own.
+//! Invariants: A pool deleted and recreated at the same path gets a new committer.
+//! Invariants: A ticket is durable once every span submitted up to it, then the header, synced.
+//! Invariants: A failed flush poisons the committer: later tickets fail, earlier ones stay durable.
+//! Invariants: Dropping the last handle on a pool flushes what is pending before the thread exits.
+use std::collections::HashMap;
+use std::fs::File;
+use std::io;
+use std::path::{Path, PathBuf};
+use std::sync::{Arc, Condvar, LazyLock, Mutex, MutexGuard, PoisonError, Weak};
+use std::thread::{self, JoinHandle};
+use std::time::{Duration, Instant};
+
+use memmap2::MmapMut;
+
+use crate::core::error::{Error, ErrorKind};
+use crate::core::metrics::{Counter, HeaderMetrics};
+use crate::core::pool::HEADER_SIZE;
+
+/// Longest an append waits for other appends to join its flush (`Durability::group_commit`).
+pub const DEFAULT_GROUP_COMMIT_DELAY: Duration = Duration::from_millis(2);
+/// Dirty bytes that start a flush before the delay runs out (`Durability::group_commit`).
+pub const DEFAULT_GROUP_COMMIT_BYTES: u64 = 1024 * 1024;
+/// Spans closer than this are flushed as one range; msync skips clean pages in between.
+const MERGE_GAP: usize = 64 * 1024;
+
+static COMMITTERS: LazyLock<Mutex<HashMap<FileKey, Weak<GroupCommitter>>>> =
+    LazyLock::new(|| Mutex::new(HashMap::new()));
+
+/// Registry key for a pool file. An identity tied to the open file, not its path, keeps a
+/// recreated pool from being flushed through the old file's mapping.
+#[derive(Clone, Debug, Eq, Hash, PartialEq)]
+enum FileKey {
+    #[cfg(unix)]
+    Inode { dev: u64, ino: u64 },
+    #[cfg(not(unix))]
+    Path(PathBuf),
+}
+
+impl FileKey {
+    #[cfg(unix)]
+    fn of(_path: &Path, file: &File) -> io::Result<Self> {
+        use std::os::unix::fs::MetadataExt;
+        let meta = file.metadata()?;
+        Ok(Self::Inode {
+            dev: meta.dev(),
+            ino: meta.ino(),
+        })
+    }
+
+    #[cfg(not(unix))]
+    fn of(path: &Path, _file: &File) -> io::Result<Self> {
+        Ok(Self::Path(
+            std::fs::canonicalize(path).unwrap_or_else(|_| path.to_path_buf()),
+        ))
+    }
+}
+
+/// Completion of one append's flush. Handles from `Durability::Fast` and `Durability::Flush`
+/// appends are complete on return; group-commit handles complete when the flusher syncs them.
+#[derive(Clone, Debug, Default)]
+pub struct CommitHandle {
+    ticket: Option<(Arc<Shared>, u64)>,
+}
+
+impl CommitHandle {
+    pub(crate) fn done() -> Self {
+        Self::default()
+    }
+
+    /// Whether the append is on disk (or never asked to be). Does not block.
+    pub fn is_durable(&self) -> bool {
+        match &self.ticket {
+            None => true,
+            Some((shared, ticket)) => shared.lock().durable >= *ticket,
+        }
+    }
+
+    /// Block until the flush covering the append completes. Fails if that flush, or any flush
+    /// before it on the same pool, failed.
+    pub fn wait(&self) -> Result<(), Error> {
+        let Some((shared, ticket)) = &self.ticket else {
+            return Ok(());
+        };
+        let mut state = shared.lock();
+        loop {
+            if state.durable >= *ticket {
+                return Ok(());
+            }
+            if let Some((kind, message)) = &state.failure {
+                return Err(Error::new(ErrorKind::Io)
+                    .with_message("group commit flush failed")
+                    .with_path(&shared.path)
+                    .with_hint("Reopen the pool; recent appends may not be on disk.")
+                    .with_source(io::Error::new(*kind, message.clone())));
+            }
+            state = shared
+                .done
+                .wait(state)
+                .unwrap_or_else(PoisonError::into_inner);
+        }
+    }
+}
+
+#[derive(Debug)]
+struct Shared {
+    path: PathBuf,
+    state: Mutex<State>,
+    /// Signaled when a submit may move the flush earlier, and on shutdown.
+    work: Condvar,
+    /// Signaled after every flush attempt.
+    done: Condvar,
+}
+
+impl Shared {
+    fn lock(&self) -> MutexGuard<'_, State> {
+        self.state.lock().unwrap_or_else(PoisonError::into_inner)
+    }
+}
+
+#[derive(Debug)]
+struct State {
+    /// `(start, end)` byte ranges of the file dirtied since the last flush began.
+    spans: Vec<(usize, usize)>,
+    pending_bytes: u64,
+    /// Earliest `submit time + max_delay` among pending appends; `None` when nothing is pending.
+    deadline: Option<Instant>,
+    /// Smallest `max_bytes` among pending appends.
+    byte_limit: u64,
+    /// Tickets handed out; ticket `n` is the `n`th submit.
+    submitted: u64,
+    /// Every ticket up to this one is on disk.
+    durable: u64,
+    failure: Option<(io::ErrorKind, String)>,
+    shutdown: bool,
+}
+
+/// The flusher thread for one pool file and the queue of spans waiting on it.
+#[derive(Debug)]
+pub(crate) struct GroupCommitter {
+    shared: Arc<Shared>,
+    thread: Option<JoinHandle<()>>,
+}
+
+impl GroupCommitter {
+    /// The committer for the pool file `file` (opened at `path`), starting one that maps it if
+    /// none is running.
+    pub(crate) fn for_pool(path: &Path, file: &File) -> Result<Arc<Self>, Error> {
+        let key = FileKey::of(path, file).map_err(|err| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to stat pool file for group commit")
+                .with_path(path)
+                .with_source(err)
+        })?;
+        let mut committers = COMMITTERS.lock().unwrap_or_else(PoisonError::into_inner);
+        if let Some(existing) = committers.get(&key).and_then(Weak::upgrade) {
+            return Ok(existing);
+        }
+        committers.retain(|_, committer| committer.strong_count() > 0);
+
+        let mmap = unsafe {
+            MmapMut::map_mut(file).map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to mmap pool file for group commit")
+                    .with_path(path)
+                    .with_source(err)
+            })?
+        };
+        let shared = Arc::new(Shared {
+            path: path.to_path_buf(),
+            state: Mutex::new(State {
+                spans: Vec::new(),
+                pending_bytes: 0,
+                deadline: None,
+                byte_limit: u64::MAX,
+                submitted: 0,
+                durable: 0,
+                failure: None,
+                shutdown: false,
+            }),
+            work: Condvar::new(),
+            done: Condvar::new(),
+        });
+        let thread = thread::Builder::new()
+            .name("plasmite-commit".to_string())
+            .spawn({
+                let shared = Arc::clone(&shared);
+                move || run(&shared, &mmap)
+            })
+            .map_err(|err| {
+                Error::new(ErrorKind::Io)
+                    .with_message("failed to start group commit thread")
+                    .with_path(path)
+                    .with_source(err)
+            })?;
+        let committer = Arc::new(Self {
+            shared,
+            thread: Some(thread),
+        });
+        committers.insert(key, Arc::downgrade(&committer));
+        Ok(committer)
+    }
+
+    /// Queue `(start, end)` ranges already written to the file. The flush starts within
+    /// `max_delay`, or as soon as `max_bytes` are pending, whichever comes first.
+    pub(crate) fn submit(
+        &self,
+        spans: impl IntoIterator<Item = (usize, usize)>,
+        max_delay: Duration,
+        max_bytes: u64,
+    ) -> CommitHandle {
+        let mut state = self.shared.lock();
+        let was_bytes = state.pending_bytes;
+        for (start, end) in spans {
+            state.pending_bytes += (end - start) as u64;
+            state.spans.push((start, end));
+        }
+        let deadline = Instant::now() + max_delay;
+        let sooner = state.deadline.is_none_or(|pending| deadline < pending);
+        if sooner {
+            state.deadline = Some(deadline);
+        }
+        state.byte_limit = state.byte_limit.min(max_bytes);
+        let full = was_bytes < state.byte_limit && state.pending_bytes >= state.byte_limit;
+        state.submitted += 1;
+        let ticket = state.submitted;
+        drop(state);
+        if sooner || full {
+            self.shared.work.notify_one();
+        }
+        CommitHandle {
+            ticket: Some((Arc::clone(&self.shared), ticket)),
+        }
+    }
+}
+
+impl Drop for GroupCommitter {
+    fn drop(&mut self) {
+        self.shared.lock().shutdown = true;
+        self.shared.work.notify_one();
+        if let Some(thread) = self.thread.take() {
+            let _ = thread.join();
+        }
+    }
+}
+
+fn run(shared: &Shared, mmap: &MmapMut) {
+    let metrics = HeaderMetrics::new(&mmap[..]);
+    let mut state = shared.lock();
+    loop {
+        let Some(deadline) = state.deadline else {
+            if state.shutdown {
+                return;
+            }
+            state = shared
+                .work
+                .wait(state)
+                .unwrap_or_else(PoisonError::into_inner);
+            continue;
+        };
+        let now = Instant::now();
+        if !state.shutdown && now < deadline && state.pending_bytes < state.byte_limit {
+            state = shared
+                .work
+                .wait_timeout(state, deadline - now)
+                .unwrap_or_else(PoisonError::into_inner)
+                .0;
+            continue;
+        }
+
+        let spans = std::mem::take(&mut state.spans);
+        let target = state.submitted;
+        let appends = target - state.durable;
+        state.pending_bytes = 0;
+        state.deadline = None;
+        state.byte_limit = u64::MAX;
+        if state.failure.is_some() {
+            // Poisoned: nothing after the failed flush can be reported durable again.
+            shared.done.notify_all();
+            continue;
+        }
+        drop(state);
+
+        let result = flush(mmap, spans);
+        metrics.add(Counter::GroupCommitFlushes, 1);
+        metrics.add(Counter::GroupCommitAppends, appends);
+
+        state = shared.lock();
+        match result {
+            Ok(()) => state.durable = target,
+            Err(err) => state.failure = Some((err.kind(), err.to_string())),
+        }
+        shared.done.notify_all();
+    }
+}
+
+/// Sync `spans` merged into as few ranges as possible, then the header that publishes them.
+fn flush(mmap: &MmapMut, mut spans: Vec<(usize, usize)>) -> io::Result<()> {
+    for (start, end) in merge_spans(&mut spans) {
+        mmap.flush_range(start, end - start)?;
+    }
+    mmap.flush_range(0, HEADER_SIZE)
+}
+
+fn merge_spans(spans: &mut [(usize, usize)]) -> Vec<(usize, usize)> {
+    spans.sort_unstable();
+    let mut merged: Vec<(usize, usize)> = Vec::with_capacity(spans.len());
+    for &(start, end) in spans.iter() {
+        match merged.last_mut() {
+            Some(last) if start <= last.1.saturating_add(MERGE_GAP) => last.1 = last.1.max(end),
+            _ => merged.push((start, end)),
+        }
+    }
+    merged
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{GroupCommitter, MERGE_GAP, merge_spans};
+    use crate::core::pool::HEADER_SIZE;
+    use std::sync::Arc;
+    use std::time::Duration;
+
+    fn pool_file(dir: &tempfile::TempDir) -> (std::path::PathBuf, std::fs::File) {
+        let path = dir.path().join("commit.plasmite");
+        let file = std::fs::OpenOptions::new()
+            .create(true)
+            .truncate(true)
+            .read(true)
+            .write(true)
+            .open(&path)
+            .expect("open");
+        file.set_len((HEADER_SIZE * 64) as u64).expect("len");
+        (path, file)
+    }
+
+    #[test]
+    fn merge_spans_sorts_and_joins_nearby_ranges() {
+        let mut spans = vec![
+            (10 * MERGE_GAP, 10 * MERGE_GAP + 8),
+            (100, 200),
+            (150, 300),
+            (300 + MERGE_GAP, 300 + MERGE_GAP + 1),
+        ];
+        assert_eq!(
+            merge_spans(&mut spans),
+            vec![
+                (100, 300 + MERGE_GAP + 1),
+                (10 * MERGE_GAP, 10 * MERGE_GAP + 8)
+            ]
+        );
+    }
+
+    #[test]
+    fn committers_are_shared_per_file_and_restart_after_drop() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let (path, file) = pool_file(&dir);
+        let first = GroupCommitter::for_pool(&path, &file).expect("committer");
+        let second = GroupCommitter::for_pool(&path, &file).expect("committer");
+        assert!(Arc::ptr_eq(&first, &second));
+
+        let pending = first.submit(
+            [(HEADER_SIZE, HEADER_SIZE + 16)],
+            Duration::from_secs(60),
+            u64::MAX,
+        );
+        drop(first);
+        drop(second);
+        // Shutdown flushes what was pending instead of abandoning it.
+        assert!(pending.is_durable());
+
+        let third = GroupCommitter::for_pool(&path, &file).expect("committer");
+        third
+            .submit([(HEADER_SIZE, HEADER_SIZE + 16)], Duration::ZERO, u64::MAX)
+            .wait()
+            .expect("flush");
+    }
+
+    #[test]
+    fn recreated_pool_file_gets_its_own_committer() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let (path, old_file) = pool_file(&dir);
+        let old = GroupCommitter::for_pool(&path, &old_file).expect("committer");
+
+        std::fs::remove_file(&path).expect("remove");
+        let (path, new_file) = pool_file(&dir);
+        let new = GroupCommitter::for_pool(&path, &new_file).expect("committer");
+        assert!(!Arc::ptr_eq(&old, &new));
+        assert!(Arc::ptr_eq(
+            &new,
+            &GroupCommitter::for_pool(&path, &new_file).expect("committer")
+        ));
+    }
+
+    #[test]
+    fn concurrent_submits_share_flushes() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let (path, file) = pool_file(&dir);
+        let committer = GroupCommitter::for_pool(&path, &file).expect("committer");
+
+        let threads: Vec<_> = (0..8)
+            .map(|i| {
+                let committer = Arc::clone(&committer);
+                std::thread::spawn(move || {
+                    for j in 0..16 {
+                        let start = HEADER_SIZE * (1 + (i * 16 + j) % 63);
+                        committer
+                            .submit([(start, start + 64)], Duration::from_millis(1), u64::MAX)
+                            .wait()
+                            .expect("flush");
+                    }
+                })
+            })
+            .collect();
+        for thread in threads {
+            thread.join().expect("join");
+        }
+
+        let state = committer.shared.lock();
+        assert_eq!(state.submitted, 128);
+        assert_eq!(state.durable, 128);
+    }
+
+    #[test]
+    fn byte_limit_starts_the_flush_before_the_delay() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let (path, file) = pool_file(&dir);
+        let committer = GroupCommitter::for_pool(&path, &file).expect("committer");
+        let started = std::time::Instant::now();
+        committer
+            .submit(
+                [(HEADER_SIZE, HEADER_SIZE * 3)],
+                Duration::from_secs(60),
+                1024,
+            )
+            .wait()
+            .expect("flush");
+        assert!(started.elapsed() < Duration::from_secs(30));
+    }
+}
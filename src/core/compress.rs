@@ -0,0 +1,388 @@
+//! Purpose: Optional pool-level zstd compression of frame payloads with a shared dictionary.
+//! Exports: `Compression`, `train_dictionary`, `ZSTD_DEFAULT_LEVEL`, `DEFAULT_MIN_FRAME_LEN`,
+//! `MAX_DICTIONARY_LEN`.
+//! Role: Pool-owned codec: compresses payloads on append and decodes them only when a reader
+//! asks for the bytes (`Pool::frame_payload`).
+//! Invariants: Settings are fixed at pool creation and live in header bytes
+//! `COMPRESSION_OFFSET..COMPRESSION_END`; the dictionary sits between the index and the ring.
+//! Invariants: Payloads shorter than `min_frame_len`, or that do not shrink, are stored raw.
+//! Invariants: Compressed frames carry `frame::FRAME_FLAG_ZSTD`; their header tag bloom is
+//! computed from the raw payload so tag filters never need to decompress.
+//! Invariants: Decompressed sizes are bounded by the ring's largest payload.
+use std::borrow::Cow;
+use std::cell::RefCell;
+use std::sync::Arc;
+
+use zstd::zstd_safe::{self, DCtx, DDict};
+
+use crate::core::error::{Error, ErrorKind};
+use crate::core::frame;
+
+/// Header bytes holding the compression settings: codec (u32), level (i32),
+/// min_frame_len (u32), dictionary length (u32).
+pub(crate) const COMPRESSION_OFFSET: usize = 640;
+pub(crate) const COMPRESSION_END: usize = COMPRESSION_OFFSET + 16;
+const CODEC_NONE: u32 = 0;
+const CODEC_ZSTD: u32 = 1;
+/// zstd level used when none is configured; favours append throughput over ratio.
+pub const ZSTD_DEFAULT_LEVEL: i32 = 3;
+/// Payloads below this many bytes stay raw by default: they rarely shrink enough to pay
+/// for the decode on read.
+pub const DEFAULT_MIN_FRAME_LEN: u32 = 256;
+/// Largest dictionary a pool will reserve space for.
+pub const MAX_DICTIONARY_LEN: usize = 1024 * 1024;
+
+/// Pool-level payload compression, chosen at creation via `PoolOptions::with_compression`.
+#[derive(Clone, Debug, Eq, PartialEq)]
+pub struct Compression {
+    level: i32,
+    min_frame_len: u32,
+    dictionary: Option<Arc<[u8]>>,
+}
+
+impl Compression {
+    pub fn zstd() -> Self {
+        Self {
+            level: ZSTD_DEFAULT_LEVEL,
+            min_frame_len: DEFAULT_MIN_FRAME_LEN,
+            dictionary: None,
+        }
+    }
+
+    /// zstd compression level; negative levels trade ratio for speed.
+    pub fn with_level(mut self, level: i32) -> Self {
+        self.level = level;
+        self
+    }
+
+    /// Smallest payload, in bytes, that is considered for compression.
+    pub fn with_min_frame_len(mut self, min_frame_len: u32) -> Self {
+        self.min_frame_len = min_frame_len;
+        self
+    }
+
+    /// Shared dictionary (e.g. from `train_dictionary`), stored in the pool file.
+    pub fn with_dictionary(mut self, dictionary: impl Into<Vec<u8>>) -> Self {
+        let dictionary: Vec<u8> = dictionary.into();
+        self.dictionary = (!dictionary.is_empty()).then(|| dictionary.into());
+        self
+    }
+
+    pub fn level(&self) -> i32 {
+        self.level
+    }
+
+    pub fn min_frame_len(&self) -> u32 {
+        self.min_frame_len
+    }
+
+    pub fn dictionary(&self) -> Option<&[u8]> {
+        self.dictionary.as_deref()
+    }
+
+    pub(crate) fn validate(&self) -> Result<(), Error> {
+        let (min, max) = (zstd_safe::min_c_level(), zstd_safe::max_c_level());
+        if self.level < min || self.level > max {
+            return Err(Error::new(ErrorKind::Usage)
+                .with_message(format!("zstd level must be between {min} and {max}")));
+        }
+        if self
+            .dictionary()
+            .is_some_and(|dict| dict.len() > MAX_DICTIONARY_LEN)
+        {
+            return Err(Error::new(ErrorKind::Usage)
+                .with_message("compression dictionary is too large")
+                .with_hint(format!(
+                    "Dictionaries are limited to {MAX_DICTIONARY_LEN} bytes."
+                )));
+        }
+        Ok(())
+    }
+}
+
+/// Train a zstd dictionary of at most `max_len` bytes from representative payloads.
+pub fn train_dictionary<S: AsRef<[u8]>>(samples: &[S], max_len: usize) -> Result<Vec<u8>, Error> {
+    if max_len == 0 || max_len > MAX_DICTIONARY_LEN {
+        return Err(Error::new(ErrorKind::Usage).with_message(format!(
+            "dictionary size must be between 1 and {MAX_DICTIONARY_LEN} bytes"
+        )));
+    }
+    zstd::dict::from_samples(samples, max_len).map_err(|err| {
+        Error::new(ErrorKind::Usage)
+            .with_message("failed to train compression dictionary")
+            .with_hint("Provide more (and more varied) sample payloads.")
+            .with_source(err)
+    })
+}
+
+/// Bytes reserved after the index for `compression`'s dictionary.
+pub(crate) fn reserved_len(compression: Option<&Compression>) -> u64 {
+    dictionary_region_len(
+        compression
+            .and_then(Compression::dictionary)
+            .map_or(0, <[u8]>::len),
+    )
+}
+
+/// Region holding a `dict_len`-byte dictionary, kept 8-byte aligned so ring offsets stay aligned.
+pub(crate) fn dictionary_region_len(dict_len: usize) -> u64 {
+    (dict_len as u64).div_ceil(8) * 8
+}
+
+/// A payload as it will be stored: possibly compressed, with the frame flags and raw-payload
+/// tag bloom to record in its header.
+pub(crate) struct EncodedPayload<'p> {
+    pub(crate) bytes: Cow<'p, [u8]>,
+    pub(crate) flags: u32,
+    pub(crate) tag_bloom: u64,
+}
+
+impl<'p> EncodedPayload<'p> {
+    pub(crate) fn raw(payload: &'p [u8]) -> Self {
+        Self {
+            bytes: Cow::Borrowed(payload),
+            flags: 0,
+            tag_bloom: frame::payload_tag_bloom(payload),
+        }
+    }
+}
+
+thread_local! {
+    // Decompression contexts are large; readers reuse one per thread across pools.
+    static DCTX: RefCell<Option<DCtx<'static>>> = const { RefCell::new(None) };
+}
+
+/// Per-pool codec state built from the header at create/open.
+#[derive(Default)]
+pub(crate) struct FrameCodec {
+    compression: Option<Compression>,
+    ddict: Option<DDict<'static>>,
+    // Created on first compressed append; readers never need one.
+    compressor: Option<zstd::bulk::Compressor<'static>>,
+}
+
+impl FrameCodec {
+    pub(crate) fn new(compression: Option<Compression>) -> Self {
+        let ddict = compression
+            .as_ref()
+            .and_then(Compression::dictionary)
+            .map(DDict::create);
+        Self {
+            compression,
+            ddict,
+            compressor: None,
+        }
+    }
+
+    pub(crate) fn compression(&self) -> Option<&Compression> {
+        self.compression.as_ref()
+    }
+
+    /// Write the settings into the header page and the dictionary at `dict_offset`.
+    pub(crate) fn store(&self, page: &mut [u8], dict_offset: usize) {
+        let slots = &mut page[COMPRESSION_OFFSET..COMPRESSION_END];
+        slots.fill(0);
+        let Some(compression) = &self.compression else {
+            return;
+        };
+        let dictionary = compression.dictionary().unwrap_or_default();
+        slots[0..4].copy_from_slice(&CODEC_ZSTD.to_le_bytes());
+        slots[4..8].copy_from_slice(&compression.level.to_le_bytes());
+        slots[8..12].copy_from_slice(&compression.min_frame_len.to_le_bytes());
+        slots[12..16].copy_from_slice(&(dictionary.len() as u32).to_le_bytes());
+        page[dict_offset..dict_offset + dictionary.len()].copy_from_slice(dictionary);
+    }
+
+    /// Settings recorded in `page`, plus the dictionary length (0 without one).
+    pub(crate) fn settings(page: &[u8]) -> Result<Option<(i32, u32, u32)>, Error> {
+        let slot = |index: usize| {
+            let start = COMPRESSION_OFFSET + index * 4;
+            let mut out = [0u8; 4];
+            out.copy_from_slice(&page[start..start + 4]);
+            out
+        };
+        match u32::from_le_bytes(slot(0)) {
+            CODEC_NONE => Ok(None),
+            CODEC_ZSTD => Ok(Some((
+                i32::from_le_bytes(slot(1)),
+                u32::from_le_bytes(slot(2)),
+                u32::from_le_bytes(slot(3)),
+            ))),
+            _ => Err(Error::new(ErrorKind::Corrupt).with_message("unsupported compression codec")),
+        }
+    }
+
+    /// Rebuild the codec from recorded `settings` and the pool's dictionary bytes.
+    pub(crate) fn load(settings: Option<(i32, u32, u32)>, dictionary: &[u8]) -> Self {
+        let compression = settings.map(|(level, min_frame_len, _)| {
+            Compression::zstd()
+                .with_level(level)
+                .with_min_frame_len(min_frame_len)
+                .with_dictionary(dictionary.to_vec())
+        });
+        Self::new(compression)
+    }
+
+    /// Encode `payload` for storage. Payloads over `max_len` (the ring's largest frame) stay
+    /// raw so the planner rejects them exactly as in an uncompressed pool.
+    pub(crate) fn encode<'p>(
+        &mut self,
+        payload: &'p [u8],
+        max_len: usize,
+    ) -> Result<EncodedPayload<'p>, Error> {
+        let Some(compression) = &self.compression else {
+            return Ok(EncodedPayload::raw(payload));
+        };
+        if payload.len() < compression.min_frame_len as usize || payload.len() > max_len {
+            return Ok(EncodedPayload::raw(payload));
+        }
+        let compressor = match &mut self.compressor {
+            Some(compressor) => compressor,
+            slot => slot.insert(
+                zstd::bulk::Compressor::with_dictionary(
+                    compression.level,
+                    compression.dictionary().unwrap_or_default(),
+                )
+                .map_err(|err| {
+                    Error::new(ErrorKind::Internal)
+                        .with_message("failed to initialize zstd compressor")
+                        .with_source(err)
+                })?,
+            ),
+        };
+        let compressed = compressor.compress(payload).map_err(|err| {
+            Error::new(ErrorKind::Internal)
+                .with_message("failed to compress payload")
+                .with_source(err)
+        })?;
+        if compressed.len() >= payload.len() {
+            return Ok(EncodedPayload::raw(payload));
+        }
+        Ok(EncodedPayload {
+            bytes: Cow::Owned(compressed),
+            flags: frame::FRAME_FLAG_ZSTD,
+            tag_bloom: frame::payload_tag_bloom(payload),
+        })
+    }
+
+    /// The raw payload of a frame stored with `flags`, decompressing at most `max_len` bytes.
+    pub(crate) fn decode<'a>(
+        &self,
+        flags: u32,
+        stored: &'a [u8],
+        max_len: usize,
+    ) -> Result<Cow<'a, [u8]>, Error> {
+        if flags & frame::FRAME_FLAG_ZSTD == 0 {
+            return Ok(Cow::Borrowed(stored));
+        }
+        if self.compression.is_none() {
+            return Err(Error::new(ErrorKind::Corrupt)
+                .with_message("compressed frame in a pool without compression"));
+        }
+        let corrupt = || Error::new(ErrorKind::Corrupt).with_message("invalid compressed payload");
+        let len = match zstd_safe::get_frame_content_size(stored) {
+            Ok(Some(len)) if len <= max_len as u64 => len as usize,
+            _ => return Err(corrupt()),
+        };
+        let mut out = Vec::with_capacity(len);
+        DCTX.with(|cell| {
+            let mut cell = cell.borrow_mut();
+            let dctx = cell.get_or_insert_with(DCtx::create);
+            let written = match &self.ddict {
+                Some(ddict) => dctx.decompress_using_ddict(&mut out, stored, ddict),
+                None => dctx.decompress(&mut out, stored),
+            };
+            match written {
+                Ok(written) if written == len => Ok(()),
+                _ => Err(corrupt()),
+            }
+        })?;
+        Ok(Cow::Owned(out))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{COMPRESSION_END, Compression, FrameCodec, reserved_len, train_dictionary};
+    use crate::core::error::ErrorKind;
+    use crate::core::frame;
+    use crate::core::lite3;
+    use serde_json::json;
+
+    fn payload(i: usize) -> Vec<u8> {
+        let data =
+            json!({"kind": "metric", "host": format!("web-{i:03}"), "note": "x".repeat(200)});
+        lite3::encode_message(&["ops".to_string()], &data)
+            .expect("encode")
+            .as_slice()
+            .to_vec()
+    }
+
+    #[test]
+    fn small_or_incompressible_payloads_stay_raw() {
+        let mut codec = FrameCodec::new(Some(Compression::zstd().with_min_frame_len(64)));
+        let small = [7u8; 16];
+        let encoded = codec.encode(&small, 4096).expect("encode");
+        assert_eq!(encoded.flags, 0);
+        assert_eq!(&*encoded.bytes, small.as_slice());
+
+        let mut state = 0x9e37_79b9_7f4a_7c15u64;
+        let noise: Vec<u8> = (0..512)
+            .map(|_| {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                state as u8
+            })
+            .collect();
+        assert_eq!(codec.encode(&noise, 4096).expect("encode").flags, 0);
+    }
+
+    #[test]
+    fn compressed_payload_round_trips_and_keeps_raw_tag_bloom() {
+        let raw = payload(1);
+        let mut codec = FrameCodec::new(Some(Compression::zstd()));
+        let encoded = codec.encode(&raw, 4096).expect("encode");
+        assert_eq!(encoded.flags, frame::FRAME_FLAG_ZSTD);
+        assert!(encoded.bytes.len() < raw.len());
+        assert_eq!(encoded.tag_bloom, frame::payload_tag_bloom(&raw));
+
+        let decoded = codec
+            .decode(encoded.flags, &encoded.bytes, raw.len())
+            .expect("decode");
+        assert_eq!(&*decoded, raw.as_slice());
+        let err = codec
+            .decode(encoded.flags, &encoded.bytes, raw.len() - 1)
+            .expect_err("bounded");
+        assert_eq!(err.kind(), ErrorKind::Corrupt);
+    }
+
+    #[test]
+    fn dictionary_settings_round_trip_through_header_page() {
+        let samples: Vec<Vec<u8>> = (0..200).map(payload).collect();
+        let dictionary = train_dictionary(&samples, 4096).expect("train");
+        let compression = Compression::zstd()
+            .with_level(-1)
+            .with_dictionary(dictionary.clone());
+        let reserved = reserved_len(Some(&compression)) as usize;
+        assert!(reserved >= dictionary.len() && reserved % 8 == 0);
+
+        let mut page = vec![0u8; 4096 + reserved];
+        let codec = FrameCodec::new(Some(compression.clone()));
+        codec.store(&mut page, 4096);
+        let settings = FrameCodec::settings(&page[..COMPRESSION_END])
+            .expect("settings")
+            .expect("zstd");
+        assert_eq!(settings.2 as usize, dictionary.len());
+        let loaded = FrameCodec::load(Some(settings), &page[4096..4096 + dictionary.len()]);
+        assert_eq!(loaded.compression(), Some(&compression));
+
+        let raw = payload(7);
+        let mut writer = FrameCodec::new(Some(compression));
+        let encoded = writer.encode(&raw, 4096).expect("encode");
+        let decoded = loaded
+            .decode(encoded.flags, &encoded.bytes, raw.len())
+            .expect("decode");
+        assert_eq!(&*decoded, raw.as_slice());
+    }
+}
@@ -1,11 +1,20 @@
 //! Purpose: Iterate committed frames in the ring with overwrite safety and minimal scanning.
-//! Exports: `Cursor`, `CursorResult`, `FrameRef`.
+//! Exports: `Cursor`, `CursorResult`, `FrameRef`, `BatchResult`, `BatchCursor`.
 //! Role: Read-side API used by CLI commands (fetch/follow) without exposing raw offsets.
 //! Invariants: Never returns `Writing` or invalid frames; treats them as non-visible.
 //! Invariants: Detects overwrite (fell-behind) and resynchronizes to the current tail.
+//! Invariants: Exposes each frame's tag bloom so filtered readers can skip without decoding.
+//! Invariants: `seek_to_time` is a lower-bound hint; it never skips a frame stamped in order.
+//! Invariants: `next_batch` reads against one header snapshot and re-checks eviction once after.
+//! Invariants: `BatchCursor` re-checks each buffered frame for eviction as it is handed out.
+//! Invariants: Every `FellBehind` is counted as a resync in the pool's hot metrics.
+//! Invariants: Frames borrow stored bytes; compressed payloads are decoded only on request.
+//! Invariants: Read-ahead/release advice follows the read position and restarts on resync.
 use crate::core::error::{Error, ErrorKind};
 use crate::core::frame::{self, FRAME_HEADER_LEN, FrameHeader, FrameState};
-use crate::core::pool::Pool;
+use crate::core::metrics::Counter;
+use crate::core::pool::{Pool, PoolHeader};
+use crate::core::residency::ReadWindow;
 
 #[derive(Debug, PartialEq)]
 pub enum CursorResult<'a> {
@@ -14,18 +23,50 @@ pub enum CursorResult<'a> {
     FellBehind,
 }
 
-#[derive(Debug, PartialEq)]
+#[derive(Clone, Copy, Debug, PartialEq)]
 pub struct FrameRef<'a> {
     pub seq: u64,
     pub timestamp_ns: u64,
     pub flags: u32,
+    /// `meta.tags` bloom from the frame header; 0 when the writer did not record one.
+    pub tag_bloom: u64,
+    /// Stored payload bytes; compressed when `is_compressed` (see `Pool::frame_payload`).
     pub payload: &'a [u8],
 }
 
+impl FrameRef<'_> {
+    /// Whether the payload is stored compressed rather than as a raw Lite3 document.
+    pub fn is_compressed(&self) -> bool {
+        self.flags & frame::FRAME_FLAG_ZSTD != 0
+    }
+
+    /// This frame's header fields over `payload`, typically the bytes decoded by
+    /// `Pool::frame_payload`; storage flags are cleared.
+    pub fn with_payload<'b>(&self, payload: &'b [u8]) -> FrameRef<'b> {
+        FrameRef {
+            seq: self.seq,
+            timestamp_ns: self.timestamp_ns,
+            flags: self.flags & !frame::FRAME_FLAG_ZSTD,
+            tag_bloom: self.tag_bloom,
+            payload,
+        }
+    }
+}
+
 #[derive(Debug)]
 pub struct Cursor {
     next_off: usize,
     last_seq: u64,
+    window: ReadWindow,
+}
+
+/// Outcome of `Cursor::next_batch`; `WouldBlock`/`FellBehind` mean what they do for `next`.
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub enum BatchResult {
+    /// This many frames were appended to the caller's buffer, in seq order.
+    Frames(usize),
+    WouldBlock,
+    FellBehind,
 }
 
 impl Cursor {
@@ -33,43 +74,34 @@ impl Cursor {
         Self {
             next_off: 0,
             last_seq: 0,
+            window: ReadWindow::default(),
         }
     }
 
     pub fn seek_to(&mut self, offset: usize) {
         self.next_off = offset;
         self.last_seq = 0;
+        self.window.reset();
+    }
+
+    /// Position before the first message stamped at or after `timestamp_ns`, using the pool's
+    /// time checkpoints instead of a walk from the tail. Earlier frames may still follow, so
+    /// readers keep filtering on `FrameRef::timestamp_ns`.
+    pub fn seek_to_time(&mut self, pool: &Pool, timestamp_ns: u64) -> Result<(), Error> {
+        let offset = pool.seek_time(timestamp_ns)?;
+        self.seek_to(offset);
+        Ok(())
     }
 
     pub fn next<'a>(&mut self, pool: &'a Pool) -> Result<CursorResult<'a>, Error> {
         let header = pool.header_from_mmap()?;
-        if header.oldest_seq == 0 {
-            return Ok(CursorResult::WouldBlock);
+        match self.check_position(header)? {
+            Some(BatchResult::WouldBlock) => return Ok(CursorResult::WouldBlock),
+            Some(_) => return Ok(resynced(pool, CursorResult::FellBehind)),
+            None => {}
         }
-
-        if self.last_seq != 0 && self.last_seq >= header.newest_seq {
-            return Ok(CursorResult::WouldBlock);
-        }
-
         let ring_size = header.ring_size as usize;
-        if ring_size == 0 {
-            return Err(Error::new(ErrorKind::Corrupt).with_message("ring size is zero"));
-        }
-
         let tail = header.tail_off as usize;
-        let head = header.head_off as usize;
-        let is_full = head == tail && header.oldest_seq != 0;
-        if !is_full && self.next_off == head {
-            return Ok(CursorResult::WouldBlock);
-        }
-
-        if self.next_off >= ring_size
-            || !offset_in_range(self.next_off, tail, head, ring_size, header.oldest_seq)
-        {
-            self.next_off = tail;
-            self.last_seq = 0;
-            return Ok(CursorResult::FellBehind);
-        }
 
         loop {
             let read = read_frame_at(
@@ -87,16 +119,184 @@ impl Cursor {
                 ReadResult::FellBehind => {
                     self.next_off = tail;
                     self.last_seq = 0;
-                    return Ok(CursorResult::FellBehind);
+                    self.window.reset();
+                    return Ok(resynced(pool, CursorResult::FellBehind));
                 }
                 ReadResult::Message { frame, next_off } => {
                     self.next_off = next_off;
                     self.last_seq = frame.seq;
+                    self.advise(pool, ring_size);
                     return Ok(CursorResult::Message(frame));
                 }
             }
         }
     }
+
+    /// Read up to `max` committed frames into `out`, decoding the pool header once for the
+    /// whole batch instead of once per frame. Stops at the snapshot's newest frame. The
+    /// header is read again afterwards, and frames evicted meanwhile (whose bytes a writer
+    /// may have reused) are dropped from `out`. Dropping them reports `FellBehind` when
+    /// nothing else was read.
+    pub fn next_batch<'a>(
+        &mut self,
+        pool: &'a Pool,
+        max: usize,
+        out: &mut Vec<FrameRef<'a>>,
+    ) -> Result<BatchResult, Error> {
+        let header = pool.header_from_mmap()?;
+        if let Some(result) = self.check_position(header)? {
+            if result == BatchResult::FellBehind {
+                return Ok(resynced(pool, result));
+            }
+            return Ok(result);
+        }
+        let ring_offset = header.ring_offset as usize;
+        let ring_size = header.ring_size as usize;
+        let start = out.len();
+        let mut fell_behind = false;
+        while out.len() - start < max && self.last_seq < header.newest_seq {
+            match read_frame_at(pool.mmap(), ring_offset, ring_size, self.next_off)? {
+                ReadResult::Wrap => self.next_off = 0,
+                ReadResult::WouldBlock => break,
+                ReadResult::FellBehind => {
+                    fell_behind = true;
+                    break;
+                }
+                ReadResult::Message { frame, next_off } => {
+                    self.next_off = next_off;
+                    self.last_seq = frame.seq;
+                    out.push(frame);
+                }
+            }
+        }
+
+        let read = out.len() - start;
+        if read > 0 {
+            self.advise(pool, ring_size);
+            let current = pool.header_from_mmap()?;
+            let live = &out[start..];
+            let evicted = if current.oldest_seq == 0 {
+                live.len()
+            } else {
+                live.partition_point(|frame| frame.seq < current.oldest_seq)
+            };
+            out.drain(start..start + evicted);
+            if evicted == read {
+                return Ok(resynced(pool, BatchResult::FellBehind));
+            }
+            return Ok(BatchResult::Frames(read - evicted));
+        }
+        if fell_behind {
+            self.next_off = header.tail_off as usize;
+            self.last_seq = 0;
+            self.window.reset();
+            return Ok(resynced(pool, BatchResult::FellBehind));
+        }
+        Ok(BatchResult::WouldBlock)
+    }
+
+    /// Shared `next`/`next_batch` preamble: `None` when a frame may be readable at the
+    /// current position. On `FellBehind` the cursor is already reset to the tail.
+    fn check_position(&mut self, header: PoolHeader) -> Result<Option<BatchResult>, Error> {
+        if header.oldest_seq == 0 {
+            return Ok(Some(BatchResult::WouldBlock));
+        }
+
+        if self.last_seq != 0 && self.last_seq >= header.newest_seq {
+            return Ok(Some(BatchResult::WouldBlock));
+        }
+
+        let ring_size = header.ring_size as usize;
+        if ring_size == 0 {
+            return Err(Error::new(ErrorKind::Corrupt).with_message("ring size is zero"));
+        }
+
+        let tail = header.tail_off as usize;
+        let head = header.head_off as usize;
+        let is_full = head == tail && header.oldest_seq != 0;
+        if !is_full && self.next_off == head {
+            return Ok(Some(BatchResult::WouldBlock));
+        }
+
+        if self.next_off >= ring_size
+            || !offset_in_range(self.next_off, tail, head, ring_size, header.oldest_seq)
+        {
+            self.next_off = tail;
+            self.last_seq = 0;
+            self.window.reset();
+            return Ok(Some(BatchResult::FellBehind));
+        }
+        Ok(None)
+    }
+
+    /// Move the pool's read-ahead/release windows along after a read; a no-op unless the
+    /// pool was opened with cursor advice (see `Residency`).
+    fn advise(&mut self, pool: &Pool, ring_size: usize) {
+        let Some(window) = pool.residency().window_bytes() else {
+            return;
+        };
+        if let Some((behind, ahead)) = self.window.advance(window, ring_size, self.next_off) {
+            pool.advise_read_window(behind, ahead);
+        }
+    }
+}
+
+/// Count a fell-behind result in the pool's hot metrics and pass it through.
+fn resynced<T>(pool: &Pool, result: T) -> T {
+    pool.metrics().add(Counter::CursorResyncs, 1);
+    result
+}
+
+/// A `Cursor` that refills through `next_batch` and hands frames out one at a time, so
+/// `next`-style read loops pay for the header decode once per batch. Each buffered frame is
+/// re-checked against the published `oldest_seq` as it is handed out; frames evicted since
+/// the fill are dropped and reported once as `FellBehind`.
+#[derive(Debug)]
+pub struct BatchCursor<'a> {
+    cursor: Cursor,
+    frames: Vec<FrameRef<'a>>,
+    pos: usize,
+    max: usize,
+}
+
+impl<'a> BatchCursor<'a> {
+    pub fn new(cursor: Cursor, max: usize) -> Self {
+        Self {
+            cursor,
+            frames: Vec::with_capacity(max),
+            pos: 0,
+            max: max.max(1),
+        }
+    }
+
+    pub fn next(&mut self, pool: &'a Pool) -> Result<CursorResult<'a>, Error> {
+        if self.pos == self.frames.len() {
+            self.frames.clear();
+            self.pos = 0;
+            match self.cursor.next_batch(pool, self.max, &mut self.frames)? {
+                BatchResult::Frames(_) => {}
+                BatchResult::WouldBlock => return Ok(CursorResult::WouldBlock),
+                BatchResult::FellBehind => return Ok(CursorResult::FellBehind),
+            }
+        } else {
+            // `next_batch` re-checked the batch when it was filled; later frames may have been
+            // evicted (and their bytes reused) while earlier ones were being consumed.
+            let oldest = pool.oldest_seq_from_mmap();
+            let pending = &self.frames[self.pos..];
+            let evicted = if oldest == 0 {
+                pending.len()
+            } else {
+                pending.partition_point(|frame| frame.seq < oldest)
+            };
+            if evicted > 0 {
+                self.pos += evicted;
+                return Ok(resynced(pool, CursorResult::FellBehind));
+            }
+        }
+        let frame = self.frames[self.pos];
+        self.pos += 1;
+        Ok(CursorResult::Message(frame))
+    }
 }
 
 impl Default for Cursor {
@@ -170,6 +370,7 @@ pub(crate) fn read_frame_at<'a>(
             seq: h1.seq,
             timestamp_ns: h1.timestamp_ns,
             flags: h1.flags,
+            tag_bloom: h1.tag_bloom,
             payload,
         },
         next_off,
@@ -203,7 +404,7 @@ fn offset_in_range(
 
 #[cfg(test)]
 mod tests {
-    use super::{Cursor, CursorResult, ReadResult, read_frame_at};
+    use super::{BatchCursor, BatchResult, Cursor, CursorResult, ReadResult, read_frame_at};
     use crate::core::frame::{self, FRAME_HEADER_LEN, FrameHeader, FrameState};
     use crate::core::lite3;
     use crate::core::pool::{Pool, PoolOptions};
@@ -311,6 +512,140 @@ mod tests {
         assert!(matches!(result, CursorResult::Message(_)));
     }
 
+    #[test]
+    fn next_batch_matches_next_across_wraps() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &json!({"x": 3})).expect("payload");
+        let frame_len = frame::frame_total_len(FRAME_HEADER_LEN, payload.len()).expect("len");
+        let ring_size = frame_len * 5 + FRAME_HEADER_LEN;
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(4096 + ring_size as u64).with_index_capacity(0),
+        )
+        .expect("create");
+        for _ in 0..13 {
+            pool.append(payload.as_slice()).expect("append");
+        }
+
+        let expected = drain_seqs(&pool);
+        assert!(expected.len() > 2 && expected.first() > Some(&1));
+        assert_eq!(expected.last(), Some(&13));
+
+        let mut cursor = Cursor::new();
+        let mut frames = Vec::new();
+        loop {
+            match cursor.next_batch(&pool, 2, &mut frames).expect("batch") {
+                BatchResult::Frames(count) => assert!((1..=2).contains(&count)),
+                BatchResult::WouldBlock => break,
+                // A fresh cursor starts at ring offset 0, which may no longer be the tail.
+                BatchResult::FellBehind => assert!(frames.is_empty()),
+            }
+        }
+        let seqs: Vec<u64> = frames.iter().map(|frame| frame.seq).collect();
+        assert_eq!(seqs, expected);
+
+        pool.append(payload.as_slice()).expect("append");
+        frames.clear();
+        let result = cursor.next_batch(&pool, 16, &mut frames).expect("batch");
+        assert_eq!(result, BatchResult::Frames(1));
+        assert_eq!(frames[0].seq, 14);
+
+        let expected = drain_seqs(&pool);
+        let mut batched = BatchCursor::new(Cursor::new(), 3);
+        let mut seqs = Vec::new();
+        loop {
+            match batched.next(&pool).expect("next") {
+                CursorResult::Message(frame) => seqs.push(frame.seq),
+                CursorResult::WouldBlock => break,
+                CursorResult::FellBehind => assert!(seqs.is_empty()),
+            }
+        }
+        assert_eq!(seqs, expected);
+    }
+
+    #[test]
+    fn next_batch_resyncs_on_overwrite() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &json!({"x": 2})).expect("payload");
+        let frame_len = frame::frame_total_len(FRAME_HEADER_LEN, payload.len()).expect("len");
+        let ring_size = frame_len + FRAME_HEADER_LEN;
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(4096 + ring_size as u64).with_index_capacity(0),
+        )
+        .expect("create");
+        pool.append(payload.as_slice()).expect("append 1");
+        pool.append(payload.as_slice()).expect("append 2");
+
+        let mut cursor = Cursor::new();
+        cursor.next_off = ring_size + 8;
+        let mut frames = Vec::new();
+        let result = cursor.next_batch(&pool, 8, &mut frames).expect("batch");
+        assert_eq!(result, BatchResult::FellBehind);
+        assert!(frames.is_empty());
+        let result = cursor.next_batch(&pool, 8, &mut frames).expect("batch");
+        assert_eq!(result, BatchResult::Frames(1));
+        assert_eq!(frames[0].seq, 2);
+    }
+
+    #[test]
+    fn batch_cursor_drops_frames_evicted_mid_batch() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &json!({"x": 3})).expect("payload");
+        let frame_len = frame::frame_total_len(FRAME_HEADER_LEN, payload.len()).expect("len");
+        let ring_size = frame_len * 6;
+        let mut writer = Pool::create(
+            &path,
+            PoolOptions::new(4096 + ring_size as u64).with_index_capacity(0),
+        )
+        .expect("create");
+        for _ in 0..4 {
+            writer.append(payload.as_slice()).expect("append");
+        }
+        let reader = Pool::open(&path).expect("open");
+        let mut batched = BatchCursor::new(Cursor::new(), 4);
+        match batched.next(&reader).expect("next") {
+            CursorResult::Message(frame) => assert_eq!(frame.seq, 1),
+            other => panic!("expected seq 1, got {other:?}"),
+        }
+
+        // Wrap the ring under the half-consumed batch until buffered seqs 2 and 3 are gone.
+        while reader.oldest_seq_from_mmap() <= 3 {
+            writer.append(payload.as_slice()).expect("append");
+        }
+        let oldest = reader.oldest_seq_from_mmap();
+        let newest = writer.bounds().expect("bounds").newest_seq.expect("newest");
+
+        assert_eq!(
+            batched.next(&reader).expect("next"),
+            CursorResult::FellBehind
+        );
+        let mut seqs = Vec::new();
+        loop {
+            match batched.next(&reader).expect("next") {
+                CursorResult::Message(frame) => seqs.push(frame.seq),
+                CursorResult::WouldBlock => break,
+                CursorResult::FellBehind => assert!(seqs.is_empty()),
+            }
+        }
+        assert_eq!(seqs, (oldest..=newest).collect::<Vec<_>>());
+    }
+
+    fn drain_seqs(pool: &Pool) -> Vec<u64> {
+        let mut cursor = Cursor::new();
+        let mut seqs = Vec::new();
+        loop {
+            match cursor.next(pool).expect("next") {
+                CursorResult::Message(frame) => seqs.push(frame.seq),
+                CursorResult::WouldBlock => return seqs,
+                CursorResult::FellBehind => assert!(seqs.is_empty()),
+            }
+        }
+    }
+
     fn write_payload_and_marker(buf: &mut [u8], payload: &[u8]) {
         let payload_start = FRAME_HEADER_LEN;
         let payload_end = payload_start + payload.len();
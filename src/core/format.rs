@@ -1,13 +1,19 @@
 //! Purpose: Centralize pool format versioning and migration guidance.
-//! Exports: `POOL_FORMAT_VERSION`, `SUPPORTED_POOL_FORMAT_VERSIONS`, `pool_version_error`.
+//! Exports: `POOL_FORMAT_VERSION`, `POOL_FORMAT_VERSION_COMPRESSED`,
+//! `SUPPORTED_POOL_FORMAT_VERSIONS`, `pool_version_error`.
 //! Role: Shared policy for gating on-disk compatibility across open/validation paths.
 //! Invariants: Version list is additive; bump only for incompatible on-disk changes.
 //! Invariants: Migration guidance stays actionable and stable for users.
+//! Invariants: Compressed pools carry their own version so readers without zstd refuse them.
 
 use crate::core::error::{Error, ErrorKind};
 
 pub const POOL_FORMAT_VERSION: u32 = 3;
-pub const SUPPORTED_POOL_FORMAT_VERSIONS: &[u32] = &[POOL_FORMAT_VERSION];
+/// Pools created with compression: version 3 plus zstd frames and a dictionary region.
+/// Uncompressed pools keep `POOL_FORMAT_VERSION`, so older binaries still open them.
+pub const POOL_FORMAT_VERSION_COMPRESSED: u32 = 4;
+pub const SUPPORTED_POOL_FORMAT_VERSIONS: &[u32] =
+    &[POOL_FORMAT_VERSION, POOL_FORMAT_VERSION_COMPRESSED];
 
 pub fn pool_version_error(detected: u32) -> Error {
     let supported = SUPPORTED_POOL_FORMAT_VERSIONS
@@ -1,11 +1,13 @@
 //! Purpose: Define frame header layout plus helpers for sizing/alignment and validation.
-//! Exports: `FrameHeader`, `FrameState`, `FRAME_HEADER_LEN`, `FRAME_COMMIT_MARKER`, `frame_total_len`.
+//! Exports: `FrameHeader`, `FrameState`, `FRAME_HEADER_LEN`, `FRAME_COMMIT_MARKER`, `frame_total_len`,
+//! `tag_bloom`, `payload_tag_bloom`, `tag_bloom_may_match`, `FRAME_FLAG_ZSTD`.
 //! Role: Shared encoding/validation primitives used by planner, pool, cursor, and validator.
 //! Invariants: Frame headers are fixed-size (64 bytes) and encoded little-endian.
 //! Invariants: Payload validation enforces canonical Lite3 encoding when required.
 //! Invariants: Committed frames include an 8-byte commit marker written after the payload.
+//! Invariants: A zero tag bloom means "unknown" (older writers); readers must then decode tags.
+//! Invariants: `flags` 0 means a raw Lite3 payload; other bits describe how it is stored.
 use crate::core::error::{Error, ErrorKind};
-#[cfg(test)]
 use crate::core::lite3;
 
 pub const FRAME_MAGIC: [u8; 4] = *b"FRM1";
@@ -13,6 +15,10 @@ pub const FRAME_HEADER_LEN: usize = 64;
 pub const FRAME_COMMIT_MARKER: [u8; 8] = *b"PLSMCMIT";
 pub const FRAME_COMMIT_MARKER_LEN: usize = FRAME_COMMIT_MARKER.len();
 pub const MAX_PAYLOAD_ABS: usize = 256 * 1024 * 1024;
+/// Set in every computed tag bloom so that 0 can mean "not recorded".
+pub const TAG_BLOOM_PRESENT: u64 = 1 << 63;
+/// `FrameHeader::flags` bit: the payload is a zstd frame (see `core::compress`).
+pub const FRAME_FLAG_ZSTD: u32 = 1;
 
 #[derive(Clone, Copy, Debug, Eq, PartialEq)]
 pub enum FrameState {
@@ -44,6 +50,8 @@ pub struct FrameHeader {
     pub payload_len: u32,
     pub payload_len_xor: u32,
     pub crc32c: u32,
+    /// Bloom of the payload's `meta.tags` (bytes 44..52); see `tag_bloom`.
+    pub tag_bloom: u64,
 }
 
 impl FrameHeader {
@@ -64,9 +72,15 @@ impl FrameHeader {
             payload_len,
             payload_len_xor: payload_len ^ 0xFFFF_FFFF,
             crc32c,
+            tag_bloom: 0,
         }
     }
 
+    pub fn with_tag_bloom(mut self, tag_bloom: u64) -> Self {
+        self.tag_bloom = tag_bloom;
+        self
+    }
+
     pub fn encode(&self) -> [u8; FRAME_HEADER_LEN] {
         let mut buf = [0u8; FRAME_HEADER_LEN];
         buf[0..4].copy_from_slice(&FRAME_MAGIC);
@@ -78,6 +92,7 @@ impl FrameHeader {
         write_u32(&mut buf, 32, self.payload_len);
         write_u32(&mut buf, 36, self.payload_len_xor);
         write_u32(&mut buf, 40, self.crc32c);
+        write_u64(&mut buf, 44, self.tag_bloom);
         buf
     }
 
@@ -96,6 +111,7 @@ impl FrameHeader {
         let payload_len = read_u32(buf, 32);
         let payload_len_xor = read_u32(buf, 36);
         let crc32c = read_u32(buf, 40);
+        let tag_bloom = read_u64(buf, 44);
 
         Ok(Self {
             state,
@@ -106,6 +122,7 @@ impl FrameHeader {
             payload_len,
             payload_len_xor,
             crc32c,
+            tag_bloom,
         })
     }
 
@@ -143,6 +160,46 @@ pub fn max_payload(ring_size: usize, header_len: usize) -> usize {
     ring_cap.min(MAX_PAYLOAD_ABS)
 }
 
+/// Two-bit-per-tag bloom over `tags` (FNV-1a, stable across processes and versions).
+/// The same function builds a reader's mask for the tags it requires.
+pub fn tag_bloom<'a>(tags: impl IntoIterator<Item = &'a str>) -> u64 {
+    tags.into_iter()
+        .fold(TAG_BLOOM_PRESENT, |bloom, tag| bloom | tag_bloom_bits(tag))
+}
+
+fn tag_bloom_bits(tag: &str) -> u64 {
+    let mut hash: u64 = 0xcbf2_9ce4_8422_2325;
+    for byte in tag.as_bytes() {
+        hash ^= u64::from(*byte);
+        hash = hash.wrapping_mul(0x0000_0100_0000_01b3);
+    }
+    (1 << (hash % 63)) | (1 << ((hash >> 32) % 63))
+}
+
+/// Tag bloom of an encoded message, or 0 if its `meta.tags` cannot be read.
+pub fn payload_tag_bloom(payload: &[u8]) -> u64 {
+    let doc = lite3::Lite3DocRef::new(payload);
+    let Ok(Some(tags_ofs)) = doc.offset_at_path(0, lite3::meta_tags_path()) else {
+        return 0;
+    };
+    let Ok(count) = doc.count_at(tags_ofs) else {
+        return 0;
+    };
+    let mut bloom = TAG_BLOOM_PRESENT;
+    for index in 0..count {
+        match doc.array_str_at(tags_ofs, index) {
+            Ok(tag) => bloom |= tag_bloom_bits(tag),
+            Err(_) => return 0,
+        }
+    }
+    bloom
+}
+
+/// False only when `bloom` proves the frame lacks a tag in `required` (a `tag_bloom` mask).
+pub fn tag_bloom_may_match(bloom: u64, required: u64) -> bool {
+    bloom & TAG_BLOOM_PRESENT == 0 || bloom & required == required
+}
+
 #[cfg(test)]
 pub fn validate_payload(payload: &[u8]) -> Result<(), Error> {
     lite3::validate_bytes(payload).map_err(|err| {
@@ -184,7 +241,7 @@ fn write_u64(buf: &mut [u8], offset: usize, value: u64) {
 mod tests {
     use super::{
         FRAME_HEADER_LEN, FrameHeader, FrameState, MAX_PAYLOAD_ABS, align8, frame_total_len,
-        max_payload, validate_payload,
+        max_payload, payload_tag_bloom, tag_bloom, tag_bloom_may_match, validate_payload,
     };
     use crate::core::error::ErrorKind;
     use crate::core::lite3::encode_message;
@@ -274,6 +331,29 @@ mod tests {
         assert_eq!(header, decoded);
     }
 
+    #[test]
+    fn tag_bloom_round_trips_and_filters() {
+        let tags = vec!["ops".to_string(), "alpha".to_string()];
+        let payload = encode_message(&tags, &json!({"x": 1})).expect("payload");
+        let bloom = payload_tag_bloom(payload.as_slice());
+        assert_eq!(bloom, tag_bloom(["alpha", "ops"]));
+
+        let header =
+            FrameHeader::new(FrameState::Committed, 0, 7, 100, 12, 0).with_tag_bloom(bloom);
+        let decoded = FrameHeader::decode(&header.encode()).expect("decode");
+        assert_eq!(decoded.tag_bloom, bloom);
+
+        assert!(tag_bloom_may_match(bloom, tag_bloom(["ops"])));
+        assert!(tag_bloom_may_match(bloom, tag_bloom(["ops", "alpha"])));
+        assert!(!tag_bloom_may_match(bloom, tag_bloom(["billing"])));
+        assert!(!tag_bloom_may_match(
+            tag_bloom(std::iter::empty()),
+            tag_bloom(["ops"])
+        ));
+        // Frames from writers that never recorded a bloom must still be decoded.
+        assert!(tag_bloom_may_match(0, tag_bloom(["billing"])));
+    }
+
     #[test]
     fn header_rejects_torn_payload_len() {
         let mut header = FrameHeader::new(FrameState::Committed, 0, 1, 1, 8, 0);
@@ -1,21 +1,35 @@
 //! Purpose: Safe wrappers around Lite3 encoding/decoding and canonical message validation.
-//! Exports: `Lite3Buf`, `Lite3DocRef`, `encode_message`, `validate_bytes`.
+//! Exports: `Lite3Buf`, `Lite3DocRef`, `Lite3ValueRef`, `Lite3Path`,
+//! `encode_message(_into|_json)`, `encoded_len_hint`, `validate_bytes`, `node_search_kernel`,
+//! `node_size`, `json_scan_kernel`.
 //! Role: Canonical JSON <-> Lite3 boundary for payloads stored in pool frames.
 //! Invariants: Buffer growth is capped (`MAX_LITE3_BUF`) to avoid unbounded allocation.
+//! Invariants: `to_value_at` walks Lite3 natively and matches `to_json_at` + `serde_json` parsing.
+//! Invariants: `write_json_at` emits the same bytes as `serde_json::to_vec(&to_value_at(..))`.
+//! Invariants: `encode_message` writes Lite3 directly from `Value` (no JSON text round trip).
+//! Invariants: JSON text is parsed into a per-thread yyjson arena, not a fresh heap document,
+//! and decoded once: output grows in place (uninitialized capacity) instead of re-decoding.
+//! Invariants: `Lite3Path` hashes its keys once; lookups still verify key bytes (collisions).
 //! Invariants: All FFI interaction is confined to this module + `sys`.
+//! Invariants: Public encode/decode entry points feed the sampled `metrics` codec timers.
 #[cfg(test)]
 use std::cell::Cell;
 use std::ffi::CString;
 use std::io;
+use std::os::raw::{c_char, c_int};
 
-use serde::Serialize;
 use serde_json::Value;
 
 use crate::core::error::{Error, ErrorKind};
+use crate::core::metrics::{CodecTimer, LITE3_DECODE, LITE3_ENCODE};
 
 pub mod sys;
 
 const MAX_LITE3_BUF: usize = 256 * 1024 * 1024;
+// Starting size for `encode_message`; most messages fit without a regrow.
+const ENCODE_INITIAL_BUF: usize = 1024;
+// Mirrors `LITE3_JSON_NESTING_DEPTH_MAX` so native decoding rejects what the JSON encoder rejects.
+const MAX_VALUE_NESTING_DEPTH: usize = 32;
 
 #[derive(Clone, Debug)]
 pub struct Lite3Buf {
@@ -24,52 +38,27 @@ pub struct Lite3Buf {
 
 impl Lite3Buf {
     pub fn from_json_str(json: &str) -> Result<Self, Error> {
-        let mut buf_len = json.len().saturating_mul(2).max(256);
-        let json_cstr = CString::new(json).map_err(|err| {
-            Error::new(ErrorKind::Usage)
-                .with_message("json contains null")
-                .with_source(err)
+        let _timer = CodecTimer::start(&LITE3_ENCODE);
+        if json.as_bytes().contains(&0) {
+            return Err(Error::new(ErrorKind::Usage).with_message("json contains null"));
+        }
+        let mut bytes = Vec::new();
+        let ret = decode_into_vec(&mut bytes, |arena, out| unsafe {
+            sys::plasmite_lite3_json_dec_arena(
+                arena,
+                json.as_ptr().cast::<c_char>(),
+                json.len(),
+                out,
+            )
         })?;
-
-        loop {
-            if buf_len > MAX_LITE3_BUF {
-                return Err(
-                    Error::new(ErrorKind::Usage).with_message("lite3 buffer exceeded max size")
-                );
-            }
-
-            let mut buf = vec![0u8; buf_len];
-            let mut out_len: usize = 0;
-            let ret = unsafe {
-                sys::plasmite_lite3_json_dec(
-                    json_cstr.as_ptr(),
-                    json.len(),
-                    buf.as_mut_ptr(),
-                    &mut out_len as *mut usize,
-                    buf.len(),
-                )
-            };
-
-            if ret == 0 {
-                buf.truncate(out_len);
-                return Ok(Self { bytes: buf });
-            }
-
-            let err_no = unsafe { sys::plasmite_lite3_last_errno() };
-            if err_no == libc::ENOBUFS {
-                buf_len = buf_len.saturating_mul(2);
-                continue;
+        if ret == 0 {
+            return Ok(Self { bytes });
+        }
+        match unsafe { sys::plasmite_lite3_last_errno() } {
+            libc::ENOBUFS => {
+                Err(Error::new(ErrorKind::Usage).with_message("lite3 buffer exceeded max size"))
             }
-
-            let err = if err_no != 0 {
-                io::Error::from_raw_os_error(err_no)
-            } else {
-                io::Error::other("unknown lite3 errno")
-            };
-
-            return Err(Error::new(ErrorKind::Usage)
-                .with_message("failed to encode json as lite3")
-                .with_source(err));
+            err_no => Err(encode_error(err_no)),
         }
     }
 
@@ -90,6 +79,20 @@ impl Lite3Buf {
     }
 }
 
+/// One Lite3 value read without decoding: scalars borrow from the document, containers expose
+/// the offset to pass to further `*_at` lookups.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub enum Lite3ValueRef<'a> {
+    Null,
+    Bool(bool),
+    I64(i64),
+    F64(f64),
+    Bytes(&'a [u8]),
+    Str(&'a str),
+    Object(usize),
+    Array(usize),
+}
+
 #[derive(Clone, Copy, Debug)]
 pub struct Lite3DocRef<'a> {
     bytes: &'a [u8],
@@ -111,6 +114,7 @@ impl<'a> Lite3DocRef<'a> {
     }
 
     pub fn to_json_at(&self, ofs: usize, pretty: bool) -> Result<String, Error> {
+        let _timer = CodecTimer::start(&LITE3_DECODE);
         #[cfg(test)]
         TO_JSON_AT_CALLS.with(|count| count.set(count.get() + 1));
         let mut out_len: usize = 0;
@@ -150,6 +154,50 @@ impl<'a> Lite3DocRef<'a> {
         json
     }
 
+    /// Append the value at `ofs` to `out` as compact JSON, streamed straight from Lite3 (no
+    /// `Value`, no yyjson document). Reusing `out` across calls keeps this allocation-free.
+    pub fn write_json_at(&self, ofs: usize, out: &mut Vec<u8>) -> Result<(), Error> {
+        let _timer = CodecTimer::start(&LITE3_DECODE);
+        let start = out.len();
+        loop {
+            let spare = out.capacity() - start;
+            let needed = unsafe {
+                sys::plasmite_lite3_json_write(
+                    self.bytes.as_ptr(),
+                    self.bytes.len(),
+                    ofs,
+                    out.as_mut_ptr().add(start).cast::<c_char>(),
+                    spare,
+                )
+            };
+            if needed < 0 {
+                return Err(json_write_error(unsafe {
+                    sys::plasmite_lite3_last_errno()
+                }));
+            }
+            let needed = needed as usize;
+            if needed <= spare {
+                // SAFETY: the writer initialized `needed` bytes past `start`.
+                unsafe { out.set_len(start + needed) };
+                return Ok(());
+            }
+            out.reserve(needed);
+        }
+    }
+
+    /// Decode the whole document into a `serde_json::Value` without a JSON text round-trip.
+    pub fn to_value(&self) -> Result<Value, Error> {
+        self.to_value_at(0)
+    }
+
+    /// Decode the value at `ofs` into a `serde_json::Value` by iterating Lite3 nodes directly.
+    pub fn to_value_at(&self, ofs: usize) -> Result<Value, Error> {
+        let _timer = CodecTimer::start(&LITE3_DECODE);
+        #[cfg(test)]
+        TO_VALUE_AT_CALLS.with(|count| count.set(count.get() + 1));
+        value_at(self.bytes, ofs, 0)
+    }
+
     pub fn key_offset(&self, key: &str) -> Result<usize, Error> {
         get_key_offset(self.bytes, key)
     }
@@ -167,6 +215,11 @@ impl<'a> Lite3DocRef<'a> {
     }
 
     pub fn array_string_at(&self, ofs: usize, index: u32) -> Result<String, Error> {
+        self.array_str_at(ofs, index).map(str::to_string)
+    }
+
+    /// Borrowed variant of `array_string_at`; the text lives in the document bytes.
+    pub fn array_str_at(&self, ofs: usize, index: u32) -> Result<&'a str, Error> {
         let mut out_ptr: *const std::os::raw::c_char = std::ptr::null();
         let mut out_len: usize = 0;
         let ret = unsafe {
@@ -185,12 +238,11 @@ impl<'a> Lite3DocRef<'a> {
             );
         }
         let bytes = unsafe { std::slice::from_raw_parts(out_ptr.cast::<u8>(), out_len) };
-        let text = std::str::from_utf8(bytes).map_err(|err| {
+        std::str::from_utf8(bytes).map_err(|err| {
             Error::new(ErrorKind::Corrupt)
                 .with_message("invalid utf-8")
                 .with_source(err)
-        })?;
-        Ok(text.to_string())
+        })
     }
 
     pub fn bool_at_key(&self, ofs: usize, key: &str) -> Result<bool, Error> {
@@ -227,6 +279,112 @@ impl<'a> Lite3DocRef<'a> {
         Ok(out)
     }
 
+    /// Value under `key` in the object at `ofs`; `Ok(None)` when the key is absent.
+    pub fn value_ref_at_key(
+        &self,
+        ofs: usize,
+        key: &str,
+    ) -> Result<Option<Lite3ValueRef<'a>>, Error> {
+        if self.type_at_key(ofs, key).is_err() {
+            return Ok(None);
+        }
+        let val_ofs = get_key_offset_at(self.bytes, ofs, key)?;
+        let mut raw = sys::Lite3Value::default();
+        let ret = unsafe {
+            sys::plasmite_lite3_val_read(
+                self.bytes.as_ptr(),
+                self.bytes.len(),
+                val_ofs,
+                &mut raw as *mut _,
+            )
+        };
+        if ret < 0 {
+            return Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 value"));
+        }
+        self.value_ref_from_raw(val_ofs, &raw).map(Some)
+    }
+
+    /// Offset of the value at `path` below the object at `ofs`; `Ok(None)` when a key is
+    /// missing or a value along the way is not an object.
+    pub fn offset_at_path(&self, ofs: usize, path: &Lite3Path) -> Result<Option<usize>, Error> {
+        let mut val_ofs = 0usize;
+        let ret = unsafe {
+            sys::plasmite_lite3_path_get(
+                self.bytes.as_ptr(),
+                self.bytes.len(),
+                ofs,
+                path.keys.as_ptr(),
+                path.keys.len(),
+                &mut val_ofs as *mut usize,
+                std::ptr::null_mut(),
+            )
+        };
+        match ret {
+            0 => Ok(Some(val_ofs)),
+            1 => Ok(None),
+            _ => Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 path lookup")),
+        }
+    }
+
+    /// `value_ref_at_key` for a whole precompiled path, resolved in one FFI call.
+    pub fn value_ref_at_path(
+        &self,
+        ofs: usize,
+        path: &Lite3Path,
+    ) -> Result<Option<Lite3ValueRef<'a>>, Error> {
+        let mut val_ofs = 0usize;
+        let mut raw = sys::Lite3Value::default();
+        let ret = unsafe {
+            sys::plasmite_lite3_path_get(
+                self.bytes.as_ptr(),
+                self.bytes.len(),
+                ofs,
+                path.keys.as_ptr(),
+                path.keys.len(),
+                &mut val_ofs as *mut usize,
+                &mut raw as *mut _,
+            )
+        };
+        match ret {
+            0 => self.value_ref_from_raw(val_ofs, &raw).map(Some),
+            1 => Ok(None),
+            _ => Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 path lookup")),
+        }
+    }
+
+    fn value_ref_from_raw(
+        &self,
+        val_ofs: usize,
+        raw: &sys::Lite3Value,
+    ) -> Result<Lite3ValueRef<'a>, Error> {
+        let borrowed: &'a [u8] = if raw.ptr.is_null() || raw.len == 0 {
+            &[]
+        } else {
+            // SAFETY: `val_read` points into `self.bytes`, which lives for `'a`.
+            unsafe { std::slice::from_raw_parts(raw.ptr, raw.len) }
+        };
+        let value = match raw.type_ {
+            sys::LITE3_TYPE_NULL => Lite3ValueRef::Null,
+            sys::LITE3_TYPE_BOOL => Lite3ValueRef::Bool(raw.boolean),
+            sys::LITE3_TYPE_I64 => Lite3ValueRef::I64(raw.i64),
+            sys::LITE3_TYPE_F64 => Lite3ValueRef::F64(raw.f64),
+            sys::LITE3_TYPE_BYTES => Lite3ValueRef::Bytes(borrowed),
+            sys::LITE3_TYPE_STRING => {
+                Lite3ValueRef::Str(std::str::from_utf8(borrowed).map_err(|err| {
+                    Error::new(ErrorKind::Corrupt)
+                        .with_message("invalid utf-8")
+                        .with_source(err)
+                })?)
+            }
+            sys::LITE3_TYPE_OBJECT => Lite3ValueRef::Object(val_ofs),
+            sys::LITE3_TYPE_ARRAY => Lite3ValueRef::Array(val_ofs),
+            _ => {
+                return Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 value type"));
+            }
+        };
+        Ok(value)
+    }
+
     pub fn type_at_key(&self, ofs: usize, key: &str) -> Result<u8, Error> {
         let value = unsafe {
             sys::plasmite_lite3_get_type(
@@ -308,38 +466,570 @@ impl<'a> Lite3DocRef<'a> {
 }
 
 pub fn encode_message(meta_tags: &[String], data: &Value) -> Result<Lite3Buf, Error> {
+    let _timer = CodecTimer::start(&LITE3_ENCODE);
+    ensure_data_object(data)?;
+    let mut encoder = Lite3Encoder::new(EncodeBuf::Owned(vec![0u8; ENCODE_INITIAL_BUF]))?;
+    encoder.message(meta_tags, data)?;
+    Ok(encoder.into_lite3_buf())
+}
+
+/// Encode a message whose data is still JSON text, parsing it with yyjson in the calling
+/// thread's arena instead of building a `serde_json::Value` first.
+///
+/// Returns `Ok(None)` when `json` does not parse, so callers can report it as input they could
+/// not read; every other failure matches `encode_message` (data must be an object, no NUL keys,
+/// same nesting limit). Keys are inserted in text order, so the bytes can differ from
+/// `encode_message` while decoding to the same value.
+pub fn encode_message_json(meta_tags: &[String], json: &str) -> Result<Option<Lite3Buf>, Error> {
+    let _timer = CodecTimer::start(&LITE3_ENCODE);
+    let mut encoder = Lite3Encoder::new(EncodeBuf::Owned(vec![0u8; ENCODE_INITIAL_BUF]))?;
+    encoder.meta(meta_tags)?;
+    let mut bytes = encoder.into_lite3_buf().bytes;
+    let ret = decode_into_vec(&mut bytes, |arena, out| unsafe {
+        sys::plasmite_lite3_json_dec_set(
+            arena,
+            out,
+            c"data".as_ptr(),
+            json.as_ptr().cast::<c_char>(),
+            json.len(),
+        )
+    })?;
+    if ret != 0 {
+        let message = match unsafe { sys::plasmite_lite3_last_errno() } {
+            libc::EBADMSG => return Ok(None),
+            libc::ENOBUFS => "lite3 buffer exceeded max size",
+            libc::EILSEQ => "json key contains null",
+            libc::EINVAL => "json nesting too deep for lite3",
+            err_no => return Err(encode_error(err_no)),
+        };
+        return Err(Error::new(ErrorKind::Usage).with_message(message));
+    }
+
+    let data_type =
+        unsafe { sys::plasmite_lite3_get_type(bytes.as_ptr(), bytes.len(), 0, c"data".as_ptr()) };
+    if data_type != sys::LITE3_TYPE_OBJECT {
+        return Err(Error::new(ErrorKind::Usage).with_message("data must be object"));
+    }
+    Ok(Some(Lite3Buf { bytes }))
+}
+
+/// Encode a message into caller-provided memory (e.g. a reserved pool frame).
+///
+/// Returns the encoded length, or `None` when `out` is too small; the caller decides how to
+/// fall back. Bytes of `out` past the returned length are unspecified.
+pub fn encode_message_into(
+    meta_tags: &[String],
+    data: &Value,
+    out: &mut [u8],
+) -> Result<Option<usize>, Error> {
+    let _timer = CodecTimer::start(&LITE3_ENCODE);
+    ensure_data_object(data)?;
+    if out.len() < sys::LITE3_NODE_SIZE {
+        return Ok(None);
+    }
+    let mut encoder = Lite3Encoder::new(EncodeBuf::Borrowed(out))?;
+    match encoder.message(meta_tags, data) {
+        Ok(()) => Ok(Some(encoder.len)),
+        Err(_) if encoder.exhausted => Ok(None),
+        Err(err) => Err(err),
+    }
+}
+
+/// Size estimate for `encode_message` output, meant for sizing `encode_message_into` buffers.
+///
+/// Budgets one node per three entries (the B-tree minimum fill) plus worst-case key tags and
+/// alignment, so it overshoots; treat it as a hint and handle `None` from `encode_message_into`.
+pub fn encoded_len_hint(meta_tags: &[String], data: &Value) -> usize {
+    let tags_len: usize = meta_tags
+        .iter()
+        .map(|tag| ENTRY_LEN_HINT + string_len_hint(tag))
+        .sum();
+    node_len_hint(2)
+        + node_len_hint(1)
+        + node_len_hint(meta_tags.len())
+        + key_len_hint("meta")
+        + key_len_hint("tags")
+        + key_len_hint("data")
+        + 3 * ENTRY_LEN_HINT
+        + tags_len
+        + value_len_hint(data)
+}
+
+// Type tag plus worst-case alignment padding for one entry.
+const ENTRY_LEN_HINT: usize = 4;
+
+fn value_len_hint(value: &Value) -> usize {
+    match value {
+        Value::Null => 0,
+        Value::Bool(_) => 1,
+        Value::Number(_) => 8,
+        Value::String(value) => string_len_hint(value),
+        Value::Object(map) => {
+            node_len_hint(map.len())
+                + map
+                    .iter()
+                    .map(|(key, value)| key_len_hint(key) + ENTRY_LEN_HINT + value_len_hint(value))
+                    .sum::<usize>()
+        }
+        Value::Array(items) => {
+            node_len_hint(items.len())
+                + items
+                    .iter()
+                    .map(|item| ENTRY_LEN_HINT + value_len_hint(item))
+                    .sum::<usize>()
+        }
+    }
+}
+
+fn node_len_hint(entries: usize) -> usize {
+    // Node plus the padding a split may insert to realign it.
+    (entries / 3 + 1) * (sys::LITE3_NODE_SIZE + 3)
+}
+
+fn key_len_hint(key: &str) -> usize {
+    4 + key.len() + 1
+}
+
+fn string_len_hint(value: &str) -> usize {
+    4 + value.len() + 1
+}
+
+fn ensure_data_object(data: &Value) -> Result<(), Error> {
     if !matches!(data, Value::Object(_)) {
         return Err(Error::new(ErrorKind::Usage).with_message("data must be object"));
     }
+    Ok(())
+}
+
+enum EncodeBuf<'a> {
+    Owned(Vec<u8>),
+    Borrowed(&'a mut [u8]),
+}
+
+impl EncodeBuf<'_> {
+    fn as_mut_slice(&mut self) -> &mut [u8] {
+        match self {
+            EncodeBuf::Owned(bytes) => bytes.as_mut_slice(),
+            EncodeBuf::Borrowed(bytes) => bytes,
+        }
+    }
+}
+
+/// Single-pass `serde_json::Value` -> Lite3 writer.
+///
+/// Inserts go straight into `buf`; on `ENOBUFS` an owned buffer is grown in place and only the
+/// failed insert is retried. Lite3 offsets are relative, so growth never invalidates `ofs`.
+/// A borrowed buffer cannot grow, so `ENOBUFS` sets `exhausted` and fails the encode.
+struct Lite3Encoder<'a> {
+    buf: EncodeBuf<'a>,
+    len: usize,
+    key: Vec<u8>,
+    exhausted: bool,
+}
+
+impl<'a> Lite3Encoder<'a> {
+    fn new(buf: EncodeBuf<'a>) -> Result<Self, Error> {
+        let mut encoder = Self {
+            buf,
+            len: 0,
+            key: Vec::new(),
+            exhausted: false,
+        };
+        let buf = encoder.buf.as_mut_slice();
+        let ret = unsafe {
+            sys::plasmite_lite3_init_obj(
+                buf.as_mut_ptr(),
+                &mut encoder.len as *mut usize,
+                buf.len(),
+            )
+        };
+        if ret < 0 {
+            return Err(encode_error(unsafe { sys::plasmite_lite3_last_errno() }));
+        }
+        Ok(encoder)
+    }
+
+    fn into_lite3_buf(self) -> Lite3Buf {
+        let bytes = match self.buf {
+            EncodeBuf::Owned(mut bytes) => {
+                bytes.truncate(self.len);
+                bytes
+            }
+            EncodeBuf::Borrowed(bytes) => bytes[..self.len].to_vec(),
+        };
+        Lite3Buf { bytes }
+    }
+
+    fn message(&mut self, meta_tags: &[String], data: &Value) -> Result<(), Error> {
+        // Same insertion order as serializing `{"meta":{"tags":[..]},"data":..}` and decoding it.
+        self.meta(meta_tags)?;
+        self.value(0, Some("data"), data, 2)
+    }
 
-    #[derive(Serialize)]
-    struct MetaEnvelope<'a> {
-        tags: &'a [String],
+    fn meta(&mut self, meta_tags: &[String]) -> Result<(), Error> {
+        let meta_ofs = self.object(0, Some("meta"), 2)?;
+        let tags_ofs = self.array(meta_ofs, Some("tags"), 3)?;
+        for tag in meta_tags {
+            self.string(tags_ofs, None, tag)?;
+        }
+        Ok(())
+    }
+
+    fn value(
+        &mut self,
+        ofs: usize,
+        key: Option<&str>,
+        value: &Value,
+        depth: usize,
+    ) -> Result<(), Error> {
+        match value {
+            Value::Null => self.insert(key, |buf, len, buf_sz, key| unsafe {
+                sys::plasmite_lite3_set_null(buf, len, ofs, buf_sz, key)
+            }),
+            Value::Bool(value) => self.insert(key, |buf, len, buf_sz, key| unsafe {
+                sys::plasmite_lite3_set_bool(buf, len, ofs, buf_sz, key, *value)
+            }),
+            Value::Number(number) => {
+                // Matches yyjson: integers beyond i64 fall back to f64.
+                if let Some(value) = number.as_i64() {
+                    self.insert(key, |buf, len, buf_sz, key| unsafe {
+                        sys::plasmite_lite3_set_i64(buf, len, ofs, buf_sz, key, value)
+                    })
+                } else {
+                    let value = number.as_f64().ok_or_else(|| {
+                        Error::new(ErrorKind::Usage).with_message("json number out of range")
+                    })?;
+                    self.insert(key, |buf, len, buf_sz, key| unsafe {
+                        sys::plasmite_lite3_set_f64(buf, len, ofs, buf_sz, key, value)
+                    })
+                }
+            }
+            Value::String(value) => self.string(ofs, key, value),
+            Value::Object(map) => {
+                let obj_ofs = self.object(ofs, key, depth)?;
+                for (child_key, child) in map {
+                    self.value(obj_ofs, Some(child_key), child, depth + 1)?;
+                }
+                Ok(())
+            }
+            Value::Array(items) => {
+                let arr_ofs = self.array(ofs, key, depth)?;
+                for item in items {
+                    self.value(arr_ofs, None, item, depth + 1)?;
+                }
+                Ok(())
+            }
+        }
     }
 
-    #[derive(Serialize)]
-    struct MessageEnvelope<'a> {
-        meta: MetaEnvelope<'a>,
-        data: &'a Value,
+    fn string(&mut self, ofs: usize, key: Option<&str>, value: &str) -> Result<(), Error> {
+        self.insert(key, |buf, len, buf_sz, key| unsafe {
+            sys::plasmite_lite3_set_str(
+                buf,
+                len,
+                ofs,
+                buf_sz,
+                key,
+                value.as_ptr().cast::<c_char>(),
+                value.len(),
+            )
+        })
     }
 
-    let json = MessageEnvelope {
-        meta: MetaEnvelope { tags: meta_tags },
-        data,
+    fn object(&mut self, ofs: usize, key: Option<&str>, depth: usize) -> Result<usize, Error> {
+        check_nesting_depth(depth)?;
+        let mut out_ofs: usize = 0;
+        self.insert(key, |buf, len, buf_sz, key| unsafe {
+            sys::plasmite_lite3_set_obj(buf, len, ofs, buf_sz, key, &mut out_ofs as *mut usize)
+        })?;
+        Ok(out_ofs)
+    }
+
+    fn array(&mut self, ofs: usize, key: Option<&str>, depth: usize) -> Result<usize, Error> {
+        check_nesting_depth(depth)?;
+        let mut out_ofs: usize = 0;
+        self.insert(key, |buf, len, buf_sz, key| unsafe {
+            sys::plasmite_lite3_set_arr(buf, len, ofs, buf_sz, key, &mut out_ofs as *mut usize)
+        })?;
+        Ok(out_ofs)
+    }
+
+    /// Runs one shim setter, growing and retrying on `ENOBUFS`. A `None` key appends to an array.
+    fn insert(
+        &mut self,
+        key: Option<&str>,
+        mut op: impl FnMut(*mut u8, *mut usize, usize, *const c_char) -> c_int,
+    ) -> Result<(), Error> {
+        let key_ptr = match key {
+            Some(key) => {
+                if key.as_bytes().contains(&0) {
+                    return Err(Error::new(ErrorKind::Usage).with_message("json key contains null"));
+                }
+                self.key.clear();
+                self.key.extend_from_slice(key.as_bytes());
+                self.key.push(0);
+                self.key.as_ptr().cast::<c_char>()
+            }
+            None => std::ptr::null(),
+        };
+
+        loop {
+            let buf = self.buf.as_mut_slice();
+            // Lite3 does not zero split realignment padding; clear it so reused memory (a
+            // reserved pool frame) never leaks stale bytes into the payload.
+            let pad_end = (self.len + 3).min(buf.len());
+            buf[self.len.min(pad_end)..pad_end].fill(0);
+            // The setter may advance `len` (node splits) even when it reports ENOBUFS.
+            let ret = op(
+                buf.as_mut_ptr(),
+                &mut self.len as *mut usize,
+                buf.len(),
+                key_ptr,
+            );
+            if ret == 0 {
+                return Ok(());
+            }
+            let err_no = unsafe { sys::plasmite_lite3_last_errno() };
+            if err_no != libc::ENOBUFS {
+                return Err(encode_error(err_no));
+            }
+            let EncodeBuf::Owned(bytes) = &mut self.buf else {
+                self.exhausted = true;
+                return Err(
+                    Error::new(ErrorKind::Usage).with_message("lite3 payload exceeds buffer")
+                );
+            };
+            if bytes.len() >= MAX_LITE3_BUF {
+                return Err(
+                    Error::new(ErrorKind::Usage).with_message("lite3 buffer exceeded max size")
+                );
+            }
+            let next_len = bytes.len().saturating_mul(2).min(MAX_LITE3_BUF);
+            bytes.resize(next_len, 0);
+        }
+    }
+}
+
+/// Per-thread yyjson allocator for JSON text decoding (`c/lite3_json_arena.c`); a thread that
+/// never decodes JSON text never allocates one.
+struct JsonArena(*mut sys::Lite3Arena);
+
+impl Drop for JsonArena {
+    fn drop(&mut self) {
+        unsafe { sys::plasmite_lite3_arena_free(self.0) };
+    }
+}
+
+thread_local! {
+    static JSON_ARENA: JsonArena = JsonArena(unsafe { sys::plasmite_lite3_arena_new() });
+}
+
+/// Runs one arena decoder writing after the current contents of `bytes`, straight into its
+/// spare capacity. `grow_vec` extends the Vec from inside the decoder, so a document that
+/// outgrows the first size guess is resumed rather than decoded again, and no byte is
+/// zero-filled just to be overwritten.
+fn decode_into_vec(
+    bytes: &mut Vec<u8>,
+    decode: impl FnOnce(*mut sys::Lite3Arena, *mut sys::Lite3Out) -> c_int,
+) -> Result<c_int, Error> {
+    let ctx: *mut Vec<u8> = bytes;
+    // SAFETY: `ctx` comes from a live `&mut Vec<u8>`; only the decoder (via `grow_vec`) touches
+    // the Vec until `set_len` below.
+    let mut out = unsafe {
+        sys::Lite3Out {
+            buf: (*ctx).as_mut_ptr(),
+            len: (*ctx).len(),
+            cap: (*ctx).capacity(),
+            grow: Some(grow_vec),
+            ctx: ctx.cast(),
+        }
     };
-    let json_str = serde_json::to_string(&json).map_err(|err| {
-        Error::new(ErrorKind::Usage)
-            .with_message("failed to serialize json")
-            .with_source(err)
-    })?;
+    let ret = with_json_arena(|arena| decode(arena, &mut out as *mut sys::Lite3Out))?;
+    // SAFETY: the decoder writes every byte below `out.len` (`c/lite3_json_arena.c`), and
+    // `grow_vec` keeps the Vec's allocation the one `out.buf` points into.
+    unsafe { (*ctx).set_len(out.len) };
+    Ok(ret)
+}
+
+/// `Lite3GrowFn` over the `Vec<u8>` behind `ctx`: keeps the `len` bytes written so far, at
+/// least doubles, and never passes `MAX_LITE3_BUF`.
+unsafe extern "C" fn grow_vec(
+    ctx: *mut std::os::raw::c_void,
+    len: usize,
+    min_cap: usize,
+    out_cap: *mut usize,
+) -> *mut u8 {
+    // SAFETY: `ctx` is the Vec handed over by `decode_into_vec`; its first `len` bytes are
+    // initialized by the decoder.
+    let bytes = unsafe { &mut *ctx.cast::<Vec<u8>>() };
+    let target = min_cap
+        .max(bytes.capacity().saturating_mul(2))
+        .min(MAX_LITE3_BUF);
+    if target <= bytes.capacity() {
+        return std::ptr::null_mut();
+    }
+    unsafe { bytes.set_len(len) };
+    if bytes.try_reserve_exact(target - len).is_err() {
+        return std::ptr::null_mut();
+    }
+    unsafe { *out_cap = bytes.capacity() };
+    bytes.as_mut_ptr()
+}
+
+fn with_json_arena<T>(decode: impl FnOnce(*mut sys::Lite3Arena) -> T) -> Result<T, Error> {
+    JSON_ARENA
+        .try_with(|arena| (!arena.0.is_null()).then(|| decode(arena.0)))
+        .ok()
+        .flatten()
+        .ok_or_else(|| Error::new(ErrorKind::Internal).with_message("json arena unavailable"))
+}
+
+fn check_nesting_depth(depth: usize) -> Result<(), Error> {
+    if depth > MAX_VALUE_NESTING_DEPTH {
+        return Err(Error::new(ErrorKind::Usage).with_message("json nesting too deep for lite3"));
+    }
+    Ok(())
+}
+
+fn encode_error(err_no: i32) -> Error {
+    let err = if err_no != 0 {
+        io::Error::from_raw_os_error(err_no)
+    } else {
+        io::Error::other("unknown lite3 errno")
+    };
+    Error::new(ErrorKind::Usage)
+        .with_message("failed to encode json as lite3")
+        .with_source(err)
+}
+
+fn json_write_error(err_no: c_int) -> Error {
+    if err_no == libc::ENOMEM {
+        return Error::new(ErrorKind::Internal).with_message("out of memory writing json");
+    }
+    let message = match err_no {
+        libc::EILSEQ => "invalid utf-8",
+        libc::EDOM => "non-finite number",
+        libc::ELOOP => "lite3 nesting too deep",
+        _ => "invalid lite3 value",
+    };
+    Error::new(ErrorKind::Corrupt)
+        .with_message(message)
+        .with_source(io::Error::from_raw_os_error(err_no))
+}
+
+/// String-escape scan kernel used by `write_json_at` (`avx2`, `sse2`, `neon` or `scalar`).
+pub fn json_scan_kernel() -> &'static str {
+    // SAFETY: the shim returns a pointer to a static, NUL-terminated ASCII literal.
+    let name = unsafe { std::ffi::CStr::from_ptr(sys::plasmite_lite3_json_scan_kernel()) };
+    name.to_str().unwrap_or("scalar")
+}
+
+/// Node-search kernel the vendored Lite3 was built with (`avx2`, `sse2`, `neon` or `scalar`).
+pub fn node_search_kernel() -> &'static str {
+    // SAFETY: the shim returns a pointer to a static, NUL-terminated ASCII literal.
+    let name = unsafe { std::ffi::CStr::from_ptr(sys::plasmite_lite3_node_search_kernel()) };
+    name.to_str().unwrap_or("scalar")
+}
 
-    Lite3Buf::from_json_str(&json_str)
+/// B-tree node size the vendored Lite3 was built with; payloads only round-trip between builds
+/// that agree on it.
+pub fn node_size() -> usize {
+    // SAFETY: takes no arguments and returns a compile-time constant.
+    unsafe { sys::plasmite_lite3_node_size() }
 }
 
 pub fn validate_bytes(buf: &[u8]) -> Result<(), Error> {
     Lite3DocRef::new(buf).validate()
 }
 
+/// Object key path (`meta.tags`, `data.level`) hashed once and reused across documents.
+pub struct Lite3Path {
+    // Owns the NUL-terminated segments that `keys[i].key` points into; CString heap
+    // buffers do not move when the Vec does.
+    segments: Vec<CString>,
+    keys: Vec<sys::Lite3Key>,
+}
+
+// SAFETY: `keys` only points into `segments`, which is owned and never mutated.
+unsafe impl Send for Lite3Path {}
+unsafe impl Sync for Lite3Path {}
+
+impl Lite3Path {
+    /// Compile a dotted path; each `.`-separated segment is one object key.
+    pub fn parse(dotted: &str) -> Result<Self, Error> {
+        Self::new(dotted.split('.'))
+    }
+
+    pub fn new<'s>(segments: impl IntoIterator<Item = &'s str>) -> Result<Self, Error> {
+        let segments = segments
+            .into_iter()
+            .map(|segment| {
+                if segment.is_empty() {
+                    return Err(
+                        Error::new(ErrorKind::Usage).with_message("empty lite3 path segment")
+                    );
+                }
+                CString::new(segment).map_err(|err| {
+                    Error::new(ErrorKind::Usage)
+                        .with_message("lite3 path segment contains null")
+                        .with_source(err)
+                })
+            })
+            .collect::<Result<Vec<_>, _>>()?;
+        Ok(Self::from_cstrings(segments))
+    }
+
+    fn from_cstrings(segments: Vec<CString>) -> Self {
+        let pointers = segments
+            .iter()
+            .map(|segment| segment.as_ptr())
+            .collect::<Vec<_>>();
+        let mut keys = vec![
+            sys::Lite3Key {
+                key: std::ptr::null(),
+                hash: 0,
+                size: 0,
+            };
+            segments.len()
+        ];
+        unsafe {
+            sys::plasmite_lite3_path_compile(pointers.as_ptr(), pointers.len(), keys.as_mut_ptr());
+        }
+        Self { segments, keys }
+    }
+
+    pub fn segments(&self) -> impl Iterator<Item = &str> {
+        self.segments
+            .iter()
+            .map(|segment| segment.to_str().unwrap_or_default())
+    }
+}
+
+impl Clone for Lite3Path {
+    fn clone(&self) -> Self {
+        Self::from_cstrings(self.segments.clone())
+    }
+}
+
+impl PartialEq for Lite3Path {
+    fn eq(&self, other: &Self) -> bool {
+        self.segments == other.segments
+    }
+}
+
+impl std::fmt::Debug for Lite3Path {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_list().entries(self.segments()).finish()
+    }
+}
+
+/// `meta.tags`, looked up on every tag-filtered frame.
+pub(crate) fn meta_tags_path() -> &'static Lite3Path {
+    static PATH: std::sync::LazyLock<Lite3Path> =
+        std::sync::LazyLock::new(|| Lite3Path::new(["meta", "tags"]).expect("static lite3 path"));
+    &PATH
+}
+
 fn c_key(key: &str) -> CString {
     CString::new(key).expect("c key")
 }
@@ -365,6 +1055,147 @@ fn get_key_offset_at(bytes: &[u8], ofs: usize, key: &str) -> Result<usize, Error
     Ok(out_ofs)
 }
 
+fn value_at(bytes: &[u8], ofs: usize, depth: usize) -> Result<Value, Error> {
+    let mut raw = sys::Lite3Value::default();
+    let ret = unsafe {
+        sys::plasmite_lite3_val_read(bytes.as_ptr(), bytes.len(), ofs, &mut raw as *mut _)
+    };
+    if ret < 0 {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 value"));
+    }
+    match raw.type_ {
+        sys::LITE3_TYPE_NULL => Ok(Value::Null),
+        sys::LITE3_TYPE_BOOL => Ok(Value::Bool(raw.boolean)),
+        sys::LITE3_TYPE_I64 => Ok(Value::from(raw.i64)),
+        sys::LITE3_TYPE_F64 => serde_json::Number::from_f64(raw.f64)
+            .map(Value::Number)
+            .ok_or_else(|| Error::new(ErrorKind::Corrupt).with_message("non-finite number")),
+        sys::LITE3_TYPE_BYTES => Ok(Value::String(base64_encode(raw_slice(&raw)))),
+        sys::LITE3_TYPE_STRING => Ok(Value::String(utf8_string(raw_slice(&raw))?)),
+        sys::LITE3_TYPE_OBJECT => object_at(bytes, ofs, depth + 1),
+        sys::LITE3_TYPE_ARRAY => array_at(bytes, ofs, depth + 1),
+        _ => Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 value type")),
+    }
+}
+
+fn object_at(bytes: &[u8], ofs: usize, depth: usize) -> Result<Value, Error> {
+    let mut iter = iter_at(bytes, ofs, depth)?;
+    let mut map = serde_json::Map::new();
+    loop {
+        let mut key_ptr: *const std::os::raw::c_char = std::ptr::null();
+        let mut key_len: usize = 0;
+        let mut val_ofs: usize = 0;
+        let ret = unsafe {
+            sys::plasmite_lite3_iter_next(
+                bytes.as_ptr(),
+                bytes.len(),
+                &mut iter as *mut sys::Lite3Iter,
+                &mut key_ptr as *mut *const std::os::raw::c_char,
+                &mut key_len as *mut usize,
+                &mut val_ofs as *mut usize,
+            )
+        };
+        match ret {
+            sys::LITE3_ITER_DONE => return Ok(Value::Object(map)),
+            sys::LITE3_ITER_ITEM if !key_ptr.is_null() => {
+                let key = unsafe { std::slice::from_raw_parts(key_ptr.cast::<u8>(), key_len) };
+                let key = utf8_string(key)?;
+                let value = value_at(bytes, val_ofs, depth)?;
+                map.insert(key, value);
+            }
+            _ => {
+                return Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 object"));
+            }
+        }
+    }
+}
+
+fn array_at(bytes: &[u8], ofs: usize, depth: usize) -> Result<Value, Error> {
+    let mut iter = iter_at(bytes, ofs, depth)?;
+    let mut items = Vec::new();
+    loop {
+        let mut val_ofs: usize = 0;
+        let ret = unsafe {
+            sys::plasmite_lite3_iter_next(
+                bytes.as_ptr(),
+                bytes.len(),
+                &mut iter as *mut sys::Lite3Iter,
+                std::ptr::null_mut(),
+                std::ptr::null_mut(),
+                &mut val_ofs as *mut usize,
+            )
+        };
+        match ret {
+            sys::LITE3_ITER_DONE => return Ok(Value::Array(items)),
+            sys::LITE3_ITER_ITEM => items.push(value_at(bytes, val_ofs, depth)?),
+            _ => {
+                return Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 array"));
+            }
+        }
+    }
+}
+
+fn iter_at(bytes: &[u8], ofs: usize, depth: usize) -> Result<sys::Lite3Iter, Error> {
+    if depth > MAX_VALUE_NESTING_DEPTH {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("lite3 nesting too deep"));
+    }
+    let mut iter = sys::Lite3Iter::new();
+    let ret = unsafe {
+        sys::plasmite_lite3_iter_create(
+            bytes.as_ptr(),
+            bytes.len(),
+            ofs,
+            &mut iter as *mut sys::Lite3Iter,
+        )
+    };
+    if ret < 0 {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("invalid lite3 container"));
+    }
+    Ok(iter)
+}
+
+fn raw_slice(raw: &sys::Lite3Value) -> &[u8] {
+    if raw.ptr.is_null() || raw.len == 0 {
+        return &[];
+    }
+    unsafe { std::slice::from_raw_parts(raw.ptr, raw.len) }
+}
+
+fn utf8_string(bytes: &[u8]) -> Result<String, Error> {
+    std::str::from_utf8(bytes)
+        .map(str::to_string)
+        .map_err(|err| {
+            Error::new(ErrorKind::Corrupt)
+                .with_message("invalid utf-8")
+                .with_source(err)
+        })
+}
+
+/// Standard padded base64, matching how the vendored JSON encoder renders Lite3 bytes.
+fn base64_encode(bytes: &[u8]) -> String {
+    const ALPHABET: &[u8; 64] = b"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    let mut out = String::with_capacity(bytes.len().div_ceil(3) * 4);
+    for chunk in bytes.chunks(3) {
+        let b0 = chunk[0] as u32;
+        let b1 = chunk.get(1).copied().unwrap_or(0) as u32;
+        let b2 = chunk.get(2).copied().unwrap_or(0) as u32;
+        let triple = (b0 << 16) | (b1 << 8) | b2;
+        out.push(ALPHABET[(triple >> 18) as usize & 63] as char);
+        out.push(ALPHABET[(triple >> 12) as usize & 63] as char);
+        if chunk.len() > 1 {
+            out.push(ALPHABET[(triple >> 6) as usize & 63] as char);
+        } else {
+            out.push('=');
+        }
+        if chunk.len() > 2 {
+            out.push(ALPHABET[triple as usize & 63] as char);
+        } else {
+            out.push('=');
+        }
+    }
+    out
+}
+
 fn array_count(bytes: &[u8], ofs: usize) -> Result<u32, Error> {
     let mut out: u32 = 0;
     let ret = unsafe {
@@ -397,12 +1228,14 @@ fn array_item_type(bytes: &[u8], ofs: usize, index: u32) -> Result<u8, Error> {
 std::thread_local! {
     static TO_JSON_CALLS: Cell<usize> = const { Cell::new(0) };
     static TO_JSON_AT_CALLS: Cell<usize> = const { Cell::new(0) };
+    static TO_VALUE_AT_CALLS: Cell<usize> = const { Cell::new(0) };
 }
 
 #[cfg(test)]
 pub(crate) fn reset_json_counters() {
     TO_JSON_CALLS.with(|count| count.set(0));
     TO_JSON_AT_CALLS.with(|count| count.set(0));
+    TO_VALUE_AT_CALLS.with(|count| count.set(0));
 }
 
 #[cfg(test)]
@@ -413,10 +1246,19 @@ pub(crate) fn json_counter_snapshot() -> (usize, usize) {
     )
 }
 
+#[cfg(test)]
+pub(crate) fn value_counter_snapshot() -> usize {
+    TO_VALUE_AT_CALLS.with(Cell::get)
+}
+
 #[cfg(test)]
 mod tests {
-    use super::{Lite3Buf, encode_message, validate_bytes};
-    use serde_json::json;
+    use super::{
+        Lite3Buf, Lite3Path, Lite3ValueRef, base64_encode, encode_message, encode_message_into,
+        encoded_len_hint, json_scan_kernel, meta_tags_path, node_search_kernel, node_size, sys,
+        validate_bytes,
+    };
+    use serde_json::{Value, json};
 
     #[test]
     fn round_trip_json() {
@@ -429,6 +1271,152 @@ mod tests {
         assert_eq!(value["meta"]["tags"][0], "event");
     }
 
+    #[test]
+    fn lookups_walk_multi_level_objects() {
+        let data = (0..200)
+            .map(|index| (format!("k{index}"), json!(index)))
+            .collect::<serde_json::Map<_, _>>();
+        let buf = encode_message(&[], &serde_json::Value::Object(data)).expect("encode");
+        let doc = buf.as_doc();
+        let data_ofs = doc.key_offset("data").expect("data");
+        for index in 0..200 {
+            let value = doc
+                .i64_at_key(data_ofs, &format!("k{index}"))
+                .expect("lookup");
+            assert_eq!(value, index);
+        }
+        assert!(doc.type_at_key(data_ofs, "absent").is_err());
+        assert!(["avx2", "sse2", "neon", "scalar"].contains(&node_search_kernel()));
+    }
+
+    #[test]
+    fn node_size_matches_c_build() {
+        assert_eq!(node_size(), sys::LITE3_NODE_SIZE);
+    }
+
+    #[test]
+    fn value_ref_at_key_borrows_scalars() {
+        let data = json!({"n": 7, "f": 1.5, "s": "hi", "b": false, "z": null, "o": {}});
+        let buf = encode_message(&[], &data).expect("encode");
+        let doc = buf.as_doc();
+        let Some(Lite3ValueRef::Object(data_ofs)) = doc.value_ref_at_key(0, "data").expect("data")
+        else {
+            panic!("data is not an object");
+        };
+        let get = |key| doc.value_ref_at_key(data_ofs, key).expect("lookup");
+        assert_eq!(get("n"), Some(Lite3ValueRef::I64(7)));
+        assert_eq!(get("f"), Some(Lite3ValueRef::F64(1.5)));
+        assert_eq!(get("s"), Some(Lite3ValueRef::Str("hi")));
+        assert_eq!(get("b"), Some(Lite3ValueRef::Bool(false)));
+        assert_eq!(get("z"), Some(Lite3ValueRef::Null));
+        assert!(matches!(get("o"), Some(Lite3ValueRef::Object(_))));
+        assert_eq!(get("missing"), None);
+    }
+
+    #[test]
+    fn compiled_paths_resolve_nested_values() {
+        let data = json!({"job": {"stage": {"name": "build", "retries": 2}}, "n": 1});
+        let buf = encode_message(&["ci".to_string()], &data).expect("encode");
+        let doc = buf.as_doc();
+        let path = |dotted| Lite3Path::parse(dotted).expect("path");
+
+        assert_eq!(
+            doc.value_ref_at_path(0, &path("data.job.stage.name"))
+                .expect("lookup"),
+            Some(Lite3ValueRef::Str("build"))
+        );
+        assert_eq!(
+            doc.value_ref_at_path(0, &path("data.job.stage.retries"))
+                .expect("lookup"),
+            Some(Lite3ValueRef::I64(2))
+        );
+        assert!(
+            doc.offset_at_path(0, meta_tags_path())
+                .expect("lookup")
+                .is_some()
+        );
+        assert!(matches!(
+            doc.value_ref_at_path(0, meta_tags_path()).expect("lookup"),
+            Some(Lite3ValueRef::Array(_))
+        ));
+
+        assert_eq!(
+            doc.value_ref_at_path(0, &path("data.job.missing"))
+                .expect("lookup"),
+            None
+        );
+        // Indexing through a scalar is "not found", not corruption.
+        assert_eq!(
+            doc.value_ref_at_path(0, &path("data.n.deeper"))
+                .expect("lookup"),
+            None
+        );
+    }
+
+    #[test]
+    fn compiled_paths_reject_empty_segments() {
+        for dotted in ["", "data.", ".data", "data..level"] {
+            let err = Lite3Path::parse(dotted).expect_err("empty segment");
+            assert_eq!(err.kind(), crate::core::error::ErrorKind::Usage);
+        }
+        let path = Lite3Path::parse("data.level").expect("path");
+        assert_eq!(path.segments().collect::<Vec<_>>(), ["data", "level"]);
+        assert_eq!(path.clone(), path);
+    }
+
+    #[test]
+    fn write_json_at_matches_serde_json() {
+        let wide: serde_json::Map<String, serde_json::Value> =
+            (0..40).map(|i| (format!("k{i}"), json!(i))).collect();
+        let data = json!({
+            "s": "plain ascii text that is longer than one simd block of bytes",
+            "esc": "q\"b\\n\nt\tc\u{1}\u{1f}\u{7f}/",
+            "utf8": "héllo 中文 😀",
+            "ints": [0, -1, i64::MIN, i64::MAX],
+            "floats": [0.0, -0.0, 1.0, 1.5, 0.1, 1e15, 1e16, 1e17, 1e20, 1e-5, 1e-7, -2.5e-300],
+            "z": null,
+            "t": true,
+            "f": false,
+            "nested": {"b": [{"c": {}}, []], "a": "x"},
+            "wide": wide,
+            "": "empty key",
+        });
+        let buf = encode_message(&[], &data).expect("encode");
+        let doc = buf.as_doc();
+        let data_ofs = doc.key_offset("data").expect("data offset");
+
+        let mut out = Vec::new();
+        doc.write_json_at(data_ofs, &mut out).expect("write");
+        assert_eq!(
+            String::from_utf8(out).expect("utf-8"),
+            serde_json::to_string(&data).expect("serialize")
+        );
+
+        // Appends after existing bytes, growing from a too-small buffer.
+        let mut out = Vec::with_capacity(4);
+        out.extend_from_slice(b"[");
+        doc.write_json_at(data_ofs, &mut out).expect("write");
+        assert_eq!(out[0], b'[');
+        assert_eq!(
+            serde_json::from_slice::<Value>(&out[1..]).expect("parse"),
+            data
+        );
+        assert!(!json_scan_kernel().is_empty());
+    }
+
+    #[test]
+    fn values_cut_off_by_the_buffer_end_are_rejected() {
+        let buf = encode_message(&[], &json!({"n": 1234567, "s": "text"})).expect("encode");
+        let bytes = buf.as_slice();
+        let data_ofs = super::get_key_offset_at(bytes, 0, "data").expect("data");
+        for key in ["n", "s"] {
+            let val_ofs = super::get_key_offset_at(bytes, data_ofs, key).expect("value");
+            // Keep the type byte but not the whole scalar (or string length prefix).
+            let err = super::value_at(&bytes[..val_ofs + 3], val_ofs, 0).expect_err("truncated");
+            assert_eq!(err.kind(), crate::core::error::ErrorKind::Corrupt);
+        }
+    }
+
     #[test]
     fn invalid_bytes_are_rejected() {
         let buf = [0u8; 8];
@@ -460,4 +1448,198 @@ mod tests {
             "event".to_string()
         );
     }
+
+    #[test]
+    fn to_value_matches_json_text_round_trip() {
+        let wide: serde_json::Map<String, serde_json::Value> =
+            (0..40).map(|i| (format!("k{i}"), json!(i))).collect();
+        let data = json!({
+            "s": "héllo \"quoted\"",
+            "n": -42,
+            "f": 1.5,
+            "whole": 2.0,
+            "t": true,
+            "z": null,
+            "arr": [1, "two", [3.25, {"deep": false}], {}],
+            "obj": {"a": {"b": {"c": []}}},
+            "wide": wide,
+        });
+        let buf = encode_message(&["a".to_string(), "b".to_string()], &data).expect("encode");
+        let doc = buf.as_doc();
+        let via_text: serde_json::Value =
+            serde_json::from_str(&doc.to_json(false).expect("json")).expect("parse");
+        assert_eq!(doc.to_value().expect("value"), via_text);
+
+        let data_ofs = doc.key_offset("data").expect("data offset");
+        assert_eq!(doc.to_value_at(data_ofs).expect("data value"), data);
+    }
+
+    #[test]
+    fn encode_message_matches_json_text_encoding() {
+        let tags = vec!["a".to_string(), "b\"c".to_string()];
+        let data = json!({
+            "s": "nul\0inside",
+            "n": i64::MIN,
+            "big": u64::MAX,
+            "f": -0.25,
+            "t": false,
+            "z": null,
+            "arr": [null, 1, [2, [3]], {"k": "v"}],
+            "obj": {"nested": {"empty": {}}},
+        });
+        let direct = encode_message(&tags, &data).expect("encode");
+        validate_bytes(direct.as_slice()).expect("valid");
+
+        let text = format!(
+            r#"{{"meta":{{"tags":{}}},"data":{}}}"#,
+            serde_json::to_string(&tags).expect("tags"),
+            serde_json::to_string(&data).expect("data")
+        );
+        let via_text = Lite3Buf::from_json_str(&text).expect("lite3");
+        assert_eq!(
+            direct.as_doc().to_value().expect("direct"),
+            via_text.as_doc().to_value().expect("via text")
+        );
+    }
+
+    #[test]
+    fn encode_message_grows_buffer_in_place() {
+        let items: Vec<serde_json::Value> = (0..2000)
+            .map(|i| json!({"id": i, "name": format!("item-{i}"), "pad": "x".repeat(64)}))
+            .collect();
+        let data = json!({"items": items});
+        let buf = encode_message(&["bulk".to_string()], &data).expect("encode");
+        assert!(buf.len() > super::ENCODE_INITIAL_BUF);
+        let doc = buf.as_doc();
+        let data_ofs = doc.key_offset("data").expect("data offset");
+        assert_eq!(doc.to_value_at(data_ofs).expect("data"), data);
+    }
+
+    #[test]
+    fn encode_message_rejects_nul_keys_and_deep_nesting() {
+        let err = encode_message(&[], &json!({"a\0b": 1})).expect_err("nul key");
+        assert_eq!(err.kind(), crate::core::error::ErrorKind::Usage);
+
+        let mut deep = json!(1);
+        for _ in 0..super::MAX_VALUE_NESTING_DEPTH {
+            deep = json!([deep]);
+        }
+        let err = encode_message(&[], &json!({ "deep": deep })).expect_err("too deep");
+        assert_eq!(err.kind(), crate::core::error::ErrorKind::Usage);
+    }
+
+    #[test]
+    fn encode_message_json_matches_value_encoding() {
+        let tags = vec!["a".to_string(), "b\"c".to_string()];
+        let mut data = json!({
+            "s": "nul\0inside",
+            "n": i64::MIN,
+            "big": u64::MAX,
+            "f": -0.25,
+            "t": false,
+            "z": null,
+            "arr": [null, 1, [2, [3]], {"k": "v"}],
+            "obj": {"nested": {"empty": {}}},
+        });
+        data["wide"] = (0..200)
+            .map(|i| (format!("k{i}"), json!("x".repeat(i))))
+            .collect::<serde_json::Map<_, _>>()
+            .into();
+        let direct = encode_message(&tags, &data).expect("encode");
+        // Several rounds so later messages reuse (and outgrow) the warmed-up arena.
+        for _ in 0..3 {
+            let text = serde_json::to_string(&data).expect("data");
+            let via_text = super::encode_message_json(&tags, &text)
+                .expect("encode json")
+                .expect("parses");
+            validate_bytes(via_text.as_slice()).expect("valid");
+            assert_eq!(
+                direct.as_doc().to_value().expect("direct"),
+                via_text.as_doc().to_value().expect("via text")
+            );
+        }
+    }
+
+    #[test]
+    fn json_text_decoding_grows_past_the_first_size_guess() {
+        // Small ints expand far more than the decoder's per-value guess, forcing in-place growth.
+        let data = json!({"ints": (0..20_000).collect::<Vec<i64>>(), "tail": "end"});
+        let text = serde_json::to_string(&data).expect("data");
+
+        let root = Lite3Buf::from_json_str(&text).expect("lite3");
+        assert!(root.len() > 4 * text.len());
+        assert_eq!(root.as_doc().to_value().expect("root"), data);
+
+        let message = super::encode_message_json(&[], &text)
+            .expect("encode json")
+            .expect("parses");
+        validate_bytes(message.as_slice()).expect("valid");
+        let doc = message.as_doc();
+        let data_ofs = doc.key_offset("data").expect("data offset");
+        assert_eq!(doc.to_value_at(data_ofs).expect("data"), data);
+    }
+
+    #[test]
+    fn encode_message_json_separates_parse_errors_from_encode_errors() {
+        for text in ["{\"a\":", "nope", "{} {}", "{\"s\":\"\\ud800\"}"] {
+            assert!(
+                super::encode_message_json(&[], text)
+                    .expect("no encode error")
+                    .is_none(),
+                "{text}"
+            );
+        }
+        for text in ["[1]", "42", r#"{"a\u0000b":1}"#] {
+            let err = super::encode_message_json(&[], text).expect_err(text);
+            assert_eq!(err.kind(), crate::core::error::ErrorKind::Usage);
+        }
+
+        let nest =
+            |depth: usize| format!(r#"{{"deep":{}1{}}}"#, "[".repeat(depth), "]".repeat(depth));
+        let limit = super::MAX_VALUE_NESTING_DEPTH - 2;
+        assert!(
+            super::encode_message_json(&[], &nest(limit))
+                .expect("at limit")
+                .is_some()
+        );
+        let err = super::encode_message_json(&[], &nest(limit + 1)).expect_err("too deep");
+        assert_eq!(err.kind(), crate::core::error::ErrorKind::Usage);
+    }
+
+    #[test]
+    fn encode_message_into_writes_in_place() {
+        let tags = vec!["t".to_string()];
+        let data = json!({"k": "v", "list": [1, 2, 3], "nested": {"deep": [true, null]}});
+        let heap = encode_message(&tags, &data).expect("encode");
+        let hint = encoded_len_hint(&tags, &data);
+        assert!(hint >= heap.len());
+
+        let mut slot = vec![0xAAu8; hint];
+        let len = encode_message_into(&tags, &data, &mut slot)
+            .expect("encode into")
+            .expect("fits");
+        assert_eq!(&slot[..len], heap.as_slice());
+
+        let mut small = vec![0u8; heap.len() / 2];
+        assert_eq!(
+            encode_message_into(&tags, &data, &mut small).expect("no error"),
+            None
+        );
+    }
+
+    #[test]
+    fn to_value_rejects_garbage() {
+        let buf = [0xFFu8; 16];
+        let doc = super::Lite3DocRef::new(&buf);
+        assert!(doc.to_value().is_err());
+    }
+
+    #[test]
+    fn base64_encode_pads_like_json_encoder() {
+        assert_eq!(base64_encode(b""), "");
+        assert_eq!(base64_encode(b"f"), "Zg==");
+        assert_eq!(base64_encode(b"fo"), "Zm8=");
+        assert_eq!(base64_encode(b"foo"), "Zm9v");
+        assert_eq!(base64_encode(b"foobar"), "Zm9vYmFy");
+    }
 }
@@ -5,6 +5,23 @@
 //! Invariants: Any heap pointer returned from the shim is freed via `plasmite_lite3_free`.
 use std::os::raw::{c_char, c_int, c_uchar, c_void};
 
+// Mirrors `LITE3_NODE_SIZE` as `build.rs` configures it (`lite3-node-*` features; default 96).
+#[cfg(feature = "lite3-node-48")]
+pub const LITE3_NODE_SIZE: usize = 48;
+#[cfg(feature = "lite3-node-192")]
+pub const LITE3_NODE_SIZE: usize = 192;
+#[cfg(feature = "lite3-node-384")]
+pub const LITE3_NODE_SIZE: usize = 384;
+#[cfg(feature = "lite3-node-768")]
+pub const LITE3_NODE_SIZE: usize = 768;
+#[cfg(not(any(
+    feature = "lite3-node-48",
+    feature = "lite3-node-192",
+    feature = "lite3-node-384",
+    feature = "lite3-node-768"
+)))]
+pub const LITE3_NODE_SIZE: usize = 96;
+
 pub const LITE3_TYPE_NULL: u8 = 0;
 pub const LITE3_TYPE_BOOL: u8 = 1;
 pub const LITE3_TYPE_I64: u8 = 2;
@@ -15,6 +32,84 @@ pub const LITE3_TYPE_OBJECT: u8 = 6;
 pub const LITE3_TYPE_ARRAY: u8 = 7;
 pub const LITE3_TYPE_INVALID: u8 = 8;
 
+pub const LITE3_ITER_ITEM: c_int = 1;
+pub const LITE3_ITER_DONE: c_int = 0;
+
+/// Mirrors `plasmite_lite3_iter`: opaque storage for a stack-allocated `lite3_iter`.
+#[repr(C)]
+pub struct Lite3Iter {
+    opaque: [u64; 16],
+}
+
+impl Lite3Iter {
+    pub fn new() -> Self {
+        Self { opaque: [0; 16] }
+    }
+}
+
+impl Default for Lite3Iter {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Mirrors `plasmite_lite3_value`; `ptr`/`len` borrow from the Lite3 buffer.
+#[repr(C)]
+pub struct Lite3Value {
+    pub type_: c_uchar,
+    pub boolean: bool,
+    pub i64: i64,
+    pub f64: f64,
+    pub ptr: *const c_uchar,
+    pub len: usize,
+}
+
+impl Default for Lite3Value {
+    fn default() -> Self {
+        Self {
+            type_: LITE3_TYPE_INVALID,
+            boolean: false,
+            i64: 0,
+            f64: 0.0,
+            ptr: std::ptr::null(),
+            len: 0,
+        }
+    }
+}
+
+/// Mirrors `plasmite_lite3_key`; `key` borrows a NUL-terminated segment.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct Lite3Key {
+    pub key: *const c_char,
+    pub hash: u32,
+    pub size: u32,
+}
+
+/// Opaque `plasmite_lite3_arena`; only ever handled through a pointer.
+#[repr(C)]
+pub struct Lite3Arena {
+    _opaque: [u8; 0],
+}
+
+/// `plasmite_lite3_out.grow`: `(ctx, len, min_cap, out_cap) -> buf`, NULL to give up.
+pub type Lite3GrowFn = unsafe extern "C" fn(
+    ctx: *mut c_void,
+    len: usize,
+    min_cap: usize,
+    out_cap: *mut usize,
+) -> *mut c_uchar;
+
+/// Mirrors `plasmite_lite3_out`: decoder output; bytes in `len..cap` may be uninitialized.
+#[repr(C)]
+pub struct Lite3Out {
+    pub buf: *mut c_uchar,
+    pub len: usize,
+    pub cap: usize,
+    pub grow: Option<Lite3GrowFn>,
+    pub ctx: *mut c_void,
+}
+
 unsafe extern "C" {
     pub fn plasmite_lite3_json_dec(
         json_str: *const c_char,
@@ -95,7 +190,144 @@ unsafe extern "C" {
         out_len: *mut usize,
     ) -> c_int;
 
+    pub fn plasmite_lite3_iter_create(
+        buf: *const c_uchar,
+        buf_len: usize,
+        ofs: usize,
+        out: *mut Lite3Iter,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_iter_next(
+        buf: *const c_uchar,
+        buf_len: usize,
+        iter: *mut Lite3Iter,
+        out_key: *mut *const c_char,
+        out_key_len: *mut usize,
+        out_val_ofs: *mut usize,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_val_read(
+        buf: *const c_uchar,
+        buf_len: usize,
+        val_ofs: usize,
+        out: *mut Lite3Value,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_path_compile(
+        segments: *const *const c_char,
+        count: usize,
+        out: *mut Lite3Key,
+    );
+
+    pub fn plasmite_lite3_path_get(
+        buf: *const c_uchar,
+        buf_len: usize,
+        ofs: usize,
+        path: *const Lite3Key,
+        count: usize,
+        out_ofs: *mut usize,
+        out_val: *mut Lite3Value,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_init_obj(buf: *mut c_uchar, out_len: *mut usize, buf_sz: usize) -> c_int;
+
+    pub fn plasmite_lite3_set_null(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_set_bool(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+        value: bool,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_set_i64(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+        value: i64,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_set_f64(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+        value: f64,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_set_str(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+        str_ptr: *const c_char,
+        str_len: usize,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_set_obj(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+        out_ofs: *mut usize,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_set_arr(
+        buf: *mut c_uchar,
+        inout_len: *mut usize,
+        ofs: usize,
+        buf_sz: usize,
+        key: *const c_char,
+        out_ofs: *mut usize,
+    ) -> c_int;
+
     pub fn plasmite_lite3_last_errno() -> c_int;
 
     pub fn plasmite_lite3_free(ptr: *mut c_void);
+
+    pub fn plasmite_lite3_node_search_kernel() -> *const c_char;
+
+    pub fn plasmite_lite3_node_size() -> usize;
+
+    pub fn plasmite_lite3_json_write(
+        buf: *const c_uchar,
+        buf_len: usize,
+        ofs: usize,
+        out: *mut c_char,
+        out_cap: usize,
+    ) -> i64;
+
+    pub fn plasmite_lite3_json_scan_kernel() -> *const c_char;
+
+    pub fn plasmite_lite3_arena_new() -> *mut Lite3Arena;
+
+    pub fn plasmite_lite3_arena_free(arena: *mut Lite3Arena);
+
+    pub fn plasmite_lite3_json_dec_arena(
+        arena: *mut Lite3Arena,
+        json_str: *const c_char,
+        json_len: usize,
+        out: *mut Lite3Out,
+    ) -> c_int;
+
+    pub fn plasmite_lite3_json_dec_set(
+        arena: *mut Lite3Arena,
+        out: *mut Lite3Out,
+        key: *const c_char,
+        json_str: *const c_char,
+        json_len: usize,
+    ) -> c_int;
 }
@@ -0,0 +1,558 @@
+//! Purpose: Always-on hot-path counters and log-scale histograms for pools and the Lite3 codec.
+//! Exports: `HotMetrics`, `LogHistogram`, `Lite3CodecMetrics`, `lite3_codec_metrics`,
+//! `HISTOGRAM_BUCKETS`.
+//! Role: Explains latency spikes (lock contention, index misses, resyncs) without a profiler.
+//! Invariants: Pool counters live in header bytes `METRICS_OFFSET..METRICS_END`, outside
+//! Invariants: `PoolHeader`, so every process mapping a pool adds to (and reads) the same totals.
+//! Invariants: Pools written by builds without counters read zero there; nothing validates it.
+//! Invariants: Updates are relaxed atomic adds and never fail; snapshots are not point-in-time.
+//! Invariants: Writer and reader counters sit on separate cache lines.
+//! Invariants: Lite3 codec counters are per process; one call in `CODEC_TIMING_SAMPLE` per
+//! Invariants: thread is timed, so `calls` advances in steps of that size.
+use std::cell::Cell;
+use std::fmt::Write as _;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::time::{Duration, Instant};
+
+use serde_json::{Value, json};
+
+/// First header byte of the counter region (cache-line aligned, after the writer lease slot).
+pub(crate) const METRICS_OFFSET: usize = 128;
+const COUNTER_SLOTS: usize = 16;
+/// Bucket `k` counts values in `(4^(k-1), 4^k]` (bucket 0: `0..=1`); the last is unbounded.
+pub const HISTOGRAM_BUCKETS: usize = 16;
+const HISTOGRAM_OFFSET: usize = METRICS_OFFSET + COUNTER_SLOTS * 8;
+const HISTOGRAMS: usize = 3;
+pub(crate) const METRICS_END: usize = HISTOGRAM_OFFSET + HISTOGRAMS * HISTOGRAM_BUCKETS * 8;
+/// One Lite3 encode/decode call in this many (per thread) is timed.
+const CODEC_TIMING_SAMPLE: u32 = 16;
+
+/// Counter slot indexes. Slots 0..8 are bumped by writers (under the append lock), 8..16 by
+/// readers, so tail-heavy workloads do not bounce the writer's line.
+#[derive(Clone, Copy, Debug)]
+pub(crate) enum Counter {
+    LockAcquires = 0,
+    LockContended = 1,
+    LockWaitNs = 2,
+    LockHoldNs = 3,
+    NotifyPosts = 4,
+    GroupCommitFlushes = 5,
+    GroupCommitAppends = 6,
+    IndexHits = 8,
+    IndexMisses = 9,
+    ScanFallbacks = 10,
+    ScanFrames = 11,
+    CursorResyncs = 12,
+    NotifyWaits = 13,
+    NotifyWakeups = 14,
+}
+
+#[derive(Clone, Copy, Debug)]
+pub(crate) enum Histogram {
+    LockWaitNs = 0,
+    LockHoldNs = 1,
+    ScanFrames = 2,
+}
+
+/// Handle on the counter region of a mapped pool header.
+#[derive(Clone, Copy)]
+pub(crate) struct HeaderMetrics<'a> {
+    page: &'a [u8],
+}
+
+impl<'a> HeaderMetrics<'a> {
+    pub(crate) fn new(page: &'a [u8]) -> Self {
+        debug_assert!(page.len() >= METRICS_END);
+        Self { page }
+    }
+
+    pub(crate) fn add(self, counter: Counter, n: u64) {
+        self.slot(METRICS_OFFSET + counter as usize * 8)
+            .fetch_add(n, Ordering::Relaxed);
+    }
+
+    pub(crate) fn record(self, histogram: Histogram, value: u64) {
+        let offset =
+            HISTOGRAM_OFFSET + (histogram as usize * HISTOGRAM_BUCKETS + bucket(value)) * 8;
+        self.slot(offset).fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Count one append-lock acquisition that waited `waited` (contended or not).
+    pub(crate) fn lock_acquired(self, waited: Duration, contended: bool) {
+        let waited_ns = duration_ns(waited);
+        self.add(Counter::LockAcquires, 1);
+        if contended {
+            self.add(Counter::LockContended, 1);
+        }
+        self.add(Counter::LockWaitNs, waited_ns);
+        self.record(Histogram::LockWaitNs, waited_ns);
+    }
+
+    pub(crate) fn lock_released(self, held: Duration) {
+        let held_ns = duration_ns(held);
+        self.add(Counter::LockHoldNs, held_ns);
+        self.record(Histogram::LockHoldNs, held_ns);
+    }
+
+    /// Count a `get` that fell back to scanning `frames` frames from the tail.
+    pub(crate) fn scan_fallback(self, frames: u64) {
+        self.add(Counter::ScanFallbacks, 1);
+        self.add(Counter::ScanFrames, frames);
+        self.record(Histogram::ScanFrames, frames);
+    }
+
+    pub(crate) fn snapshot(self) -> HotMetrics {
+        let counter = |counter: Counter| self.load(METRICS_OFFSET + counter as usize * 8);
+        let histogram = |histogram: Histogram| {
+            let base = HISTOGRAM_OFFSET + histogram as usize * HISTOGRAM_BUCKETS * 8;
+            LogHistogram {
+                buckets: std::array::from_fn(|bucket| self.load(base + bucket * 8)),
+            }
+        };
+        HotMetrics {
+            append_lock_acquires: counter(Counter::LockAcquires),
+            append_lock_contended: counter(Counter::LockContended),
+            append_lock_wait_ns: counter(Counter::LockWaitNs),
+            append_lock_hold_ns: counter(Counter::LockHoldNs),
+            append_lock_wait: histogram(Histogram::LockWaitNs),
+            append_lock_hold: histogram(Histogram::LockHoldNs),
+            index_hits: counter(Counter::IndexHits),
+            index_misses: counter(Counter::IndexMisses),
+            scan_fallbacks: counter(Counter::ScanFallbacks),
+            scan_frames: counter(Counter::ScanFrames),
+            scan_length: histogram(Histogram::ScanFrames),
+            cursor_resyncs: counter(Counter::CursorResyncs),
+            notify_posts: counter(Counter::NotifyPosts),
+            notify_waits: counter(Counter::NotifyWaits),
+            notify_wakeups: counter(Counter::NotifyWakeups),
+            group_commit_flushes: counter(Counter::GroupCommitFlushes),
+            group_commit_appends: counter(Counter::GroupCommitAppends),
+        }
+    }
+
+    fn load(self, offset: usize) -> u64 {
+        self.slot(offset).load(Ordering::Relaxed)
+    }
+
+    fn slot(self, offset: usize) -> &'a AtomicU64 {
+        let slot = &self.page[offset..offset + 8];
+        // SAFETY: 8-byte aligned inside the page-aligned shared mapping; only accessed atomically.
+        unsafe { &*(slot.as_ptr() as *const AtomicU64) }
+    }
+}
+
+fn bucket(value: u64) -> usize {
+    if value <= 1 {
+        return 0;
+    }
+    let bits = 64 - (value - 1).leading_zeros() as usize;
+    bits.div_ceil(2).min(HISTOGRAM_BUCKETS - 1)
+}
+
+fn duration_ns(duration: Duration) -> u64 {
+    u64::try_from(duration.as_nanos()).unwrap_or(u64::MAX)
+}
+
+/// Pool-wide hot-path totals since the pool was created, summed over every process.
+#[derive(Clone, Debug, Default, Eq, PartialEq)]
+pub struct HotMetrics {
+    pub append_lock_acquires: u64,
+    /// Acquisitions that found the lock held and had to block.
+    pub append_lock_contended: u64,
+    pub append_lock_wait_ns: u64,
+    /// Time from acquisition to release for appends (reservations included).
+    pub append_lock_hold_ns: u64,
+    pub append_lock_wait: LogHistogram,
+    pub append_lock_hold: LogHistogram,
+    pub index_hits: u64,
+    /// `get` calls whose seq index slot was stale or missing (pools with an index only).
+    pub index_misses: u64,
+    pub scan_fallbacks: u64,
+    /// Frames between the tail and the target, summed over scan fallbacks.
+    pub scan_frames: u64,
+    pub scan_length: LogHistogram,
+    /// Cursor reads that found their position evicted and restarted at the tail.
+    pub cursor_resyncs: u64,
+    pub notify_posts: u64,
+    pub notify_waits: u64,
+    /// Waits that ended on a post rather than a timeout.
+    pub notify_wakeups: u64,
+    /// Syncs made by group-commit flushers (`Durability::GroupCommit`).
+    pub group_commit_flushes: u64,
+    /// Appends made durable by those syncs; divided by flushes, the average batch size.
+    pub group_commit_appends: u64,
+}
+
+/// Counts per power-of-four bucket; see `HISTOGRAM_BUCKETS`.
+#[derive(Clone, Debug, Default, Eq, PartialEq)]
+pub struct LogHistogram {
+    pub buckets: [u64; HISTOGRAM_BUCKETS],
+}
+
+impl LogHistogram {
+    /// Inclusive upper bound of `bucket`; `None` for the last, unbounded one.
+    pub fn upper_bound(bucket: usize) -> Option<u64> {
+        (bucket + 1 < HISTOGRAM_BUCKETS).then(|| 1u64 << (2 * bucket))
+    }
+
+    pub fn count(&self) -> u64 {
+        self.buckets.iter().sum()
+    }
+
+    fn to_json(&self) -> Value {
+        json!(self.buckets.as_slice())
+    }
+
+    fn write_prometheus(&self, out: &mut String, name: &str, labels: &str, sum: u64, scale: f64) {
+        let mut cumulative = 0;
+        for (bucket, count) in self.buckets.iter().enumerate() {
+            cumulative += count;
+            let le = match Self::upper_bound(bucket) {
+                Some(bound) => (bound as f64 * scale).to_string(),
+                None => "+Inf".to_string(),
+            };
+            let _ = writeln!(out, "{name}_bucket{{{labels},le=\"{le}\"}} {cumulative}");
+        }
+        let _ = writeln!(out, "{name}_sum{{{labels}}} {}", sum as f64 * scale);
+        let _ = writeln!(out, "{name}_count{{{labels}}} {cumulative}");
+    }
+}
+
+impl HotMetrics {
+    pub fn to_json(&self) -> Value {
+        json!({
+            "append_lock": {
+                "acquires": self.append_lock_acquires,
+                "contended": self.append_lock_contended,
+                "wait_ns": self.append_lock_wait_ns,
+                "hold_ns": self.append_lock_hold_ns,
+                "wait_ns_buckets": self.append_lock_wait.to_json(),
+                "hold_ns_buckets": self.append_lock_hold.to_json(),
+            },
+            "get": {
+                "index_hits": self.index_hits,
+                "index_misses": self.index_misses,
+                "scan_fallbacks": self.scan_fallbacks,
+                "scan_frames": self.scan_frames,
+                "scan_frames_buckets": self.scan_length.to_json(),
+            },
+            "cursor": {
+                "resyncs": self.cursor_resyncs,
+            },
+            "notify": {
+                "posts": self.notify_posts,
+                "waits": self.notify_waits,
+                "wakeups": self.notify_wakeups,
+            },
+            "group_commit": {
+                "flushes": self.group_commit_flushes,
+                "appends": self.group_commit_appends,
+            },
+        })
+    }
+
+    /// Append Prometheus text-format samples labeled with `pool`.
+    pub fn write_prometheus(&self, out: &mut String, pool: &str) {
+        let labels = format!("pool=\"{}\"", escape_label(pool));
+        let counters = [
+            (
+                "plasmite_append_lock_acquires_total",
+                "Append lock acquisitions.",
+                self.append_lock_acquires,
+            ),
+            (
+                "plasmite_append_lock_contended_total",
+                "Append lock acquisitions that blocked on another holder.",
+                self.append_lock_contended,
+            ),
+            (
+                "plasmite_get_index_hits_total",
+                "Gets resolved through the seq index.",
+                self.index_hits,
+            ),
+            (
+                "plasmite_get_index_misses_total",
+                "Gets whose seq index entry was stale or missing.",
+                self.index_misses,
+            ),
+            (
+                "plasmite_get_scan_fallbacks_total",
+                "Gets resolved by scanning from the tail.",
+                self.scan_fallbacks,
+            ),
+            (
+                "plasmite_cursor_resyncs_total",
+                "Cursor reads restarted at the tail after their position was evicted.",
+                self.cursor_resyncs,
+            ),
+            (
+                "plasmite_notify_posts_total",
+                "Notify posts made by writers.",
+                self.notify_posts,
+            ),
+            (
+                "plasmite_notify_waits_total",
+                "Notify waits made by readers.",
+                self.notify_waits,
+            ),
+            (
+                "plasmite_notify_wakeups_total",
+                "Notify waits that ended on a post.",
+                self.notify_wakeups,
+            ),
+            (
+                "plasmite_group_commit_flushes_total",
+                "Syncs made by group-commit flushers.",
+                self.group_commit_flushes,
+            ),
+            (
+                "plasmite_group_commit_appends_total",
+                "Appends made durable by group-commit syncs.",
+                self.group_commit_appends,
+            ),
+        ];
+        for (name, help, value) in counters {
+            let _ = writeln!(out, "# HELP {name} {help}");
+            let _ = writeln!(out, "# TYPE {name} counter");
+            let _ = writeln!(out, "{name}{{{labels}}} {value}");
+        }
+        let histograms = [
+            (
+                "plasmite_append_lock_wait_seconds",
+                "Time spent acquiring the append lock.",
+                &self.append_lock_wait,
+                self.append_lock_wait_ns,
+                1e-9,
+            ),
+            (
+                "plasmite_append_lock_hold_seconds",
+                "Time the append lock was held per append.",
+                &self.append_lock_hold,
+                self.append_lock_hold_ns,
+                1e-9,
+            ),
+            (
+                "plasmite_get_scan_frames",
+                "Frames between the tail and the target per scan fallback.",
+                &self.scan_length,
+                self.scan_frames,
+                1.0,
+            ),
+        ];
+        for (name, help, histogram, sum, scale) in histograms {
+            let _ = writeln!(out, "# HELP {name} {help}");
+            let _ = writeln!(out, "# TYPE {name} histogram");
+            histogram.write_prometheus(out, name, &labels, sum, scale);
+        }
+    }
+}
+
+fn escape_label(value: &str) -> String {
+    value
+        .replace('\\', "\\\\")
+        .replace('"', "\\\"")
+        .replace('\n', "\\n")
+}
+
+/// Process-wide Lite3 call counts and sampled time. "Encode" builds Lite3 (from JSON text or a
+/// `Value`); "decode" reads it back out (JSON text or a `Value`).
+#[derive(Clone, Debug, Default, Eq, PartialEq)]
+pub struct Lite3CodecMetrics {
+    pub encode_calls: u64,
+    pub encode_timed: u64,
+    pub encode_timed_ns: u64,
+    pub decode_calls: u64,
+    pub decode_timed: u64,
+    pub decode_timed_ns: u64,
+}
+
+impl Lite3CodecMetrics {
+    pub fn to_json(&self) -> Value {
+        json!({
+            "encode_calls": self.encode_calls,
+            "encode_timed": self.encode_timed,
+            "encode_timed_ns": self.encode_timed_ns,
+            "decode_calls": self.decode_calls,
+            "decode_timed": self.decode_timed,
+            "decode_timed_ns": self.decode_timed_ns,
+        })
+    }
+
+    /// Append Prometheus text-format samples (no pool label: the codec is process-wide).
+    pub fn write_prometheus(&self, out: &mut String) {
+        for (op, calls, timed, timed_ns) in [
+            (
+                "encode",
+                self.encode_calls,
+                self.encode_timed,
+                self.encode_timed_ns,
+            ),
+            (
+                "decode",
+                self.decode_calls,
+                self.decode_timed,
+                self.decode_timed_ns,
+            ),
+        ] {
+            let _ = writeln!(
+                out,
+                "# HELP plasmite_lite3_{op}_calls_total Lite3 {op} calls."
+            );
+            let _ = writeln!(out, "# TYPE plasmite_lite3_{op}_calls_total counter");
+            let _ = writeln!(out, "plasmite_lite3_{op}_calls_total {calls}");
+            let _ = writeln!(
+                out,
+                "# HELP plasmite_lite3_{op}_sampled_seconds Time spent in sampled Lite3 {op} calls."
+            );
+            let _ = writeln!(out, "# TYPE plasmite_lite3_{op}_sampled_seconds summary");
+            let _ = writeln!(
+                out,
+                "plasmite_lite3_{op}_sampled_seconds_sum {}",
+                timed_ns as f64 * 1e-9
+            );
+            let _ = writeln!(out, "plasmite_lite3_{op}_sampled_seconds_count {timed}");
+        }
+    }
+}
+
+pub(crate) struct CodecOp {
+    tick: usize,
+    timed: AtomicU64,
+    timed_ns: AtomicU64,
+}
+
+pub(crate) static LITE3_ENCODE: CodecOp = CodecOp::new(0);
+pub(crate) static LITE3_DECODE: CodecOp = CodecOp::new(1);
+
+thread_local! {
+    static CODEC_TICKS: [Cell<u32>; 2] = const { [Cell::new(0), Cell::new(0)] };
+}
+
+impl CodecOp {
+    const fn new(tick: usize) -> Self {
+        Self {
+            tick,
+            timed: AtomicU64::new(0),
+            timed_ns: AtomicU64::new(0),
+        }
+    }
+
+    fn snapshot(&self) -> (u64, u64, u64) {
+        let timed = self.timed.load(Ordering::Relaxed);
+        let timed_ns = self.timed_ns.load(Ordering::Relaxed);
+        (timed * u64::from(CODEC_TIMING_SAMPLE), timed, timed_ns)
+    }
+}
+
+/// Times one codec call in `CODEC_TIMING_SAMPLE`; the rest cost a thread-local increment.
+pub(crate) struct CodecTimer {
+    op: &'static CodecOp,
+    started: Option<Instant>,
+}
+
+impl CodecTimer {
+    pub(crate) fn start(op: &'static CodecOp) -> Self {
+        let due = CODEC_TICKS.with(|ticks| {
+            let tick = &ticks[op.tick];
+            let next = tick.get() + 1;
+            tick.set(next % CODEC_TIMING_SAMPLE);
+            next == CODEC_TIMING_SAMPLE
+        });
+        Self {
+            op,
+            started: due.then(Instant::now),
+        }
+    }
+}
+
+impl Drop for CodecTimer {
+    fn drop(&mut self) {
+        if let Some(started) = self.started {
+            self.op.timed.fetch_add(1, Ordering::Relaxed);
+            self.op
+                .timed_ns
+                .fetch_add(duration_ns(started.elapsed()), Ordering::Relaxed);
+        }
+    }
+}
+
+pub fn lite3_codec_metrics() -> Lite3CodecMetrics {
+    let (encode_calls, encode_timed, encode_timed_ns) = LITE3_ENCODE.snapshot();
+    let (decode_calls, decode_timed, decode_timed_ns) = LITE3_DECODE.snapshot();
+    Lite3CodecMetrics {
+        encode_calls,
+        encode_timed,
+        encode_timed_ns,
+        decode_calls,
+        decode_timed,
+        decode_timed_ns,
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{
+        CodecTimer, Counter, HISTOGRAM_BUCKETS, HeaderMetrics, Histogram, LITE3_DECODE,
+        LogHistogram, METRICS_END, bucket, lite3_codec_metrics,
+    };
+    use std::time::Duration;
+
+    #[repr(C, align(8))]
+    struct Page([u8; METRICS_END]);
+
+    #[test]
+    fn buckets_are_powers_of_four() {
+        assert_eq!(bucket(0), 0);
+        assert_eq!(bucket(1), 0);
+        assert_eq!(bucket(2), 1);
+        assert_eq!(bucket(4), 1);
+        assert_eq!(bucket(5), 2);
+        assert_eq!(bucket(16), 2);
+        assert_eq!(bucket(17), 3);
+        assert_eq!(bucket(u64::MAX), HISTOGRAM_BUCKETS - 1);
+        for index in 0..HISTOGRAM_BUCKETS - 1 {
+            let bound = LogHistogram::upper_bound(index).expect("bounded");
+            assert_eq!(bucket(bound), index);
+            assert_eq!(bucket(bound + 1), index + 1);
+        }
+        assert_eq!(LogHistogram::upper_bound(HISTOGRAM_BUCKETS - 1), None);
+    }
+
+    #[test]
+    fn header_counters_round_trip_through_snapshot() {
+        let page = Page([0; METRICS_END]);
+        let metrics = HeaderMetrics::new(&page.0);
+        metrics.lock_acquired(Duration::from_nanos(3), false);
+        metrics.lock_acquired(Duration::from_micros(5), true);
+        metrics.lock_released(Duration::from_nanos(100));
+        metrics.add(Counter::IndexHits, 2);
+        metrics.scan_fallback(40);
+        metrics.record(Histogram::ScanFrames, 1);
+
+        let snapshot = metrics.snapshot();
+        assert_eq!(snapshot.append_lock_acquires, 2);
+        assert_eq!(snapshot.append_lock_contended, 1);
+        assert_eq!(snapshot.append_lock_wait_ns, 5_003);
+        assert_eq!(snapshot.append_lock_wait.count(), 2);
+        assert_eq!(snapshot.append_lock_hold.buckets[bucket(100)], 1);
+        assert_eq!(snapshot.index_hits, 2);
+        assert_eq!(snapshot.scan_fallbacks, 1);
+        assert_eq!(snapshot.scan_frames, 40);
+        assert_eq!(snapshot.scan_length.count(), 2);
+
+        let mut text = String::new();
+        snapshot.write_prometheus(&mut text, "a\"b");
+        assert!(text.contains("plasmite_get_index_hits_total{pool=\"a\\\"b\"} 2"));
+        assert!(text.contains("plasmite_append_lock_wait_seconds_count{pool=\"a\\\"b\"} 2"));
+        assert!(text.contains("plasmite_get_scan_frames_bucket{pool=\"a\\\"b\",le=\"+Inf\"} 2"));
+    }
+
+    #[test]
+    fn codec_timer_samples_one_call_in_sixteen() {
+        let before = lite3_codec_metrics().decode_timed;
+        for _ in 0..32 {
+            drop(CodecTimer::start(&LITE3_DECODE));
+        }
+        assert!(lite3_codec_metrics().decode_timed >= before + 2);
+    }
+}
@@ -1,15 +1,21 @@
 //! Purpose: Core storage, encoding, planning, validation, and error modeling.
-//! Exports: `pool`, `cursor`, `plan`, `frame`, `validate`, `error`, `lite3`, `format`, `notify`.
+//! Exports: `pool`, `cursor`, `plan`, `frame`, `validate`, `error`, `lite3`, `format`, `notify`,
+//! `scan`, `metrics`, `compress`, `residency`, `commit`.
 //! Role: Internal core layer shared by CLI and tests; does not perform CLI I/O.
 //! Invariants: Public functions take explicit inputs and return explicit results/errors.
 //! Invariants: Full scans/expensive validation are opt-in and not on hot paths.
 #![allow(clippy::result_large_err)]
+pub mod commit;
+pub mod compress;
 pub mod cursor;
 pub mod error;
 pub mod format;
 pub mod frame;
 pub mod lite3;
+pub mod metrics;
 pub mod notify;
 pub mod plan;
 pub mod pool;
+pub mod residency;
+pub mod scan;
 pub mod validate;
@@ -1,15 +1,30 @@
-//! Purpose: Provide best-effort per-pool notifications via named semaphores.
-//! Exports: `PoolSemaphore`, `NotifyError`, `WaitOutcome`, `pool_semaphore_name`, `post_for_path`.
+//! Purpose: Provide best-effort per-pool notifications: broadcast wakeups on an epoch word in
+//! the pool header where the OS can wait on shared memory, named semaphores elsewhere.
+//! Exports: `PoolSemaphore`, `PoolWaiter`, `WriterSemaphore`, `NotifyError`, `WaitOutcome`,
+//! `EpochBackend`, `pool_semaphore_name`, `open_for_path`.
 //! Role: Optimization for tail-style consumers; correctness must not depend on notify.
 //! Invariants: Name derivation is deterministic; failures never panic or block progress.
 //! Invariants: Unsupported semaphore operations surface as `NotifyError::Unavailable`.
-
+//! Invariants: Waiters are counted in the pool header; writers skip posts while it reads zero,
+//! after one last post on the first append that sees it drop to zero.
+//! Invariants: Posts, and waits by registered waiters, are counted in the header hot metrics.
+//! Invariants: An epoch post wakes every waiter; a waiter is signaled by any bump since its
+//! previous wait (or since it opened), so appends between waits are never lost.
+//! Invariants: Epoch wakeups are used on Linux (futex) and macOS (`__ulock`); the choice is
+//! per platform, so every process on one host agrees on it.
+
+use memmap2::{Mmap, MmapMut, MmapOptions};
 use sha2::{Digest, Sha256};
+use std::fs::OpenOptions;
 use std::io;
 use std::path::Path;
 #[cfg(test)]
-use std::sync::atomic::{AtomicBool, Ordering};
-use std::time::Duration;
+use std::sync::atomic::AtomicBool;
+use std::sync::atomic::{AtomicU32, Ordering, fence};
+use std::time::{Duration, Instant};
+
+use crate::core::metrics::{Counter, HeaderMetrics};
+use crate::core::pool::{HEADER_SIZE, NOTIFY_EPOCH_OFFSET, NOTIFY_WAITERS_OFFSET};
 
 #[cfg(unix)]
 use std::ffi::CString;
@@ -70,9 +85,20 @@ impl<B: SemaphoreBackend> Drop for Semaphore<B> {
 #[derive(Clone)]
 pub(crate) struct OsSemaphoreBackend;
 
+/// Named semaphore handle from `sem_open`.
+#[cfg(unix)]
+pub(crate) struct SemHandle(*mut libc::sem_t);
+
+// SAFETY: POSIX named semaphores are process-wide objects; `sem_post`/`sem_trywait`/`sem_close`
+// may be called from any thread.
+#[cfg(unix)]
+unsafe impl Send for SemHandle {}
+#[cfg(unix)]
+unsafe impl Sync for SemHandle {}
+
 #[cfg(unix)]
 impl SemaphoreBackend for OsSemaphoreBackend {
-    type Handle = *mut libc::sem_t;
+    type Handle = SemHandle;
 
     fn open(&self, name: &str) -> Result<Self::Handle, NotifyError> {
         let full = format!("/{name}");
@@ -83,11 +109,11 @@ impl SemaphoreBackend for OsSemaphoreBackend {
         if handle == libc::SEM_FAILED {
             return Err(map_sem_error());
         }
-        Ok(handle)
+        Ok(SemHandle(handle))
     }
 
     fn post(&self, handle: &Self::Handle) -> Result<(), NotifyError> {
-        let rc = unsafe { libc::sem_post(*handle) };
+        let rc = unsafe { libc::sem_post(handle.0) };
         if rc != 0 {
             return Err(map_sem_error());
         }
@@ -99,7 +125,7 @@ impl SemaphoreBackend for OsSemaphoreBackend {
         let poll = Duration::from_millis(5).min(timeout.max(Duration::from_millis(1)));
 
         loop {
-            let rc = unsafe { libc::sem_trywait(*handle) };
+            let rc = unsafe { libc::sem_trywait(handle.0) };
             if rc == 0 {
                 return Ok(WaitOutcome::Signaled);
             }
@@ -120,7 +146,7 @@ impl SemaphoreBackend for OsSemaphoreBackend {
 
     fn close(&self, handle: &Self::Handle) {
         unsafe {
-            libc::sem_close(*handle);
+            libc::sem_close(handle.0);
         }
     }
 }
@@ -146,6 +172,183 @@ impl SemaphoreBackend for OsSemaphoreBackend {
 
 pub(crate) type PoolSemaphore = Semaphore<OsSemaphoreBackend>;
 
+/// Wait/wake on a 32-bit word in a shared file mapping, across processes (futex-style).
+pub(crate) trait EpochBackend: Clone {
+    /// Block while `word` holds `expected`, for at most `timeout`. May return early.
+    fn wait(&self, word: &AtomicU32, expected: u32, timeout: Duration) -> Result<(), NotifyError>;
+    /// Wake every thread blocked on `word`, in any process.
+    fn wake_all(&self, word: &AtomicU32) -> Result<(), NotifyError>;
+}
+
+#[derive(Clone)]
+pub(crate) struct OsEpochBackend;
+
+/// Whether this platform notifies through the header epoch word instead of a semaphore.
+pub(crate) const EPOCH_WAKEUPS: bool = cfg!(any(target_os = "linux", target_os = "macos"));
+
+#[cfg(target_os = "linux")]
+impl EpochBackend for OsEpochBackend {
+    fn wait(&self, word: &AtomicU32, expected: u32, timeout: Duration) -> Result<(), NotifyError> {
+        let timeout = libc::timespec {
+            tv_sec: libc::time_t::try_from(timeout.as_secs()).unwrap_or(libc::time_t::MAX),
+            tv_nsec: timeout.subsec_nanos() as libc::c_long,
+        };
+        // Not FUTEX_PRIVATE_FLAG: the word is in a shared file mapping, so the kernel keys the
+        // wait on the file page and writers in other processes reach it.
+        let rc = unsafe {
+            libc::syscall(
+                libc::SYS_futex,
+                word.as_ptr(),
+                libc::FUTEX_WAIT,
+                expected,
+                &timeout as *const libc::timespec,
+            )
+        };
+        if rc == 0 {
+            return Ok(());
+        }
+        let err = io::Error::last_os_error();
+        match err.raw_os_error() {
+            Some(libc::EAGAIN | libc::EINTR | libc::ETIMEDOUT) => Ok(()),
+            _ => Err(map_sem_error_with(err)),
+        }
+    }
+
+    fn wake_all(&self, word: &AtomicU32) -> Result<(), NotifyError> {
+        let rc = unsafe {
+            libc::syscall(
+                libc::SYS_futex,
+                word.as_ptr(),
+                libc::FUTEX_WAKE,
+                libc::c_int::MAX,
+            )
+        };
+        if rc < 0 {
+            return Err(map_sem_error());
+        }
+        Ok(())
+    }
+}
+
+#[cfg(target_os = "macos")]
+unsafe extern "C" {
+    // libSystem's address-wait primitive (macOS 10.12+), as used by libc++ and the Rust std.
+    fn __ulock_wait(
+        operation: u32,
+        addr: *mut libc::c_void,
+        value: u64,
+        timeout_us: u32,
+    ) -> libc::c_int;
+    fn __ulock_wake(operation: u32, addr: *mut libc::c_void, wake_value: u64) -> libc::c_int;
+}
+
+#[cfg(target_os = "macos")]
+const UL_COMPARE_AND_WAIT_SHARED: u32 = 3;
+#[cfg(target_os = "macos")]
+const ULF_WAKE_ALL: u32 = 0x0000_0100;
+#[cfg(target_os = "macos")]
+const ULF_NO_ERRNO: u32 = 0x0100_0000;
+
+#[cfg(target_os = "macos")]
+impl EpochBackend for OsEpochBackend {
+    fn wait(&self, word: &AtomicU32, expected: u32, timeout: Duration) -> Result<(), NotifyError> {
+        // 0 means "no timeout" to `__ulock_wait`.
+        let timeout_us = u32::try_from(timeout.as_micros())
+            .unwrap_or(u32::MAX)
+            .max(1);
+        let rc = unsafe {
+            __ulock_wait(
+                UL_COMPARE_AND_WAIT_SHARED | ULF_NO_ERRNO,
+                word.as_ptr().cast(),
+                u64::from(expected),
+                timeout_us,
+            )
+        };
+        match rc {
+            rc if rc >= 0 => Ok(()),
+            rc if -rc == libc::ETIMEDOUT || -rc == libc::EINTR || -rc == libc::EFAULT => Ok(()),
+            rc => Err(map_sem_error_with(io::Error::from_raw_os_error(-rc))),
+        }
+    }
+
+    fn wake_all(&self, word: &AtomicU32) -> Result<(), NotifyError> {
+        let rc = unsafe {
+            __ulock_wake(
+                UL_COMPARE_AND_WAIT_SHARED | ULF_WAKE_ALL | ULF_NO_ERRNO,
+                word.as_ptr().cast(),
+                0,
+            )
+        };
+        // ENOENT: nobody was waiting.
+        if rc >= 0 || -rc == libc::ENOENT {
+            return Ok(());
+        }
+        Err(map_sem_error_with(io::Error::from_raw_os_error(-rc)))
+    }
+}
+
+#[cfg(not(any(target_os = "linux", target_os = "macos")))]
+impl EpochBackend for OsEpochBackend {
+    fn wait(
+        &self,
+        _word: &AtomicU32,
+        _expected: u32,
+        _timeout: Duration,
+    ) -> Result<(), NotifyError> {
+        Err(NotifyError::Unavailable)
+    }
+
+    fn wake_all(&self, _word: &AtomicU32) -> Result<(), NotifyError> {
+        Err(NotifyError::Unavailable)
+    }
+}
+
+/// Waits until the header epoch word moves past the value this waiter last saw.
+struct EpochWaiter<B: EpochBackend> {
+    backend: B,
+    /// Read-only mapping of the pool header page; waiting never needs write access.
+    page: Mmap,
+    last_seen: AtomicU32,
+}
+
+impl<B: EpochBackend> EpochWaiter<B> {
+    fn open(path: &Path, backend: B) -> Result<Self, NotifyError> {
+        let file = OpenOptions::new()
+            .read(true)
+            .open(path)
+            .map_err(NotifyError::Io)?;
+        if file.metadata().map_err(NotifyError::Io)?.len() < HEADER_SIZE as u64 {
+            return Err(NotifyError::Unavailable);
+        }
+        let page =
+            unsafe { MmapOptions::new().len(HEADER_SIZE).map(&file) }.map_err(NotifyError::Io)?;
+        let last_seen = AtomicU32::new(notify_epoch(&page).load(Ordering::SeqCst));
+        Ok(Self {
+            backend,
+            page,
+            last_seen,
+        })
+    }
+
+    fn wait(&self, timeout: Duration) -> Result<WaitOutcome, NotifyError> {
+        let epoch = notify_epoch(&self.page);
+        let seen = self.last_seen.load(Ordering::Relaxed);
+        let start = Instant::now();
+        loop {
+            let current = epoch.load(Ordering::SeqCst);
+            if current != seen {
+                self.last_seen.store(current, Ordering::Relaxed);
+                return Ok(WaitOutcome::Signaled);
+            }
+            let elapsed = start.elapsed();
+            if elapsed >= timeout {
+                return Ok(WaitOutcome::TimedOut);
+            }
+            self.backend.wait(epoch, seen, timeout - elapsed)?;
+        }
+    }
+}
+
 pub(crate) fn pool_semaphore_name(path: &Path) -> String {
     let bytes = canonical_path_bytes(path);
     let digest = Sha256::digest(&bytes);
@@ -157,7 +360,7 @@ pub(crate) fn pool_semaphore_name(path: &Path) -> String {
     format!("plsm-{hex}")
 }
 
-pub(crate) fn open_for_path(path: &Path) -> Result<PoolSemaphore, NotifyError> {
+fn open_semaphore(path: &Path) -> Result<PoolSemaphore, NotifyError> {
     #[cfg(test)]
     if FORCE_UNAVAILABLE.load(Ordering::SeqCst) {
         return Err(NotifyError::Unavailable);
@@ -166,13 +369,158 @@ pub(crate) fn open_for_path(path: &Path) -> Result<PoolSemaphore, NotifyError> {
     PoolSemaphore::open_with_backend(name, OsSemaphoreBackend)
 }
 
-pub(crate) fn post_for_path(path: &Path) -> Result<(), NotifyError> {
+/// Open the pool's notifications for waiting and register as a waiter so writers keep posting.
+pub(crate) fn open_for_path(path: &Path) -> Result<PoolWaiter, NotifyError> {
     #[cfg(test)]
     if FORCE_UNAVAILABLE.load(Ordering::SeqCst) {
         return Err(NotifyError::Unavailable);
     }
-    let semaphore = open_for_path(path)?;
-    semaphore.post()
+    let source = if EPOCH_WAKEUPS {
+        WaitSource::Epoch(EpochWaiter::open(path, OsEpochBackend)?)
+    } else {
+        WaitSource::Semaphore(open_semaphore(path)?)
+    };
+    Ok(PoolWaiter {
+        source,
+        registration: WaiterRegistration::register(path),
+    })
+}
+
+/// Consumer side of pool notifications.
+pub(crate) struct PoolWaiter {
+    source: WaitSource,
+    // `None` when the pool file is not writable: waits still work, but writers only post while
+    // some other waiter is registered, so this consumer may fall back to its poll interval.
+    registration: Option<WaiterRegistration>,
+}
+
+enum WaitSource {
+    Epoch(EpochWaiter<OsEpochBackend>),
+    Semaphore(PoolSemaphore),
+}
+
+impl PoolWaiter {
+    pub(crate) fn wait(&self, timeout: Duration) -> Result<WaitOutcome, NotifyError> {
+        let outcome = match &self.source {
+            WaitSource::Epoch(waiter) => waiter.wait(timeout)?,
+            WaitSource::Semaphore(semaphore) => semaphore.wait(timeout)?,
+        };
+        if let Some(registration) = &self.registration {
+            let metrics = HeaderMetrics::new(&registration.page);
+            metrics.add(Counter::NotifyWaits, 1);
+            if outcome == WaitOutcome::Signaled {
+                metrics.add(Counter::NotifyWakeups, 1);
+            }
+        }
+        Ok(outcome)
+    }
+}
+
+/// Holds one count in the pool header's waiter slot via a private mapping of the header page.
+struct WaiterRegistration {
+    page: MmapMut,
+}
+
+impl WaiterRegistration {
+    fn register(path: &Path) -> Option<Self> {
+        let file = OpenOptions::new().read(true).write(true).open(path).ok()?;
+        if file.metadata().ok()?.len() < HEADER_SIZE as u64 {
+            return None;
+        }
+        let page = unsafe { MmapOptions::new().len(HEADER_SIZE).map_mut(&file) }.ok()?;
+        waiter_count(&page).fetch_add(1, Ordering::SeqCst);
+        Some(Self { page })
+    }
+}
+
+impl Drop for WaiterRegistration {
+    fn drop(&mut self) {
+        let waiters = waiter_count(&self.page);
+        let _ = waiters.fetch_update(Ordering::SeqCst, Ordering::SeqCst, |n| n.checked_sub(1));
+    }
+}
+
+/// Waiter slot inside a mapped pool header. A crashed waiter leaves it high, which only costs
+/// writers the posts they would have made anyway.
+pub(crate) fn waiter_count(header: &[u8]) -> &AtomicU32 {
+    let slot = &header[NOTIFY_WAITERS_OFFSET..NOTIFY_WAITERS_OFFSET + 4];
+    debug_assert_eq!(slot.as_ptr().align_offset(4), 0);
+    // SAFETY: the slot is 4-byte aligned within a page-aligned shared mapping and is only ever
+    // accessed atomically, by any process mapping the pool.
+    unsafe { &*(slot.as_ptr() as *const AtomicU32) }
+}
+
+/// Epoch slot inside a mapped pool header: bumped by writers on each notified append.
+pub(crate) fn notify_epoch(header: &[u8]) -> &AtomicU32 {
+    let slot = &header[NOTIFY_EPOCH_OFFSET..NOTIFY_EPOCH_OFFSET + 4];
+    debug_assert_eq!(slot.as_ptr().align_offset(4), 0);
+    // SAFETY: as for `waiter_count`; the slot is 4-byte aligned and only accessed atomically.
+    unsafe { &*(slot.as_ptr() as *const AtomicU32) }
+}
+
+/// Writer side of pool notifications: posts are skipped while no waiter is registered, except
+/// for one post on the first append after the count drops to zero, which covers a waiter that
+/// deregisters while an unregistered one (read-only, or an older binary) is still blocked. With
+/// epoch wakeups a post bumps the header epoch and wakes every waiter; otherwise the semaphore
+/// is opened on first use and kept for the owner's lifetime.
+#[derive(Default)]
+pub(crate) struct WriterSemaphore {
+    state: WriterState,
+    saw_waiters: bool,
+}
+
+#[derive(Default)]
+enum WriterState {
+    #[default]
+    Unopened,
+    Open(PoolSemaphore),
+    Unavailable,
+}
+
+impl WriterSemaphore {
+    /// Post once for an append already published in `header`.
+    pub(crate) fn post_if_waiting(
+        &mut self,
+        path: &Path,
+        header: &[u8],
+    ) -> Result<(), NotifyError> {
+        // Order the header publish before the waiter check (paired with registration).
+        fence(Ordering::SeqCst);
+        if waiter_count(header).load(Ordering::Relaxed) == 0 {
+            if !std::mem::replace(&mut self.saw_waiters, false) {
+                return Ok(());
+            }
+        } else {
+            self.saw_waiters = true;
+        }
+        if EPOCH_WAKEUPS {
+            notify_epoch(header).fetch_add(1, Ordering::SeqCst);
+            OsEpochBackend.wake_all(notify_epoch(header))?;
+            HeaderMetrics::new(header).add(Counter::NotifyPosts, 1);
+            return Ok(());
+        }
+        if matches!(self.state, WriterState::Unopened) {
+            match open_semaphore(path) {
+                Ok(semaphore) => self.state = WriterState::Open(semaphore),
+                Err(NotifyError::Unavailable) => self.state = WriterState::Unavailable,
+                // Transient open failures are retried on the next append.
+                Err(err) => return Err(err),
+            }
+        }
+        match &self.state {
+            WriterState::Open(semaphore) => {
+                semaphore.post()?;
+                HeaderMetrics::new(header).add(Counter::NotifyPosts, 1);
+                Ok(())
+            }
+            _ => Err(NotifyError::Unavailable),
+        }
+    }
+
+    #[cfg(test)]
+    pub(crate) fn is_unopened(&self) -> bool {
+        matches!(self.state, WriterState::Unopened)
+    }
 }
 
 #[cfg(test)]
@@ -295,6 +643,136 @@ mod tests {
         assert_eq!(first, second);
     }
 
+    #[test]
+    fn waiter_registration_counts_in_header() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        std::fs::write(&path, vec![0u8; HEADER_SIZE]).expect("write");
+
+        let first = WaiterRegistration::register(&path).expect("register");
+        let second = WaiterRegistration::register(&path).expect("register");
+        assert_eq!(waiter_count(&first.page).load(Ordering::SeqCst), 2);
+        drop(second);
+        assert_eq!(waiter_count(&first.page).load(Ordering::SeqCst), 1);
+        drop(first);
+
+        let bytes = std::fs::read(&path).expect("read");
+        assert_eq!(
+            &bytes[NOTIFY_WAITERS_OFFSET..NOTIFY_WAITERS_OFFSET + 4],
+            &[0; 4]
+        );
+
+        let short = dir.path().join("short.plasmite");
+        std::fs::write(&short, [0u8; 16]).expect("write");
+        assert!(WaiterRegistration::register(&short).is_none());
+    }
+
+    #[test]
+    fn writer_skips_post_without_waiters() {
+        let header = MmapMut::map_anon(HEADER_SIZE).expect("map");
+        let mut writer = WriterSemaphore::default();
+        writer
+            .post_if_waiting(Path::new("unused.plasmite"), &header)
+            .expect("skip");
+        assert!(writer.is_unopened());
+    }
+
+    #[cfg(any(target_os = "linux", target_os = "macos"))]
+    #[test]
+    fn epoch_post_wakes_every_waiter() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        std::fs::write(&path, vec![0u8; HEADER_SIZE]).expect("write");
+        let waiters: Vec<_> = (0..4)
+            .map(|_| open_for_path(&path).expect("open"))
+            .collect();
+
+        let started = std::sync::Arc::new(std::sync::Barrier::new(waiters.len() + 1));
+        let threads: Vec<_> = waiters
+            .into_iter()
+            .map(|waiter| {
+                let started = started.clone();
+                std::thread::spawn(move || {
+                    started.wait();
+                    let begin = Instant::now();
+                    let outcome = waiter.wait(Duration::from_secs(10)).expect("wait");
+                    (outcome, begin.elapsed())
+                })
+            })
+            .collect();
+        started.wait();
+        std::thread::sleep(Duration::from_millis(20));
+
+        let file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .open(&path)
+            .expect("open");
+        let header = unsafe { MmapMut::map_mut(&file) }.expect("map");
+        assert_eq!(waiter_count(&header).load(Ordering::SeqCst), 4);
+        WriterSemaphore::default()
+            .post_if_waiting(&path, &header)
+            .expect("post");
+        // One post reaches all four waiters, not just one of them.
+        for thread in threads {
+            let (outcome, elapsed) = thread.join().expect("join");
+            assert_eq!(outcome, WaitOutcome::Signaled);
+            assert!(elapsed < Duration::from_secs(5));
+        }
+        assert_eq!(notify_epoch(&header).load(Ordering::SeqCst), 1);
+    }
+
+    #[cfg(any(target_os = "linux", target_os = "macos"))]
+    #[test]
+    fn epoch_waiter_keeps_posts_made_between_waits() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        std::fs::write(&path, vec![0u8; HEADER_SIZE]).expect("write");
+        let waiter = open_for_path(&path).expect("open");
+        let file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .open(&path)
+            .expect("open");
+        let header = unsafe { MmapMut::map_mut(&file) }.expect("map");
+        let mut writer = WriterSemaphore::default();
+
+        writer.post_if_waiting(&path, &header).expect("post");
+        writer.post_if_waiting(&path, &header).expect("post");
+        assert_eq!(
+            waiter.wait(Duration::from_millis(1)).expect("wait"),
+            WaitOutcome::Signaled
+        );
+        assert_eq!(
+            waiter.wait(Duration::from_millis(5)).expect("wait"),
+            WaitOutcome::TimedOut
+        );
+    }
+
+    #[cfg(any(target_os = "linux", target_os = "macos"))]
+    #[test]
+    fn writer_posts_once_after_waiters_drop_to_zero() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        std::fs::write(&path, vec![0u8; HEADER_SIZE]).expect("write");
+        let file = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .open(&path)
+            .expect("open");
+        let header = unsafe { MmapMut::map_mut(&file) }.expect("map");
+        let mut writer = WriterSemaphore::default();
+
+        let registration = WaiterRegistration::register(&path).expect("register");
+        writer.post_if_waiting(&path, &header).expect("post");
+        assert_eq!(notify_epoch(&header).load(Ordering::SeqCst), 1);
+        drop(registration);
+        writer.post_if_waiting(&path, &header).expect("post");
+        assert_eq!(notify_epoch(&header).load(Ordering::SeqCst), 2);
+        writer.post_if_waiting(&path, &header).expect("skip");
+        assert_eq!(notify_epoch(&header).load(Ordering::SeqCst), 2);
+    }
+
     #[test]
     fn test_backend_post_and_wait() {
         let backend = TestBackend::default();
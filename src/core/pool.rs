@@ -1,33 +1,94 @@
 //! Purpose: Manage pool files (create/open), mmap access, locking, and append application.
 //! Exports: `Pool`, `PoolOptions`, `AppendOptions`, `Durability`, `PoolHeader`, `Bounds`,
-//! `PoolInfo`, `SeqOffsetCache`.
+//! `PoolInfo`, `SeqOffsetCache`, `ReservedFrame`.
 //! Role: IO boundary for the core: owns file handles/mmap and delegates planning to `plan`.
 //! Invariants: All mutations hold an exclusive append lock across processes.
+//! Invariants: A writer lease holds that lock for the handle's lifetime; others get `Busy`.
 //! Invariants: Append writes mark frames `Writing` -> payload -> `Committed`; header persists last.
+//! Invariants: Reservations publish their evictions before handing out ring memory.
 //! Invariants: Header size is fixed (4096) and validated strictly on open.
+//! Invariants: Appends post notify through a cached semaphore, only while waiters are registered.
+//! Invariants: Auto-sized indexes add a block tier so every live seq resolves in bounded hops.
+//! Invariants: Index misses on large rings try a chunked parallel `scan` before the cursor walk.
+//! Invariants: Appends stamp sparse header time checkpoints; `seek_time` trusts only live ones.
+//! Invariants: Lock waits/holds, index hits and scan fallbacks feed the header `metrics` region.
+//! Invariants: Compression is fixed at create; a dictionary sits between the index and the ring.
+//! Invariants: Reserved (in-place) frames are always stored raw.
+//! Invariants: `Residency` advice is per handle and best-effort; only preallocation can fail.
+//! Invariants: Group-commit appends submit their spans to `commit` under the lock, wait after it.
+use std::borrow::Cow;
 use std::collections::{HashMap, VecDeque};
 use std::fs::{File, OpenOptions};
 use std::io::{self, Read, Seek, SeekFrom, Write};
+use std::ops::ControlFlow;
 use std::path::{Path, PathBuf};
-use std::time::{SystemTime, UNIX_EPOCH};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicU64, Ordering, fence};
+use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
 
 use fs2::FileExt;
 use libc::{EACCES, EPERM};
 use memmap2::MmapMut;
 
+use crate::core::commit::{self, CommitHandle, GroupCommitter};
+use crate::core::compress::{self, Compression, EncodedPayload, FrameCodec};
 use crate::core::error::{Error, ErrorKind};
 use crate::core::format;
 use crate::core::frame::{self, FRAME_HEADER_LEN, FrameHeader, FrameState};
+use crate::core::metrics::{self, Counter, HeaderMetrics, HotMetrics};
 use crate::core::notify;
 use crate::core::plan;
+use crate::core::residency::{self, Advice, Residency};
+use crate::core::scan::{self, ScanOptions};
 use crate::core::validate;
 
 const MAGIC: [u8; 4] = *b"PLSM";
 const ENDIANNESS_LE: u8 = 1;
-const HEADER_SIZE: usize = 4096;
+pub(crate) const HEADER_SIZE: usize = 4096;
+/// Header slot (u32) counting registered notify waiters; not part of `PoolHeader`.
+pub(crate) const NOTIFY_WAITERS_OFFSET: usize = 104;
+/// Header slot (u32) that writers bump for each notified append; waiters futex-wait on it.
+pub(crate) const NOTIFY_EPOCH_OFFSET: usize = 108;
+/// Header slot (u64) with the pid of the exclusive writer lease holder, 0 when unleased.
+const WRITER_LEASE_OFFSET: usize = 112;
+/// Writer lease slot bit: the pid is still waiting for the append lock.
+const LEASE_PENDING: u64 = 1 << 63;
+// Sleep bounds while polling a contended append lock (lease waits, or under `lock_timeout`).
+const LOCK_BACKOFF_MIN: Duration = Duration::from_micros(20);
+const LOCK_BACKOFF_MAX: Duration = Duration::from_micros(500);
 const INDEX_SLOT_BYTES: u64 = 16;
 const MAX_AUTO_INDEX_CAPACITY: u64 = 65_536;
 const MIN_RING_SIZE_FOR_INDEX: u64 = 1024;
+/// `PoolHeader::flags` bit: the index region ends with a block tier (see `IndexLayout`).
+const INDEX_FLAG_BLOCKS: u64 = 1;
+// Header flag: created with compression; stored as `POOL_FORMAT_VERSION_COMPRESSED`.
+const HEADER_FLAG_COMPRESSED: u64 = 2;
+/// Seqs per block-tier slot; a block lookup hops at most this many frame headers.
+const INDEX_BLOCK_SEQS: u64 = 4096;
+/// Smallest frame (empty payload), bounding how many frames a ring can hold at once.
+const MIN_FRAME_BYTES: u64 = (FRAME_HEADER_LEN + frame::FRAME_COMMIT_MARKER_LEN) as u64;
+/// Header bytes holding the sparse time index: (seq, ring offset, timestamp_ns) checkpoints.
+const TIME_INDEX_OFFSET: usize = 1024;
+/// Slot `k` holds the frame covering ring position `k * time_stride(ring_size)`.
+const TIME_CHECKPOINTS: usize = 128;
+const TIME_CHECKPOINT_BYTES: usize = 24;
+/// How far `seek_time` backs off its target: writers stamp before taking the append lock, so
+/// concurrent appends commit stamps out of order by up to their lock wait.
+const SEEK_TIME_SKEW_NS: u64 = 1_000_000_000;
+const _: () = assert!(TIME_INDEX_OFFSET + TIME_CHECKPOINTS * TIME_CHECKPOINT_BYTES <= HEADER_SIZE);
+const _: () = assert!(
+    NOTIFY_EPOCH_OFFSET >= NOTIFY_WAITERS_OFFSET + 4
+        && NOTIFY_EPOCH_OFFSET + 4 <= WRITER_LEASE_OFFSET
+);
+const _: () = assert!(
+    metrics::METRICS_OFFSET >= WRITER_LEASE_OFFSET + 8 && metrics::METRICS_END <= TIME_INDEX_OFFSET
+);
+const _: () = assert!(
+    compress::COMPRESSION_OFFSET >= metrics::METRICS_END
+        && compress::COMPRESSION_END <= TIME_INDEX_OFFSET
+);
+/// Live ring bytes below which an index miss scans sequentially instead of in parallel chunks.
+const PARALLEL_SCAN_MIN_BYTES: u64 = 64 * 1024 * 1024;
 
 #[derive(Clone, Copy, Debug, Eq, PartialEq)]
 pub struct PoolHeader {
@@ -45,13 +106,15 @@ pub struct PoolHeader {
 }
 
 impl PoolHeader {
-    fn new(file_size: u64, index_capacity: u32) -> Result<Self, Error> {
+    /// `reserved_bytes` sit between the index and the ring (the compression dictionary).
+    fn new(file_size: u64, index_capacity: u32, reserved_bytes: u64) -> Result<Self, Error> {
         let index_offset = HEADER_SIZE as u64;
         let index_bytes = (index_capacity as u64)
             .checked_mul(INDEX_SLOT_BYTES)
             .ok_or_else(|| Error::new(ErrorKind::Usage).with_message("index capacity too large"))?;
         let ring_offset = index_offset
             .checked_add(index_bytes)
+            .and_then(|index_end| index_end.checked_add(reserved_bytes))
             .ok_or_else(|| Error::new(ErrorKind::Usage).with_message("index capacity too large"))?;
         if file_size <= ring_offset {
             return Err(Error::new(ErrorKind::Usage)
@@ -76,7 +139,7 @@ impl PoolHeader {
     fn encode(&self) -> [u8; HEADER_SIZE] {
         let mut buf = [0u8; HEADER_SIZE];
         buf[0..4].copy_from_slice(&MAGIC);
-        buf[4..8].copy_from_slice(&format::POOL_FORMAT_VERSION.to_le_bytes());
+        buf[4..8].copy_from_slice(&format_version(self.flags).to_le_bytes());
         buf[8] = ENDIANNESS_LE;
 
         write_u64(&mut buf, 16, self.file_size);
@@ -102,7 +165,7 @@ impl PoolHeader {
             return Err(Error::new(ErrorKind::Corrupt).with_message("bad magic"));
         }
         let version = u32::from_le_bytes(read_4(buf, 4));
-        if version != format::POOL_FORMAT_VERSION {
+        if !format::SUPPORTED_POOL_FORMAT_VERSIONS.contains(&version) {
             return Err(format::pool_version_error(version));
         }
         if buf[8] != ENDIANNESS_LE {
@@ -120,6 +183,10 @@ impl PoolHeader {
         let tail_next_off = read_u64(buf, 80);
         let oldest_seq = read_u64(buf, 88);
         let newest_seq = read_u64(buf, 96);
+        if version != format_version(flags) {
+            return Err(Error::new(ErrorKind::Corrupt)
+                .with_message("pool format version does not match header flags"));
+        }
 
         Ok(Self {
             file_size,
@@ -136,7 +203,7 @@ impl PoolHeader {
         })
     }
 
-    fn validate(&self, actual_file_size: u64) -> Result<(), Error> {
+    fn validate(&self, actual_file_size: u64, reserved_bytes: u64) -> Result<(), Error> {
         if self.file_size == 0 {
             return Err(Error::new(ErrorKind::Corrupt).with_message("invalid file size"));
         }
@@ -152,6 +219,7 @@ impl PoolHeader {
         let expected_ring_offset = self
             .index_offset
             .checked_add(index_bytes)
+            .and_then(|index_end| index_end.checked_add(reserved_bytes))
             .ok_or_else(|| Error::new(ErrorKind::Corrupt).with_message("ring offset overflow"))?;
         if self.ring_offset < HEADER_SIZE as u64 {
             return Err(Error::new(ErrorKind::Corrupt).with_message("invalid ring offset"));
@@ -191,6 +259,15 @@ impl PoolHeader {
     }
 }
 
+/// On-disk format version for a header with `flags`.
+fn format_version(flags: u64) -> u32 {
+    if flags & HEADER_FLAG_COMPRESSED != 0 {
+        format::POOL_FORMAT_VERSION_COMPRESSED
+    } else {
+        format::POOL_FORMAT_VERSION
+    }
+}
+
 fn read_4(buf: &[u8], offset: usize) -> [u8; 4] {
     let mut out = [0u8; 4];
     out.copy_from_slice(&buf[offset..offset + 4]);
@@ -221,10 +298,14 @@ fn write_u32(buf: &mut [u8], offset: usize, value: u32) {
     buf[offset..offset + 4].copy_from_slice(&value.to_le_bytes());
 }
 
-#[derive(Clone, Copy, Debug)]
+#[derive(Clone, Debug)]
 pub struct PoolOptions {
     pub file_size: u64,
     pub index_capacity: Option<u32>,
+    /// Payload compression for the pool's lifetime; `None` stores every frame raw.
+    pub compression: Option<Compression>,
+    /// Residency tuning for the creating handle (not persisted; see `Pool::open_with`).
+    pub residency: Residency,
 }
 
 impl PoolOptions {
@@ -232,6 +313,8 @@ impl PoolOptions {
         Self {
             file_size,
             index_capacity: None,
+            compression: None,
+            residency: Residency::default(),
         }
     }
 
@@ -240,6 +323,40 @@ impl PoolOptions {
         self
     }
 
+    pub fn with_compression(mut self, compression: Compression) -> Self {
+        self.compression = Some(compression);
+        self
+    }
+
+    pub fn with_residency(mut self, residency: Residency) -> Self {
+        self.residency = residency;
+        self
+    }
+
+    /// Index slots and header flags for a new pool. An auto-sized index appends a block tier
+    /// covering every frame the ring can hold; an explicit capacity is a direct table only.
+    fn resolved_index(&self) -> (u32, u64) {
+        let direct = self.resolved_index_capacity();
+        if self.index_capacity.is_some() || direct == 0 {
+            return (direct, 0);
+        }
+        let direct_bytes = u64::from(direct) * INDEX_SLOT_BYTES;
+        // Sized from a ring bound that ignores the block tier itself, so `IndexLayout::of`
+        // (which sees the final, smaller ring) never needs more block slots than reserved.
+        let ring_bound = self
+            .file_size
+            .saturating_sub(HEADER_SIZE as u64 + direct_bytes);
+        let total = u64::from(direct) + index_block_slots(ring_bound);
+        let budget = self
+            .file_size
+            .saturating_sub(HEADER_SIZE as u64 + MIN_RING_SIZE_FOR_INDEX)
+            / INDEX_SLOT_BYTES;
+        match u32::try_from(total) {
+            Ok(total) if u64::from(total) <= budget => (total, INDEX_FLAG_BLOCKS),
+            _ => (direct, 0),
+        }
+    }
+
     fn resolved_index_capacity(&self) -> u32 {
         if let Some(explicit) = self.index_capacity {
             return explicit;
@@ -260,6 +377,23 @@ impl PoolOptions {
 pub enum Durability {
     Fast,
     Flush,
+    /// Like `Flush`, but the sync is made by a background thread shared with every concurrent
+    /// group-commit append to the pool in this process. It starts at most `max_delay` after
+    /// the append, or once `max_bytes` are waiting to be synced.
+    GroupCommit {
+        max_delay: Duration,
+        max_bytes: u64,
+    },
+}
+
+impl Durability {
+    /// `GroupCommit` with `DEFAULT_GROUP_COMMIT_DELAY` and `DEFAULT_GROUP_COMMIT_BYTES`.
+    pub fn group_commit() -> Self {
+        Self::GroupCommit {
+            max_delay: commit::DEFAULT_GROUP_COMMIT_DELAY,
+            max_bytes: commit::DEFAULT_GROUP_COMMIT_BYTES,
+        }
+    }
 }
 
 #[derive(Clone, Copy, Debug)]
@@ -381,6 +515,8 @@ pub struct PoolInfo {
     pub ring_size: u64,
     pub bounds: Bounds,
     pub metrics: Option<PoolMetrics>,
+    /// Pool-wide hot-path counters; `None` when the source cannot report them (remote pools).
+    pub hot_metrics: Option<HotMetrics>,
 }
 
 #[derive(Clone, Debug, Eq, PartialEq)]
@@ -411,11 +547,22 @@ pub struct Pool {
     file: File,
     mmap: MmapMut,
     header: PoolHeader,
+    notify: notify::WriterSemaphore,
+    lease: Option<AppendLock>,
+    codec: FrameCodec,
+    residency: Residency,
+    /// How long `append_lock` retries a contended lock; `None` waits indefinitely.
+    lock_timeout: Option<Duration>,
+    /// Started by the first `Durability::GroupCommit` append through this handle.
+    committer: Option<Arc<GroupCommitter>>,
 }
 
 impl Pool {
     pub fn create(path: impl AsRef<Path>, options: PoolOptions) -> Result<Self, Error> {
         let path = path.as_ref().to_path_buf();
+        if let Some(compression) = &options.compression {
+            compression.validate()?;
+        }
 
         // Creating a pool is a mutating operation; ensure the parent directory exists so
         // API/binding users don't need to `mkdir -p` for common first-run flows.
@@ -462,9 +609,23 @@ impl Pool {
                 .with_path(&path)
                 .with_source(err)
         })?;
+        if options.residency.preallocate {
+            residency::preallocate(&file, options.file_size).map_err(|err| {
+                let kind = map_io_error_kind(&err);
+                Error::new(kind)
+                    .with_message("failed to preallocate pool file")
+                    .with_path(&path)
+                    .with_source(err)
+            })?;
+        }
 
-        let index_capacity = options.resolved_index_capacity();
-        let header = PoolHeader::new(options.file_size, index_capacity)?;
+        let (index_capacity, index_flags) = options.resolved_index();
+        let reserved_bytes = compress::reserved_len(options.compression.as_ref());
+        let mut header = PoolHeader::new(options.file_size, index_capacity, reserved_bytes)?;
+        header.flags |= index_flags;
+        if options.compression.is_some() {
+            header.flags |= HEADER_FLAG_COMPRESSED;
+        }
         write_header(&mut file, &header, &path)?;
 
         let mmap = unsafe {
@@ -482,14 +643,28 @@ impl Pool {
             file,
             mmap,
             header,
+            notify: notify::WriterSemaphore::default(),
+            lease: None,
+            codec: FrameCodec::new(options.compression),
+            residency: options.residency,
+            lock_timeout: None,
+            committer: None,
         };
+        pool.apply_residency();
         let index_start = pool.header.index_offset as usize;
         let index_end = pool.header.ring_offset as usize;
         pool.mmap[index_start..index_end].fill(0);
+        pool.codec
+            .store(&mut pool.mmap[..], index_end - reserved_bytes as usize);
         Ok(pool)
     }
 
     pub fn open(path: impl AsRef<Path>) -> Result<Self, Error> {
+        Self::open_with(path, Residency::default())
+    }
+
+    /// Open with residency tuning for this handle. Preallocation applies only at create.
+    pub fn open_with(path: impl AsRef<Path>, residency: Residency) -> Result<Self, Error> {
         let path = path.as_ref().to_path_buf();
         let mut file = OpenOptions::new()
             .read(true)
@@ -511,20 +686,95 @@ impl Pool {
             .map(|meta| meta.len())
             .map_err(|err| Error::new(ErrorKind::Io).with_path(&path).with_source(err))?;
 
-        let header = read_header(&mut file, &path)?;
-        header.validate(actual_size)?;
+        let page = read_header_page(&mut file, &path)?;
+        let header = PoolHeader::decode(&page)?;
+        let compression = FrameCodec::settings(&page)?;
+        if compression.is_some() != (header.flags & HEADER_FLAG_COMPRESSED != 0) {
+            return Err(Error::new(ErrorKind::Corrupt)
+                .with_message("compression settings do not match the pool format version")
+                .with_path(&path));
+        }
+        let dict_len = compression.map_or(0, |(_, _, dict_len)| dict_len as usize);
+        if dict_len > compress::MAX_DICTIONARY_LEN {
+            return Err(Error::new(ErrorKind::Corrupt)
+                .with_message("invalid compression dictionary length")
+                .with_path(&path));
+        }
+        let reserved_bytes = compress::dictionary_region_len(dict_len);
+        header.validate(actual_size, reserved_bytes)?;
 
         let mmap = unsafe {
             MmapMut::map_mut(&file)
                 .map_err(|err| Error::new(ErrorKind::Io).with_path(&path).with_source(err))?
         };
+        let dict_start = (header.ring_offset - reserved_bytes) as usize;
+        let codec = FrameCodec::load(compression, &mmap[dict_start..dict_start + dict_len]);
 
-        Ok(Self {
+        let pool = Self {
             path,
             file,
             mmap,
             header,
-        })
+            notify: notify::WriterSemaphore::default(),
+            lease: None,
+            codec,
+            residency,
+            lock_timeout: None,
+            committer: None,
+        };
+        pool.apply_residency();
+        Ok(pool)
+    }
+
+    /// Mapping-wide advice from `residency`, applied once per handle after mapping.
+    fn apply_residency(&self) {
+        let options = self.residency;
+        let ring_offset = self.header.ring_offset as usize;
+        let ring_size = self.header.ring_size as usize;
+        if options.huge_pages {
+            let _ = residency::advise(&self.mmap, ring_offset, ring_size, Advice::HugePage);
+        }
+        if options.sequential {
+            let _ = residency::advise(&self.mmap, ring_offset, ring_size, Advice::Sequential);
+        }
+        if options.prefault {
+            residency::prefault(&self.mmap);
+        }
+    }
+
+    pub fn residency(&self) -> Residency {
+        self.residency
+    }
+
+    /// Bound how long appends wait for a contended append lock before failing with `Busy`.
+    /// `None` (the default) waits indefinitely.
+    pub fn set_lock_timeout(&mut self, timeout: Option<Duration>) {
+        self.lock_timeout = timeout;
+    }
+
+    pub fn lock_timeout(&self) -> Option<Duration> {
+        self.lock_timeout
+    }
+
+    /// Cursor advice (see `ReadWindow`): release the ring span read since the last call,
+    /// prefetch the one ahead. Spans are `(ring offset, len)` and may wrap.
+    pub(crate) fn advise_read_window(&self, behind: Option<(usize, usize)>, ahead: (usize, usize)) {
+        if let (Some(advice), Some((start, len))) = (self.residency.release_behind, behind) {
+            self.advise_ring(start, len, Advice::Release(advice));
+        }
+        if self.residency.readahead_bytes > 0 {
+            self.advise_ring(ahead.0, ahead.1, Advice::WillNeed);
+        }
+    }
+
+    fn advise_ring(&self, start: usize, len: usize, advice: Advice) {
+        let ring_offset = self.header.ring_offset as usize;
+        let ring_size = self.header.ring_size as usize;
+        let first = len.min(ring_size.saturating_sub(start));
+        let _ = residency::advise(&self.mmap, ring_offset + start, first, advice);
+        if first < len {
+            let _ = residency::advise(&self.mmap, ring_offset, len - first, advice);
+        }
     }
 
     pub fn header(&self) -> PoolHeader {
@@ -535,6 +785,12 @@ impl Pool {
         PoolHeader::decode(&self.mmap[0..HEADER_SIZE])
     }
 
+    /// `oldest_seq` as currently published in the mapping, without decoding the whole header;
+    /// 0 while the ring is empty.
+    pub(crate) fn oldest_seq_from_mmap(&self) -> u64 {
+        read_u64(&self.mmap, 88)
+    }
+
     pub(crate) fn path(&self) -> &Path {
         &self.path
     }
@@ -565,9 +821,19 @@ impl Pool {
             ring_size: header.ring_size,
             bounds,
             metrics: Some(self.metrics_from_header(header, bounds)),
+            hot_metrics: Some(self.hot_metrics()),
         })
     }
 
+    /// Hot-path counters accumulated in this pool's header by every process using it.
+    pub fn hot_metrics(&self) -> HotMetrics {
+        self.metrics().snapshot()
+    }
+
+    pub(crate) fn metrics(&self) -> HeaderMetrics<'_> {
+        HeaderMetrics::new(&self.mmap)
+    }
+
     pub fn get(&self, seq: u64) -> Result<crate::core::cursor::FrameRef<'_>, Error> {
         let mut header = self.header_from_mmap()?;
         let bounds = bounds_from_header(header);
@@ -587,6 +853,24 @@ impl Pool {
         }
 
         if let Some(frame) = self.get_via_index(header, seq) {
+            self.metrics().add(Counter::IndexHits, 1);
+            return Ok(frame);
+        }
+        if header.index_capacity != 0 {
+            self.metrics().add(Counter::IndexMisses, 1);
+        }
+        self.metrics().scan_fallback(seq - oldest + 1);
+        let used = used_ring_bytes(header);
+        if self.residency.readahead_bytes > 0 {
+            // A miss walks the whole live span; start fetching all of it before the walk does.
+            self.advise_ring(header.tail_off as usize, used as usize, Advice::WillNeed);
+        }
+        let scanned = if used >= PARALLEL_SCAN_MIN_BYTES {
+            self.get_via_scan(header, seq, &ScanOptions::new())
+        } else {
+            None
+        };
+        if let Some(frame) = scanned {
             return Ok(frame);
         }
 
@@ -628,7 +912,28 @@ impl Pool {
         header: PoolHeader,
         seq: u64,
     ) -> Option<crate::core::cursor::FrameRef<'_>> {
-        let index_capacity = header.index_capacity as u64;
+        self.indexed_frame(header, seq).map(|(_, frame)| frame)
+    }
+
+    /// Frame for `seq` and its ring offset, from its direct slot when current, else through
+    /// the block tier.
+    fn indexed_frame(
+        &self,
+        header: PoolHeader,
+        seq: u64,
+    ) -> Option<(usize, crate::core::cursor::FrameRef<'_>)> {
+        let layout = IndexLayout::of(&header);
+        self.direct_indexed_frame(header, layout, seq)
+            .or_else(|| self.block_indexed_frame(header, layout, seq))
+    }
+
+    fn direct_indexed_frame(
+        &self,
+        header: PoolHeader,
+        layout: IndexLayout,
+        seq: u64,
+    ) -> Option<(usize, crate::core::cursor::FrameRef<'_>)> {
+        let index_capacity = u64::from(layout.direct);
         if index_capacity == 0 {
             return None;
         }
@@ -654,6 +959,165 @@ impl Pool {
             ring_offset,
             ring_size,
             stored_offset as usize,
+        ) {
+            Ok(crate::core::cursor::ReadResult::Message { frame, .. }) if frame.seq == seq => {
+                Some((stored_offset as usize, frame))
+            }
+            _ => None,
+        }
+    }
+
+    /// Resolve `seq` by hopping frame headers forward from the first frame of its block, or
+    /// from the tail when that frame is already evicted. Every hop must land on the next
+    /// committed seq, and the final frame is fully validated; anything else is a miss.
+    fn block_indexed_frame(
+        &self,
+        header: PoolHeader,
+        layout: IndexLayout,
+        seq: u64,
+    ) -> Option<(usize, crate::core::cursor::FrameRef<'_>)> {
+        if layout.blocks == 0 || header.oldest_seq == 0 || seq < header.oldest_seq {
+            return None;
+        }
+        let block_start = seq - seq % INDEX_BLOCK_SEQS;
+        let (mut at_seq, mut offset) = if block_start < header.oldest_seq {
+            (header.oldest_seq, header.tail_off as usize)
+        } else {
+            let (start, len) =
+                index_entry_range(header.index_offset, layout.block_slot(block_start)?)?;
+            if start + len > self.mmap.len() || read_u64(self.mmap(), start) != block_start {
+                return None;
+            }
+            (block_start, read_u64(self.mmap(), start + 8) as usize)
+        };
+        let ring_offset = header.ring_offset as usize;
+        let ring_size = header.ring_size as usize;
+        loop {
+            if offset >= ring_size {
+                return None;
+            }
+            if ring_size - offset < FRAME_HEADER_LEN {
+                offset = 0;
+            }
+            let start = ring_offset + offset;
+            let hop = FrameHeader::decode(&self.mmap[start..start + FRAME_HEADER_LEN]).ok()?;
+            if hop.state == FrameState::Wrap && offset != 0 {
+                offset = 0;
+                continue;
+            }
+            if hop.state != FrameState::Committed || hop.seq != at_seq {
+                return None;
+            }
+            if at_seq == seq {
+                break;
+            }
+            offset += frame::frame_total_len(FRAME_HEADER_LEN, hop.payload_len as usize)?;
+            if offset == ring_size {
+                offset = 0;
+            }
+            at_seq += 1;
+        }
+        match crate::core::cursor::read_frame_at(self.mmap(), ring_offset, ring_size, offset) {
+            Ok(crate::core::cursor::ReadResult::Message { frame, .. }) if frame.seq == seq => {
+                Some((offset, frame))
+            }
+            _ => None,
+        }
+    }
+
+    /// Ring offset to start a cursor from when reading messages stamped at or after
+    /// `timestamp_ns`: the newest frame known to be older than `timestamp_ns` less
+    /// `SEEK_TIME_SKEW_NS`, found by binary search over the header's time checkpoints and then
+    /// over the seq index, or `tail_off` when none is.
+    ///
+    /// Stamps may run out of order by up to the skew margin; a frame stamped further behind a
+    /// later one may be skipped. Callers keep filtering by timestamp while reading forward.
+    pub fn seek_time(&self, timestamp_ns: u64) -> Result<usize, Error> {
+        let timestamp_ns = timestamp_ns.saturating_sub(SEEK_TIME_SKEW_NS);
+        let header = self.header_from_mmap()?;
+        let tail = header.tail_off as usize;
+        if header.oldest_seq == 0 {
+            return Ok(tail);
+        }
+        let ring_offset = header.ring_offset as usize;
+        let ring_size = header.ring_size as usize;
+        let mut checkpoints = Vec::with_capacity(TIME_CHECKPOINTS);
+        for slot in 0..TIME_CHECKPOINTS {
+            let start = TIME_INDEX_OFFSET + slot * TIME_CHECKPOINT_BYTES;
+            let seq = read_u64(self.mmap(), start);
+            let offset = read_u64(self.mmap(), start + 8) as usize;
+            let stamp = read_u64(self.mmap(), start + 16);
+            if seq < header.oldest_seq || seq > header.newest_seq || offset >= ring_size {
+                continue;
+            }
+            // Slots are advisory: keep only those that still describe a live frame.
+            match crate::core::cursor::read_frame_at(self.mmap(), ring_offset, ring_size, offset) {
+                Ok(crate::core::cursor::ReadResult::Message { frame, .. })
+                    if frame.seq == seq && frame.timestamp_ns == stamp =>
+                {
+                    checkpoints.push((seq, offset, stamp));
+                }
+                _ => {}
+            }
+        }
+        checkpoints.sort_unstable();
+        checkpoints.dedup();
+
+        let older = checkpoints.partition_point(|&(_, _, stamp)| stamp < timestamp_ns);
+        let (mut lo_seq, mut lo_off) = match older.checked_sub(1) {
+            Some(at) => (checkpoints[at].0, checkpoints[at].1),
+            None => (header.oldest_seq - 1, tail),
+        };
+        let mut hi_seq = checkpoints
+            .get(older)
+            .map_or(header.newest_seq + 1, |&(seq, _, _)| seq);
+        // Narrow the gap through the seq index while its slots still cover the probes.
+        while hi_seq - lo_seq > 1 {
+            let mid = lo_seq + (hi_seq - lo_seq) / 2;
+            let Some((offset, frame)) = self.indexed_frame(header, mid) else {
+                break;
+            };
+            if frame.timestamp_ns < timestamp_ns {
+                lo_seq = mid;
+                lo_off = offset;
+            } else {
+                hi_seq = mid;
+            }
+        }
+        Ok(lo_off)
+    }
+
+    /// Find `seq` with a chunked parallel walk of the live ring. `None` on a miss or on any
+    /// fault (e.g. a concurrent writer evicting frames mid-scan); callers then fall back to the
+    /// cursor walk, which resynchronizes on overwrite.
+    fn get_via_scan(
+        &self,
+        header: PoolHeader,
+        seq: u64,
+        options: &ScanOptions,
+    ) -> Option<crate::core::cursor::FrameRef<'_>> {
+        let scan = scan::scan_ring(
+            self.mmap(),
+            header,
+            options,
+            || None,
+            |found: &mut Option<usize>, offset, frame| {
+                if frame.seq < seq {
+                    return ControlFlow::Continue(());
+                }
+                if frame.seq == seq {
+                    *found = Some(offset);
+                }
+                ControlFlow::Break(())
+            },
+        )
+        .ok()?;
+        let offset = scan.chunks.into_iter().flatten().next()?;
+        match crate::core::cursor::read_frame_at(
+            self.mmap(),
+            header.ring_offset as usize,
+            header.ring_size as usize,
+            offset,
         ) {
             Ok(crate::core::cursor::ReadResult::Message { frame, .. }) if frame.seq == seq => {
                 Some(frame)
@@ -662,6 +1126,67 @@ impl Pool {
         }
     }
 
+    /// Rewrite the seq index from a full ring scan, e.g. after `doctor` warns about stale
+    /// slots. Holds the append lock throughout and returns the number of slots written; fails
+    /// with `Corrupt` (and writes nothing) if the ring does not walk cleanly.
+    pub fn rebuild_index(&mut self) -> Result<usize, Error> {
+        let _lock = self.lock_for_append()?;
+        let header = self.header;
+        if header.index_capacity == 0 || header.oldest_seq == 0 {
+            return Ok(0);
+        }
+        let layout = IndexLayout::of(&header);
+        // Only the newest `direct` seqs can own a direct slot; older ones would be overwritten.
+        let floor = header.newest_seq.saturating_sub(u64::from(layout.direct));
+        let scan = scan::scan_ring(
+            &self.mmap,
+            header,
+            &ScanOptions::new(),
+            Vec::new,
+            |slots: &mut Vec<(u64, usize)>, offset, frame| {
+                if frame.seq > floor || layout.block_slot(frame.seq).is_some() {
+                    slots.push((frame.seq, offset));
+                }
+                ControlFlow::Continue(())
+            },
+        )?;
+        if let Some(fault) = scan.fault {
+            let mut err = Error::new(ErrorKind::Corrupt)
+                .with_message(fault.message)
+                .with_path(&self.path)
+                .with_offset(fault.offset as u64);
+            if let Some(seq) = scan.last_good_seq {
+                err = err.with_seq(seq);
+            }
+            return Err(err);
+        }
+        let mut written = 0usize;
+        for (seq, offset) in scan.chunks.into_iter().flatten() {
+            write_index_entries(&mut self.mmap, &header, seq, offset as u64)?;
+            written += 1;
+        }
+        flush_mmap_range(
+            &self.mmap,
+            header.index_offset as usize,
+            header.index_capacity as usize * INDEX_SLOT_BYTES as usize,
+            &self.path,
+            "failed to flush rebuilt index",
+        )?;
+        Ok(written)
+    }
+
+    /// Whether `frame`, borrowed from this pool's mmap, still holds its committed bytes.
+    /// Readers that decode a payload in place re-check afterwards; `false` means a writer
+    /// has started reclaiming the frame and anything decoded from it must be discarded.
+    pub fn frame_still_valid(&self, frame: &crate::core::cursor::FrameRef<'_>) -> bool {
+        match frame_offset_in(&self.mmap, frame.payload) {
+            Some(frame_off) => {
+                frame_view_valid(&self.mmap, frame_off, frame.seq, frame.payload.len())
+            }
+            None => false,
+        }
+    }
+
     /// Fetch a frame using a caller-managed seq->offset cache for faster repeats.
     /// The cache is an optional optimization and must be passed explicitly.
     pub fn get_with_cache(
@@ -736,18 +1261,205 @@ impl Pool {
         }
     }
 
+    /// Take the cross-process append lock, blocking while another writer holds it. Fails with
+    /// `Busy` instead of waiting while a handle holds or is acquiring an exclusive writer
+    /// lease, or once `lock_timeout` passes.
+    ///
+    /// A writer already blocked when a lease is requested can still queue behind the lease;
+    /// set `lock_timeout` to bound that wait.
     pub fn append_lock(&self) -> Result<AppendLock, Error> {
-        let file = self.file.try_clone().map_err(|err| {
+        let file = self.lock_file()?;
+        let slot = writer_lease_slot(&self.mmap);
+        let started = Instant::now();
+        let contended = match file.try_lock_exclusive() {
+            Ok(()) => false,
+            Err(err) if is_lock_contended(&err) => {
+                let unleased = || match slot.load(Ordering::SeqCst) {
+                    0 => Ok(()),
+                    value => Err(self.lease_busy(value)),
+                };
+                unleased()?;
+                match self.lock_timeout {
+                    None => file.lock_exclusive().map_err(|err| self.lock_error(err))?,
+                    Some(timeout) => self.poll_lock(&file, Some(started + timeout), unleased)?,
+                }
+                true
+            }
+            Err(err) => return Err(self.lock_error(err)),
+        };
+        // Holding the lock proves a recorded lease holder is gone. A pending lease stays while
+        // its process lives: it is still waiting its turn.
+        let value = slot.load(Ordering::SeqCst);
+        if value != 0 && (value & LEASE_PENDING == 0 || is_stale_pending(value)) {
+            let _ = slot.compare_exchange(value, 0, Ordering::SeqCst, Ordering::SeqCst);
+        }
+        Ok(self.locked(file, started, contended))
+    }
+
+    /// Hold the append lock for this handle's lifetime so appends skip `flock` and the header
+    /// re-read. Other writers get `Busy` until the lease is released, the pool is dropped, or
+    /// the holder process exits.
+    ///
+    /// While the lock is contended the lease is published as pending, so writers arriving in
+    /// the meantime fail fast rather than block behind it; the wait polls and honors
+    /// `lock_timeout`.
+    pub fn acquire_writer_lease(&mut self) -> Result<(), Error> {
+        if self.lease.is_some() {
+            return Ok(());
+        }
+        let file = self.lock_file()?;
+        let slot = writer_lease_slot(&self.mmap);
+        let pid = u64::from(std::process::id());
+        let pending = pid | LEASE_PENDING;
+        let started = Instant::now();
+        let contended = match file.try_lock_exclusive() {
+            Ok(()) => false,
+            Err(err) if is_lock_contended(&err) => {
+                // Checked before every retry: re-publishes the marker if a writer cleared it.
+                let announce = || match slot.load(Ordering::SeqCst) {
+                    value if value == pending => Ok(()),
+                    value if value == 0 || is_stale_pending(value) => {
+                        match slot.compare_exchange(
+                            value,
+                            pending,
+                            Ordering::SeqCst,
+                            Ordering::SeqCst,
+                        ) {
+                            Ok(_) | Err(0) => Ok(()),
+                            Err(current) => Err(self.lease_busy(current)),
+                        }
+                    }
+                    value => Err(self.lease_busy(value)),
+                };
+                let deadline = self.lock_timeout.map(|timeout| started + timeout);
+                let polled = self.poll_lock(&file, deadline, announce);
+                if polled.is_err() {
+                    let _ = slot.compare_exchange(pending, 0, Ordering::SeqCst, Ordering::SeqCst);
+                }
+                polled?;
+                true
+            }
+            Err(err) => return Err(self.lock_error(err)),
+        };
+        let lock = self.locked(file, started, contended);
+        self.header = self.header_from_mmap()?;
+        writer_lease_slot(&self.mmap).store(pid, Ordering::SeqCst);
+        self.lease = Some(lock);
+        Ok(())
+    }
+
+    /// Retry a contended lock with backoff until it is taken, `check` fails, or `deadline`
+    /// passes. `check` runs before each sleep.
+    fn poll_lock(
+        &self,
+        file: &File,
+        deadline: Option<Instant>,
+        check: impl Fn() -> Result<(), Error>,
+    ) -> Result<(), Error> {
+        let mut backoff = LOCK_BACKOFF_MIN;
+        loop {
+            check()?;
+            let mut sleep = backoff;
+            if let Some(deadline) = deadline {
+                let remaining = deadline.saturating_duration_since(Instant::now());
+                if remaining.is_zero() {
+                    return Err(Error::new(ErrorKind::Busy)
+                        .with_message("timed out waiting for the append lock")
+                        .with_path(&self.path));
+                }
+                sleep = sleep.min(remaining);
+            }
+            std::thread::sleep(sleep);
+            backoff = (backoff * 2).min(LOCK_BACKOFF_MAX);
+            match file.try_lock_exclusive() {
+                Ok(()) => return Ok(()),
+                Err(err) if is_lock_contended(&err) => {}
+                Err(err) => return Err(self.lock_error(err)),
+            }
+        }
+    }
+
+    /// A separate open file description to `flock`: the lock belongs to the description.
+    fn lock_file(&self) -> Result<File, Error> {
+        if self.lease.is_some() {
+            // flock is per open file description: a second lock here would share, and on drop
+            // release, the lease itself.
+            return Err(Error::new(ErrorKind::Busy)
+                .with_message("append lock is held by this handle's writer lease")
+                .with_path(&self.path));
+        }
+        self.file.try_clone().map_err(|err| {
             Error::new(ErrorKind::Io)
                 .with_path(&self.path)
                 .with_source(err)
-        })?;
-        file.lock_exclusive().map_err(|err| {
-            Error::new(lock_error_kind(&err))
-                .with_path(&self.path)
-                .with_source(err)
-        })?;
-        Ok(AppendLock { file })
+        })
+    }
+
+    fn lock_error(&self, err: io::Error) -> Error {
+        Error::new(lock_error_kind(&err))
+            .with_path(&self.path)
+            .with_source(err)
+    }
+
+    fn lease_busy(&self, value: u64) -> Error {
+        let pid = value & !LEASE_PENDING;
+        let message = if value & LEASE_PENDING == 0 {
+            format!("pool is leased by an exclusive writer (pid {pid})")
+        } else {
+            format!("pool is being leased by an exclusive writer (pid {pid})")
+        };
+        Error::new(ErrorKind::Busy)
+            .with_message(message)
+            .with_path(&self.path)
+    }
+
+    fn locked(&self, file: File, started: Instant, contended: bool) -> AppendLock {
+        let acquired = Instant::now();
+        self.metrics()
+            .lock_acquired(acquired.duration_since(started), contended);
+        AppendLock { file, acquired }
+    }
+
+    pub fn release_writer_lease(&mut self) {
+        if let Some(lock) = self.lease.take() {
+            writer_lease_slot(&self.mmap).store(0, Ordering::SeqCst);
+            drop(lock);
+        }
+    }
+
+    pub fn has_writer_lease(&self) -> bool {
+        self.lease.is_some()
+    }
+
+    /// Pid recorded by the current exclusive writer lease, if any; a lease still waiting for
+    /// the lock is not reported. A holder that died without releasing is cleared by the next
+    /// writer that takes the lock.
+    pub fn writer_lease_holder(&self) -> Option<u64> {
+        match writer_lease_slot(&self.mmap).load(Ordering::SeqCst) {
+            value if value & LEASE_PENDING != 0 => None,
+            0 => None,
+            pid => Some(pid),
+        }
+    }
+
+    /// Serialize an append. Under a writer lease nothing else can move the header, so this is
+    /// free; otherwise take the append lock and refresh the header from the mapping.
+    fn lock_for_append(&mut self) -> Result<Option<AppendLock>, Error> {
+        if self.lease.is_some() {
+            return Ok(None);
+        }
+        let lock = self.append_lock()?;
+        // Refresh header after acquiring the lock to avoid stale state across processes.
+        self.header = self.header_from_mmap()?;
+        Ok(Some(lock))
+    }
+
+    /// Drop a lock from `lock_for_append`, counting how long it was held. Error paths simply
+    /// drop theirs, so hold times describe completed appends.
+    fn release_append_lock(&self, lock: Option<AppendLock>) {
+        if let Some(lock) = lock {
+            self.metrics().lock_released(lock.acquired.elapsed());
+        }
     }
 
     pub fn append(&mut self, payload: &[u8]) -> Result<u64, Error> {
@@ -767,84 +1479,377 @@ impl Pool {
         payload: &[u8],
         options: AppendOptions,
     ) -> Result<u64, Error> {
-        let _lock = self.append_lock()?;
-        // Refresh header after acquiring the lock to avoid stale state across processes.
-        self.header = self.header_from_mmap()?;
-        self.append_locked(payload, options)
+        let (seq, commit) = self.append_with_commit(payload, options)?;
+        commit.wait()?;
+        Ok(seq)
     }
 
-    fn append_locked(&mut self, payload: &[u8], options: AppendOptions) -> Result<u64, Error> {
-        let ring_offset = self.header.ring_offset as usize;
-        let ring_size = self.header.ring_size as usize;
-        let plan = plan::plan_append(self.header, &self.mmap, payload.len())?;
-
-        apply_append(
-            &mut self.mmap,
-            ring_offset,
-            &plan,
-            payload,
-            options.timestamp_ns,
-        )?;
+    /// Append without waiting for `Durability::GroupCommit`: returns once the frame is
+    /// published, with a handle that completes when it is on disk. Other durabilities are
+    /// already complete on return.
+    pub fn append_with_commit(
+        &mut self,
+        payload: &[u8],
+        options: AppendOptions,
+    ) -> Result<(u64, CommitHandle), Error> {
+        let lock = self.lock_for_append()?;
+        let appended = self.append_locked(payload, options)?;
+        self.release_append_lock(lock);
+        Ok(appended)
+    }
 
-        self.header = plan.next_header;
+    /// Append several payloads under one lock acquisition. Frames are planned and written in
+    /// order against a running header, `Durability::Flush` syncs coalesced ranges once (a group
+    /// commit submits them once), and waiters are notified once. Returns the assigned seqs,
+    /// which are contiguous.
+    ///
+    /// Payload sizes are checked before anything is written; a failure after that point may
+    /// leave a prefix of the batch committed (see `append_batch_partial` to learn which).
+    pub fn append_batch(
+        &mut self,
+        payloads: &[&[u8]],
+        options: AppendOptions,
+    ) -> Result<Vec<u64>, Error> {
+        let (seqs, result) = self.append_batch_partial(payloads, options);
+        result.map(|()| seqs)
+    }
 
-        if options.durability == Durability::Flush {
-            let frame_offset = ring_offset + plan.frame_offset;
-            flush_mmap_range(
-                &self.mmap,
-                frame_offset,
-                plan.frame_len,
-                &self.path,
-                "failed to flush frame",
-            )?;
-            if let Some(wrap_head) = plan.wrap_offset {
-                let wrap_start = ring_offset + wrap_head;
-                flush_mmap_range(
-                    &self.mmap,
-                    wrap_start,
-                    FRAME_HEADER_LEN,
-                    &self.path,
-                    "failed to flush wrap marker",
-                )?;
+    /// `append_batch` that reports the committed prefix alongside any failure: every returned
+    /// seq is published even when the result is an error, so callers can avoid re-appending it.
+    pub fn append_batch_partial(
+        &mut self,
+        payloads: &[&[u8]],
+        options: AppendOptions,
+    ) -> (Vec<u64>, Result<(), Error>) {
+        if payloads.is_empty() {
+            return (Vec::new(), Ok(()));
+        }
+        let lock = match self.lock_for_append() {
+            Ok(lock) => lock,
+            Err(err) => return (Vec::new(), Err(err)),
+        };
+        let (seqs, commit) = self.append_batch_locked(payloads, options);
+        match commit {
+            Ok(commit) => {
+                self.release_append_lock(lock);
+                (seqs, commit.wait())
+            }
+            Err(err) => (seqs, Err(err)),
+        }
+    }
+
+    /// Largest payload a single frame can hold in this pool's ring.
+    pub fn max_payload_len(&self) -> usize {
+        frame::max_payload(self.header.ring_size as usize, FRAME_HEADER_LEN)
+    }
+
+    /// Payload compression this pool was created with, if any.
+    pub fn compression(&self) -> Option<&Compression> {
+        self.codec.compression()
+    }
+
+    pub(crate) fn codec(&self) -> &FrameCodec {
+        &self.codec
+    }
+
+    /// The Lite3 payload of `frame`: borrowed as stored when raw, decompressed when
+    /// `frame.is_compressed()`. Zero-copy readers that only need raw frames can skip this and
+    /// use `frame.payload` directly after checking the flag.
+    pub fn frame_payload<'a>(
+        &self,
+        frame: &crate::core::cursor::FrameRef<'a>,
+    ) -> Result<Cow<'a, [u8]>, Error> {
+        self.codec
+            .decode(frame.flags, frame.payload, self.max_payload_len())
+            .map_err(|err| err.with_path(&self.path).with_seq(frame.seq))
+    }
+
+    pub fn append_reserve(&mut self, max_len: usize) -> Result<ReservedFrame<'_>, Error> {
+        self.append_reserve_with_options(max_len, AppendOptions::default())
+    }
+
+    /// Reserve ring space for a payload of up to `max_len` bytes and hand it out for in-place
+    /// writes. The append lock is held until the returned frame is committed or dropped.
+    ///
+    /// Space is planned for `max_len`, so frames evicted to make room stay evicted even if the
+    /// frame is committed shorter or abandoned.
+    pub fn append_reserve_with_options(
+        &mut self,
+        max_len: usize,
+        options: AppendOptions,
+    ) -> Result<ReservedFrame<'_>, Error> {
+        let reservation = self.reserve(max_len, options)?;
+        Ok(ReservedFrame {
+            pool: self,
+            reservation,
+        })
+    }
+
+    pub(crate) fn reserve(
+        &mut self,
+        max_len: usize,
+        options: AppendOptions,
+    ) -> Result<Reservation, Error> {
+        let lock = self.lock_for_append()?;
+        let plan = plan::plan_append(self.header, &self.mmap, max_len)?;
+        // The caller scribbles over evicted frames before commit; publishing the new tail now
+        // also means an abandoned reservation never leaves damaged frames inside [tail, head).
+        publish_evictions(&mut self.mmap, &mut self.header, &plan);
+        Ok(Reservation {
+            lock,
+            frame_offset: plan.frame_offset,
+            max_len,
+            options,
+        })
+    }
+
+    /// Re-plan `reservation` for a larger `max_len` without releasing the append lock. Only the
+    /// frames the larger slot additionally needs are evicted; the payload written so far is
+    /// not carried over, since the slot may move.
+    pub(crate) fn grow_reservation(
+        &mut self,
+        reservation: &mut Reservation,
+        max_len: usize,
+    ) -> Result<(), Error> {
+        if max_len <= reservation.max_len {
+            return Ok(());
+        }
+        let plan = plan::plan_append(self.header, &self.mmap, max_len)?;
+        publish_evictions(&mut self.mmap, &mut self.header, &plan);
+        reservation.frame_offset = plan.frame_offset;
+        reservation.max_len = max_len;
+        Ok(())
+    }
+
+    pub(crate) fn reserved_payload_mut(&mut self, reservation: &Reservation) -> &mut [u8] {
+        let start = self.header.ring_offset as usize + reservation.frame_offset + FRAME_HEADER_LEN;
+        &mut self.mmap[start..start + reservation.max_len]
+    }
+
+    pub(crate) fn commit_reservation(
+        &mut self,
+        reservation: Reservation,
+        payload_len: usize,
+    ) -> Result<u64, Error> {
+        if payload_len > reservation.max_len {
+            return Err(
+                Error::new(ErrorKind::Usage).with_message("commit length exceeds reservation")
+            );
+        }
+        let ring_offset = self.header.ring_offset as usize;
+        // Evictions for `max_len` already happened, so this plan should drop nothing; publish
+        // any it does before the move below overwrites their bytes.
+        let plan = plan::plan_append(self.header, &self.mmap, payload_len)?;
+        debug_assert!(plan.drops.is_empty());
+        publish_evictions(&mut self.mmap, &mut self.header, &plan);
+        if plan.frame_offset != reservation.frame_offset {
+            // `max_len` forced a wrap that the shorter frame does not need; move it into place.
+            let src = ring_offset + reservation.frame_offset + FRAME_HEADER_LEN;
+            let dst = ring_offset + plan.frame_offset + FRAME_HEADER_LEN;
+            self.mmap.copy_within(src..src + payload_len, dst);
+        }
+
+        apply_reserved_append(
+            &mut self.mmap,
+            ring_offset,
+            &plan,
+            payload_len,
+            reservation.options.timestamp_ns,
+        )?;
+        let (seq, commit) = self.finish_append(&plan, reservation.options)?;
+        self.release_append_lock(reservation.lock);
+        commit.wait()?;
+        Ok(seq)
+    }
+
+    fn append_locked(
+        &mut self,
+        payload: &[u8],
+        options: AppendOptions,
+    ) -> Result<(u64, CommitHandle), Error> {
+        let ring_offset = self.header.ring_offset as usize;
+        let encoded = self.codec.encode(payload, self.max_payload_len())?;
+        let plan = plan::plan_append(self.header, &self.mmap, encoded.bytes.len())?;
+        publish_evictions(&mut self.mmap, &mut self.header, &plan);
+
+        apply_append(
+            &mut self.mmap,
+            ring_offset,
+            &plan,
+            &encoded,
+            options.timestamp_ns,
+        )?;
+
+        self.finish_append(&plan, options)
+    }
+
+    /// Write `payloads` in order, stopping at the first failure. Returns the seqs written so
+    /// far with either the commit for them or that failure.
+    fn append_batch_locked(
+        &mut self,
+        payloads: &[&[u8]],
+        options: AppendOptions,
+    ) -> (Vec<u64>, Result<CommitHandle, Error>) {
+        let max_payload = self.max_payload_len();
+        if payloads.iter().any(|payload| payload.len() > max_payload) {
+            let err = Error::new(ErrorKind::Usage).with_message("payload exceeds ring capacity");
+            return (Vec::new(), Err(err));
+        }
+
+        let ring_offset = self.header.ring_offset as usize;
+        let mut seqs = Vec::with_capacity(payloads.len());
+        let mut frame_spans = FlushSpans::default();
+        let mut index_spans = FlushSpans::default();
+        let mut failure = None;
+        for payload in payloads {
+            let planned = self.codec.encode(payload, max_payload).and_then(|encoded| {
+                let plan = plan::plan_append(self.header, &self.mmap, encoded.bytes.len())?;
+                Ok((encoded, plan))
+            });
+            let (encoded, plan) = match planned {
+                Ok(planned) => planned,
+                Err(err) => {
+                    failure = Some(err);
+                    break;
+                }
+            };
+            publish_evictions(&mut self.mmap, &mut self.header, &plan);
+            if let Err(err) = apply_append(
+                &mut self.mmap,
+                ring_offset,
+                &plan,
+                &encoded,
+                options.timestamp_ns,
+            ) {
+                failure = Some(err);
+                break;
+            }
+            self.header = plan.next_header;
+            if let Some(wrap_offset) = plan.wrap_offset {
+                frame_spans.push(ring_offset + wrap_offset, FRAME_HEADER_LEN);
+            }
+            frame_spans.push(ring_offset + plan.frame_offset, plan.frame_len);
+            for (start, len) in index_ranges(&plan.next_header, plan.seq)
+                .into_iter()
+                .flatten()
+            {
+                index_spans.push(start, len);
+            }
+            seqs.push(plan.seq);
+        }
+
+        let mut commit = CommitHandle::done();
+        if !seqs.is_empty() {
+            // The frames are published either way; wake readers before reporting a sync error.
+            let committed = self.commit_spans(options.durability, &frame_spans, &index_spans);
+            self.announce_append();
+            commit = match committed {
+                Ok(commit) => commit,
+                Err(err) => return (seqs, Err(err)),
+            };
+        }
+
+        match failure {
+            Some(err) => (seqs, Err(err)),
+            None => (seqs, Ok(commit)),
+        }
+    }
+
+    fn finish_append(
+        &mut self,
+        plan: &plan::AppendPlan,
+        options: AppendOptions,
+    ) -> Result<(u64, CommitHandle), Error> {
+        let ring_offset = self.header.ring_offset as usize;
+        self.header = plan.next_header;
+
+        let mut frame_spans = FlushSpans::default();
+        let mut index_spans = FlushSpans::default();
+        if options.durability != Durability::Fast {
+            if let Some(wrap_head) = plan.wrap_offset {
+                frame_spans.push(ring_offset + wrap_head, FRAME_HEADER_LEN);
             }
-            if plan.next_header.index_capacity > 0 {
-                let (index_start, index_len) = index_slot_range(
-                    plan.next_header.index_offset,
-                    plan.next_header.index_capacity,
-                    plan.seq,
-                )
-                .ok_or_else(|| {
-                    Error::new(ErrorKind::Corrupt).with_message("index slot calculation overflow")
-                })?;
+            frame_spans.push(ring_offset + plan.frame_offset, plan.frame_len);
+            for (index_start, index_len) in index_ranges(&plan.next_header, plan.seq)
+                .into_iter()
+                .flatten()
+            {
+                index_spans.push(index_start, index_len);
+            }
+        }
+        let commit = self.commit_spans(options.durability, &frame_spans, &index_spans)?;
+
+        self.announce_append();
+
+        Ok((plan.seq, commit))
+    }
+
+    /// Make written frame and index spans durable as `durability` asks, header last: inline
+    /// for `Flush`, through the pool's group committer for `GroupCommit`.
+    fn commit_spans(
+        &mut self,
+        durability: Durability,
+        frame_spans: &FlushSpans,
+        index_spans: &FlushSpans,
+    ) -> Result<CommitHandle, Error> {
+        match durability {
+            Durability::Fast => Ok(CommitHandle::done()),
+            Durability::Flush => {
+                for &(start, end) in &frame_spans.spans {
+                    flush_mmap_range(
+                        &self.mmap,
+                        start,
+                        end - start,
+                        &self.path,
+                        "failed to flush frame",
+                    )?;
+                }
+                for &(start, end) in &index_spans.spans {
+                    flush_mmap_range(
+                        &self.mmap,
+                        start,
+                        end - start,
+                        &self.path,
+                        "failed to flush index slot",
+                    )?;
+                }
                 flush_mmap_range(
                     &self.mmap,
-                    index_start,
-                    index_len,
+                    0,
+                    HEADER_SIZE,
                     &self.path,
-                    "failed to flush index slot",
+                    "failed to flush header",
                 )?;
+                Ok(CommitHandle::done())
+            }
+            Durability::GroupCommit {
+                max_delay,
+                max_bytes,
+            } => {
+                let committer = match self.committer.take() {
+                    Some(committer) => committer,
+                    None => GroupCommitter::for_pool(&self.path, &self.file)?,
+                };
+                let spans = frame_spans.spans.iter().chain(&index_spans.spans).copied();
+                let commit = committer.submit(spans, max_delay, max_bytes);
+                self.committer = Some(committer);
+                Ok(commit)
             }
-            flush_mmap_range(
-                &self.mmap,
-                0,
-                HEADER_SIZE,
-                &self.path,
-                "failed to flush header",
-            )?;
         }
+    }
 
+    /// Post-commit bookkeeping shared by single and batched appends.
+    fn announce_append(&mut self) {
         validate::debug_assert_tail_committed(
             &self.mmap,
-            ring_offset,
-            ring_size,
+            self.header.ring_offset as usize,
+            self.header.ring_size as usize,
             self.header.tail_off as usize,
             self.header.tail_next_off as usize,
             self.header.oldest_seq,
         );
 
-        let _ = notify::post_for_path(&self.path);
-
-        Ok(plan.seq)
+        let _ = self.notify.post_if_waiting(&self.path, &self.mmap);
     }
 
     fn metrics_from_header(&self, header: PoolHeader, bounds: Bounds) -> PoolMetrics {
@@ -903,8 +1908,52 @@ impl Pool {
     }
 }
 
+/// Writable payload slot inside the ring, returned by `Pool::append_reserve`.
+///
+/// Write the payload through `payload_mut`, then `commit` the bytes actually used. Dropping
+/// without committing publishes nothing (beyond evictions made to fit `max_len`).
+pub struct ReservedFrame<'a> {
+    pool: &'a mut Pool,
+    reservation: Reservation,
+}
+
+impl ReservedFrame<'_> {
+    pub fn max_len(&self) -> usize {
+        self.reservation.max_len
+    }
+
+    pub fn payload_mut(&mut self) -> &mut [u8] {
+        self.pool.reserved_payload_mut(&self.reservation)
+    }
+
+    /// Enlarge the slot to `max_len` while keeping the append lock, e.g. when a size hint came
+    /// up short. Rewrite the payload afterwards: the slot may have moved.
+    pub fn grow(&mut self, max_len: usize) -> Result<(), Error> {
+        self.pool.grow_reservation(&mut self.reservation, max_len)
+    }
+
+    pub fn commit(self, payload_len: usize) -> Result<u64, Error> {
+        self.pool.commit_reservation(self.reservation, payload_len)
+    }
+}
+
+/// Lifetime-free half of `ReservedFrame`, for owners (like the C ABI) that hold the pool.
+pub(crate) struct Reservation {
+    lock: Option<AppendLock>,
+    frame_offset: usize,
+    max_len: usize,
+    options: AppendOptions,
+}
+
+impl Drop for Pool {
+    fn drop(&mut self) {
+        self.release_writer_lease();
+    }
+}
+
 pub struct AppendLock {
     file: File,
+    acquired: Instant,
 }
 
 impl Drop for AppendLock {
@@ -933,7 +1982,7 @@ fn map_io_error_kind(err: &io::Error) -> ErrorKind {
     }
 }
 
-fn read_header(file: &mut File, path: &Path) -> Result<PoolHeader, Error> {
+fn read_header_page(file: &mut File, path: &Path) -> Result<[u8; HEADER_SIZE], Error> {
     let mut buf = [0u8; HEADER_SIZE];
     file.seek(SeekFrom::Start(0))
         .map_err(|err| Error::new(ErrorKind::Io).with_path(path).with_source(err))?;
@@ -945,7 +1994,7 @@ fn read_header(file: &mut File, path: &Path) -> Result<PoolHeader, Error> {
         };
         Error::new(kind).with_path(path).with_source(err)
     })?;
-    PoolHeader::decode(&buf)
+    Ok(buf)
 }
 
 fn write_header(file: &mut File, header: &PoolHeader, path: &Path) -> Result<(), Error> {
@@ -959,9 +2008,93 @@ fn write_header(file: &mut File, header: &PoolHeader, path: &Path) -> Result<(),
     Ok(())
 }
 
+/// Offset of the frame header in `mmap` for a payload slice borrowed from it.
+pub(crate) fn frame_offset_in(mmap: &[u8], payload: &[u8]) -> Option<usize> {
+    let base = mmap.as_ptr() as usize;
+    let start = (payload.as_ptr() as usize).checked_sub(base)?;
+    if start + payload.len() > mmap.len() {
+        return None;
+    }
+    start.checked_sub(FRAME_HEADER_LEN)
+}
+
+/// Overwrite check for a frame borrowed at `frame_off` (an offset into the whole mapping).
+///
+/// Writers publish evictions in the pool header, then a release fence, before overwriting any
+/// evicted byte (see `publish_evictions`), so a frame whose seq is still in bounds after the
+/// acquire fence below has not been touched. The header and commit-marker comparison adds no
+/// ordering of its own; it rejects a token that never named a committed frame.
+pub(crate) fn frame_view_valid(
+    mmap: &[u8],
+    frame_off: usize,
+    seq: u64,
+    payload_len: usize,
+) -> bool {
+    // Order the caller's payload reads before the re-check below.
+    std::sync::atomic::fence(Ordering::Acquire);
+    if mmap.len() < HEADER_SIZE {
+        return false;
+    }
+    let header = match PoolHeader::decode(&mmap[0..HEADER_SIZE]) {
+        Ok(header) => header,
+        Err(_) => return false,
+    };
+    if header.oldest_seq == 0 || seq < header.oldest_seq || seq > header.newest_seq {
+        return false;
+    }
+    let ring_start = header.ring_offset as usize;
+    let ring_end = ring_start.saturating_add(header.ring_size as usize);
+    let marker_start = frame_off + FRAME_HEADER_LEN + payload_len;
+    let marker_end = marker_start + frame::FRAME_COMMIT_MARKER_LEN;
+    if frame_off < ring_start || marker_end > ring_end || marker_end > mmap.len() {
+        return false;
+    }
+    let frame_header = match FrameHeader::decode(&mmap[frame_off..frame_off + FRAME_HEADER_LEN]) {
+        Ok(frame_header) => frame_header,
+        Err(_) => return false,
+    };
+    frame_header.state == FrameState::Committed
+        && frame_header.seq == seq
+        && frame_header.payload_len as usize == payload_len
+        && mmap[marker_start..marker_end] == frame::FRAME_COMMIT_MARKER
+}
+
+fn is_lock_contended(err: &io::Error) -> bool {
+    err.raw_os_error() == fs2::lock_contended_error().raw_os_error()
+}
+
+/// A pending lease whose process has exited; it will never take the lock.
+fn is_stale_pending(value: u64) -> bool {
+    value & LEASE_PENDING != 0 && !process_alive(value & !LEASE_PENDING)
+}
+
+#[cfg(unix)]
+fn process_alive(pid: u64) -> bool {
+    let Ok(pid) = libc::pid_t::try_from(pid) else {
+        return false;
+    };
+    if pid <= 0 {
+        return false;
+    }
+    // SAFETY: signal 0 only probes for the process; nothing is delivered.
+    let rc = unsafe { libc::kill(pid, 0) };
+    rc == 0 || io::Error::last_os_error().raw_os_error() != Some(libc::ESRCH)
+}
+
+#[cfg(not(unix))]
+fn process_alive(_pid: u64) -> bool {
+    true
+}
+
+fn writer_lease_slot(mmap: &[u8]) -> &AtomicU64 {
+    let slot = &mmap[WRITER_LEASE_OFFSET..WRITER_LEASE_OFFSET + 8];
+    // SAFETY: 8-byte aligned inside the page-aligned shared mapping; only accessed atomically.
+    unsafe { &*(slot.as_ptr() as *const AtomicU64) }
+}
+
 fn write_pool_header(mmap: &mut MmapMut, header: &PoolHeader) {
     mmap[0..4].copy_from_slice(&MAGIC);
-    mmap[4..8].copy_from_slice(&format::POOL_FORMAT_VERSION.to_le_bytes());
+    mmap[4..8].copy_from_slice(&format_version(header.flags).to_le_bytes());
     mmap[8] = ENDIANNESS_LE;
     write_u64(mmap, 16, header.file_size);
     write_u64(mmap, 24, header.index_offset);
@@ -1086,9 +2219,10 @@ fn apply_append(
     mmap: &mut MmapMut,
     ring_offset: usize,
     plan: &plan::AppendPlan,
-    payload: &[u8],
+    encoded: &EncodedPayload<'_>,
     timestamp_ns: u64,
 ) -> Result<(), Error> {
+    let payload = &*encoded.bytes;
     let expected_len = frame::frame_total_len(FRAME_HEADER_LEN, payload.len())
         .ok_or_else(|| Error::new(ErrorKind::Corrupt).with_message("frame length overflow"))?;
     if expected_len != plan.frame_len {
@@ -1101,31 +2235,203 @@ fn apply_append(
 
     let header = FrameHeader::new(
         FrameState::Writing,
-        0,
+        encoded.flags,
         plan.seq,
         timestamp_ns,
         payload.len() as u32,
         0,
-    );
+    )
+    .with_tag_bloom(encoded.tag_bloom);
     write_frame(mmap, ring_offset, plan.frame_offset, &header, payload)?;
 
     let mut committed = header;
     committed.state = FrameState::Committed;
     write_frame_header(mmap, ring_offset, plan.frame_offset, &committed)?;
 
-    write_index_slot(
-        mmap,
-        plan.next_header.index_offset,
-        plan.next_header.index_capacity,
+    write_index_entries(mmap, &plan.next_header, plan.seq, plan.frame_offset as u64)?;
+    write_time_checkpoints(mmap, plan, timestamp_ns);
+
+    write_pool_header(mmap, &plan.next_header);
+
+    Ok(())
+}
+
+/// Variant of `apply_append` for a payload already written in place by a reservation.
+fn apply_reserved_append(
+    mmap: &mut MmapMut,
+    ring_offset: usize,
+    plan: &plan::AppendPlan,
+    payload_len: usize,
+    timestamp_ns: u64,
+) -> Result<(), Error> {
+    let expected_len = frame::frame_total_len(FRAME_HEADER_LEN, payload_len)
+        .ok_or_else(|| Error::new(ErrorKind::Corrupt).with_message("frame length overflow"))?;
+    if expected_len != plan.frame_len {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("append plan length mismatch"));
+    }
+
+    if let Some(wrap_offset) = plan.wrap_offset {
+        write_wrap(mmap, ring_offset, wrap_offset)?;
+    }
+
+    let payload_start = ring_offset + plan.frame_offset + FRAME_HEADER_LEN;
+    let tag_bloom = frame::payload_tag_bloom(&mmap[payload_start..payload_start + payload_len]);
+    let header = FrameHeader::new(
+        FrameState::Writing,
+        0,
         plan.seq,
-        plan.frame_offset as u64,
-    )?;
+        timestamp_ns,
+        payload_len as u32,
+        0,
+    )
+    .with_tag_bloom(tag_bloom);
+    write_frame_header(mmap, ring_offset, plan.frame_offset, &header)?;
+    let marker_start = payload_start + payload_len;
+    let marker_end = marker_start + frame::FRAME_COMMIT_MARKER_LEN;
+    mmap[marker_start..marker_end].copy_from_slice(&frame::FRAME_COMMIT_MARKER);
+
+    let mut committed = header;
+    committed.state = FrameState::Committed;
+    write_frame_header(mmap, ring_offset, plan.frame_offset, &committed)?;
+
+    write_index_entries(mmap, &plan.next_header, plan.seq, plan.frame_offset as u64)?;
+    write_time_checkpoints(mmap, plan, timestamp_ns);
 
     write_pool_header(mmap, &plan.next_header);
 
     Ok(())
 }
 
+/// Byte ranges to flush, merged while each push continues the previous range.
+#[derive(Default)]
+struct FlushSpans {
+    spans: Vec<(usize, usize)>,
+}
+
+impl FlushSpans {
+    fn push(&mut self, start: usize, len: usize) {
+        if let Some(last) = self.spans.last_mut() {
+            if last.1 == start {
+                last.1 = start + len;
+                return;
+            }
+        }
+        self.spans.push((start, start + len));
+    }
+}
+
+/// Move the tail past the frames `plan` drops before any of their bytes are overwritten.
+/// The release fence pairs with the acquire in `frame_view_valid`: a reader that saw
+/// overwritten bytes also sees the dropped seqs fall out of bounds.
+fn publish_evictions(mmap: &mut MmapMut, header: &mut PoolHeader, plan: &plan::AppendPlan) {
+    if plan.drops.is_empty() {
+        return;
+    }
+    let evicted = evicted_header(*header, plan);
+    write_pool_header(mmap, &evicted);
+    fence(Ordering::Release);
+    *header = evicted;
+}
+
+/// Header state after `plan`'s evictions but before its frame is written.
+fn evicted_header(header: PoolHeader, plan: &plan::AppendPlan) -> PoolHeader {
+    if plan.next_header.oldest_seq == plan.seq {
+        // Every live frame was evicted: an empty ring anchored at the current head.
+        return PoolHeader {
+            tail_off: header.head_off,
+            tail_next_off: header.head_off,
+            oldest_seq: 0,
+            ..header
+        };
+    }
+    PoolHeader {
+        tail_off: plan.next_header.tail_off,
+        tail_next_off: plan.next_header.tail_next_off,
+        oldest_seq: plan.next_header.oldest_seq,
+        ..header
+    }
+}
+
+/// How a pool's index region is split. The first `direct` slots map `seq % direct` to a
+/// frame offset. Pools flagged `INDEX_FLAG_BLOCKS` follow them with `blocks` slots mapping
+/// each `INDEX_BLOCK_SEQS`-aligned seq to its frame; `blocks` is derived from the ring size
+/// so the live blocks never share a slot.
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+struct IndexLayout {
+    direct: u32,
+    blocks: u64,
+}
+
+impl IndexLayout {
+    fn of(header: &PoolHeader) -> Self {
+        let capacity = u64::from(header.index_capacity);
+        let blocks = if header.flags & INDEX_FLAG_BLOCKS != 0 {
+            index_block_slots(header.ring_size)
+        } else {
+            0
+        };
+        if blocks == 0 || blocks >= capacity {
+            return Self {
+                direct: header.index_capacity,
+                blocks: 0,
+            };
+        }
+        Self {
+            direct: (capacity - blocks) as u32,
+            blocks,
+        }
+    }
+
+    /// Region slot of the block entry for `seq`, when `seq` starts a block.
+    fn block_slot(&self, seq: u64) -> Option<usize> {
+        if self.blocks == 0 || seq % INDEX_BLOCK_SEQS != 0 {
+            return None;
+        }
+        usize::try_from(u64::from(self.direct) + (seq / INDEX_BLOCK_SEQS) % self.blocks).ok()
+    }
+}
+
+/// Block slots needed so that no two blocks a full ring can hold collide; the extra slot
+/// covers the partial blocks at both ends of the live range.
+fn index_block_slots(ring_size: u64) -> u64 {
+    (ring_size / MIN_FRAME_BYTES).div_ceil(INDEX_BLOCK_SEQS) + 1
+}
+
+/// Write every index entry `seq` owns: its direct slot and, at block starts, its block slot.
+fn write_index_entries(
+    mmap: &mut [u8],
+    header: &PoolHeader,
+    seq: u64,
+    ring_relative_offset: u64,
+) -> Result<(), Error> {
+    let layout = IndexLayout::of(header);
+    write_index_slot(
+        mmap,
+        header.index_offset,
+        layout.direct,
+        seq,
+        ring_relative_offset,
+    )?;
+    if let Some(slot) = layout.block_slot(seq) {
+        let (start, len) = index_entry_range(header.index_offset, slot).ok_or_else(|| {
+            Error::new(ErrorKind::Corrupt).with_message("index slot calculation overflow")
+        })?;
+        write_index_entry(mmap, start, len, seq, ring_relative_offset)?;
+    }
+    Ok(())
+}
+
+/// Byte ranges of the entries `write_index_entries` touches for `seq`, for flushing.
+fn index_ranges(header: &PoolHeader, seq: u64) -> [Option<(usize, usize)>; 2] {
+    let layout = IndexLayout::of(header);
+    [
+        index_slot_range(header.index_offset, layout.direct, seq),
+        layout
+            .block_slot(seq)
+            .and_then(|slot| index_entry_range(header.index_offset, slot)),
+    ]
+}
+
 fn write_index_slot(
     mmap: &mut [u8],
     index_offset: u64,
@@ -1140,6 +2446,16 @@ fn write_index_slot(
         index_slot_range(index_offset, index_capacity, seq).ok_or_else(|| {
             Error::new(ErrorKind::Corrupt).with_message("index slot calculation overflow")
         })?;
+    write_index_entry(mmap, start, slot_bytes, seq, ring_relative_offset)
+}
+
+fn write_index_entry(
+    mmap: &mut [u8],
+    start: usize,
+    slot_bytes: usize,
+    seq: u64,
+    ring_relative_offset: u64,
+) -> Result<(), Error> {
     let end = start + slot_bytes;
     if end > mmap.len() {
         return Err(Error::new(ErrorKind::Corrupt).with_message("index slot out of bounds"));
@@ -1149,11 +2465,33 @@ fn write_index_slot(
     Ok(())
 }
 
+/// Point every time-index slot whose ring position this frame covers at the frame. Frames
+/// smaller than the stride cover at most one position, so most appends write one slot or none.
+fn write_time_checkpoints(mmap: &mut [u8], plan: &plan::AppendPlan, timestamp_ns: u64) {
+    let stride = time_stride(plan.next_header.ring_size as usize);
+    let first = plan.frame_offset.div_ceil(stride);
+    let last = ((plan.frame_offset + plan.frame_len - 1) / stride).min(TIME_CHECKPOINTS - 1);
+    for slot in first..=last {
+        let start = TIME_INDEX_OFFSET + slot * TIME_CHECKPOINT_BYTES;
+        write_u64(mmap, start, plan.seq);
+        write_u64(mmap, start + 8, plan.frame_offset as u64);
+        write_u64(mmap, start + 16, timestamp_ns);
+    }
+}
+
+fn time_stride(ring_size: usize) -> usize {
+    ring_size.div_ceil(TIME_CHECKPOINTS).max(1)
+}
+
 fn index_slot_range(index_offset: u64, index_capacity: u32, seq: u64) -> Option<(usize, usize)> {
     if index_capacity == 0 {
         return None;
     }
     let slot = usize::try_from(seq % index_capacity as u64).ok()?;
+    index_entry_range(index_offset, slot)
+}
+
+fn index_entry_range(index_offset: u64, slot: usize) -> Option<(usize, usize)> {
     let index_offset = usize::try_from(index_offset).ok()?;
     let slot_bytes = usize::try_from(INDEX_SLOT_BYTES).ok()?;
     let start = index_offset.checked_add(slot.checked_mul(slot_bytes)?)?;
@@ -1167,13 +2505,16 @@ mod tests {
     use crate::core::frame::{self, FRAME_HEADER_LEN, FrameHeader, FrameState};
     use crate::core::lite3;
     use crate::core::lite3::Lite3DocRef;
+    use crate::core::notify;
     use crate::core::plan;
+    use crate::core::scan::ScanOptions;
     use std::fs;
     use std::fs::OpenOptions;
     use std::io::{Seek, SeekFrom, Write};
     use std::process::Command;
+    use std::sync::atomic::Ordering;
     use std::thread;
-    use std::time::Duration;
+    use std::time::{Duration, Instant};
 
     #[test]
     fn create_and_open_pool() {
@@ -1259,7 +2600,7 @@ mod tests {
             .expect("create");
         file.set_len(1024 * 1024).expect("len");
 
-        let header = super::PoolHeader::new(1024 * 1024, 0).expect("header");
+        let header = super::PoolHeader::new(1024 * 1024, 0, 0).expect("header");
         let mut buf = header.encode();
         buf[4..8].copy_from_slice(&42u32.to_le_bytes());
         file.seek(SeekFrom::Start(0)).expect("seek");
@@ -1411,7 +2752,7 @@ mod tests {
         file.set_len(1024 * 1024).expect("len");
         file.seek(SeekFrom::Start(0)).expect("seek");
 
-        let header = super::PoolHeader::new(512 * 1024, 0).expect("header");
+        let header = super::PoolHeader::new(512 * 1024, 0, 0).expect("header");
         let buf = header.encode();
         file.write_all(&buf).expect("write");
         file.flush().expect("flush");
@@ -1491,10 +2832,9 @@ mod tests {
             &header,
             payload_len,
         );
-        super::write_index_slot(
+        super::write_index_entries(
             storage,
-            plan.next_header.index_offset,
-            plan.next_header.index_capacity,
+            &plan.next_header,
             plan.seq,
             plan.frame_offset as u64,
         )
@@ -1623,19 +2963,661 @@ mod tests {
     }
 
     #[test]
-    fn append_succeeds_when_notify_unavailable() {
+    fn append_batch_matches_sequential_appends() {
         let dir = tempfile::tempdir().expect("tempdir");
-        let path = dir.path().join("pool.plasmite");
-        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
-        let mut pool = Pool::create(&path, PoolOptions::new(4096 + 2048).with_index_capacity(0))
-            .expect("create");
-
-        crate::core::notify::force_unavailable_for_tests(true);
-        let result = pool.append(payload.as_slice());
-        crate::core::notify::force_unavailable_for_tests(false);
-
-        assert!(result.is_ok());
-    }
+        let payloads: Vec<_> = (0..7)
+            .map(|i| lite3::encode_message(&[], &serde_json::json!({"x": i})).expect("payload"))
+            .collect();
+        let frame_len =
+            frame::frame_total_len(FRAME_HEADER_LEN, payloads[0].len()).expect("frame len");
+        // Small enough that the batch wraps and evicts its own earliest frames.
+        let ring_size = frame_len * 3 + FRAME_HEADER_LEN;
+        let options = super::AppendOptions::new(42, super::Durability::Flush);
+
+        let batch_path = dir.path().join("batch.plasmite");
+        let mut batch = Pool::create(
+            &batch_path,
+            PoolOptions::new(4096 + 16 * 4 + ring_size as u64).with_index_capacity(4),
+        )
+        .expect("create");
+        let slices: Vec<&[u8]> = payloads.iter().map(|payload| payload.as_slice()).collect();
+        let seqs = batch.append_batch(&slices, options).expect("append batch");
+        assert_eq!(seqs, (1..=7).collect::<Vec<_>>());
+
+        let single_path = dir.path().join("single.plasmite");
+        let mut single = Pool::create(
+            &single_path,
+            PoolOptions::new(4096 + 16 * 4 + ring_size as u64).with_index_capacity(4),
+        )
+        .expect("create");
+        for payload in &slices {
+            single
+                .append_with_options(payload, options)
+                .expect("append");
+        }
+
+        assert_eq!(batch.header(), single.header());
+        assert_eq!(&batch.mmap[..], &single.mmap[..]);
+        assert_eq!(collect_seqs(&batch), vec![5, 6, 7]);
+    }
+
+    #[test]
+    fn residency_advice_leaves_reads_and_appends_unchanged() {
+        use crate::core::residency::{ReleaseAdvice, Residency};
+
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let residency = Residency::new()
+            .with_preallocation()
+            .with_prefault()
+            .with_huge_pages()
+            .with_sequential();
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(256 * 1024).with_residency(residency),
+        )
+        .expect("create");
+        assert_eq!(pool.residency(), residency);
+        for value in 0..2_000 {
+            let payload =
+                lite3::encode_message(&[], &serde_json::json!({"x": value})).expect("payload");
+            pool.append(payload.as_slice()).expect("append");
+        }
+        let expected = collect_seqs(&pool);
+        assert!(
+            expected.first().copied() > Some(1),
+            "ring should have wrapped"
+        );
+
+        let reader = Pool::open_with(
+            &path,
+            Residency::new()
+                .with_readahead(8 * 1024)
+                .with_release_behind(ReleaseAdvice::PageOut),
+        )
+        .expect("open");
+        let mut cursor = crate::core::cursor::Cursor::new();
+        let mut seen = Vec::new();
+        loop {
+            match cursor.next(&reader).expect("next") {
+                crate::core::cursor::CursorResult::Message(frame) => seen.push(frame.seq),
+                crate::core::cursor::CursorResult::WouldBlock => break,
+                crate::core::cursor::CursorResult::FellBehind => assert!(seen.is_empty()),
+            }
+        }
+        assert_eq!(seen, expected);
+        let oldest = expected[0];
+        assert_eq!(reader.get(oldest).expect("get").seq, oldest);
+    }
+
+    #[test]
+    fn compressed_pool_flags_large_frames_and_reopens_with_dictionary() {
+        use crate::core::compress::{Compression, train_dictionary};
+
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("compressed.plasmite");
+        let message = |i: usize, note: usize| {
+            let data = serde_json::json!({"host": format!("web-{i:03}"), "note": "x".repeat(note)});
+            lite3::encode_message(&["ops".to_string()], &data).expect("payload")
+        };
+        let samples: Vec<Vec<u8>> = (0..200)
+            .map(|i| message(i, 300).as_slice().to_vec())
+            .collect();
+        let dictionary = train_dictionary(&samples, 4096).expect("train");
+        let compression = Compression::zstd().with_dictionary(dictionary);
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(1024 * 1024).with_compression(compression.clone()),
+        )
+        .expect("create");
+
+        let large = message(1, 300);
+        let small = message(2, 0);
+        pool.append(large.as_slice()).expect("append large");
+        pool.append(small.as_slice()).expect("append small");
+        pool.append_batch(&[large.as_slice()], super::AppendOptions::default())
+            .expect("append batch");
+        drop(pool);
+
+        let pool = Pool::open(&path).expect("open");
+        assert_eq!(pool.compression(), Some(&compression));
+        for (seq, raw, compressed) in [(1, &large, true), (2, &small, false), (3, &large, true)] {
+            let frame = pool.get(seq).expect("get");
+            assert_eq!(frame.is_compressed(), compressed);
+            assert_eq!(frame.payload.len() < raw.len(), compressed);
+            assert_eq!(frame.tag_bloom, frame::payload_tag_bloom(raw.as_slice()));
+            assert_eq!(
+                &*pool.frame_payload(&frame).expect("payload"),
+                raw.as_slice()
+            );
+        }
+    }
+
+    #[test]
+    fn compressed_pools_are_refused_by_version_3_readers() {
+        use crate::core::compress::Compression;
+        use crate::core::format::{POOL_FORMAT_VERSION, POOL_FORMAT_VERSION_COMPRESSED};
+
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("compressed.plasmite");
+        let plain_path = dir.path().join("plain.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"note": "x".repeat(512)}))
+            .expect("payload");
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(1024 * 1024).with_compression(Compression::zstd()),
+        )
+        .expect("create");
+        pool.append(payload.as_slice()).expect("append");
+        drop(pool);
+        drop(Pool::create(&plain_path, PoolOptions::new(1024 * 1024)).expect("create"));
+
+        let stored_version = |path: &std::path::Path| {
+            let bytes = fs::read(path).expect("read");
+            u32::from_le_bytes(bytes[4..8].try_into().expect("version"))
+        };
+        // A version-3 binary opens exactly version 3 and reports anything else as unsupported.
+        assert_eq!(stored_version(&path), POOL_FORMAT_VERSION_COMPRESSED);
+        assert_ne!(stored_version(&path), 3);
+        assert_eq!(stored_version(&plain_path), POOL_FORMAT_VERSION);
+        assert!(
+            Pool::open(&path)
+                .expect("open")
+                .get(1)
+                .expect("get")
+                .is_compressed()
+        );
+
+        // Relabelled as version 3, the pool is refused rather than read as raw Lite3.
+        let mut file = OpenOptions::new().write(true).open(&path).expect("open");
+        file.seek(SeekFrom::Start(4)).expect("seek");
+        file.write_all(&POOL_FORMAT_VERSION.to_le_bytes())
+            .expect("write");
+        drop(file);
+        let err = Pool::open(&path).err().expect("mismatched version");
+        assert_eq!(err.kind(), ErrorKind::Corrupt);
+    }
+
+    #[test]
+    fn append_batch_partial_reports_the_committed_prefix() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(64 * 1024).with_index_capacity(0))
+            .expect("create");
+        let ring_size = pool.header.ring_size as usize;
+        let pad = "p".repeat(ring_size * 3 / 10);
+        let payload =
+            lite3::encode_message(&[], &serde_json::json!({"pad": pad})).expect("payload");
+        pool.append(payload.as_slice()).expect("append 1");
+        pool.append(payload.as_slice()).expect("append 2");
+
+        // The first batch frame fits in free space; the second wraps, evicts seq 1, and fails
+        // reading the corrupted header of seq 2 as the new tail.
+        let second = pool.header.ring_offset as usize + pool.header.tail_next_off as usize;
+        pool.mmap[second..second + FRAME_HEADER_LEN].fill(0xff);
+        let (seqs, result) = pool.append_batch_partial(
+            &[payload.as_slice(), payload.as_slice()],
+            super::AppendOptions::default(),
+        );
+        assert_eq!(seqs, vec![3]);
+        assert_eq!(result.expect_err("corrupt tail").kind(), ErrorKind::Corrupt);
+        assert_eq!(pool.header_from_mmap().expect("header").newest_seq, 3);
+    }
+
+    #[test]
+    fn append_batch_rejects_oversized_payload_before_writing() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let oversized = vec![0u8; pool.max_payload_len() + 1];
+
+        let err = pool
+            .append_batch(
+                &[payload.as_slice(), oversized.as_slice()],
+                super::AppendOptions::default(),
+            )
+            .expect_err("oversized batch");
+        assert_eq!(err.kind(), ErrorKind::Usage);
+        assert!(pool.bounds().expect("bounds").newest_seq.is_none());
+        assert!(
+            pool.append_batch(&[], super::AppendOptions::default())
+                .expect("empty batch")
+                .is_empty()
+        );
+    }
+
+    #[test]
+    fn writer_lease_excludes_other_writers_until_released() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut leased = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let mut other = Pool::open(&path).expect("open");
+
+        leased.acquire_writer_lease().expect("lease");
+        assert!(leased.has_writer_lease());
+        assert_eq!(
+            other.writer_lease_holder(),
+            Some(u64::from(std::process::id()))
+        );
+        assert_eq!(leased.append(payload.as_slice()).expect("append"), 1);
+        assert_eq!(leased.append(payload.as_slice()).expect("append"), 2);
+
+        let err = other.append(payload.as_slice()).expect_err("leased");
+        assert_eq!(err.kind(), ErrorKind::Busy);
+        assert!(err.message().unwrap_or("").contains("exclusive writer"));
+
+        drop(leased);
+        assert_eq!(other.writer_lease_holder(), None);
+        assert_eq!(other.append(payload.as_slice()).expect("append"), 3);
+        assert_eq!(collect_seqs(&other), vec![1, 2, 3]);
+    }
+
+    #[test]
+    fn stale_writer_lease_is_cleared_by_next_writer() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+
+        // A holder that died keeps its pid in the header but no longer holds the lock.
+        super::writer_lease_slot(&pool.mmap).store(999_999, Ordering::SeqCst);
+        assert_eq!(pool.writer_lease_holder(), Some(999_999));
+        pool.append(payload.as_slice()).expect("append");
+        assert_eq!(pool.writer_lease_holder(), None);
+    }
+
+    #[test]
+    fn stale_pending_lease_is_cleared_by_next_writer() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let slot = |pool: &Pool| super::writer_lease_slot(&pool.mmap).load(Ordering::SeqCst);
+
+        // Above any pid_max, so no live process can own it.
+        super::writer_lease_slot(&pool.mmap)
+            .store(super::LEASE_PENDING | 0x7fff_fff0, Ordering::SeqCst);
+        assert_eq!(pool.writer_lease_holder(), None);
+        pool.append(payload.as_slice()).expect("append");
+        assert_eq!(slot(&pool), 0);
+
+        // A live pending lease is still waiting its turn and must survive.
+        let live = super::LEASE_PENDING | u64::from(std::process::id());
+        super::writer_lease_slot(&pool.mmap).store(live, Ordering::SeqCst);
+        pool.append(payload.as_slice()).expect("append");
+        assert_eq!(slot(&pool), live);
+    }
+
+    #[test]
+    fn contended_append_lock_blocks_until_released() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let holder = Pool::open(&path).expect("open");
+
+        let lock = holder.append_lock().expect("lock");
+        let started = Instant::now();
+        let releasing = thread::spawn(move || {
+            thread::sleep(Duration::from_millis(20));
+            drop(lock);
+            holder
+        });
+        assert_eq!(pool.append(payload.as_slice()).expect("append"), 1);
+        assert!(started.elapsed() >= Duration::from_millis(20));
+        drop(releasing.join().expect("join"));
+    }
+
+    #[test]
+    fn pending_writer_lease_turns_away_new_writers() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let holder = Pool::open(&path).expect("open");
+        let mut leaser = Pool::open(&path).expect("open");
+
+        let lock = holder.append_lock().expect("lock");
+        let leasing = thread::spawn(move || {
+            leaser.acquire_writer_lease().expect("lease");
+            leaser
+        });
+        let pending = super::LEASE_PENDING | u64::from(std::process::id());
+        while super::writer_lease_slot(&pool.mmap).load(Ordering::SeqCst) != pending {
+            thread::sleep(Duration::from_millis(1));
+        }
+        // Fails fast rather than blocking behind the lease about to be taken.
+        let err = pool.append(payload.as_slice()).expect_err("pending lease");
+        assert_eq!(err.kind(), ErrorKind::Busy);
+        assert!(err.message().unwrap_or("").contains("being leased"));
+
+        drop(lock);
+        let leaser = leasing.join().expect("join");
+        assert!(leaser.has_writer_lease());
+        assert_eq!(
+            pool.writer_lease_holder(),
+            Some(u64::from(std::process::id()))
+        );
+        drop(leaser);
+        assert_eq!(pool.append(payload.as_slice()).expect("append"), 1);
+    }
+
+    #[test]
+    fn contended_append_lock_honors_lock_timeout() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let holder = Pool::open(&path).expect("open");
+        pool.set_lock_timeout(Some(Duration::from_millis(30)));
+
+        let lock = holder.append_lock().expect("lock");
+        let started = Instant::now();
+        let err = pool.append(payload.as_slice()).expect_err("timed out");
+        assert_eq!(err.kind(), ErrorKind::Busy);
+        assert!(err.message().unwrap_or("").contains("timed out"));
+        assert!(started.elapsed() >= Duration::from_millis(30));
+
+        drop(lock);
+        assert_eq!(pool.append(payload.as_slice()).expect("append"), 1);
+    }
+
+    #[test]
+    fn appends_record_tag_bloom_in_frame_header() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let tags = vec!["ops".to_string()];
+        let data = serde_json::json!({"x": 1});
+        let payload = lite3::encode_message(&tags, &data).expect("payload");
+        pool.append(payload.as_slice()).expect("append");
+        let mut reserved = pool.append_reserve(payload.len()).expect("reserve");
+        reserved.payload_mut()[..payload.len()].copy_from_slice(payload.as_slice());
+        reserved.commit(payload.len()).expect("commit");
+
+        for seq in [1, 2] {
+            let frame = pool.get(seq).expect("get");
+            assert_eq!(frame.tag_bloom, frame::tag_bloom(["ops"]));
+            assert!(frame::tag_bloom_may_match(
+                frame.tag_bloom,
+                frame::tag_bloom(["ops"])
+            ));
+            assert!(!frame::tag_bloom_may_match(
+                frame.tag_bloom,
+                frame::tag_bloom(["billing"])
+            ));
+        }
+    }
+
+    #[test]
+    fn frame_view_turns_invalid_once_overwritten() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let options = PoolOptions::new(HEADER_SIZE as u64 + 1024).with_index_capacity(0);
+        let mut pool = Pool::create(&path, options).expect("create");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        pool.append(payload.as_slice()).expect("append");
+
+        let frame = pool.get(1).expect("get");
+        assert!(pool.frame_still_valid(&frame));
+        let frame_off = super::frame_offset_in(&pool.mmap, frame.payload).expect("offset");
+        let len = frame.payload.len();
+
+        while pool.bounds().expect("bounds").oldest_seq == Some(1) {
+            pool.append(payload.as_slice()).expect("append");
+        }
+        assert!(!super::frame_view_valid(&pool.mmap, frame_off, 1, len));
+        let newest = pool.bounds().expect("bounds").newest_seq.expect("newest");
+        let frame = pool.get(newest).expect("get newest");
+        assert!(pool.frame_still_valid(&frame));
+    }
+
+    #[test]
+    fn evictions_are_published_before_frame_bytes_are_overwritten() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let options = PoolOptions::new(HEADER_SIZE as u64 + 1024).with_index_capacity(0);
+        let mut pool = Pool::create(&path, options).expect("create");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        loop {
+            let plan =
+                plan::plan_append(pool.header, &pool.mmap, payload.len()).expect("plan append");
+            if !plan.drops.is_empty() {
+                break;
+            }
+            pool.append(payload.as_slice()).expect("append");
+        }
+
+        let frame = pool.get(1).expect("get");
+        let frame_off = super::frame_offset_in(&pool.mmap, frame.payload).expect("offset");
+        let len = frame.payload.len();
+        // Stop after the eviction step of an append: frame 1's bytes are still intact, but its
+        // view must already read as reclaimed.
+        let plan = plan::plan_append(pool.header, &pool.mmap, payload.len()).expect("plan");
+        super::publish_evictions(&mut pool.mmap, &mut pool.header, &plan);
+        assert!(!super::frame_view_valid(&pool.mmap, frame_off, 1, len));
+    }
+
+    #[test]
+    fn reserve_commit_writes_frame_in_place() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let tags = vec!["evt".to_string()];
+        let data = serde_json::json!({"x": 1, "name": "in-place"});
+        let expected = lite3::encode_message(&tags, &data).expect("payload");
+
+        let mut reserved = pool
+            .append_reserve(lite3::encoded_len_hint(&tags, &data))
+            .expect("reserve");
+        let len = lite3::encode_message_into(&tags, &data, reserved.payload_mut())
+            .expect("encode")
+            .expect("fits");
+        let seq = reserved.commit(len).expect("commit");
+
+        assert_eq!(seq, 1);
+        assert_eq!(pool.get(seq).expect("get").payload, expected.as_slice());
+        let header = pool.header_from_mmap().expect("header");
+        crate::core::validate::validate_pool_state(header, &pool.mmap).expect("validate");
+        assert_eq!(pool.append(expected.as_slice()).expect("append"), 2);
+    }
+
+    #[test]
+    fn reserve_without_commit_publishes_nothing() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        pool.append(payload.as_slice()).expect("append");
+        let before = pool.header_from_mmap().expect("header");
+
+        {
+            let mut reserved = pool.append_reserve(256).expect("reserve");
+            reserved.payload_mut().fill(0xEE);
+        }
+
+        let after = pool.header_from_mmap().expect("header");
+        assert_eq!(after, before);
+        assert_eq!(pool.append(payload.as_slice()).expect("append"), 2);
+        assert_eq!(collect_seqs(&pool), vec![1, 2]);
+    }
+
+    #[test]
+    fn reserve_commit_shorter_frame_skips_unneeded_wrap() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 3})).expect("payload");
+        let frame_len = frame::frame_total_len(FRAME_HEADER_LEN, payload.len()).expect("len");
+        let ring_size = frame_len * 3 + FRAME_HEADER_LEN;
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(4096 + ring_size as u64).with_index_capacity(0),
+        )
+        .expect("create");
+        pool.append(payload.as_slice()).expect("append 1");
+        pool.append(payload.as_slice()).expect("append 2");
+
+        // A two-frame reservation cannot fit before the ring end, so it wraps and evicts both
+        // frames; the committed single frame still fits at the old head.
+        let max_len = 2 * frame_len - FRAME_HEADER_LEN - frame::FRAME_COMMIT_MARKER_LEN;
+        let mut reserved = pool.append_reserve(max_len).expect("reserve");
+        reserved.payload_mut()[..payload.len()].copy_from_slice(payload.as_slice());
+        let seq = reserved.commit(payload.len()).expect("commit");
+
+        assert_eq!(seq, 3);
+        assert_eq!(collect_seqs(&pool), vec![3]);
+        assert_eq!(pool.get(3).expect("get").payload, payload.as_slice());
+        assert_eq!(pool.header().tail_off as usize, 2 * frame_len);
+        let header = pool.header_from_mmap().expect("header");
+        crate::core::validate::validate_pool_state(header, &pool.mmap).expect("validate");
+    }
+
+    #[test]
+    fn abandoned_reservation_keeps_evictions_consistent() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 4})).expect("payload");
+        let frame_len = frame::frame_total_len(FRAME_HEADER_LEN, payload.len()).expect("len");
+        let ring_size = frame_len * 4;
+        let mut pool = Pool::create(
+            &path,
+            PoolOptions::new(4096 + ring_size as u64).with_index_capacity(0),
+        )
+        .expect("create");
+        for _ in 0..6 {
+            pool.append(payload.as_slice()).expect("append");
+        }
+
+        {
+            let mut reserved = pool.append_reserve(frame_len).expect("reserve");
+            reserved.payload_mut().fill(0xEE);
+        }
+
+        let header = pool.header_from_mmap().expect("header");
+        crate::core::validate::validate_pool_state(header, &pool.mmap).expect("validate");
+        assert_eq!(header.newest_seq, 6);
+        assert!(header.oldest_seq > 3);
+        assert_eq!(pool.append(payload.as_slice()).expect("append"), 7);
+        let header = pool.header_from_mmap().expect("header");
+        crate::core::validate::validate_pool_state(header, &pool.mmap).expect("validate");
+    }
+
+    #[test]
+    fn append_succeeds_when_notify_unavailable() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(4096 + 2048).with_index_capacity(0))
+            .expect("create");
+        // Pretend a waiter is registered so the append actually tries to post.
+        notify::waiter_count(&pool.mmap).fetch_add(1, Ordering::SeqCst);
+
+        notify::force_unavailable_for_tests(true);
+        let result = pool.append(payload.as_slice());
+        notify::force_unavailable_for_tests(false);
+
+        assert!(result.is_ok());
+    }
+
+    #[test]
+    fn append_notifies_only_when_waiters_registered() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+
+        pool.append(payload.as_slice()).expect("append");
+        assert!(pool.notify.is_unopened());
+        assert_eq!(notify::notify_epoch(&pool.mmap).load(Ordering::SeqCst), 0);
+
+        notify::waiter_count(&pool.mmap).fetch_add(1, Ordering::SeqCst);
+        pool.append(payload.as_slice()).expect("append");
+        if notify::EPOCH_WAKEUPS {
+            assert_eq!(notify::notify_epoch(&pool.mmap).load(Ordering::SeqCst), 1);
+        } else {
+            assert!(!pool.notify.is_unopened());
+        }
+
+        // The slot sits outside the decoded header and survives header rewrites.
+        assert_eq!(notify::waiter_count(&pool.mmap).load(Ordering::SeqCst), 1);
+        let reopened = Pool::open(&path).expect("open");
+        assert_eq!(reopened.header(), pool.header());
+    }
+
+    #[test]
+    fn group_commit_appends_wait_for_one_shared_flush() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let lazy = super::AppendOptions::new(
+            0,
+            super::Durability::GroupCommit {
+                max_delay: Duration::from_secs(60),
+                max_bytes: u64::MAX,
+            },
+        );
+
+        let pending: Vec<_> = (0..3)
+            .map(|_| {
+                pool.append_with_commit(payload.as_slice(), lazy)
+                    .expect("append")
+                    .1
+            })
+            .collect();
+        assert!(pending.iter().all(|commit| !commit.is_durable()));
+
+        // A handle on the same file shares the committer; its zero delay flushes everyone.
+        let mut other = Pool::open(&path).expect("open");
+        let eager = super::Durability::GroupCommit {
+            max_delay: Duration::ZERO,
+            max_bytes: u64::MAX,
+        };
+        let seq = other
+            .append_with_options(payload.as_slice(), super::AppendOptions::new(0, eager))
+            .expect("append");
+        assert_eq!(seq, 4);
+        for commit in &pending {
+            commit.wait().expect("durable");
+        }
+        let metrics = pool.hot_metrics();
+        assert_eq!(metrics.group_commit_flushes, 1);
+        assert_eq!(metrics.group_commit_appends, 4);
+    }
+
+    #[test]
+    fn group_commit_appends_from_many_threads() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+
+        let writers: Vec<_> = (0..4)
+            .map(|_| {
+                let path = path.clone();
+                thread::spawn(move || {
+                    let payload =
+                        lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+                    let mut pool = Pool::open(&path).expect("open");
+                    let options = super::AppendOptions::new(0, super::Durability::group_commit());
+                    for _ in 0..25 {
+                        pool.append_with_options(payload.as_slice(), options)
+                            .expect("append");
+                    }
+                })
+            })
+            .collect();
+        for writer in writers {
+            writer.join().expect("join");
+        }
+
+        let pool = Pool::open(&path).expect("open");
+        assert_eq!(pool.bounds().expect("bounds").newest_seq, Some(100));
+        let metrics = pool.hot_metrics();
+        assert_eq!(metrics.group_commit_appends, 100);
+        assert!(metrics.group_commit_flushes <= 100);
+    }
 
     #[test]
     fn model_apply_matches_plan_on_wrap() {
@@ -1663,7 +3645,7 @@ mod tests {
             &mut pool.mmap,
             header.ring_offset as usize,
             &plan,
-            payload_b.as_slice(),
+            &super::EncodedPayload::raw(payload_b.as_slice()),
             0,
         )
         .expect("apply");
@@ -1705,7 +3687,7 @@ mod tests {
             &mut pool.mmap,
             header.ring_offset as usize,
             &plan,
-            payload_b.as_slice(),
+            &super::EncodedPayload::raw(payload_b.as_slice()),
             0,
         )
         .expect("apply");
@@ -1790,6 +3772,195 @@ mod tests {
         assert_eq!(frame.seq, 2);
     }
 
+    #[test]
+    fn get_via_scan_finds_every_live_seq_across_chunks() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(32 * 1024).with_index_capacity(0))
+            .expect("create");
+        for value in 0..400 {
+            let payload =
+                lite3::encode_message(&[], &serde_json::json!({"x": value})).expect("payload");
+            pool.append(payload.as_slice()).expect("append");
+        }
+
+        let header = pool.header_from_mmap().expect("header");
+        assert!(header.oldest_seq > 1);
+        let options = ScanOptions::new().with_workers(4).with_chunk_bytes(512);
+        for seq in header.oldest_seq..=header.newest_seq {
+            let frame = pool.get_via_scan(header, seq, &options).expect("scan get");
+            assert_eq!(frame, pool.get(seq).expect("get"));
+        }
+        assert!(
+            pool.get_via_scan(header, header.oldest_seq - 1, &options)
+                .is_none()
+        );
+    }
+
+    #[test]
+    fn rebuild_index_restores_cleared_slots() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024).with_index_capacity(16))
+            .expect("create");
+        for value in 0..40 {
+            let payload =
+                lite3::encode_message(&[], &serde_json::json!({"x": value})).expect("payload");
+            pool.append(payload.as_slice()).expect("append");
+        }
+        let header = pool.header_from_mmap().expect("header");
+        let index_start = header.index_offset as usize;
+        let before = pool.mmap[index_start..index_start + 16 * 16].to_vec();
+        pool.mmap[index_start..index_start + 16 * 16].fill(0);
+        assert!(pool.get_via_index(header, 40).is_none());
+
+        assert_eq!(pool.rebuild_index().expect("rebuild"), 16);
+        assert_eq!(pool.mmap[index_start..index_start + 16 * 16], before[..]);
+        for seq in 25..=40 {
+            assert_eq!(pool.get_via_index(header, seq).expect("indexed").seq, seq);
+        }
+    }
+
+    #[test]
+    fn block_index_resolves_seqs_past_the_direct_table() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024)).expect("create");
+        let header = pool.header_from_mmap().expect("header");
+        assert_ne!(header.flags & super::INDEX_FLAG_BLOCKS, 0);
+        let layout = super::IndexLayout::of(&header);
+        assert!(layout.blocks > 0);
+        assert_eq!(
+            u64::from(layout.direct) + layout.blocks,
+            u64::from(header.index_capacity)
+        );
+
+        // Minimal frames (the pool layer does not decode payloads), enough to wrap the ring
+        // twice while holding far more live seqs than the direct table.
+        for _ in 0..30_000 {
+            pool.append(&[0u8; 8]).expect("append");
+        }
+        let header = pool.header_from_mmap().expect("header");
+        let oldest = header.oldest_seq;
+        assert!(header.newest_seq - oldest > 2 * u64::from(layout.direct));
+        let probes = (oldest..=header.newest_seq).step_by(7).chain([
+            oldest,
+            oldest.next_multiple_of(4096),
+            header.newest_seq,
+        ]);
+        for seq in probes.clone() {
+            let (offset, frame) = pool
+                .block_indexed_frame(header, layout, seq)
+                .unwrap_or_else(|| panic!("seq {seq} not resolved"));
+            assert_eq!(frame.seq, seq);
+            assert_eq!(pool.indexed_frame(header, seq).expect("indexed").0, offset);
+        }
+
+        let index = header.index_offset as usize..header.ring_offset as usize;
+        pool.mmap[index].fill(0);
+        assert!(pool.indexed_frame(header, oldest + 4096).is_none());
+        pool.rebuild_index().expect("rebuild");
+        for seq in probes {
+            assert_eq!(pool.get_via_index(header, seq).expect("indexed").seq, seq);
+        }
+    }
+
+    #[test]
+    fn explicit_index_capacity_keeps_a_direct_table() {
+        let options = PoolOptions::new(1024 * 1024).with_index_capacity(64);
+        assert_eq!(options.resolved_index(), (64, 0));
+        let (capacity, flags) = PoolOptions::new(1024 * 1024).resolved_index();
+        assert_eq!(flags, super::INDEX_FLAG_BLOCKS);
+        assert!(capacity > PoolOptions::new(1024 * 1024).resolved_index_capacity());
+    }
+
+    #[test]
+    fn seek_time_lands_just_before_first_matching_frame() {
+        use crate::core::cursor::{Cursor, CursorResult};
+
+        // One frame per skew margin, so backing off the target costs about one extra frame.
+        const STEP: u64 = super::SEEK_TIME_SKEW_NS;
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024).with_index_capacity(16))
+            .expect("create");
+        let pad = "p".repeat(1024);
+        for value in 1..=200u64 {
+            let payload = lite3::encode_message(&[], &serde_json::json!({"x": value, "pad": pad}))
+                .expect("payload");
+            pool.append_with_timestamp(payload.as_slice(), value * STEP)
+                .expect("append");
+        }
+
+        // Reads from the seek point until the first frame stamped at or after `target`,
+        // returning (that frame's seq, older frames read on the way).
+        let read_from = |pool: &Pool, target: u64| {
+            let mut cursor = Cursor::new();
+            cursor.seek_to_time(pool, target).expect("seek");
+            let mut skipped = 0;
+            loop {
+                match cursor.next(pool).expect("next") {
+                    CursorResult::Message(frame) if frame.timestamp_ns >= target => {
+                        return (frame.seq, skipped);
+                    }
+                    CursorResult::Message(_) => skipped += 1,
+                    other => panic!("unexpected {other:?}"),
+                }
+            }
+        };
+        for target in [1, 1000, 1500, 50_000, 123_456, 199_000, 200_000] {
+            let (seq, skipped) = read_from(&pool, target * STEP / 1000);
+            assert_eq!(seq, target.div_ceil(1000).max(1));
+            assert!(skipped <= 17, "target {target} skipped {skipped} frames");
+        }
+        let header = pool.header_from_mmap().expect("header");
+        assert_eq!(
+            pool.seek_time(STEP).expect("seek"),
+            header.tail_off as usize
+        );
+        assert_eq!(pool.seek_time(0).expect("seek"), header.tail_off as usize);
+
+        // Garbage checkpoints are ignored rather than trusted.
+        let checkpoints = super::TIME_INDEX_OFFSET
+            ..super::TIME_INDEX_OFFSET + super::TIME_CHECKPOINTS * super::TIME_CHECKPOINT_BYTES;
+        pool.mmap[checkpoints].fill(0x5a);
+        assert_eq!(read_from(&pool, 50 * STEP).0, 50);
+        assert_eq!(read_from(&pool, 200 * STEP).0, 200);
+    }
+
+    #[test]
+    fn seek_time_keeps_frames_stamped_out_of_order() {
+        use crate::core::cursor::{Cursor, CursorResult};
+
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(1024 * 1024).with_index_capacity(16))
+            .expect("create");
+        let pad = "p".repeat(1024);
+        // Two interleaved writers: each even seq was stamped 1.5ms before the odd seq that
+        // committed ahead of it, as when a writer stamps and then waits on the append lock.
+        let stamp = |seq: u64| seq * 1_000_000 - if seq % 2 == 0 { 1_500_000 } else { 0 };
+        for seq in 1..=200u64 {
+            let payload = lite3::encode_message(&[], &serde_json::json!({"x": seq, "pad": pad}))
+                .expect("payload");
+            pool.append_with_timestamp(payload.as_slice(), stamp(seq))
+                .expect("append");
+        }
+
+        for target in (0..200).map(|ms| ms * 1_000_000 + 700_000) {
+            let mut cursor = Cursor::new();
+            cursor.seek_to_time(&pool, target).expect("seek");
+            let mut seen = Vec::new();
+            while let CursorResult::Message(frame) = cursor.next(&pool).expect("next") {
+                if frame.timestamp_ns >= target {
+                    seen.push(frame.seq);
+                }
+            }
+            let expected: Vec<u64> = (1..=200).filter(|&seq| stamp(seq) >= target).collect();
+            assert_eq!(seen, expected, "target {target}");
+        }
+    }
+
     #[test]
     fn write_pool_header_partial_updates() {
         let dir = tempfile::tempdir().expect("tempdir");
@@ -2068,10 +4239,9 @@ mod tests {
             return Ok(());
         }
 
-        super::write_index_slot(
+        super::write_index_entries(
             &mut pool.mmap,
-            plan.next_header.index_offset,
-            plan.next_header.index_capacity,
+            &plan.next_header,
             plan.seq,
             plan.frame_offset as u64,
         )?;
@@ -2135,4 +4305,37 @@ mod tests {
         assert!(metrics.age.oldest_age_ms.is_some());
         assert!(metrics.age.newest_age_ms.is_some());
     }
+
+    #[test]
+    fn hot_metrics_count_locks_index_hits_and_scans_across_handles() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pool.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(64 * 1024).with_index_capacity(16))
+            .expect("create");
+        let payload = lite3::encode_message(&[], &serde_json::json!({"x": 1})).expect("payload");
+        let first = pool.append(payload.as_slice()).expect("append 1");
+        pool.append_batch(
+            &[payload.as_slice(), payload.as_slice()],
+            super::AppendOptions::default(),
+        )
+        .expect("batch");
+        pool.get(first).expect("indexed get");
+
+        // A second handle (as another process would) sees and adds to the same counters.
+        let reader = Pool::open(&path).expect("open");
+        let index_start = reader.header.index_offset as usize;
+        let slot = index_start + (first % 16) as usize * 16;
+        pool.mmap[slot..slot + 16].fill(0);
+        reader.get(first).expect("scanned get");
+
+        let metrics = pool.info().expect("info").hot_metrics.expect("hot metrics");
+        assert_eq!(metrics.append_lock_acquires, 2);
+        assert_eq!(metrics.append_lock_hold.count(), 2);
+        assert_eq!(metrics.append_lock_wait.count(), 2);
+        assert_eq!(metrics.index_hits, 1);
+        assert_eq!(metrics.index_misses, 1);
+        assert_eq!(metrics.scan_fallbacks, 1);
+        assert_eq!(metrics.scan_frames, 1);
+        assert_eq!(reader.hot_metrics(), metrics);
+    }
 }
@@ -0,0 +1,309 @@
+//! Purpose: Control how much of a pool mapping is resident: preallocation, prefaulting,
+//! huge-page and sequential advice, and the read-ahead/release windows cursors advance.
+//! Exports: `Residency`, `ReleaseAdvice`, `DEFAULT_RELEASE_WINDOW_BYTES`.
+//! Role: Process-local tuning applied by `Pool::create`/`Pool::open_with`; nothing is persisted.
+//! Invariants: Advice is best-effort and never changes file contents; failures are ignored.
+//! Invariants: Only preallocation reports failure, since running out of space is what it prevents.
+//! Invariants: Advised ranges are clamped to the mapping; release advice never widens its range.
+//! Invariants: Advice the platform lacks is a no-op (huge pages, cold, pageout, populate: Linux).
+use std::fs::File;
+use std::io;
+
+/// Stride between release calls when `release_behind` is set without a read-ahead window.
+pub const DEFAULT_RELEASE_WINDOW_BYTES: u64 = 4 * 1024 * 1024;
+
+/// What a cursor tells the kernel about ring bytes it has already consumed.
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub enum ReleaseAdvice {
+    /// `MADV_COLD`: move the pages to the inactive list; they are reclaimed first under pressure.
+    Cold,
+    /// `MADV_PAGEOUT`: write back and reclaim the pages now.
+    PageOut,
+}
+
+/// Residency tuning for one pool handle. The default leaves the mapping to the kernel.
+#[derive(Clone, Copy, Debug, Default, Eq, PartialEq)]
+pub struct Residency {
+    /// Allocate the file's blocks at create (`posix_fallocate`) instead of leaving it sparse.
+    pub preallocate: bool,
+    /// Fault every page in writable when the pool is mapped (`MADV_POPULATE_WRITE`), so the
+    /// first append to each page does not take a fault.
+    pub prefault: bool,
+    /// Ask for transparent huge pages over the ring (`MADV_HUGEPAGE`). Only file systems that
+    /// back page cache with large folios (tmpfs/shmem, and some others on recent kernels) honor it.
+    pub huge_pages: bool,
+    /// Mark the ring `MADV_SEQUENTIAL`: aggressive read-ahead, early reclaim behind readers.
+    pub sequential: bool,
+    /// Bytes a cursor asks the kernel to prefetch ahead of its position (`MADV_WILLNEED`); it
+    /// re-advises each time it has consumed half the window. 0 disables.
+    pub readahead_bytes: u64,
+    /// Advice for ring bytes a cursor has read past, applied one window at a time.
+    pub release_behind: Option<ReleaseAdvice>,
+}
+
+impl Residency {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    pub fn with_preallocation(mut self) -> Self {
+        self.preallocate = true;
+        self
+    }
+
+    pub fn with_prefault(mut self) -> Self {
+        self.prefault = true;
+        self
+    }
+
+    pub fn with_huge_pages(mut self) -> Self {
+        self.huge_pages = true;
+        self
+    }
+
+    pub fn with_sequential(mut self) -> Self {
+        self.sequential = true;
+        self
+    }
+
+    pub fn with_readahead(mut self, bytes: u64) -> Self {
+        self.readahead_bytes = bytes;
+        self
+    }
+
+    pub fn with_release_behind(mut self, advice: ReleaseAdvice) -> Self {
+        self.release_behind = Some(advice);
+        self
+    }
+
+    /// Bytes a cursor consumes between advice calls; `None` when cursors give no advice.
+    pub(crate) fn window_bytes(&self) -> Option<usize> {
+        let window = match (self.readahead_bytes, self.release_behind) {
+            (0, None) => return None,
+            (0, Some(_)) => DEFAULT_RELEASE_WINDOW_BYTES,
+            (bytes, _) => bytes,
+        };
+        Some(
+            usize::try_from(window)
+                .unwrap_or(usize::MAX)
+                .max(page_size()),
+        )
+    }
+}
+
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub(crate) enum Advice {
+    WillNeed,
+    Sequential,
+    HugePage,
+    PopulateWrite,
+    Release(ReleaseAdvice),
+}
+
+/// Where a cursor last advised, so it re-advises once per half window rather than per frame.
+#[derive(Clone, Copy, Debug, Default)]
+pub(crate) struct ReadWindow {
+    anchor: Option<usize>,
+}
+
+impl ReadWindow {
+    pub(crate) fn reset(&mut self) {
+        self.anchor = None;
+    }
+
+    /// Ring spans to advise now that the cursor sits at `next_off`: bytes read since the last
+    /// call to release, and the window ahead to prefetch. `None` until half a window was read.
+    pub(crate) fn advance(
+        &mut self,
+        window: usize,
+        ring_size: usize,
+        next_off: usize,
+    ) -> Option<(Option<(usize, usize)>, (usize, usize))> {
+        let behind = match self.anchor {
+            Some(anchor) => {
+                let consumed = (next_off + ring_size - anchor) % ring_size;
+                if consumed < window / 2 {
+                    return None;
+                }
+                Some((anchor, consumed))
+            }
+            None => None,
+        };
+        self.anchor = Some(next_off);
+        Some((behind, (next_off, window.min(ring_size))))
+    }
+}
+
+/// Apply `advice` to `map[offset..offset + len]`, clamped to the mapping. Acquiring advice
+/// rounds out to page boundaries; release advice rounds in, so it never reaches a page that
+/// also holds bytes outside the range.
+pub(crate) fn advise(map: &[u8], offset: usize, len: usize, advice: Advice) -> io::Result<()> {
+    let page = page_size();
+    let end = offset.saturating_add(len).min(map.len());
+    let (start, end) = match advice {
+        Advice::Release(_) => {
+            let end = if end == map.len() {
+                end
+            } else {
+                end / page * page
+            };
+            (offset.div_ceil(page) * page, end)
+        }
+        _ => (offset / page * page, end),
+    };
+    if start >= end {
+        return Ok(());
+    }
+    madvise(map, start, end - start, advice)
+}
+
+/// Fault the whole mapping in writable; kernels without `MADV_POPULATE_WRITE` (before 5.14)
+/// fall back to `MADV_WILLNEED`, which at least reads the pages into the page cache.
+pub(crate) fn prefault(map: &[u8]) {
+    if advise(map, 0, map.len(), Advice::PopulateWrite).is_err() {
+        let _ = advise(map, 0, map.len(), Advice::WillNeed);
+    }
+}
+
+/// Allocate `len` bytes of `file`. File systems that cannot preallocate are not an error;
+/// running out of space is.
+#[cfg(target_os = "linux")]
+pub(crate) fn preallocate(file: &File, len: u64) -> io::Result<()> {
+    use std::os::fd::AsRawFd;
+
+    let len = libc::off_t::try_from(len).map_err(|_| io::Error::from_raw_os_error(libc::EFBIG))?;
+    let rc = unsafe { libc::posix_fallocate(file.as_raw_fd(), 0, len) };
+    match rc {
+        0 | libc::EOPNOTSUPP | libc::EINVAL => Ok(()),
+        errno => Err(io::Error::from_raw_os_error(errno)),
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+pub(crate) fn preallocate(_file: &File, _len: u64) -> io::Result<()> {
+    Ok(())
+}
+
+#[cfg(unix)]
+fn page_size() -> usize {
+    let size = unsafe { libc::sysconf(libc::_SC_PAGESIZE) };
+    usize::try_from(size)
+        .ok()
+        .filter(|size| *size > 0)
+        .unwrap_or(4096)
+}
+
+#[cfg(not(unix))]
+fn page_size() -> usize {
+    4096
+}
+
+#[cfg(unix)]
+fn madvise(map: &[u8], start: usize, len: usize, advice: Advice) -> io::Result<()> {
+    let Some(flag) = advice_flag(advice) else {
+        return Ok(());
+    };
+    // SAFETY: `start` is page-aligned (the mapping itself is) and `start + len` lies within
+    // `map`. None of the advice used here discards data: file-backed shared pages that are
+    // reclaimed are written back and faulted in again on the next access.
+    let rc = unsafe { libc::madvise(map.as_ptr().add(start) as *mut libc::c_void, len, flag) };
+    if rc == 0 {
+        Ok(())
+    } else {
+        Err(io::Error::last_os_error())
+    }
+}
+
+#[cfg(not(unix))]
+fn madvise(_map: &[u8], _start: usize, _len: usize, _advice: Advice) -> io::Result<()> {
+    Ok(())
+}
+
+#[cfg(target_os = "linux")]
+fn advice_flag(advice: Advice) -> Option<libc::c_int> {
+    Some(match advice {
+        Advice::WillNeed => libc::MADV_WILLNEED,
+        Advice::Sequential => libc::MADV_SEQUENTIAL,
+        Advice::HugePage => libc::MADV_HUGEPAGE,
+        Advice::PopulateWrite => libc::MADV_POPULATE_WRITE,
+        Advice::Release(ReleaseAdvice::Cold) => libc::MADV_COLD,
+        Advice::Release(ReleaseAdvice::PageOut) => libc::MADV_PAGEOUT,
+    })
+}
+
+#[cfg(all(unix, not(target_os = "linux")))]
+fn advice_flag(advice: Advice) -> Option<libc::c_int> {
+    match advice {
+        Advice::WillNeed => Some(libc::MADV_WILLNEED),
+        Advice::Sequential => Some(libc::MADV_SEQUENTIAL),
+        _ => None,
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{Advice, ReadWindow, ReleaseAdvice, Residency, advise, page_size};
+
+    #[test]
+    fn window_is_off_by_default_and_defaults_for_release_only() {
+        assert_eq!(Residency::new().window_bytes(), None);
+        assert_eq!(
+            Residency::new()
+                .with_release_behind(ReleaseAdvice::Cold)
+                .window_bytes(),
+            Some(super::DEFAULT_RELEASE_WINDOW_BYTES as usize)
+        );
+        assert_eq!(
+            Residency::new().with_readahead(1).window_bytes(),
+            Some(page_size())
+        );
+    }
+
+    #[test]
+    fn read_window_advises_every_half_window_across_wraps() {
+        let mut window = ReadWindow::default();
+        assert_eq!(window.advance(100, 1000, 0), Some((None, (0, 100))));
+        assert_eq!(window.advance(100, 1000, 49), None);
+        assert_eq!(
+            window.advance(100, 1000, 60),
+            Some((Some((0, 60)), (60, 100)))
+        );
+        assert_eq!(
+            window.advance(100, 1000, 10),
+            Some((Some((60, 950)), (10, 100)))
+        );
+        window.reset();
+        assert_eq!(window.advance(100, 1000, 500), Some((None, (500, 100))));
+    }
+
+    #[test]
+    fn advice_over_a_file_mapping_keeps_contents() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("map");
+        let page = page_size();
+        let file = std::fs::OpenOptions::new()
+            .create(true)
+            .truncate(true)
+            .read(true)
+            .write(true)
+            .open(&path)
+            .expect("open");
+        file.set_len((page * 4) as u64).expect("len");
+        super::preallocate(&file, (page * 4) as u64).expect("preallocate");
+        let mut map = unsafe { memmap2::MmapMut::map_mut(&file).expect("map") };
+        map[page + 7] = 0xAB;
+
+        super::prefault(&map);
+        for advice in [
+            Advice::WillNeed,
+            Advice::Sequential,
+            Advice::Release(ReleaseAdvice::Cold),
+            Advice::Release(ReleaseAdvice::PageOut),
+        ] {
+            // Unaligned ranges are rounded rather than rejected.
+            let _ = advise(&map, 3, page * 2, advice);
+        }
+        advise(&map, page - 1, 2, Advice::Release(ReleaseAdvice::Cold)).expect("empty range");
+        assert_eq!(map[page + 7], 0xAB);
+    }
+}
@@ -0,0 +1,688 @@
+//! Purpose: Walk the live ring region in parallel chunks and stitch the results back into seq order.
+//! Exports: `ScanOptions`, `RingScan`, `ScanFault`, `scan_ring`, `scan_ring_with_codec`.
+//! Role: Slow-path engine behind pool diagnostics, index rebuilds, and index-miss point reads.
+//! Invariants: Chunks split `[tail, head)` at 8-byte aligned offsets; the first chunk of each
+//! contiguous segment starts on a known frame (`tail_off`, or ring offset 0 after a wrap).
+//! Invariants: Other chunks resync on `FRAME_MAGIC` plus a valid header and commit marker; a
+//! resync point is trusted only when the previous chunk's walk ends exactly on it.
+//! Invariants: Visited frames, faults, and seq checks match a sequential walk from `tail_off`.
+//! Invariants: Single-chunk rings are walked on the calling thread; no thread outlives a scan.
+//! Invariants: With a codec, compressed frames are decoded before validation and visiting.
+use std::ops::ControlFlow;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::thread;
+
+use crate::core::compress::FrameCodec;
+use crate::core::cursor::FrameRef;
+use crate::core::error::{Error, ErrorKind};
+use crate::core::frame::{self, FRAME_HEADER_LEN, FRAME_MAGIC, FrameHeader, FrameState};
+use crate::core::lite3;
+use crate::core::pool::PoolHeader;
+
+const DEFAULT_CHUNK_BYTES: usize = 16 * 1024 * 1024;
+const FRAME_ALIGN: usize = 8;
+
+#[derive(Clone, Copy, Debug, Eq, PartialEq)]
+pub struct ScanOptions {
+    workers: usize,
+    chunk_bytes: usize,
+    validate_payloads: bool,
+}
+
+impl ScanOptions {
+    pub fn new() -> Self {
+        Self {
+            workers: thread::available_parallelism().map_or(1, |workers| workers.get()),
+            chunk_bytes: DEFAULT_CHUNK_BYTES,
+            validate_payloads: false,
+        }
+    }
+
+    pub fn with_workers(mut self, workers: usize) -> Self {
+        self.workers = workers.max(1);
+        self
+    }
+
+    /// Rounded up to the frame alignment so every chunk boundary is a candidate frame offset.
+    pub fn with_chunk_bytes(mut self, chunk_bytes: usize) -> Self {
+        self.chunk_bytes = chunk_bytes
+            .max(1)
+            .checked_next_multiple_of(FRAME_ALIGN)
+            .unwrap_or(usize::MAX - (FRAME_ALIGN - 1));
+        self
+    }
+
+    /// Also run `lite3::validate_bytes` on every visited payload.
+    pub fn with_payload_validation(mut self, enabled: bool) -> Self {
+        self.validate_payloads = enabled;
+        self
+    }
+}
+
+impl Default for ScanOptions {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// First problem on the stitched walk; `offset` is ring-relative.
+#[derive(Clone, Debug, Eq, PartialEq)]
+pub struct ScanFault {
+    pub message: String,
+    pub offset: usize,
+}
+
+#[derive(Debug)]
+pub struct RingScan<A> {
+    /// Per-chunk accumulators in ring order, for chunks on the stitched walk only.
+    pub chunks: Vec<A>,
+    pub frames: u64,
+    pub last_good_seq: Option<u64>,
+    pub fault: Option<ScanFault>,
+    /// A visitor broke out before the walk reached `head_off`.
+    pub stopped: bool,
+}
+
+/// Walk every committed frame in `[tail, head)`, folding each into a per-chunk accumulator.
+///
+/// `visit` receives the frame's ring-relative offset and may break to end the scan after that
+/// frame. Chunks are walked concurrently, so `visit` sees frames out of order across chunks;
+/// `RingScan::chunks` restores ring order. A chunk whose resync point turns out not to be where
+/// the previous chunk ended (a false `FRAME_MAGIC` hit inside a payload) is re-walked from the
+/// correct offset with a fresh accumulator.
+pub fn scan_ring<A, I, V>(
+    mmap: &[u8],
+    header: PoolHeader,
+    options: &ScanOptions,
+    init: I,
+    visit: V,
+) -> Result<RingScan<A>, Error>
+where
+    A: Send,
+    I: Fn() -> A + Sync,
+    V: Fn(&mut A, usize, &FrameRef<'_>) -> ControlFlow<()> + Sync,
+{
+    scan(mmap, header, options, None, init, visit)
+}
+
+/// `scan_ring` for a pool stored with `codec`: compressed frames are decompressed, validated
+/// like raw ones when payload validation is on, and visited with their decoded payload. A
+/// frame that fails to decompress is a fault.
+pub(crate) fn scan_ring_with_codec<A, I, V>(
+    mmap: &[u8],
+    header: PoolHeader,
+    options: &ScanOptions,
+    codec: &FrameCodec,
+    init: I,
+    visit: V,
+) -> Result<RingScan<A>, Error>
+where
+    A: Send,
+    I: Fn() -> A + Sync,
+    V: Fn(&mut A, usize, &FrameRef<'_>) -> ControlFlow<()> + Sync,
+{
+    scan(mmap, header, options, Some(codec), init, visit)
+}
+
+fn scan<A, I, V>(
+    mmap: &[u8],
+    header: PoolHeader,
+    options: &ScanOptions,
+    codec: Option<&FrameCodec>,
+    init: I,
+    visit: V,
+) -> Result<RingScan<A>, Error>
+where
+    A: Send,
+    I: Fn() -> A + Sync,
+    V: Fn(&mut A, usize, &FrameRef<'_>) -> ControlFlow<()> + Sync,
+{
+    let ring_offset = header.ring_offset as usize;
+    let ring_size = header.ring_size as usize;
+    if ring_size == 0 {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("ring size is zero"));
+    }
+    if ring_offset + ring_size > mmap.len() {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("ring exceeds mmap bounds"));
+    }
+    let head = header.head_off as usize;
+    let tail = header.tail_off as usize;
+    if head >= ring_size || tail >= ring_size {
+        return Err(Error::new(ErrorKind::Corrupt).with_message("head/tail out of range"));
+    }
+    let mut scan = RingScan {
+        chunks: Vec::new(),
+        frames: 0,
+        last_good_seq: None,
+        fault: None,
+        stopped: false,
+    };
+    if header.oldest_seq == 0 {
+        return Ok(scan);
+    }
+
+    let ring = Ring {
+        mmap,
+        ring_offset,
+        ring_size,
+        validate_payloads: options.validate_payloads,
+        codec,
+    };
+    let segments = if tail < head {
+        vec![(tail, head)]
+    } else {
+        vec![(tail, ring_size), (0, head)]
+    };
+    let chunks = split_chunks(&segments, options.chunk_bytes);
+    let mut walks = walk_chunks(&ring, &chunks, options.workers, &init, &visit);
+
+    let mut expected_off = tail;
+    let mut expected_seq = header.oldest_seq;
+    let mut wrapped_segment = None;
+    for (index, chunk) in chunks.iter().enumerate() {
+        if wrapped_segment == Some(chunk.segment) {
+            // Bytes past a wrap marker are stale.
+            continue;
+        }
+        if chunk.known_start {
+            expected_off = chunk.lo;
+        }
+        if expected_off >= chunk.hi {
+            // The previous chunk's last frame covers this whole chunk.
+            continue;
+        }
+        let walk = match walks[index].take() {
+            Some(walk) if walk.from == Some(expected_off) => walk,
+            _ => walk_chunk(&ring, expected_off, chunk.hi, init(), &visit),
+        };
+        if walk
+            .first_seq
+            .is_some_and(|first_seq| first_seq != expected_seq)
+        {
+            scan.fault = Some(ScanFault {
+                message: "seq mismatch".to_string(),
+                offset: expected_off,
+            });
+            return Ok(scan);
+        }
+        scan.frames += walk.frames;
+        if let Some(last_seq) = walk.last_seq {
+            scan.last_good_seq = Some(last_seq);
+            expected_seq = last_seq + 1;
+        }
+        expected_off = walk.end;
+        scan.chunks.push(walk.acc);
+        match walk.how {
+            ChunkEnd::Range => {}
+            ChunkEnd::Wrap if chunk.segment + 1 < segments.len() => {
+                wrapped_segment = Some(chunk.segment);
+                expected_off = 0;
+            }
+            ChunkEnd::Wrap => {
+                scan.fault = Some(ScanFault {
+                    message: "unexpected wrap marker".to_string(),
+                    offset: walk.end,
+                });
+                return Ok(scan);
+            }
+            ChunkEnd::Stopped => {
+                scan.stopped = true;
+                return Ok(scan);
+            }
+            ChunkEnd::Fault(fault) => {
+                scan.fault = Some(fault);
+                return Ok(scan);
+            }
+        }
+    }
+
+    if expected_off == ring_size {
+        expected_off = 0;
+    }
+    if expected_off != head {
+        scan.fault = Some(ScanFault {
+            message: "head offset mismatch".to_string(),
+            offset: expected_off,
+        });
+    } else if scan.last_good_seq != Some(header.newest_seq) {
+        scan.fault = Some(ScanFault {
+            message: "seq mismatch".to_string(),
+            offset: expected_off,
+        });
+    }
+    Ok(scan)
+}
+
+#[derive(Clone, Copy, Debug)]
+struct Chunk {
+    lo: usize,
+    hi: usize,
+    segment: usize,
+    known_start: bool,
+}
+
+fn split_chunks(segments: &[(usize, usize)], chunk_bytes: usize) -> Vec<Chunk> {
+    let mut chunks = Vec::new();
+    for (segment, &(lo, hi)) in segments.iter().enumerate() {
+        let mut start = lo;
+        while start < hi {
+            let end = start.saturating_add(chunk_bytes).min(hi);
+            chunks.push(Chunk {
+                lo: start,
+                hi: end,
+                segment,
+                known_start: start == lo,
+            });
+            start = end;
+        }
+    }
+    chunks
+}
+
+enum ChunkEnd {
+    Range,
+    Wrap,
+    Stopped,
+    Fault(ScanFault),
+}
+
+struct ChunkWalk<A> {
+    /// Offset the walk started from; `None` when no frame start was found in the chunk.
+    from: Option<usize>,
+    end: usize,
+    how: ChunkEnd,
+    first_seq: Option<u64>,
+    last_seq: Option<u64>,
+    frames: u64,
+    acc: A,
+}
+
+/// Walk each chunk once, spreading chunks over up to `workers` scoped threads. Chunks after the
+/// first one that stops or faults are left unwalked; stitching walks any it still needs.
+fn walk_chunks<A, I, V>(
+    ring: &Ring<'_>,
+    chunks: &[Chunk],
+    workers: usize,
+    init: &I,
+    visit: &V,
+) -> Vec<Option<ChunkWalk<A>>>
+where
+    A: Send,
+    I: Fn() -> A + Sync,
+    V: Fn(&mut A, usize, &FrameRef<'_>) -> ControlFlow<()> + Sync,
+{
+    let mut walks: Vec<Option<ChunkWalk<A>>> = (0..chunks.len()).map(|_| None).collect();
+    let workers = workers.min(chunks.len());
+    if workers <= 1 {
+        return walks;
+    }
+    let next = AtomicUsize::new(0);
+    let cutoff = AtomicUsize::new(usize::MAX);
+    thread::scope(|scope| {
+        let handles: Vec<_> = (0..workers)
+            .map(|_| {
+                scope.spawn(|| {
+                    let mut done = Vec::new();
+                    loop {
+                        let index = next.fetch_add(1, Ordering::Relaxed);
+                        if index >= chunks.len() || index > cutoff.load(Ordering::Relaxed) {
+                            return done;
+                        }
+                        let chunk = chunks[index];
+                        let walk = if chunk.known_start {
+                            walk_chunk(ring, chunk.lo, chunk.hi, init(), visit)
+                        } else {
+                            match ring.resync(chunk.lo, chunk.hi) {
+                                Some(from) => walk_chunk(ring, from, chunk.hi, init(), visit),
+                                None => ChunkWalk::empty(None, chunk.hi, init()),
+                            }
+                        };
+                        if matches!(walk.how, ChunkEnd::Stopped | ChunkEnd::Fault(_)) {
+                            cutoff.fetch_min(index, Ordering::Relaxed);
+                        }
+                        done.push((index, walk));
+                    }
+                })
+            })
+            .collect();
+        for handle in handles {
+            let done = handle
+                .join()
+                .unwrap_or_else(|panic| std::panic::resume_unwind(panic));
+            for (index, walk) in done {
+                walks[index] = Some(walk);
+            }
+        }
+    });
+    walks
+}
+
+impl<A> ChunkWalk<A> {
+    fn empty(from: Option<usize>, end: usize, acc: A) -> Self {
+        Self {
+            from,
+            end,
+            how: ChunkEnd::Range,
+            first_seq: None,
+            last_seq: None,
+            frames: 0,
+            acc,
+        }
+    }
+}
+
+fn walk_chunk<A, V>(ring: &Ring<'_>, from: usize, hi: usize, acc: A, visit: &V) -> ChunkWalk<A>
+where
+    V: Fn(&mut A, usize, &FrameRef<'_>) -> ControlFlow<()>,
+{
+    let mut walk = ChunkWalk::empty(Some(from), from, acc);
+    let mut offset = from;
+    while offset < hi {
+        let (frame, next_off) = match ring.read(offset) {
+            Ok(Step::Frame { frame, next_off }) => (frame, next_off),
+            Ok(Step::Wrap) => {
+                walk.how = ChunkEnd::Wrap;
+                break;
+            }
+            Err(message) => {
+                walk.how = ChunkEnd::Fault(ScanFault { message, offset });
+                break;
+            }
+        };
+        if walk.last_seq.is_some_and(|last| frame.seq != last + 1) {
+            walk.how = ChunkEnd::Fault(ScanFault {
+                message: "seq mismatch".to_string(),
+                offset,
+            });
+            break;
+        }
+        let decoded;
+        let frame = match ring.codec {
+            Some(codec) if frame.is_compressed() => {
+                let max_len = frame::max_payload(ring.ring_size, FRAME_HEADER_LEN);
+                decoded = match codec.decode(frame.flags, frame.payload, max_len) {
+                    Ok(decoded) => decoded,
+                    Err(err) => {
+                        walk.how = ChunkEnd::Fault(ScanFault {
+                            message: err
+                                .message()
+                                .unwrap_or("invalid compressed payload")
+                                .to_string(),
+                            offset,
+                        });
+                        break;
+                    }
+                };
+                frame.with_payload(&decoded)
+            }
+            _ => frame,
+        };
+        // Without a codec, compressed payloads are checked by frame header only.
+        let invalid = if ring.validate_payloads && !frame.is_compressed() {
+            lite3::validate_bytes(frame.payload).err()
+        } else {
+            None
+        };
+        if let Some(err) = invalid {
+            walk.how = ChunkEnd::Fault(ScanFault {
+                message: format!("invalid lite3 payload: {err}"),
+                offset,
+            });
+            break;
+        }
+        walk.first_seq.get_or_insert(frame.seq);
+        walk.last_seq = Some(frame.seq);
+        walk.frames += 1;
+        let flow = visit(&mut walk.acc, offset, &frame);
+        offset = next_off;
+        if flow.is_break() {
+            walk.how = ChunkEnd::Stopped;
+            break;
+        }
+    }
+    walk.end = offset;
+    walk
+}
+
+struct Ring<'a> {
+    mmap: &'a [u8],
+    ring_offset: usize,
+    ring_size: usize,
+    validate_payloads: bool,
+    /// Decodes compressed frames before validation and visiting (`scan_ring_with_codec`).
+    codec: Option<&'a FrameCodec>,
+}
+
+enum Step<'a> {
+    Frame {
+        frame: FrameRef<'a>,
+        /// Not folded back to 0 at the ring end; chunk bounds never exceed `ring_size`.
+        next_off: usize,
+    },
+    Wrap,
+}
+
+impl<'a> Ring<'a> {
+    fn read(&self, offset: usize) -> Result<Step<'a>, String> {
+        if self.ring_size - offset < FRAME_HEADER_LEN {
+            return Ok(Step::Wrap);
+        }
+        let start = self.ring_offset + offset;
+        let header = FrameHeader::decode(&self.mmap[start..start + FRAME_HEADER_LEN])
+            .map_err(|err| format!("frame header decode failed: {err}"))?;
+        header
+            .validate(self.ring_size)
+            .map_err(|err| format!("frame header invalid: {err}"))?;
+        match header.state {
+            FrameState::Wrap => return Ok(Step::Wrap),
+            FrameState::Committed => {}
+            _ => return Err("unexpected frame state".to_string()),
+        }
+        let frame_len = frame::frame_total_len(FRAME_HEADER_LEN, header.payload_len as usize)
+            .ok_or_else(|| "frame length overflow".to_string())?;
+        if offset + frame_len > self.ring_size {
+            return Err("frame exceeds ring".to_string());
+        }
+        let payload_start = start + FRAME_HEADER_LEN;
+        let payload_end = payload_start + header.payload_len as usize;
+        let marker_end = payload_end + frame::FRAME_COMMIT_MARKER_LEN;
+        if self.mmap[payload_end..marker_end] != frame::FRAME_COMMIT_MARKER {
+            return Err("missing frame commit marker".to_string());
+        }
+        Ok(Step::Frame {
+            frame: FrameRef {
+                seq: header.seq,
+                timestamp_ns: header.timestamp_ns,
+                flags: header.flags,
+                tag_bloom: header.tag_bloom,
+                payload: &self.mmap[payload_start..payload_end],
+            },
+            next_off: offset + frame_len,
+        })
+    }
+
+    /// First aligned offset in `[lo, hi)` holding a committed frame or a wrap marker.
+    fn resync(&self, lo: usize, hi: usize) -> Option<usize> {
+        let mut offset = lo.next_multiple_of(FRAME_ALIGN);
+        while offset < hi && self.ring_size - offset >= FRAME_HEADER_LEN {
+            let start = self.ring_offset + offset;
+            if self.mmap[start..start + FRAME_MAGIC.len()] == FRAME_MAGIC
+                && self.read(offset).is_ok()
+            {
+                return Some(offset);
+            }
+            offset += FRAME_ALIGN;
+        }
+        None
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::{RingScan, ScanOptions, scan_ring};
+    use crate::core::frame::{self, FrameHeader, FrameState};
+    use crate::core::lite3;
+    use crate::core::pool::{Pool, PoolHeader, PoolOptions};
+    use serde_json::json;
+    use std::ops::ControlFlow;
+
+    fn collect(
+        mmap: &[u8],
+        header: PoolHeader,
+        options: &ScanOptions,
+    ) -> RingScan<Vec<(u64, usize)>> {
+        scan_ring(
+            mmap,
+            header,
+            options,
+            Vec::new,
+            |frames: &mut Vec<(u64, usize)>, offset, frame| {
+                frames.push((frame.seq, offset));
+                ControlFlow::Continue(())
+            },
+        )
+        .expect("scan")
+    }
+
+    fn wrapped_pool(dir: &tempfile::TempDir) -> Pool {
+        let path = dir.path().join("scan.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(64 * 1024).with_index_capacity(0))
+            .expect("create");
+        for i in 0..600 {
+            let pad = "x".repeat(i % 97);
+            let payload =
+                lite3::encode_message(&[], &json!({"i": i, "pad": pad})).expect("payload");
+            pool.append(payload.as_slice()).expect("append");
+        }
+        pool
+    }
+
+    #[test]
+    fn chunked_scan_matches_single_chunk_walk() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = wrapped_pool(&dir);
+        let header = pool.header_from_mmap().expect("header");
+        assert!(header.oldest_seq > 1, "ring should have wrapped");
+
+        let single = collect(pool.mmap(), header, &ScanOptions::new().with_workers(1));
+        assert_eq!(single.fault, None);
+        let seqs: Vec<u64> = single.chunks.concat().iter().map(|(seq, _)| *seq).collect();
+        assert_eq!(
+            seqs,
+            (header.oldest_seq..=header.newest_seq).collect::<Vec<_>>()
+        );
+        assert_eq!(single.last_good_seq, Some(header.newest_seq));
+
+        for chunk_bytes in [8, 200, 1000, 4096] {
+            let options = ScanOptions::new()
+                .with_workers(4)
+                .with_chunk_bytes(chunk_bytes)
+                .with_payload_validation(true);
+            let chunked = collect(pool.mmap(), header, &options);
+            assert_eq!(chunked.fault, None, "chunk_bytes={chunk_bytes}");
+            assert_eq!(chunked.frames, single.frames);
+            assert_eq!(chunked.chunks.concat(), single.chunks.concat());
+        }
+    }
+
+    #[test]
+    fn resync_rejects_frames_embedded_in_payloads() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("nested.plasmite");
+        let mut pool = Pool::create(&path, PoolOptions::new(64 * 1024).with_index_capacity(0))
+            .expect("create");
+        // A raw payload that is itself a complete committed frame with a far-off seq.
+        let inner = [7u8; 40];
+        let mut nested = FrameHeader::new(FrameState::Committed, 0, 9_999, 0, 40, 0)
+            .encode()
+            .to_vec();
+        nested.extend_from_slice(&inner);
+        nested.extend_from_slice(&frame::FRAME_COMMIT_MARKER);
+        let mut payload = Vec::new();
+        for _ in 0..8 {
+            payload.extend_from_slice(&nested);
+        }
+        for _ in 0..20 {
+            pool.append(&payload).expect("append");
+        }
+        let header = pool.header_from_mmap().expect("header");
+
+        let single = collect(pool.mmap(), header, &ScanOptions::new().with_workers(1));
+        for chunk_bytes in [8, 64, 256] {
+            let options = ScanOptions::new()
+                .with_workers(3)
+                .with_chunk_bytes(chunk_bytes);
+            let chunked = collect(pool.mmap(), header, &options);
+            assert_eq!(chunked.fault, None);
+            assert_eq!(chunked.chunks.concat(), single.chunks.concat());
+        }
+        assert_eq!(single.frames, 20);
+    }
+
+    #[test]
+    fn fault_reports_first_bad_frame_for_any_chunking() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = wrapped_pool(&dir);
+        let header = pool.header_from_mmap().expect("header");
+        let single = collect(pool.mmap(), header, &ScanOptions::new().with_workers(1));
+        let frames = single.chunks.concat();
+        let (bad_seq, bad_off) = frames[frames.len() / 2];
+
+        let mut bytes = pool.mmap().to_vec();
+        let magic = header.ring_offset as usize + bad_off;
+        bytes[magic..magic + 4].copy_from_slice(b"NOPE");
+
+        for (workers, chunk_bytes) in [(1, usize::MAX), (4, 8), (4, 512)] {
+            let options = ScanOptions::new()
+                .with_workers(workers)
+                .with_chunk_bytes(chunk_bytes);
+            let scan = collect(&bytes, header, &options);
+            let fault = scan.fault.expect("fault");
+            assert_eq!(fault.offset, bad_off);
+            assert!(fault.message.starts_with("frame header decode failed"));
+            assert_eq!(scan.last_good_seq, Some(bad_seq - 1));
+            assert_eq!(scan.chunks.concat(), frames[..frames.len() / 2]);
+        }
+    }
+
+    #[test]
+    fn visitor_break_ends_the_scan() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = wrapped_pool(&dir);
+        let header = pool.header_from_mmap().expect("header");
+        let target = header.oldest_seq + (header.newest_seq - header.oldest_seq) / 3;
+        let options = ScanOptions::new().with_workers(4).with_chunk_bytes(512);
+        let scan = scan_ring(
+            pool.mmap(),
+            header,
+            &options,
+            || None,
+            |found, offset, frame| {
+                if frame.seq < target {
+                    return ControlFlow::Continue(());
+                }
+                if frame.seq == target {
+                    *found = Some(offset);
+                }
+                ControlFlow::Break(())
+            },
+        )
+        .expect("scan");
+        assert!(scan.stopped);
+        assert_eq!(scan.fault, None);
+        assert_eq!(scan.last_good_seq, Some(target));
+        assert!(scan.chunks.into_iter().flatten().next().is_some());
+    }
+
+    #[test]
+    fn empty_pool_scans_nothing() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("empty.plasmite");
+        let pool = Pool::create(&path, PoolOptions::new(64 * 1024)).expect("create");
+        let header = pool.header_from_mmap().expect("header");
+        let scan = collect(pool.mmap(), header, &ScanOptions::new());
+        assert_eq!(scan.frames, 0);
+        assert_eq!(scan.fault, None);
+        assert!(scan.chunks.is_empty());
+    }
+}
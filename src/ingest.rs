@@ -1,10 +1,19 @@
 //! Purpose: Parse stdin streams into JSON values for `feed` with explicit, testable modes.
-//! Exports: `IngestMode`, `ErrorPolicy`, `IngestConfig`, `IngestOutcome`, `IngestFailure`, `ingest`.
+//! Exports: `IngestMode`, `ErrorPolicy`, `IngestConfig`, `IngestOutcome`, `IngestFailure`, `ingest`,
+//! `ingest_batched`, `ingest_jsonl_parallel`.
 //! Role: Input ingestion engine used by the CLI; isolates streaming heuristics from main.
 //! Invariants: Auto detection is deterministic, bounded, and documented by config limits.
 //! Invariants: Skip mode only continues at well-defined record boundaries.
 //! Invariants: No unbounded buffering; per-record buffering is capped.
+//! Invariants: Batched ingest flushes before every blocking read, so batching never delays records.
+//! Invariants: Parallel ingest commits in input order; queues between its stages are bounded.
+use std::cell::{Cell, RefCell};
+use std::collections::BTreeMap;
 use std::io::{self, BufRead, BufReader, Read};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Mutex, mpsc};
+use std::thread;
+use std::time::Duration;
 
 use bstr::ByteSlice;
 use plasmite::api::{Error, ErrorKind};
@@ -66,20 +75,47 @@ fn io_error(err: io::Error, message: &str) -> Error {
 }
 
 pub fn ingest<R, F, N>(
+    reader: R,
+    config: IngestConfig,
+    on_value: F,
+    on_failure: N,
+) -> Result<IngestOutcome, Error>
+where
+    R: Read,
+    F: FnMut(Value) -> Result<(), Error>,
+    N: FnMut(IngestFailure),
+{
+    let on_value = RefCell::new(on_value);
+    ingest_records(
+        reader,
+        config,
+        |value| (on_value.borrow_mut())(value),
+        |text| {
+            let value = json_from_str::<Value>(text).ok()?;
+            Some((on_value.borrow_mut())(value))
+        },
+        on_failure,
+    )
+}
+
+/// Shared driver for `ingest` and `ingest_batched`: JSONL records reach `on_text` unparsed
+/// (`None` means the text is not JSON), every other mode hands `on_value` a parsed `Value`.
+fn ingest_records<R, F, L, N>(
     reader: R,
     config: IngestConfig,
     mut on_value: F,
-    mut on_failure: N,
+    mut on_text: L,
+    on_failure: N,
 ) -> Result<IngestOutcome, Error>
 where
     R: Read,
     F: FnMut(Value) -> Result<(), Error>,
+    L: FnMut(&str) -> Option<Result<(), Error>>,
     N: FnMut(IngestFailure),
 {
     let mut outcome = IngestOutcome::default();
-    let mut ok = 0u64;
-    let mut failed = 0u64;
-
+    let ok = Cell::new(0u64);
+    let mut policy = FailurePolicy::new(config.errors, on_failure);
     let mut handle_failure = |index: u64,
                               mode: IngestMode,
                               line: Option<u64>,
@@ -87,7 +123,81 @@ where
                               error_kind: &str,
                               snippet: Option<String>|
      -> Result<(), Error> {
-        match config.errors {
+        policy.report(index, mode, line, message, error_kind, snippet)
+    };
+
+    let mut accept_value = |value: Value, _index: u64| -> Result<(), Error> {
+        on_value(value)?;
+        ok.set(ok.get() + 1);
+        Ok(())
+    };
+    let mut accept_text = |text: &str, _index: u64| -> Option<Result<(), Error>> {
+        let result = on_text(text)?;
+        Some(result.map(|()| ok.set(ok.get() + 1)))
+    };
+
+    match config.mode {
+        IngestMode::Auto => {
+            let (auto_mode, reader) = sniff_auto(reader, &config)?;
+            ingest_auto(
+                reader,
+                auto_mode,
+                config,
+                &mut accept_value,
+                &mut accept_text,
+                &mut handle_failure,
+            )
+        }
+        IngestMode::Jsonl => {
+            ingest_jsonl(reader, config, false, &mut accept_text, &mut handle_failure)
+        }
+        IngestMode::Json => {
+            ingest_single_json(reader, config, &mut accept_value, &mut handle_failure)
+        }
+        IngestMode::Seq => ingest_json_seq(reader, config, &mut accept_value, &mut handle_failure),
+        IngestMode::Jq => ingest_jq(reader, config, &mut accept_value, &mut handle_failure),
+        IngestMode::Event => {
+            ingest_event_stream(reader, config, &mut accept_value, &mut handle_failure)
+        }
+    }?;
+
+    outcome.ok = ok.get();
+    outcome.failed = policy.failed;
+    outcome.records_total = outcome.ok + policy.failed;
+
+    Ok(outcome)
+}
+
+/// Applies the configured `ErrorPolicy` to one failed record: stop turns it into the error that
+/// ends ingestion, skip counts it and reports it through `on_failure`.
+struct FailurePolicy<N> {
+    errors: ErrorPolicy,
+    on_failure: N,
+    failed: u64,
+}
+
+impl<N> FailurePolicy<N>
+where
+    N: FnMut(IngestFailure),
+{
+    fn new(errors: ErrorPolicy, on_failure: N) -> Self {
+        Self {
+            errors,
+            on_failure,
+            failed: 0,
+        }
+    }
+
+    fn report(
+        &mut self,
+        index: u64,
+        mode: IngestMode,
+        line: Option<u64>,
+        message: &str,
+        error_kind: &str,
+        snippet: Option<String>,
+    ) -> Result<(), Error> {
+        match self.errors {
             ErrorPolicy::Stop => {
                 let mut err = Error::new(ErrorKind::Usage).with_message(message);
                 if error_kind == "Parse" {
@@ -100,8 +210,8 @@ where
                 Err(err)
             }
             ErrorPolicy::Skip => {
-                failed += 1;
-                on_failure(IngestFailure {
+                self.failed += 1;
+                (self.on_failure)(IngestFailure {
                     index,
                     mode,
                     message: message.to_string(),
@@ -112,47 +222,447 @@ where
                 Ok(())
             }
         }
-    };
+    }
+}
 
-    let mut accept_value = |value: Value, _index: u64| -> Result<(), Error> {
-        on_value(value)?;
-        ok += 1;
+/// Like `ingest`, but hands accepted records to `on_batch` in groups of up to `max_batch`.
+///
+/// `on_record` converts each parsed value and `on_line` each JSONL record, which arrives as
+/// unparsed text (`None` from `on_line` reports the line as invalid JSON). Per-record errors
+/// follow the configured policy. A batch is handed off when it is full, before each read from
+/// `reader`, and at end of input (including before a stop-mode error is returned). A failed
+/// `on_batch` ends ingestion with its error.
+pub fn ingest_batched<R, T, F, L, B, N>(
+    reader: R,
+    config: IngestConfig,
+    max_batch: usize,
+    mut on_record: F,
+    mut on_line: L,
+    on_batch: B,
+    on_failure: N,
+) -> Result<IngestOutcome, Error>
+where
+    R: Read,
+    F: FnMut(Value) -> Result<T, Error>,
+    L: FnMut(&str) -> Option<Result<T, Error>>,
+    B: FnMut(&mut Vec<T>) -> Result<(), Error>,
+    N: FnMut(IngestFailure),
+{
+    let batch = RefCell::new(Batch {
+        pending: Vec::with_capacity(max_batch.max(1)),
+        max_batch: max_batch.max(1),
+        on_batch,
+        failure: None,
+    });
+    let reader = FlushBeforeRead {
+        inner: reader,
+        batch: &batch,
+    };
+    let push = |record: T| -> Result<(), Error> {
+        let mut batch = batch.borrow_mut();
+        batch.pending.push(record);
+        if batch.pending.len() >= batch.max_batch && !batch.flush() {
+            // The real error is kept in `batch.failure` and returned below.
+            return Err(Error::new(ErrorKind::Internal).with_message("batch append failed"));
+        }
         Ok(())
     };
+    let result = ingest_records(
+        reader,
+        config,
+        |value| push(on_record(value)?),
+        |text| Some(on_line(text)?.and_then(&push)),
+        on_failure,
+    );
+
+    let mut batch = batch.into_inner();
+    if batch.failure.is_none() {
+        batch.flush();
+    }
+    match batch.failure {
+        Some(err) => Err(err),
+        None => result,
+    }
+}
 
-    match config.mode {
-        IngestMode::Auto => {
-            let (auto_mode, reader) = sniff_auto(reader, &config)?;
-            ingest_auto(
-                reader,
-                auto_mode,
-                config,
-                &mut accept_value,
-                &mut handle_failure,
-            )
+/// Records accepted by `ingest_batched` but not yet handed to the batch callback.
+struct Batch<T, B> {
+    pending: Vec<T>,
+    max_batch: usize,
+    on_batch: B,
+    failure: Option<Error>,
+}
+
+impl<T, B> Batch<T, B>
+where
+    B: FnMut(&mut Vec<T>) -> Result<(), Error>,
+{
+    /// Hand off pending records. A failure is kept in `failure` so it survives the error paths
+    /// of `ingest`, which only see a placeholder.
+    fn flush(&mut self) -> bool {
+        if self.pending.is_empty() {
+            return true;
         }
-        IngestMode::Jsonl => ingest_jsonl(
-            reader,
-            config,
-            false,
-            &mut accept_value,
-            &mut handle_failure,
-        ),
-        IngestMode::Json => {
-            ingest_single_json(reader, config, &mut accept_value, &mut handle_failure)
+        let result = (self.on_batch)(&mut self.pending);
+        self.pending.clear();
+        match result {
+            Ok(()) => true,
+            Err(err) => {
+                self.failure = Some(err);
+                false
+            }
         }
-        IngestMode::Seq => ingest_json_seq(reader, config, &mut accept_value, &mut handle_failure),
-        IngestMode::Jq => ingest_jq(reader, config, &mut accept_value, &mut handle_failure),
-        IngestMode::Event => {
-            ingest_event_stream(reader, config, &mut accept_value, &mut handle_failure)
+    }
+}
+
+/// Flushes the pending batch before every read from the source, so records already buffered
+/// are handed off before ingestion can block waiting for more input.
+struct FlushBeforeRead<'a, R, T, B> {
+    inner: R,
+    batch: &'a RefCell<Batch<T, B>>,
+}
+
+impl<R, T, B> Read for FlushBeforeRead<'_, R, T, B>
+where
+    R: Read,
+    B: FnMut(&mut Vec<T>) -> Result<(), Error>,
+{
+    fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+        if !self.batch.borrow_mut().flush() {
+            return Err(io::Error::other("batch append failed"));
         }
-    }?;
+        self.inner.read(buf)
+    }
+}
+
+/// Bytes the pipeline splitter asks of `reader` per read; each read's whole lines become one chunk.
+const PIPELINE_READ_BYTES: usize = 256 * 1024;
+/// Chunks queued per worker on each side of the worker pool before the upstream stage blocks.
+const PIPELINE_QUEUE_PER_WORKER: usize = 2;
+/// Chunks per worker the splitter may have cut but the committer not yet applied. Bounds the
+/// committer's reorder buffer, which a slow worker would otherwise let grow with the input.
+const PIPELINE_IN_FLIGHT_PER_WORKER: usize = 2 * PIPELINE_QUEUE_PER_WORKER + 1;
+/// How often idle workers check whether the committer has stopped.
+const PIPELINE_POLL_INTERVAL: Duration = Duration::from_millis(50);
+
+/// Parallel form of `ingest_batched` for line-delimited JSON (`IngestMode::Jsonl` semantics).
+///
+/// A splitter thread reads `reader` and cuts it into chunks of whole lines, `workers` threads
+/// run `on_line` over chunks concurrently, and the calling thread commits the results in input
+/// order: records go to `on_batch` in groups of up to `max_batch`, failures go through the
+/// configured policy with the same index, line, and error as sequential ingest. A batch is
+/// handed off when it is full, whenever no further chunk is ready, and before a stop-mode
+/// error is returned. Queues between stages are bounded, so a slow `on_batch` stalls reading.
+///
+/// The splitter owns `reader` and is detached: after an early error it exits at its next
+/// read instead of holding up the return.
+pub fn ingest_jsonl_parallel<R, T, L, B, N>(
+    reader: R,
+    config: IngestConfig,
+    workers: usize,
+    max_batch: usize,
+    on_line: L,
+    on_batch: B,
+    on_failure: N,
+) -> Result<IngestOutcome, Error>
+where
+    R: Read + Send + 'static,
+    T: Send,
+    L: Fn(&str) -> Option<Result<T, Error>> + Sync,
+    B: FnMut(&mut Vec<T>) -> Result<(), Error>,
+    N: FnMut(IngestFailure),
+{
+    let workers = workers.max(1);
+    let queue_depth = workers * PIPELINE_QUEUE_PER_WORKER;
+    let (chunk_tx, chunk_rx) = mpsc::sync_channel(queue_depth);
+    // One token per chunk in flight: the splitter takes one per chunk it cuts and the
+    // committer returns it once the chunk is applied.
+    let in_flight = workers * PIPELINE_IN_FLIGHT_PER_WORKER;
+    let (token_tx, token_rx) = mpsc::sync_channel(in_flight);
+    for _ in 0..in_flight {
+        let _ = token_tx.send(());
+    }
+    thread::Builder::new()
+        .name("plasmite-ingest-split".to_string())
+        .spawn(move || split_lines(reader, chunk_tx, token_rx))
+        .map_err(|err| io_error(err, "failed to start ingest pipeline"))?;
+
+    let chunk_rx = Mutex::new(chunk_rx);
+    let stopped = AtomicBool::new(false);
+    let mut batch = Batch {
+        pending: Vec::with_capacity(max_batch.max(1)),
+        max_batch: max_batch.max(1),
+        on_batch,
+        failure: None,
+    };
+    let mut policy = FailurePolicy::new(config.errors, on_failure);
+    let result = thread::scope(|scope| {
+        let (parsed_tx, parsed_rx) = mpsc::sync_channel(queue_depth);
+        for _ in 0..workers {
+            let parsed_tx = parsed_tx.clone();
+            let (chunk_rx, stopped, on_line) = (&chunk_rx, &stopped, &on_line);
+            scope.spawn(move || parse_worker(chunk_rx, stopped, parsed_tx, &config, on_line));
+        }
+        drop(parsed_tx);
+        let result = commit_in_order(parsed_rx, &token_tx, config, &mut batch, &mut policy);
+        stopped.store(true, Ordering::Relaxed);
+        result
+    });
+
+    if batch.failure.is_none() {
+        batch.flush();
+    }
+    if let Some(err) = batch.failure {
+        return Err(err);
+    }
+    let ok = result?;
+    Ok(IngestOutcome {
+        records_total: ok + policy.failed,
+        ok,
+        failed: policy.failed,
+    })
+}
 
-    outcome.ok = ok;
-    outcome.failed = failed;
-    outcome.records_total = ok + failed;
+/// Whole input lines cut by the pipeline splitter, or the read error that ended input.
+type LineChunk = Result<Vec<u8>, Error>;
+
+/// One worker's results for a chunk, in line order.
+struct ParsedChunk<T> {
+    /// Physical lines in the chunk, blank ones included.
+    lines: u64,
+    /// Non-blank lines with their 1-based line number within the chunk.
+    records: Vec<(u64, ParsedLine<T>)>,
+    /// Error that ends input after `records`.
+    error: Option<Error>,
+}
 
-    Ok(outcome)
+enum ParsedLine<T> {
+    Record(T),
+    /// `on_line` rejected the line; handled like a failed append.
+    Rejected(Error),
+    Failed {
+        message: &'static str,
+        error_kind: &'static str,
+        snippet: String,
+    },
+}
+
+/// Cuts `reader` into chunks, waiting for a token from `tokens` before sending each one.
+fn split_lines<R: Read>(
+    mut reader: R,
+    chunks: mpsc::SyncSender<(u64, LineChunk)>,
+    tokens: mpsc::Receiver<()>,
+) {
+    // Fails once the committer has stopped and dropped its token sender.
+    let send = |chunk: (u64, LineChunk)| tokens.recv().is_ok() && chunks.send(chunk).is_ok();
+    let mut seq = 0u64;
+    let mut carry = Vec::new();
+    loop {
+        let mut buf = std::mem::take(&mut carry);
+        let start = buf.len();
+        buf.resize(start + PIPELINE_READ_BYTES, 0);
+        let read = match reader.read(&mut buf[start..]) {
+            Ok(read) => read,
+            Err(err) if err.kind() == io::ErrorKind::Interrupted => {
+                buf.truncate(start);
+                carry = buf;
+                continue;
+            }
+            Err(err) => {
+                send((seq, Err(io_error(err, "failed to read stdin"))));
+                return;
+            }
+        };
+        buf.truncate(start + read);
+        if read == 0 {
+            if !buf.is_empty() {
+                send((seq, Ok(buf)));
+            }
+            return;
+        }
+        // A line still being read stays behind for the next chunk.
+        let Some(end) = buf.rfind_byte(b'\n') else {
+            carry = buf;
+            continue;
+        };
+        carry = buf[end + 1..].to_vec();
+        buf.truncate(end + 1);
+        if !send((seq, Ok(buf))) {
+            return;
+        }
+        seq += 1;
+    }
+}
+
+fn parse_worker<T, L>(
+    chunks: &Mutex<mpsc::Receiver<(u64, LineChunk)>>,
+    stopped: &AtomicBool,
+    parsed: mpsc::SyncSender<(u64, ParsedChunk<T>)>,
+    config: &IngestConfig,
+    on_line: &L,
+) where
+    L: Fn(&str) -> Option<Result<T, Error>>,
+{
+    while !stopped.load(Ordering::Relaxed) {
+        let next = chunks
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+            .recv_timeout(PIPELINE_POLL_INTERVAL);
+        let (seq, chunk) = match next {
+            Ok(next) => next,
+            Err(mpsc::RecvTimeoutError::Timeout) => continue,
+            Err(mpsc::RecvTimeoutError::Disconnected) => return,
+        };
+        let result = match chunk {
+            Ok(bytes) => parse_chunk(&bytes, config, on_line),
+            Err(err) => ParsedChunk {
+                lines: 0,
+                records: Vec::new(),
+                error: Some(err),
+            },
+        };
+        if parsed.send((seq, result)).is_err() {
+            return;
+        }
+    }
+}
+
+fn parse_chunk<T, L>(bytes: &[u8], config: &IngestConfig, on_line: &L) -> ParsedChunk<T>
+where
+    L: Fn(&str) -> Option<Result<T, Error>>,
+{
+    let mut parsed = ParsedChunk {
+        lines: 0,
+        records: Vec::new(),
+        error: None,
+    };
+    for raw_line in bytes.split_inclusive(|byte| *byte == b'\n') {
+        parsed.lines += 1;
+        let Ok(line) = std::str::from_utf8(raw_line) else {
+            let err = io::Error::new(
+                io::ErrorKind::InvalidData,
+                "stream did not contain valid UTF-8",
+            );
+            parsed.error = Some(io_error(err, "failed to read stdin"));
+            break;
+        };
+        let trimmed = line.trim_end_matches(['\n', '\r']);
+        if trimmed.trim().is_empty() {
+            continue;
+        }
+        let record = if trimmed.len() > config.max_record_bytes {
+            ParsedLine::Failed {
+                message: "record exceeds size limit",
+                error_kind: "Oversize",
+                snippet: truncate_snippet(trimmed, config.max_snippet_bytes),
+            }
+        } else {
+            match on_line(trimmed) {
+                Some(Ok(record)) => ParsedLine::Record(record),
+                Some(Err(err)) => ParsedLine::Rejected(err),
+                None => ParsedLine::Failed {
+                    message: "invalid json input",
+                    error_kind: "Parse",
+                    snippet: truncate_snippet(trimmed, config.max_snippet_bytes),
+                },
+            }
+        };
+        parsed.records.push((parsed.lines, record));
+    }
+    parsed
+}
+
+/// Applies worker results in chunk order, returning each chunk's token to `tokens` once it is
+/// applied, and returns how many records were accepted.
+///
+/// Chunks wait in `ready` until every earlier one has arrived; the tokens cap them, and the
+/// chunk at `next_seq` always holds one, so the wait cannot deadlock.
+fn commit_in_order<T, B, N>(
+    parsed: mpsc::Receiver<(u64, ParsedChunk<T>)>,
+    tokens: &mpsc::SyncSender<()>,
+    config: IngestConfig,
+    batch: &mut Batch<T, B>,
+    policy: &mut FailurePolicy<N>,
+) -> Result<u64, Error>
+where
+    B: FnMut(&mut Vec<T>) -> Result<(), Error>,
+    N: FnMut(IngestFailure),
+{
+    let mut handle_failure = |index: u64,
+                              mode: IngestMode,
+                              line: Option<u64>,
+                              message: &str,
+                              error_kind: &str,
+                              snippet: Option<String>|
+     -> Result<(), Error> {
+        policy.report(index, mode, line, message, error_kind, snippet)
+    };
+    // The real batch error is kept in `batch.failure` and returned by the caller.
+    let batch_failed = || Error::new(ErrorKind::Internal).with_message("batch append failed");
+
+    let mut ready = BTreeMap::new();
+    let mut next_seq = 0u64;
+    let mut index = 0u64;
+    let mut line_base = 0u64;
+    let mut ok = 0u64;
+    loop {
+        let received = match parsed.try_recv() {
+            Ok(received) => received,
+            Err(mpsc::TryRecvError::Empty) => {
+                if !batch.flush() {
+                    return Err(batch_failed());
+                }
+                match parsed.recv() {
+                    Ok(received) => received,
+                    Err(_) => break,
+                }
+            }
+            Err(mpsc::TryRecvError::Disconnected) => break,
+        };
+        ready.insert(received.0, received.1);
+        while let Some(chunk) = ready.remove(&next_seq) {
+            next_seq += 1;
+            for (line_offset, record) in chunk.records {
+                index += 1;
+                let line = Some(line_base + line_offset);
+                match record {
+                    ParsedLine::Record(record) => {
+                        batch.pending.push(record);
+                        ok += 1;
+                        if batch.pending.len() >= batch.max_batch && !batch.flush() {
+                            return Err(batch_failed());
+                        }
+                    }
+                    ParsedLine::Rejected(err) => apply_result(
+                        Err(err),
+                        index,
+                        IngestMode::Jsonl,
+                        line,
+                        config.errors,
+                        &mut handle_failure,
+                    )?,
+                    ParsedLine::Failed {
+                        message,
+                        error_kind,
+                        snippet,
+                    } => handle_failure(
+                        index,
+                        IngestMode::Jsonl,
+                        line,
+                        message,
+                        error_kind,
+                        Some(snippet),
+                    )?,
+                }
+            }
+            line_base += chunk.lines;
+            if let Some(err) = chunk.error {
+                return Err(err);
+            }
+            let _ = tokens.send(());
+        }
+    }
+    Ok(ok)
 }
 
 #[derive(Copy, Clone, Debug, Eq, PartialEq)]
@@ -211,35 +721,37 @@ fn detect_auto_mode(prefix: &[u8]) -> AutoMode {
     AutoMode::JsonlMultiline
 }
 
-fn ingest_auto<R, F, N>(
+fn ingest_auto<R, F, L, N>(
     reader: PrefixReader<R>,
     mode: AutoMode,
     config: IngestConfig,
     on_value: &mut F,
+    on_text: &mut L,
     on_failure: &mut N,
 ) -> Result<(), Error>
 where
     R: Read,
     F: FnMut(Value, u64) -> Result<(), Error>,
+    L: FnMut(&str, u64) -> Option<Result<(), Error>>,
     N: FnMut(u64, IngestMode, Option<u64>, &str, &str, Option<String>) -> Result<(), Error>,
 {
     match mode {
         AutoMode::EventStream => ingest_event_stream(reader, config, on_value, on_failure),
         AutoMode::JsonSeq => ingest_json_seq(reader, config, on_value, on_failure),
-        AutoMode::JsonlMultiline => ingest_jsonl(reader, config, true, on_value, on_failure),
+        AutoMode::JsonlMultiline => ingest_jsonl(reader, config, true, on_text, on_failure),
     }
 }
 
-fn ingest_jsonl<R, F, N>(
+fn ingest_jsonl<R, L, N>(
     reader: R,
     config: IngestConfig,
     allow_multiline: bool,
-    on_value: &mut F,
+    on_text: &mut L,
     on_failure: &mut N,
 ) -> Result<(), Error>
 where
     R: Read,
-    F: FnMut(Value, u64) -> Result<(), Error>,
+    L: FnMut(&str, u64) -> Option<Result<(), Error>>,
     N: FnMut(u64, IngestMode, Option<u64>, &str, &str, Option<String>) -> Result<(), Error>,
 {
     let mut reader = BufReader::new(reader);
@@ -271,17 +783,16 @@ where
             )?;
             continue;
         }
-        match json_from_str::<Value>(trimmed) {
-            Ok(value) => apply_value(
-                value,
+        match on_text(trimmed, index) {
+            Some(result) => apply_result(
+                result,
                 index,
                 IngestMode::Jsonl,
                 Some(line_no),
                 config.errors,
-                on_value,
                 on_failure,
             )?,
-            Err(_) if allow_multiline && looks_like_json_start(trimmed) => {
+            None if allow_multiline && looks_like_json_start(trimmed) => {
                 let mut buf = String::from(trimmed);
                 let mut record_line = line_no;
                 loop {
@@ -296,14 +807,13 @@ where
                         )?;
                         break;
                     }
-                    if let Ok(value) = json_from_str::<Value>(&buf) {
-                        apply_value(
-                            value,
+                    if let Some(result) = on_text(&buf, index) {
+                        apply_result(
+                            result,
                             index,
                             IngestMode::Jsonl,
                             Some(record_line),
                             config.errors,
-                            on_value,
                             on_failure,
                         )?;
                         break;
@@ -342,7 +852,7 @@ where
                     buf.push_str(line.as_str());
                 }
             }
-            Err(_) => {
+            None => {
                 on_failure(
                     index,
                     IngestMode::Jsonl,
@@ -711,7 +1221,28 @@ where
     F: FnMut(Value, u64) -> Result<(), Error>,
     N: FnMut(u64, IngestMode, Option<u64>, &str, &str, Option<String>) -> Result<(), Error>,
 {
-    match on_value(value, index) {
+    apply_result(
+        on_value(value, index),
+        index,
+        mode,
+        line,
+        errors,
+        on_failure,
+    )
+}
+
+fn apply_result<N>(
+    result: Result<(), Error>,
+    index: u64,
+    mode: IngestMode,
+    line: Option<u64>,
+    errors: ErrorPolicy,
+    on_failure: &mut N,
+) -> Result<(), Error>
+where
+    N: FnMut(u64, IngestMode, Option<u64>, &str, &str, Option<String>) -> Result<(), Error>,
+{
+    match result {
         Ok(()) => Ok(()),
         Err(err) => {
             if errors == ErrorPolicy::Skip {
@@ -808,8 +1339,15 @@ impl<R: Read> Read for PrefixReader<R> {
 
 #[cfg(test)]
 mod tests {
-    use super::{ErrorPolicy, IngestConfig, IngestFailure, IngestMode, ingest, truncate_snippet};
+    use super::{
+        ErrorPolicy, IngestConfig, IngestFailure, IngestMode, PIPELINE_IN_FLIGHT_PER_WORKER,
+        ingest, ingest_batched, ingest_jsonl_parallel, json_from_str, truncate_snippet,
+    };
     use plasmite::api::{Error, ErrorKind};
+    use serde_json::{Value, json};
+    use std::io::{self, Read};
+    use std::sync::Arc;
+    use std::sync::atomic::{AtomicUsize, Ordering};
 
     fn config(mode: IngestMode, errors: ErrorPolicy) -> IngestConfig {
         IngestConfig {
@@ -1015,6 +1553,256 @@ mod tests {
         assert!(failures.first().unwrap().message.contains("invalid json"));
     }
 
+    /// Yields one chunk per `read` call, like a pipe delivering writes as they happen.
+    struct ChunkReader {
+        chunks: Vec<&'static [u8]>,
+    }
+
+    impl Read for ChunkReader {
+        fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+            if self.chunks.is_empty() {
+                return Ok(0);
+            }
+            let chunk = self.chunks.remove(0);
+            buf[..chunk.len()].copy_from_slice(chunk);
+            Ok(chunk.len())
+        }
+    }
+
+    #[test]
+    fn batched_ingest_flushes_before_each_read_and_when_full() {
+        let reader = ChunkReader {
+            chunks: vec![b"{\"a\":1}\n{\"a\":2}\n{\"a\":3}\n", b"{\"a\":4}\n"],
+        };
+        let mut batches = Vec::new();
+        let outcome = ingest_batched(
+            reader,
+            config(IngestMode::Jsonl, ErrorPolicy::Stop),
+            2,
+            |value| Ok(value["a"].as_i64().unwrap_or_default()),
+            |line| {
+                let value = json_from_str::<Value>(line).ok()?;
+                Some(Ok(value["a"].as_i64().unwrap_or_default()))
+            },
+            |batch: &mut Vec<i64>| {
+                batches.push(batch.clone());
+                Ok(())
+            },
+            |_failure: IngestFailure| {},
+        )
+        .expect("ingest");
+
+        assert_eq!(outcome.ok, 4);
+        assert_eq!(batches, vec![vec![1, 2], vec![3], vec![4]]);
+    }
+
+    #[test]
+    fn batched_ingest_flushes_before_stop_error_and_reports_batch_failure() {
+        let input = b"{\"a\":1}\nnot-json\n";
+        let mut batches = Vec::new();
+        let err = ingest_batched(
+            &input[..],
+            config(IngestMode::Jsonl, ErrorPolicy::Stop),
+            16,
+            Ok,
+            parse_line,
+            |batch: &mut Vec<serde_json::Value>| {
+                batches.push(batch.len());
+                Ok(())
+            },
+            |_failure: IngestFailure| {},
+        )
+        .expect_err("parse error");
+        assert_eq!(err.kind(), ErrorKind::Usage);
+        assert_eq!(batches, vec![1]);
+
+        let err = ingest_batched(
+            &b"{\"a\":1}\n{\"a\":2}\n"[..],
+            config(IngestMode::Jsonl, ErrorPolicy::Skip),
+            16,
+            Ok,
+            parse_line,
+            |_batch: &mut Vec<serde_json::Value>| Err(Error::new(ErrorKind::Busy)),
+            |_failure: IngestFailure| {},
+        )
+        .expect_err("batch failure");
+        assert_eq!(err.kind(), ErrorKind::Busy);
+    }
+
+    fn parse_line(line: &str) -> Option<Result<Value, Error>> {
+        json_from_str(line).ok().map(Ok)
+    }
+
+    #[test]
+    fn batched_ingest_hands_jsonl_records_over_as_text() {
+        let input = b"{\"a\":1}\n{\n  \"b\": 2\n}\nnot-json\n{\"c\":3}\n";
+        let mut lines = Vec::new();
+        let mut failures = Vec::new();
+        let outcome = ingest_batched(
+            &input[..],
+            config(IngestMode::Auto, ErrorPolicy::Skip),
+            16,
+            |_value| -> Result<String, Error> { panic!("jsonl records should arrive as text") },
+            |line| {
+                json_from_str::<Value>(line).ok()?;
+                Some(Ok(line.to_string()))
+            },
+            |batch: &mut Vec<String>| {
+                lines.append(batch);
+                Ok(())
+            },
+            |failure| failures.push(failure),
+        )
+        .expect("ingest");
+
+        assert_eq!(outcome.ok, 3);
+        assert_eq!(outcome.failed, 1);
+        assert_eq!(lines, vec!["{\"a\":1}", "{  \"b\": 2\n}\n", "{\"c\":3}"]);
+        assert_eq!(failures[0].error_kind, "Parse");
+    }
+
+    #[test]
+    fn parallel_ingest_matches_sequential_order_and_failures() {
+        let chunks: Vec<&'static [u8]> = vec![
+            b"{\"a\":1}\n\n{\"a\":2}\nnot-json\n{\"a\"",
+            b":3}\n",
+            b"{\"a\":4}\r\n",
+            b"\"too long for the record limit\"\n{\"a\":5}",
+        ];
+        let mut config = config(IngestMode::Jsonl, ErrorPolicy::Skip);
+        config.max_record_bytes = 16;
+
+        let mut expected = Vec::new();
+        let mut expected_failures = Vec::new();
+        let sequential = ingest_batched(
+            ChunkReader {
+                chunks: chunks.clone(),
+            },
+            config,
+            2,
+            |_value| -> Result<Value, Error> { panic!("jsonl records should arrive as text") },
+            parse_line,
+            |batch: &mut Vec<Value>| {
+                expected.append(batch);
+                Ok(())
+            },
+            |failure| expected_failures.push((failure.index, failure.line, failure.error_kind)),
+        )
+        .expect("sequential");
+
+        let mut values = Vec::new();
+        let mut failures = Vec::new();
+        let parallel = ingest_jsonl_parallel(
+            ChunkReader { chunks },
+            config,
+            3,
+            2,
+            parse_line,
+            |batch: &mut Vec<Value>| {
+                assert!(batch.len() <= 2);
+                values.append(batch);
+                Ok(())
+            },
+            |failure| failures.push((failure.index, failure.line, failure.error_kind)),
+        )
+        .expect("parallel");
+
+        assert_eq!(values, expected);
+        assert_eq!(failures, expected_failures);
+        assert_eq!(failures.len(), 2);
+        assert_eq!(parallel.ok, sequential.ok);
+        assert_eq!(parallel.failed, sequential.failed);
+        assert_eq!(parallel.records_total, 7);
+    }
+
+    #[test]
+    fn parallel_ingest_commits_records_before_stop_error() {
+        let chunks: Vec<&'static [u8]> = vec![b"{\"a\":1}\n{\"a\":2}\n", b"not-json\n{\"a\":3}\n"];
+        let mut values = Vec::new();
+        let err = ingest_jsonl_parallel(
+            ChunkReader { chunks },
+            config(IngestMode::Jsonl, ErrorPolicy::Stop),
+            4,
+            16,
+            parse_line,
+            |batch: &mut Vec<Value>| {
+                values.append(batch);
+                Ok(())
+            },
+            |_failure: IngestFailure| {},
+        )
+        .expect_err("parse error");
+        assert_eq!(err.kind(), ErrorKind::Usage);
+        assert_eq!(values, vec![json!({"a": 1}), json!({"a": 2})]);
+
+        let err = ingest_jsonl_parallel(
+            &b"{\"a\":1}\n"[..],
+            config(IngestMode::Jsonl, ErrorPolicy::Skip),
+            2,
+            16,
+            parse_line,
+            |_batch: &mut Vec<Value>| Err(Error::new(ErrorKind::Busy)),
+            |_failure: IngestFailure| {},
+        )
+        .expect_err("batch failure");
+        assert_eq!(err.kind(), ErrorKind::Busy);
+    }
+
+    #[test]
+    fn parallel_ingest_bounds_chunks_behind_a_slow_one() {
+        struct CountingReader {
+            next: u64,
+            reads: Arc<AtomicUsize>,
+        }
+
+        impl Read for CountingReader {
+            fn read(&mut self, buf: &mut [u8]) -> io::Result<usize> {
+                if self.next == 200 {
+                    return Ok(0);
+                }
+                self.reads.fetch_add(1, Ordering::SeqCst);
+                let line = format!("{{\"a\":{}}}\n", self.next);
+                self.next += 1;
+                buf[..line.len()].copy_from_slice(line.as_bytes());
+                Ok(line.len())
+            }
+        }
+
+        let reads = Arc::new(AtomicUsize::new(0));
+        let reads_behind_slow = AtomicUsize::new(0);
+        let mut values = Vec::new();
+        ingest_jsonl_parallel(
+            CountingReader {
+                next: 0,
+                reads: Arc::clone(&reads),
+            },
+            config(IngestMode::Jsonl, ErrorPolicy::Stop),
+            2,
+            16,
+            |line| {
+                // While the first chunk stalls, the others must not pile up behind it.
+                if line == "{\"a\":0}" {
+                    std::thread::sleep(std::time::Duration::from_millis(200));
+                    reads_behind_slow.store(reads.load(Ordering::SeqCst), Ordering::SeqCst);
+                }
+                parse_line(line)
+            },
+            |batch: &mut Vec<Value>| {
+                values.append(batch);
+                Ok(())
+            },
+            |_failure: IngestFailure| {},
+        )
+        .expect("ingest");
+        assert_eq!(
+            values,
+            (0..200).map(|a| json!({"a": a})).collect::<Vec<_>>()
+        );
+        // Every token out, plus the read whose chunk waits for the next one.
+        let bound = 2 * PIPELINE_IN_FLIGHT_PER_WORKER + 1;
+        assert!(reads_behind_slow.load(Ordering::SeqCst) <= bound);
+    }
+
     #[test]
     fn auto_handles_multiline_json() {
         let input = b"{\n  \"a\": 1,\n  \"b\": 2\n}\n";
@@ -1,8 +1,9 @@
 //! Purpose: Compile and evaluate jq-style expressions against JSON values.
-//! Exports: `JqFilter`, `compile_filters`, `matches_all`.
+//! Exports: `JqFilter`, `compile_filters`, `matches_all`, `prefilter_lite3`.
 //! Role: Adapter around `jaq-core` for boolean filtering in the CLI.
 //! Invariants: Parse/compile failures are usage errors; runtime eval errors count as "no match".
 //! Invariants: Each filter must yield only booleans (otherwise: usage error).
+//! Invariants: Pushed-down predicates agree with jaq; anything they cannot decide falls back.
 
 use std::cmp::Ordering;
 use std::collections::BTreeMap;
@@ -13,12 +14,15 @@ use jaq_core::load::{Arena, File, Loader};
 use jaq_core::{Bind, Compiler, Ctx, Error as JaqError, Native, RcIter};
 use serde_json::Value;
 
-use plasmite::api::{Error, ErrorKind};
+use plasmite::api::lite3::{Lite3Path, Lite3ValueRef};
+use plasmite::api::{Error, ErrorKind, Lite3DocRef};
 
 #[derive(Clone)]
 pub struct JqFilter {
     expr: String,
     filter: jaq_core::Filter<Native<JaqValue>>,
+    // Same expression evaluated directly on Lite3 payloads, when it is simple enough.
+    pushdown: Option<Pushdown>,
 }
 
 impl fmt::Debug for JqFilter {
@@ -50,9 +54,21 @@ impl JqFilter {
         Ok(Self {
             expr: expr.to_string(),
             filter,
+            pushdown: Pushdown::parse(expr),
         })
     }
 
+    /// Evaluate against an encoded `{meta, data}` payload without decoding it.
+    /// `None` means the expression (or this payload) needs the full `matches` path.
+    pub fn matches_lite3(&self, payload: &[u8]) -> Option<bool> {
+        let doc = Lite3DocRef::new(payload);
+        match self.pushdown.as_ref()?.eval(&doc) {
+            Ok(matched) => Some(matched),
+            Err(PushdownError::Runtime) => Some(false),
+            Err(PushdownError::Fallback) => None,
+        }
+    }
+
     pub fn matches(&self, input: &Value) -> Result<bool, Error> {
         let input = JaqValue::from_json(input);
         let inputs = RcIter::new(core::iter::empty::<Result<JaqValue, String>>());
@@ -95,6 +111,312 @@ pub fn matches_all(filters: &[JqFilter], input: &Value) -> Result<bool, Error> {
     Ok(true)
 }
 
+/// Cheap pass over a Lite3 payload before decoding: `Some(false)` if any pushed-down filter
+/// rejects it, `Some(true)` if every filter was decided and matched, `None` to decode and
+/// call `matches_all`.
+pub fn prefilter_lite3(filters: &[JqFilter], payload: &[u8]) -> Option<bool> {
+    let mut decided = true;
+    for filter in filters {
+        match filter.matches_lite3(payload) {
+            Some(false) => return Some(false),
+            Some(true) => {}
+            None => decided = false,
+        }
+    }
+    decided.then_some(true)
+}
+
+/// Predicate subset evaluated on Lite3: `.meta…`/`.data…` paths compared with a literal,
+/// combined with `and`/`or` and parentheses.
+#[derive(Clone, Debug, PartialEq)]
+enum Pushdown {
+    Compare {
+        path: Lite3Path,
+        op: CompareOp,
+        literal: Literal,
+    },
+    And(Box<Pushdown>, Box<Pushdown>),
+    Or(Box<Pushdown>, Box<Pushdown>),
+}
+
+#[derive(Clone, Copy, Debug, PartialEq)]
+enum CompareOp {
+    Eq,
+    Ne,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+}
+
+#[derive(Clone, Debug, PartialEq)]
+enum Literal {
+    Null,
+    Bool(bool),
+    Num(f64),
+    Str(String),
+}
+
+enum PushdownError {
+    /// jq would raise (missing key, indexing a non-object): the filter does not match.
+    Runtime,
+    /// Not decidable from Lite3 alone (bytes, non-finite floats, corrupt payload).
+    Fallback,
+}
+
+/// Payload values ordered like `JaqValue`: null < bool < number < string < array < object.
+enum Operand<'a> {
+    Null,
+    Bool(bool),
+    Num(f64),
+    Str(&'a str),
+    Array,
+    Object,
+}
+
+impl Operand<'_> {
+    fn rank(&self) -> u8 {
+        match self {
+            Self::Null => 0,
+            Self::Bool(_) => 1,
+            Self::Num(_) => 2,
+            Self::Str(_) => 3,
+            Self::Array => 4,
+            Self::Object => 5,
+        }
+    }
+
+    fn cmp_literal(&self, literal: &Literal) -> Ordering {
+        let literal_rank = match literal {
+            Literal::Null => 0,
+            Literal::Bool(_) => 1,
+            Literal::Num(_) => 2,
+            Literal::Str(_) => 3,
+        };
+        match (self, literal) {
+            (Self::Bool(a), Literal::Bool(b)) => a.cmp(b),
+            (Self::Num(a), Literal::Num(b)) => a.total_cmp(b),
+            (Self::Str(a), Literal::Str(b)) => (*a).cmp(b.as_str()),
+            _ => self.rank().cmp(&literal_rank),
+        }
+    }
+}
+
+impl CompareOp {
+    fn holds(self, ordering: Ordering) -> bool {
+        match self {
+            Self::Eq => ordering == Ordering::Equal,
+            Self::Ne => ordering != Ordering::Equal,
+            Self::Lt => ordering == Ordering::Less,
+            Self::Le => ordering != Ordering::Greater,
+            Self::Gt => ordering == Ordering::Greater,
+            Self::Ge => ordering != Ordering::Less,
+        }
+    }
+
+    /// Operator for `literal OP path` rewritten as `path OP' literal`.
+    fn flipped(self) -> Self {
+        match self {
+            Self::Eq | Self::Ne => self,
+            Self::Lt => Self::Gt,
+            Self::Le => Self::Ge,
+            Self::Gt => Self::Lt,
+            Self::Ge => Self::Le,
+        }
+    }
+}
+
+impl Pushdown {
+    fn parse(expr: &str) -> Option<Self> {
+        let mut parser = PushdownParser { rest: expr };
+        let pushdown = parser.or()?;
+        parser.skip_ws();
+        parser.rest.is_empty().then_some(pushdown)
+    }
+
+    // `and`/`or` short-circuit left to right like jq, so a runtime error on the right side
+    // only matters when the left side does not already decide the result.
+    fn eval(&self, doc: &Lite3DocRef<'_>) -> Result<bool, PushdownError> {
+        match self {
+            Self::And(lhs, rhs) => Ok(lhs.eval(doc)? && rhs.eval(doc)?),
+            Self::Or(lhs, rhs) => Ok(lhs.eval(doc)? || rhs.eval(doc)?),
+            Self::Compare { path, op, literal } => {
+                let operand = resolve_path(doc, path)?;
+                Ok(op.holds(operand.cmp_literal(literal)))
+            }
+        }
+    }
+}
+
+// A missing key or a non-object intermediate is a jq indexing error, hence `Runtime`.
+fn resolve_path<'a>(doc: &Lite3DocRef<'a>, path: &Lite3Path) -> Result<Operand<'a>, PushdownError> {
+    let current = match doc.value_ref_at_path(0, path) {
+        Ok(Some(value)) => value,
+        Ok(None) => return Err(PushdownError::Runtime),
+        Err(_) => return Err(PushdownError::Fallback),
+    };
+    match current {
+        Lite3ValueRef::Null => Ok(Operand::Null),
+        Lite3ValueRef::Bool(value) => Ok(Operand::Bool(value)),
+        Lite3ValueRef::I64(value) => Ok(Operand::Num(value as f64)),
+        Lite3ValueRef::F64(value) if value.is_finite() => Ok(Operand::Num(value)),
+        Lite3ValueRef::Str(value) => Ok(Operand::Str(value)),
+        Lite3ValueRef::Array(_) => Ok(Operand::Array),
+        Lite3ValueRef::Object(_) => Ok(Operand::Object),
+        Lite3ValueRef::F64(_) | Lite3ValueRef::Bytes(_) => Err(PushdownError::Fallback),
+    }
+}
+
+/// Recursive-descent recognizer for the `Pushdown` subset; `None` for anything else.
+struct PushdownParser<'a> {
+    rest: &'a str,
+}
+
+impl PushdownParser<'_> {
+    fn or(&mut self) -> Option<Pushdown> {
+        let mut lhs = self.and()?;
+        while self.keyword("or") {
+            lhs = Pushdown::Or(Box::new(lhs), Box::new(self.and()?));
+        }
+        Some(lhs)
+    }
+
+    fn and(&mut self) -> Option<Pushdown> {
+        let mut lhs = self.atom()?;
+        while self.keyword("and") {
+            lhs = Pushdown::And(Box::new(lhs), Box::new(self.atom()?));
+        }
+        Some(lhs)
+    }
+
+    fn atom(&mut self) -> Option<Pushdown> {
+        if self.symbol("(") {
+            let inner = self.or()?;
+            return self.symbol(")").then_some(inner);
+        }
+        if let Some(path) = self.path() {
+            let op = self.compare_op()?;
+            let literal = self.literal()?;
+            return Some(Pushdown::Compare { path, op, literal });
+        }
+        let literal = self.literal()?;
+        let op = self.compare_op()?.flipped();
+        let path = self.path()?;
+        Some(Pushdown::Compare { path, op, literal })
+    }
+
+    fn path(&mut self) -> Option<Lite3Path> {
+        self.skip_ws();
+        let start = self.rest;
+        let mut path = Vec::new();
+        while let Some(after_dot) = self.rest.strip_prefix('.') {
+            let len = after_dot
+                .char_indices()
+                .find(|(i, c)| {
+                    !(c.is_ascii_alphabetic() || *c == '_' || (*i > 0 && c.is_ascii_digit()))
+                })
+                .map_or(after_dot.len(), |(i, _)| i);
+            if len == 0 {
+                self.rest = start;
+                return None;
+            }
+            path.push(after_dot[..len].to_string());
+            self.rest = &after_dot[len..];
+        }
+        // Only the payload half of the message envelope is visible in Lite3.
+        match path.first().map(String::as_str) {
+            Some("data") | Some("meta") => Lite3Path::new(path.iter().map(String::as_str)).ok(),
+            _ => {
+                self.rest = start;
+                None
+            }
+        }
+    }
+
+    fn compare_op(&mut self) -> Option<CompareOp> {
+        self.skip_ws();
+        for (token, op) in [
+            ("==", CompareOp::Eq),
+            ("!=", CompareOp::Ne),
+            ("<=", CompareOp::Le),
+            (">=", CompareOp::Ge),
+            ("<", CompareOp::Lt),
+            (">", CompareOp::Gt),
+        ] {
+            if let Some(rest) = self.rest.strip_prefix(token) {
+                self.rest = rest;
+                return Some(op);
+            }
+        }
+        None
+    }
+
+    fn literal(&mut self) -> Option<Literal> {
+        self.skip_ws();
+        for (word, literal) in [
+            ("null", Literal::Null),
+            ("true", Literal::Bool(true)),
+            ("false", Literal::Bool(false)),
+        ] {
+            if self.keyword(word) {
+                return Some(literal);
+            }
+        }
+        if self.rest.starts_with('"') {
+            // JSON string syntax; jq string interpolation (`\(`) is left to jaq.
+            let mut stream = serde_json::Deserializer::from_str(self.rest).into_iter::<String>();
+            let text = stream.next()?.ok()?;
+            let consumed = stream.byte_offset();
+            if self.rest[..consumed].contains("\\(") {
+                return None;
+            }
+            self.rest = &self.rest[consumed..];
+            return Some(Literal::Str(text));
+        }
+        let len = self
+            .rest
+            .char_indices()
+            .find(|(i, c)| {
+                !(c.is_ascii_digit()
+                    || matches!(c, '.' | 'e' | 'E' | '+')
+                    || (*c == '-' && (*i == 0 || self.rest[..*i].ends_with(['e', 'E']))))
+            })
+            .map_or(self.rest.len(), |(i, _)| i);
+        let number = self.rest[..len].parse::<f64>().ok()?;
+        if !number.is_finite() {
+            return None;
+        }
+        self.rest = &self.rest[len..];
+        Some(Literal::Num(number))
+    }
+
+    fn keyword(&mut self, word: &str) -> bool {
+        self.skip_ws();
+        match self.rest.strip_prefix(word) {
+            Some(rest) if !rest.starts_with(|c: char| c.is_ascii_alphanumeric() || c == '_') => {
+                self.rest = rest;
+                true
+            }
+            _ => false,
+        }
+    }
+
+    fn symbol(&mut self, token: &str) -> bool {
+        self.skip_ws();
+        match self.rest.strip_prefix(token) {
+            Some(rest) => {
+                self.rest = rest;
+                true
+            }
+            None => false,
+        }
+    }
+
+    fn skip_ws(&mut self) {
+        self.rest = self.rest.trim_start();
+    }
+}
+
 fn filter_compile_error<E: fmt::Debug>(expr: &str, err: E) -> Error {
     Error::new(ErrorKind::Usage)
         .with_message("invalid filter expression")
@@ -582,7 +904,8 @@ impl jaq_std::ValT for JaqValue {
 
 #[cfg(test)]
 mod tests {
-    use super::{JqFilter, compile_filters, matches_all};
+    use super::{JqFilter, compile_filters, matches_all, prefilter_lite3};
+    use plasmite::api::lite3::encode_message;
     use serde_json::json;
 
     #[test]
@@ -646,4 +969,81 @@ mod tests {
         });
         assert!(!matches_all(&preds, &msg).unwrap());
     }
+
+    #[test]
+    fn lite3_pushdown_agrees_with_jaq() {
+        let data = json!({
+            "x": 1,
+            "f": 2.5,
+            "neg": -3,
+            "s": "hello",
+            "ok": true,
+            "nil": null,
+            "nested": {"level": "warn", "n": 10},
+            "list": [1, 2]
+        });
+        let tags = vec!["ping".to_string()];
+        let payload = encode_message(&tags, &data).unwrap();
+        let msg = json!({"seq":1,"time":"t","meta":{"tags":tags},"data":data});
+        let cases = [
+            (".data.x == 1", true),
+            ("1 == .data.x", true),
+            (".data.x != 1", false),
+            (".data.f > 2", true),
+            ("3 > .data.f", true),
+            (".data.neg <= -3", true),
+            (".data.neg < -3", false),
+            (".data.s == \"hello\"", true),
+            (".data.s >= \"help\"", false),
+            (".data.s > 1", true),
+            (".data.ok == true", true),
+            (".data.nil == null", true),
+            (".data.nil < false", true),
+            (".data.nested.level == \"warn\"", true),
+            (
+                ".data.nested.n >= 10 and .data.nested.level != \"info\"",
+                true,
+            ),
+            (".data.x == 2 or .data.nested.n == 10", true),
+            ("(.data.x == 2 or .data.x == 1) and .data.ok == true", true),
+            (".data.missing == 1", false),
+            (".data.missing == 1 or .data.x == 1", false),
+            (".data.x == 1 or .data.missing == 1", true),
+            (".data.x == 2 and .data.missing == 1", false),
+            (".data.s.deeper == 1", false),
+            (".data.list > 5", true),
+            (".data.nested == null", false),
+        ];
+        for (expr, expected) in cases {
+            let filter = JqFilter::compile(expr).unwrap();
+            assert_eq!(
+                filter.matches_lite3(payload.as_slice()),
+                Some(expected),
+                "pushdown {expr}"
+            );
+            assert_eq!(filter.matches(&msg).unwrap(), expected, "jaq {expr}");
+        }
+    }
+
+    #[test]
+    fn lite3_pushdown_falls_back_outside_the_subset() {
+        let payload = encode_message(&[], &json!({"x": 1})).unwrap();
+        for expr in [
+            ".seq == 1",
+            ".data.x + 1 == 2",
+            ".data.x == .data.x",
+            ".meta.tags[0] == \"a\"",
+            ".data.x == \"\\(1)\"",
+            ".data.x | . == 1",
+        ] {
+            let filter = JqFilter::compile(expr).unwrap();
+            assert_eq!(filter.matches_lite3(payload.as_slice()), None, "{expr}");
+        }
+        let filters =
+            compile_filters(&[".data.x == 1".to_string(), ".seq > 0".to_string()]).unwrap();
+        assert_eq!(prefilter_lite3(&filters, payload.as_slice()), None);
+        let filters =
+            compile_filters(&[".data.x == 2".to_string(), ".seq > 0".to_string()]).unwrap();
+        assert_eq!(prefilter_lite3(&filters, payload.as_slice()), Some(false));
+    }
 }
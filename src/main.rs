@@ -35,17 +35,21 @@ mod serve;
 mod serve_init;
 
 use color_json::colorize_json;
-use ingest::{ErrorPolicy, IngestConfig, IngestFailure, IngestMode, IngestOutcome, ingest};
-use jq_filter::{JqFilter, compile_filters, matches_all};
+use ingest::{
+    ErrorPolicy, IngestConfig, IngestFailure, IngestMode, IngestOutcome, ingest, ingest_batched,
+    ingest_jsonl_parallel,
+};
+use jq_filter::{JqFilter, compile_filters, matches_all, prefilter_lite3};
 use plasmite::api::{
-    AppendOptions, Cursor, CursorResult, Durability, Error, ErrorKind, FrameRef, Lite3DocRef,
-    LocalClient, Pool, PoolOptions, PoolRef, RemoteClient, RemotePool, TailOptions,
-    ValidationIssue, ValidationReport, ValidationStatus, lite3,
+    AppendOptions, Compression, Cursor, CursorResult, Durability, Error, ErrorKind, FrameRef,
+    Lite3DocRef, LocalClient, Message, Pool, PoolGroup, PoolOptions, PoolRef, ReleaseAdvice,
+    RemoteClient, RemotePool, Residency, TailOptions, ValidationIssue, ValidationReport,
+    ValidationStatus, lite3,
     notify::{self, NotifyWait},
-    to_exit_code,
+    tag_bloom, tag_bloom_may_match, to_exit_code,
 };
 use plasmite::notice::{Notice, notice_json};
-use pool_info_json::{bounds_json, pool_info_json};
+use pool_info_json::{bounds_json, pool_group_info_json, pool_group_shard_label, pool_info_json};
 use pool_paths::{PoolNameResolveError, default_pool_dir, resolve_named_pool_path};
 
 #[derive(Copy, Clone, Debug)]
@@ -308,6 +312,7 @@ NOTES
   - `--create` is local-only; remote feed never creates remote pools
   - `--in auto` detects JSONL, JSON-seq (0x1e), event streams (data: prefix)
   - `--errors skip` continues past bad records; `--durability flush` syncs to disk
+    (`group` shares each sync with concurrent writers)
   - `--retry N` retries on transient failures (lock contention, etc.)"#
     )]
     Feed {
@@ -325,7 +330,11 @@ NOTES
             value_hint = ValueHint::FilePath
         )]
         file: Option<String>,
-        #[arg(long, default_value = "fast", help = "Durability mode: fast|flush")]
+        #[arg(
+            long,
+            default_value = "fast",
+            help = "Durability mode: fast|flush|group"
+        )]
         durability: String,
         #[arg(long, help = "Create the pool if it is missing")]
         create: bool,
@@ -361,6 +370,13 @@ NOTES
             help = "Stream error policy: stop|skip"
         )]
         errors: ErrorPolicyCli,
+        #[arg(
+            long,
+            default_value_t = 1,
+            help = "Parse/encode threads for --in jsonl streams into local pools",
+            long_help = "Parse/encode threads for --in jsonl streams into local pools.\n\nWith more than one, a reader splits lines into chunks for the workers and results are\ncommitted in input order with batched appends; error handling is unchanged."
+        )]
+        workers: usize,
         #[arg(
             long,
             help = "Bearer token for remote refs (dev-only; prefer --token-file)",
@@ -506,7 +522,9 @@ NOTES
   - Remote refs must be shorthand: http(s)://host:port/<pool> (no trailing slash)
   - Remote `follow` supports `--tail`, `--tag`, `--where`, `--one`, `--timeout`, `--data-only`, and `--format`
   - `--create` is local-only; remote follow never creates remote pools
-  - `--replay N` exits when all selected messages are emitted (no live follow); `--replay 0` emits instantly"#
+  - `--replay N` exits when all selected messages are emitted (no live follow); `--replay 0` emits instantly
+  - `--readahead 8M --release-behind cold` keeps long backlog catch-ups from faulting page by
+    page or pushing hot pages out of memory"#
     )]
     Follow {
         #[arg(help = "Pool ref: local name/path or shorthand URL http(s)://host:port/<pool>")]
@@ -559,6 +577,18 @@ NOTES
         quiet_drops: bool,
         #[arg(long = "no-notify", help = "Disable semaphore wakeups (poll only)")]
         no_notify: bool,
+        #[arg(
+            long,
+            value_name = "SIZE",
+            help = "Prefetch this much of the ring ahead of the reader (bytes or K/M/G; local only)"
+        )]
+        readahead: Option<String>,
+        #[arg(
+            long = "release-behind",
+            value_name = "MODE",
+            help = "Release ring pages already read: cold|pageout (local only)"
+        )]
+        release_behind: Option<String>,
         #[arg(
             long = "replay",
             value_name = "SPEED",
@@ -626,7 +656,11 @@ NOTES
         tag: Vec<String>,
         #[arg(short = 'q', long, help = "Suppress child stdout/stderr passthrough")]
         quiet: bool,
-        #[arg(long, default_value = "fast", help = "Durability mode: fast|flush")]
+        #[arg(
+            long,
+            default_value = "fast",
+            help = "Durability mode: fast|flush|group"
+        )]
         durability: String,
         #[arg(
             last = true,
@@ -769,10 +803,19 @@ Pools include an inline sequence index by default for fast `get(seq)` lookups."#
   $ plasmite pool create foo
   $ plasmite pool create --size 8M bar baz quux
   $ plasmite pool create --size 8M --index-capacity 4096 indexed
+  $ plasmite pool create --shards 8 --size 64M telemetry
+  $ plasmite pool create --size 64M --compress --compress-dict events.dict events
+  $ plasmite pool create --size 1G --preallocate --prefault hot
   $ plasmite pool create --json foo
 
 NOTES
-  - Sizes: 64K, 1M, 8M, 1G (K/M/G are 1024-based)"#
+  - Sizes: 64K, 1M, 8M, 1G (K/M/G are 1024-based)
+  - --shards N creates a pool group: a directory of N shard pools, each --size, with
+    separate append locks so concurrent writers do not contend on one file
+  - --compress stores payloads of 256+ bytes zstd-compressed when that makes them smaller;
+    it is fixed at creation. A dictionary (e.g. from `zstd --train`) is stored in the pool.
+  - --preallocate allocates disk blocks up front; --prefault faults the mapping in so first
+    appends don't page-fault; --huge-pages only helps on tmpfs/shmem-backed pool dirs"#
     )]
     Create {
         #[arg(required = true, help = "Pool name(s) to create")]
@@ -784,6 +827,26 @@ NOTES
             help = "Inline index slot count (default: auto-size; 0 disables index)"
         )]
         index_capacity: Option<u32>,
+        #[arg(long, help = "Create a pool group with this many shard pools")]
+        shards: Option<usize>,
+        #[arg(long, help = "Store frame payloads zstd-compressed")]
+        compress: bool,
+        #[arg(
+            long = "compress-dict",
+            value_name = "PATH",
+            requires = "compress",
+            help = "Shared zstd dictionary for --compress"
+        )]
+        compress_dict: Option<PathBuf>,
+        #[arg(long, help = "Allocate the pool file's disk blocks at creation")]
+        preallocate: bool,
+        #[arg(long, help = "Fault the whole pool mapping in at creation")]
+        prefault: bool,
+        #[arg(
+            long = "huge-pages",
+            help = "Request transparent huge pages for the ring"
+        )]
+        huge_pages: bool,
         #[arg(long, help = "Emit JSON instead of human-readable output")]
         json: bool,
     },
@@ -1073,6 +1136,7 @@ const DEFAULT_SNIFF_BYTES: usize = 8 * 1024;
 const DEFAULT_SNIFF_LINES: usize = 8;
 const DEFAULT_MAX_RECORD_BYTES: usize = 1024 * 1024;
 const DEFAULT_MAX_SNIPPET_BYTES: usize = 200;
+const FEED_MAX_BATCH_RECORDS: usize = 256;
 const DEFAULT_MAX_BODY_BYTES: u64 = 1024 * 1024;
 const DEFAULT_MAX_TAIL_TIMEOUT_MS: u64 = 30_000;
 const DEFAULT_MAX_TAIL_CONCURRENCY: usize = 64;
@@ -1202,6 +1266,7 @@ fn feed_exact_create_command_hint(pool: &str, options: FeedExactCreateHint<'_>)
             match options.durability {
                 Durability::Fast => "fast",
                 Durability::Flush => "flush",
+                Durability::GroupCommit { .. } => "group",
             }
             .to_string(),
         );
@@ -1651,16 +1716,30 @@ fn list_pools(pool_dir: &Path, client: &LocalClient) -> Vec<Value> {
             .map(Value::String)
             .unwrap_or(Value::Null);
         let pool_ref = PoolRef::path(path.clone());
-        match client.pool_info(&pool_ref) {
-            Ok(info) => {
-                let mut map = Map::new();
-                map.insert("name".to_string(), json!(name));
-                map.insert("path".to_string(), json!(path.display().to_string()));
-                map.insert("file_size".to_string(), json!(info.file_size));
-                map.insert("bounds".to_string(), bounds_json(info.bounds));
-                map.insert("mtime".to_string(), mtime);
-                pools.push(Value::Object(map));
+        if PoolGroup::is_group(&path) {
+            // One row per shard, so sizes and bounds stay per-file like every other row.
+            match client
+                .open_pool_group(&pool_ref)
+                .and_then(|group| group.info())
+            {
+                Ok(shards) => {
+                    for (shard, info) in shards.iter().enumerate() {
+                        let label = pool_group_shard_label(&name, shard);
+                        pools.push(pool_list_row(&label, info, mtime.clone()));
+                    }
+                }
+                Err(err) => {
+                    pools.push(pool_list_error(
+                        &name,
+                        &path,
+                        add_corrupt_hint(add_io_hint(err)),
+                    ));
+                }
             }
+            continue;
+        }
+        match client.pool_info(&pool_ref) {
+            Ok(info) => pools.push(pool_list_row(&name, &info, mtime)),
             Err(err) => {
                 pools.push(pool_list_error(
                     &name,
@@ -1675,6 +1754,16 @@ fn list_pools(pool_dir: &Path, client: &LocalClient) -> Vec<Value> {
     pools
 }
 
+fn pool_list_row(name: &str, info: &plasmite::api::PoolInfo, mtime: Value) -> Value {
+    let mut map = Map::new();
+    map.insert("name".to_string(), json!(name));
+    map.insert("path".to_string(), json!(info.path.display().to_string()));
+    map.insert("file_size".to_string(), json!(info.file_size));
+    map.insert("bounds".to_string(), bounds_json(info.bounds));
+    map.insert("mtime".to_string(), mtime);
+    Value::Object(map)
+}
+
 fn emit_pool_list_table(pools: &[Value], pool_dir: &Path) {
     let interactive = io::stdout().is_terminal();
     if interactive && pools.is_empty() {
@@ -2766,10 +2855,36 @@ fn parse_durability(input: &str) -> Result<Durability, Error> {
     match input.trim() {
         "fast" => Ok(Durability::Fast),
         "flush" => Ok(Durability::Flush),
+        "group" => Ok(Durability::group_commit()),
         _ => Err(Error::new(ErrorKind::Usage)
             .with_message("invalid durability")
-            .with_hint("Use fast or flush.")),
+            .with_hint("Use fast, flush, or group.")),
+    }
+}
+
+fn parse_release_behind(input: &str) -> Result<ReleaseAdvice, Error> {
+    match input.trim() {
+        "cold" => Ok(ReleaseAdvice::Cold),
+        "pageout" => Ok(ReleaseAdvice::PageOut),
+        _ => Err(Error::new(ErrorKind::Usage)
+            .with_message("invalid --release-behind mode")
+            .with_hint("Use cold or pageout.")),
+    }
+}
+
+/// Reader-side residency from `follow --readahead/--release-behind`.
+fn parse_follow_residency(
+    readahead: Option<&str>,
+    release_behind: Option<&str>,
+) -> Result<Residency, Error> {
+    let mut residency = Residency::new();
+    if let Some(readahead) = readahead {
+        residency = residency.with_readahead(parse_size(readahead)?);
     }
+    if let Some(mode) = release_behind {
+        residency = residency.with_release_behind(parse_release_behind(mode)?);
+    }
+    Ok(residency)
 }
 
 fn emit_pool_info_pretty(pool_ref: &str, info: &plasmite::api::PoolInfo) {
@@ -2872,6 +2987,14 @@ fn emit_pool_info_pretty(pool_ref: &str, info: &plasmite::api::PoolInfo) {
     println!("  ring:      {}", format_bytes(info.ring_size));
 }
 
+fn emit_pool_group_info_pretty(pool_ref: &str, shards: &[plasmite::api::PoolInfo]) {
+    println!("{pool_ref}: pool group, {} shards", shards.len());
+    for (shard, info) in shards.iter().enumerate() {
+        println!();
+        emit_pool_info_pretty(&pool_group_shard_label(pool_ref, shard), info);
+    }
+}
+
 fn message_count_from_info(info: &plasmite::api::PoolInfo) -> u64 {
     info.metrics
         .as_ref()
@@ -3316,7 +3439,7 @@ fn missing_feed_data_error() -> Error {
         .with_hint("Provide JSON via DATA, --file, or pipe JSON to stdin.")
 }
 
-fn open_feed_reader(path: &str) -> Result<Box<dyn Read>, Error> {
+fn open_feed_reader(path: &str) -> Result<Box<dyn Read + Send>, Error> {
     if path == "-" {
         return Ok(Box::new(io::stdin()));
     }
@@ -3429,6 +3552,7 @@ struct FeedIngestContext<'a> {
     color_mode: ColorMode,
     input: InputMode,
     errors: ErrorPolicyCli,
+    workers: usize,
 }
 
 struct RemoteFeedIngestContext<'a> {
@@ -3443,7 +3567,7 @@ struct RemoteFeedIngestContext<'a> {
     errors: ErrorPolicyCli,
 }
 
-fn ingest_from_stdin<R: Read>(
+fn ingest_from_stdin<R: Read + Send + 'static>(
     reader: R,
     ctx: FeedIngestContext<'_>,
     emit_receipt: bool,
@@ -3457,31 +3581,67 @@ fn ingest_from_stdin<R: Read>(
         max_snippet_bytes: DEFAULT_MAX_SNIPPET_BYTES,
     };
 
-    let outcome = ingest(
-        reader,
-        ingest_config,
-        |data| {
-            let payload = lite3::encode_message(ctx.tags, &data)?;
-            let (seq, timestamp_ns) = retry_with_config(ctx.retry_config, || {
-                let timestamp_ns = now_ns()?;
-                let options = AppendOptions::new(timestamp_ns, ctx.durability);
-                let seq = ctx
-                    .pool_handle
-                    .append_with_options(payload.as_slice(), options)?;
-                Ok((seq, timestamp_ns))
-            })?;
-            if emit_receipt {
+    // Records already buffered from stdin are appended together under one lock; size is
+    // checked per record so an oversized one fails alone, as it would unbatched.
+    let max_payload_len = ctx.pool_handle.max_payload_len();
+    let fits_ring = |payload: lite3::Lite3Buf| {
+        if payload.len() > max_payload_len {
+            return Err(Error::new(ErrorKind::Usage).with_message("payload exceeds ring capacity"));
+        }
+        Ok(payload)
+    };
+    // JSONL lines go straight from text to Lite3 through the calling thread's yyjson arena.
+    let encode_line = |line: &str| match lite3::encode_message_json(ctx.tags, line) {
+        Ok(Some(payload)) => Some(fits_ring(payload)),
+        Ok(None) => None,
+        Err(err) => Some(Err(err)),
+    };
+    let append_batch = |batch: &mut Vec<lite3::Lite3Buf>| -> Result<(), Error> {
+        let payloads: Vec<&[u8]> = batch.iter().map(|payload| payload.as_slice()).collect();
+        // Only a batch that committed nothing is retried; retrying after a partial commit
+        // would append its prefix twice.
+        let (seqs, timestamp_ns, result) = retry_with_config(ctx.retry_config, || {
+            let timestamp_ns = now_ns()?;
+            let options = AppendOptions::new(timestamp_ns, ctx.durability);
+            match ctx.pool_handle.append_batch_partial(&payloads, options) {
+                (seqs, Err(err)) if seqs.is_empty() => Err(err),
+                (seqs, result) => Ok((seqs, timestamp_ns, result)),
+            }
+        })?;
+        if emit_receipt {
+            for seq in seqs {
                 emit_feed_receipt(
                     feed_receipt_json(seq, timestamp_ns, ctx.tags)?,
                     ctx.color_mode,
                 );
             }
-            Ok(())
-        },
-        |failure| {
-            ingest_failure_notice(&failure, ctx.pool_ref, ctx.pool_path_label, ctx.color_mode)
-        },
-    )?;
+        }
+        result
+    };
+    let on_failure = |failure: IngestFailure| {
+        ingest_failure_notice(&failure, ctx.pool_ref, ctx.pool_path_label, ctx.color_mode)
+    };
+    let outcome = if ctx.workers > 1 {
+        ingest_jsonl_parallel(
+            reader,
+            ingest_config,
+            ctx.workers,
+            FEED_MAX_BATCH_RECORDS,
+            encode_line,
+            append_batch,
+            on_failure,
+        )?
+    } else {
+        ingest_batched(
+            reader,
+            ingest_config,
+            FEED_MAX_BATCH_RECORDS,
+            |data| fits_ring(lite3::encode_message(ctx.tags, &data)?),
+            encode_line,
+            append_batch,
+            on_failure,
+        )?
+    };
 
     if ctx.errors == ErrorPolicyCli::Skip && outcome.failed > 0 {
         ingest_summary_notice(&outcome, ctx.pool_ref, ctx.pool_path_label, ctx.color_mode);
@@ -3642,12 +3802,7 @@ fn decode_payload(payload: &[u8]) -> Result<(Value, Value), Error> {
     let data_ofs = doc
         .key_offset("data")
         .map_err(|err| err.with_message("missing data"))?;
-    let data_json = doc.to_json_at(data_ofs, false)?;
-    let data: Value = serde_json::from_str(&data_json).map_err(|err| {
-        Error::new(ErrorKind::Corrupt)
-            .with_message("invalid payload json")
-            .with_source(err)
-    })?;
+    let data = doc.to_value_at(data_ofs)?;
     Ok((meta, data))
 }
 
@@ -3721,6 +3876,41 @@ fn parse_duplex_tty_line(me: &str, line: &str) -> Option<Value> {
     }))
 }
 
+/// Compact output with no `--where` or sender suppression never needs a decoded `Value`,
+/// so frames can be written to stdout straight from their Lite3 payload.
+fn streams_frame_lines(cfg: &FollowConfig) -> bool {
+    !cfg.pretty && cfg.where_predicates.is_empty() && cfg.suppress_sender.is_none()
+}
+
+/// Streamed counterpart of `message_from_frame` + `emit_message`; reuses `line` across frames.
+/// Returns whether the frame passed the tag filter and was written.
+fn emit_frame_line(
+    frame: &FrameRef<'_>,
+    cfg: &FollowConfig,
+    line: &mut Vec<u8>,
+) -> Result<bool, Error> {
+    line.clear();
+    let meta = if cfg.data_only {
+        Message::write_frame_data_json(frame, line)?
+    } else {
+        Message::write_frame_json(frame, line)?
+    };
+    if !cfg
+        .required_tags
+        .iter()
+        .all(|required| meta.tags.contains(required))
+    {
+        return Ok(false);
+    }
+    line.push(b'\n');
+    io::Write::write_all(&mut io::stdout().lock(), line).map_err(|err| {
+        Error::new(ErrorKind::Io)
+            .with_message("failed to write message")
+            .with_source(err)
+    })?;
+    Ok(true)
+}
+
 fn should_suppress_message(cfg: &FollowConfig, message: &Value) -> bool {
     cfg.suppress_sender
         .as_deref()
@@ -3846,12 +4036,15 @@ fn follow_pool(
 
     let mut cursor = Cursor::new();
     let mut header = pool.header_from_mmap()?;
+    let tag_mask = tag_bloom(cfg.required_tags.iter().map(String::as_str));
     let mut emit = VecDeque::new();
     let mut last_seen_seq = None::<u64>;
     let mut pending_drop: Option<DropNotice> = None;
     let mut last_notice_at: Option<Instant> = None;
     let notice_interval = Duration::from_secs(1);
     let tail_wait = cfg.one && cfg.tail > 0;
+    let stream_lines = streams_frame_lines(&cfg);
+    let mut line = Vec::new();
     let mut timeout_deadline = cfg.timeout.map(|duration| Instant::now() + duration);
     let mut notify_enabled = cfg.notify;
     let mut notify_handle = if notify_enabled {
@@ -3870,30 +4063,44 @@ fn follow_pool(
     };
 
     if let Some(since_ns) = cfg.since_ns {
-        cursor.seek_to(header.tail_off as usize);
+        cursor.seek_to_time(pool, since_ns)?;
         loop {
             if follow_should_stop(cfg.stop.as_ref()) {
                 return Ok(RunOutcome::ok());
             }
             match cursor.next(pool)? {
-                CursorResult::Message(frame) => {
+                CursorResult::Message(stored) => {
+                    let payload = pool.frame_payload(&stored)?;
+                    let frame = stored.with_payload(&payload);
                     if follow_should_stop(cfg.stop.as_ref()) {
                         return Ok(RunOutcome::ok());
                     }
                     if frame.timestamp_ns >= since_ns {
-                        let message = message_from_frame(&frame)?;
-                        if !should_suppress_message(&cfg, &message)
-                            && matches_required_tags(cfg.required_tags.as_slice(), &message)
-                            && matches_all(cfg.where_predicates.as_slice(), &message)?
+                        if stream_lines && tag_bloom_may_match(frame.tag_bloom, tag_mask) {
+                            if emit_frame_line(&frame, &cfg, &mut line)? {
+                                bump_timeout(&mut timeout_deadline);
+                                if cfg.one {
+                                    return Ok(RunOutcome::ok());
+                                }
+                            }
+                        } else if tag_bloom_may_match(frame.tag_bloom, tag_mask)
+                            && prefilter_lite3(cfg.where_predicates.as_slice(), frame.payload)
+                                != Some(false)
                         {
-                            emit_message(
-                                output_value(message, cfg.data_only),
-                                cfg.pretty,
-                                cfg.color_mode,
-                            );
-                            bump_timeout(&mut timeout_deadline);
-                            if cfg.one {
-                                return Ok(RunOutcome::ok());
+                            let message = message_from_frame(&frame)?;
+                            if !should_suppress_message(&cfg, &message)
+                                && matches_required_tags(cfg.required_tags.as_slice(), &message)
+                                && matches_all(cfg.where_predicates.as_slice(), &message)?
+                            {
+                                emit_message(
+                                    output_value(message, cfg.data_only),
+                                    cfg.pretty,
+                                    cfg.color_mode,
+                                );
+                                bump_timeout(&mut timeout_deadline);
+                                if cfg.one {
+                                    return Ok(RunOutcome::ok());
+                                }
                             }
                         }
                         last_seen_seq = Some(frame.seq);
@@ -3913,16 +4120,23 @@ fn follow_pool(
                 return Ok(RunOutcome::ok());
             }
             match cursor.next(pool)? {
-                CursorResult::Message(frame) => {
+                CursorResult::Message(stored) => {
+                    let payload = pool.frame_payload(&stored)?;
+                    let frame = stored.with_payload(&payload);
                     if follow_should_stop(cfg.stop.as_ref()) {
                         return Ok(RunOutcome::ok());
                     }
-                    let message = message_from_frame(&frame)?;
-                    if !should_suppress_message(&cfg, &message)
-                        && matches_required_tags(cfg.required_tags.as_slice(), &message)
-                        && matches_all(cfg.where_predicates.as_slice(), &message)?
+                    if tag_bloom_may_match(frame.tag_bloom, tag_mask)
+                        && prefilter_lite3(cfg.where_predicates.as_slice(), frame.payload)
+                            != Some(false)
                     {
-                        emit.push_back(message);
+                        let message = message_from_frame(&frame)?;
+                        if !should_suppress_message(&cfg, &message)
+                            && matches_required_tags(cfg.required_tags.as_slice(), &message)
+                            && matches_all(cfg.where_predicates.as_slice(), &message)?
+                        {
+                            emit.push_back(message);
+                        }
                     }
                     last_seen_seq = Some(frame.seq);
                     while emit.len() > cfg.tail as usize {
@@ -4038,7 +4252,9 @@ fn follow_pool(
             return Ok(RunOutcome::ok());
         }
         match cursor.next(pool)? {
-            CursorResult::Message(frame) => {
+            CursorResult::Message(stored) => {
+                let payload = pool.frame_payload(&stored)?;
+                let frame = stored.with_payload(&payload);
                 if follow_should_stop(cfg.stop.as_ref()) {
                     return Ok(RunOutcome::ok());
                 }
@@ -4048,37 +4264,49 @@ fn follow_pool(
                         maybe_emit_pending(&mut pending_drop, &mut last_notice_at);
                     }
                 }
-                let message = message_from_frame(&frame)?;
-                if !should_suppress_message(&cfg, &message)
-                    && matches_required_tags(cfg.required_tags.as_slice(), &message)
-                    && matches_all(cfg.where_predicates.as_slice(), &message)?
-                {
-                    if tail_wait {
-                        emit.push_back(message);
-                        while emit.len() > cfg.tail as usize {
-                            emit.pop_front();
-                        }
-                        if emit.len() == cfg.tail as usize {
-                            if let Some(value) = emit.back() {
-                                emit_message(
-                                    output_value(value.clone(), cfg.data_only),
-                                    cfg.pretty,
-                                    cfg.color_mode,
-                                );
-                            }
-                            return Ok(RunOutcome::ok());
-                        }
-                    } else {
-                        emit_message(
-                            output_value(message, cfg.data_only),
-                            cfg.pretty,
-                            cfg.color_mode,
-                        );
+                if stream_lines && !tail_wait && tag_bloom_may_match(frame.tag_bloom, tag_mask) {
+                    if emit_frame_line(&frame, &cfg, &mut line)? {
                         bump_timeout(&mut timeout_deadline);
                         if cfg.one {
                             return Ok(RunOutcome::ok());
                         }
                     }
+                } else if tag_bloom_may_match(frame.tag_bloom, tag_mask)
+                    && prefilter_lite3(cfg.where_predicates.as_slice(), frame.payload)
+                        != Some(false)
+                {
+                    let message = message_from_frame(&frame)?;
+                    if !should_suppress_message(&cfg, &message)
+                        && matches_required_tags(cfg.required_tags.as_slice(), &message)
+                        && matches_all(cfg.where_predicates.as_slice(), &message)?
+                    {
+                        if tail_wait {
+                            emit.push_back(message);
+                            while emit.len() > cfg.tail as usize {
+                                emit.pop_front();
+                            }
+                            if emit.len() == cfg.tail as usize {
+                                if let Some(value) = emit.back() {
+                                    emit_message(
+                                        output_value(value.clone(), cfg.data_only),
+                                        cfg.pretty,
+                                        cfg.color_mode,
+                                    );
+                                }
+                                return Ok(RunOutcome::ok());
+                            }
+                        } else {
+                            emit_message(
+                                output_value(message, cfg.data_only),
+                                cfg.pretty,
+                                cfg.color_mode,
+                            );
+                            bump_timeout(&mut timeout_deadline);
+                            if cfg.one {
+                                return Ok(RunOutcome::ok());
+                            }
+                        }
+                    }
                 }
                 last_seen_seq = Some(frame.seq);
                 maybe_emit_pending(&mut pending_drop, &mut last_notice_at);
@@ -4149,14 +4377,21 @@ fn follow_replay(pool: &Pool, cfg: &FollowConfig) -> Result<RunOutcome, Error> {
     let speed = cfg.replay_speed.unwrap_or(0.0);
     let mut cursor = Cursor::new();
     let mut header = pool.header_from_mmap()?;
+    let tag_mask = tag_bloom(cfg.required_tags.iter().map(String::as_str));
     let mut collected: Vec<(u64, Value)> = Vec::new();
 
     if let Some(since_ns) = cfg.since_ns {
-        cursor.seek_to(header.tail_off as usize);
+        cursor.seek_to_time(pool, since_ns)?;
         loop {
             match cursor.next(pool)? {
-                CursorResult::Message(frame) => {
-                    if frame.timestamp_ns >= since_ns {
+                CursorResult::Message(stored) => {
+                    let payload = pool.frame_payload(&stored)?;
+                    let frame = stored.with_payload(&payload);
+                    if frame.timestamp_ns >= since_ns
+                        && tag_bloom_may_match(frame.tag_bloom, tag_mask)
+                        && prefilter_lite3(cfg.where_predicates.as_slice(), frame.payload)
+                            != Some(false)
+                    {
                         let message = message_from_frame(&frame)?;
                         if matches_required_tags(cfg.required_tags.as_slice(), &message)
                             && matches_all(cfg.where_predicates.as_slice(), &message)?
@@ -4177,18 +4412,25 @@ fn follow_replay(pool: &Pool, cfg: &FollowConfig) -> Result<RunOutcome, Error> {
         let mut buffer: VecDeque<(u64, Value)> = VecDeque::new();
         loop {
             match cursor.next(pool)? {
-                CursorResult::Message(frame) => {
-                    let message = message_from_frame(&frame)?;
-                    if matches_required_tags(cfg.required_tags.as_slice(), &message)
-                        && matches_all(cfg.where_predicates.as_slice(), &message)?
+                CursorResult::Message(stored) => {
+                    let payload = pool.frame_payload(&stored)?;
+                    let frame = stored.with_payload(&payload);
+                    if tag_bloom_may_match(frame.tag_bloom, tag_mask)
+                        && prefilter_lite3(cfg.where_predicates.as_slice(), frame.payload)
+                            != Some(false)
                     {
-                        if cfg.tail > 0 {
-                            buffer.push_back((frame.timestamp_ns, message));
-                            while buffer.len() > cfg.tail as usize {
-                                buffer.pop_front();
+                        let message = message_from_frame(&frame)?;
+                        if matches_required_tags(cfg.required_tags.as_slice(), &message)
+                            && matches_all(cfg.where_predicates.as_slice(), &message)?
+                        {
+                            if cfg.tail > 0 {
+                                buffer.push_back((frame.timestamp_ns, message));
+                                while buffer.len() > cfg.tail as usize {
+                                    buffer.pop_front();
+                                }
+                            } else {
+                                collected.push((frame.timestamp_ns, message));
                             }
-                        } else {
-                            collected.push((frame.timestamp_ns, message));
                         }
                     }
                 }
@@ -4234,11 +4476,11 @@ fn follow_replay(pool: &Pool, cfg: &FollowConfig) -> Result<RunOutcome, Error> {
 #[cfg(test)]
 mod tests {
     use super::{
-        Error, ErrorKind, PoolTarget, RetryConfig, build_serve_startup_lines,
-        duplex_requires_me_when_tty, error_text, format_bytes, format_relative_time,
-        format_seq_range, format_timestamp_human, matches_required_tags, parse_duplex_tty_line,
-        parse_duration, parse_size, read_token_file, render_table, resolve_pool_target,
-        retry_with_config, short_display_path,
+        Error, ErrorKind, PoolTarget, ReleaseAdvice, Residency, RetryConfig,
+        build_serve_startup_lines, duplex_requires_me_when_tty, error_text, format_bytes,
+        format_relative_time, format_seq_range, format_timestamp_human, matches_required_tags,
+        parse_duplex_tty_line, parse_duration, parse_follow_residency, parse_size, read_token_file,
+        render_table, resolve_pool_target, retry_with_config, short_display_path,
     };
     use serde_json::json;
     use std::io::Cursor;
@@ -4364,6 +4606,19 @@ mod tests {
         assert!(parse_size("3KiB").is_err());
     }
 
+    #[test]
+    fn parse_follow_residency_reads_window_and_release_mode() {
+        assert_eq!(
+            parse_follow_residency(None, None).unwrap(),
+            Residency::new()
+        );
+        let residency = parse_follow_residency(Some("8M"), Some("cold")).unwrap();
+        assert_eq!(residency.readahead_bytes, 8 * 1024 * 1024);
+        assert_eq!(residency.release_behind, Some(ReleaseAdvice::Cold));
+        let err = parse_follow_residency(None, Some("evict")).unwrap_err();
+        assert_eq!(err.kind(), ErrorKind::Usage);
+    }
+
     #[test]
     fn parse_duration_accepts_ms_s_m() {
         assert_eq!(parse_duration("500ms").unwrap(), Duration::from_millis(500));
@@ -1,11 +1,14 @@
 //! Purpose: Shared pool-info JSON serializers for CLI and HTTP serving paths.
-//! Exports: `pool_info_json` and `bounds_json`.
+//! Exports: `pool_info_json`, `pool_group_info_json`, `pool_group_shard_label`, and `bounds_json`.
 //! Role: Keep pool metadata envelope shape consistent across entry points.
 //! Invariants: Stable key names/order for v0 pool info payloads.
 //! Invariants: Metrics block is emitted only when source metrics exist.
+//! Invariants: `hot_metrics` (pool-wide hot-path counters) likewise, for local pools only.
+//! Invariants: Pool groups nest one ordinary pool-info object per shard, labelled `name#N`.
 
 use plasmite::api::{Bounds, PoolInfo, PoolMetrics};
 use serde_json::{Map, Value, json};
+use std::path::Path;
 
 pub(crate) fn bounds_json(bounds: Bounds) -> Value {
     let mut map = Map::new();
@@ -32,9 +35,31 @@ pub(crate) fn pool_info_json(pool_ref: &str, info: &PoolInfo) -> Value {
     if let Some(metrics) = &info.metrics {
         map.insert("metrics".to_string(), pool_metrics_json(metrics));
     }
+    if let Some(hot_metrics) = &info.hot_metrics {
+        map.insert("hot_metrics".to_string(), hot_metrics.to_json());
+    }
     Value::Object(map)
 }
 
+/// Display name of one shard of a pool group.
+pub(crate) fn pool_group_shard_label(pool_ref: &str, shard: usize) -> String {
+    format!("{pool_ref}#{shard}")
+}
+
+pub(crate) fn pool_group_info_json(pool_ref: &str, path: &Path, shards: &[PoolInfo]) -> Value {
+    let shard_infos: Vec<Value> = shards
+        .iter()
+        .enumerate()
+        .map(|(shard, info)| pool_info_json(&pool_group_shard_label(pool_ref, shard), info))
+        .collect();
+    json!({
+        "name": pool_ref,
+        "path": path.display().to_string(),
+        "shard_count": shards.len(),
+        "shards": shard_infos,
+    })
+}
+
 fn pool_metrics_json(metrics: &PoolMetrics) -> Value {
     json!({
         "message_count": metrics.message_count,
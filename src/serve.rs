@@ -3,7 +3,11 @@
 //! Role: Axum-based loopback server implementing the remote v0 spec.
 //! Invariants: JSON envelopes match spec/remote/v0/SPEC.md; error kinds remain stable.
 //! Invariants: Loopback-only unless explicitly allowed (v0 policy).
+//! Invariants: Live tails share one reader per (pool, encoding); lagging subscribers resume
+//! Invariants: from the pool with the same fell-behind semantics as a private cursor.
 //! Notes: Streaming uses JSONL or framed Lite3; tail is at-least-once and resumable.
+//! Notes: Lite3 appends take one payload or a length-prefixed batch; Lite3 tails and append
+//! Notes: bodies may be zstd-compressed when the client negotiates it.
 
 use axum::body::Body;
 use axum::extract::{DefaultBodyLimit, Path as AxumPath, Query, RawQuery, State};
@@ -22,12 +26,14 @@ use rustls::pki_types::{CertificateDer, PrivateKeyDer, PrivatePkcs8KeyDer};
 use serde::{Deserialize, Serialize};
 use serde_json::{Value, json};
 use sha2::{Digest, Sha256};
-use std::collections::HashSet;
+use std::collections::{HashMap, HashSet};
 use std::future::IntoFuture;
+use std::io::{Read, Write};
 use std::net::{IpAddr, Ipv4Addr, Ipv6Addr, SocketAddr};
 use std::path::{Path, PathBuf};
-use std::sync::Arc;
-use tokio::sync::{OwnedSemaphorePermit, Semaphore, mpsc};
+use std::sync::{Arc, Mutex, PoisonError};
+use std::time::Instant;
+use tokio::sync::{OwnedSemaphorePermit, Semaphore, broadcast, mpsc};
 use tokio::task::JoinSet;
 use tokio::time::Duration;
 use tokio_rustls::TlsAcceptor;
@@ -40,8 +46,11 @@ use tracing_subscriber::EnvFilter;
 use url::Url;
 
 use crate::pool_info_json::pool_info_json;
+use plasmite::api::notify::{self, NotifyWait};
 use plasmite::api::{
-    Durability, Error, ErrorKind, LocalClient, PoolApiExt, PoolOptions, PoolRef, TailOptions, lite3,
+    BatchCursor, Cursor, CursorResult, Durability, Error, ErrorKind, FrameRef,
+    LITE3_BATCH_CONTENT_TYPE, LocalClient, Message, Meta, Pool, PoolApiExt, PoolOptions, PoolRef,
+    TailOptions, decode_lite3_batch, lite3, tag_bloom, tag_bloom_may_match,
 };
 use plasmite::mcp::{
     DispatchOutcome, JsonRpcError as McpJsonRpcError, McpDispatcher, McpHandler, McpResource,
@@ -51,6 +60,14 @@ use plasmite::mcp::{
 
 const UI_INDEX_HTML: &str = include_str!("../ui/index.html");
 const MCP_PROTOCOL_VERSION: &str = "2025-11-25";
+/// Encoded events kept per tail hub; subscribers further behind resume from the pool.
+const TAIL_HUB_CAPACITY: usize = 1024;
+/// Hub reader wait between empty polls (matches the default tail poll interval).
+const TAIL_HUB_POLL_INTERVAL: Duration = Duration::from_millis(50);
+/// Frames tail readers take per pool-header refresh (see `Cursor::next_batch`).
+const TAIL_READ_BATCH_FRAMES: usize = 256;
+/// zstd level for compressed Lite3 tails; favors per-flush CPU over ratio.
+const TAIL_ZSTD_LEVEL: i32 = 3;
 
 #[derive(Clone, Debug)]
 pub struct ServeConfig {
@@ -125,7 +142,9 @@ struct AppState {
     token: Option<String>,
     access_mode: AccessMode,
     max_tail_timeout_ms: u64,
+    max_body_bytes: usize,
     tail_semaphore: Arc<Semaphore>,
+    tail_hubs: Arc<TailHubs>,
 }
 
 #[derive(Clone, Copy, Debug)]
@@ -163,7 +182,9 @@ pub async fn serve(config: ServeConfig) -> Result<(), Error> {
         token: config.token,
         access_mode: config.access_mode,
         max_tail_timeout_ms: config.max_tail_timeout_ms,
+        max_body_bytes,
         tail_semaphore: Arc::new(Semaphore::new(config.max_concurrent_tails)),
+        tail_hubs: Arc::new(TailHubs::default()),
     });
 
     let mut app = Router::new()
@@ -174,6 +195,7 @@ pub async fn serve(config: ServeConfig) -> Result<(), Error> {
         .route("/v0/pools", post(create_pool).get(list_pools))
         .route("/v0/pools/open", post(open_pool))
         .route("/v0/pools/:pool/info", get(pool_info))
+        .route("/v0/pools/:pool/metrics", get(pool_metrics))
         .route("/v0/pools/:pool", delete(delete_pool))
         .route("/v0/pools/:pool/append", post(append_message))
         .route("/v0/pools/:pool/append_lite3", post(append_lite3))
@@ -637,21 +659,31 @@ struct PoolRequest {
     pool: String,
 }
 
+/// Either a single message (`data`/`tags`) or a batch (`messages`), never both.
 #[derive(Debug, Deserialize)]
 struct AppendRequest {
-    data: serde_json::Value,
+    data: Option<serde_json::Value>,
     tags: Option<Vec<String>>,
+    messages: Option<Vec<AppendItem>>,
     durability: Option<String>,
 }
 
+#[derive(Debug, Deserialize)]
+struct AppendItem {
+    data: serde_json::Value,
+    tags: Option<Vec<String>>,
+}
+
 #[derive(Debug, Deserialize)]
 struct TailQuery {
     since_seq: Option<u64>,
+    /// Unix nanoseconds; skips messages stamped earlier.
+    since_time: Option<u64>,
     max: Option<u64>,
     timeout_ms: Option<u64>,
 }
 
-#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[derive(Copy, Clone, Debug, Eq, Hash, PartialEq)]
 enum TailStreamEncoding {
     Jsonl,
     Lite3,
@@ -952,6 +984,34 @@ async fn pool_info(
     }
 }
 
+/// Prometheus text exposition of the pool's hot-path counters, plus this server's Lite3 codec
+/// counters (process-wide, so unlabeled).
+async fn pool_metrics(
+    State(state): State<Arc<AppState>>,
+    headers: HeaderMap,
+    AxumPath(pool): AxumPath<String>,
+) -> Response {
+    if let Err(err) = authorize(&headers, &state) {
+        return error_response(err);
+    }
+    if let Err(err) = ensure_read_access(&state) {
+        return error_response(err);
+    }
+    let pool_ref = match pool_ref_from_request(&pool) {
+        Ok(pool_ref) => pool_ref,
+        Err(err) => return error_response(err),
+    };
+    match state.client.open_pool(&pool_ref) {
+        Ok(opened) => {
+            let mut body = String::new();
+            opened.hot_metrics().write_prometheus(&mut body, &pool);
+            plasmite::api::lite3_codec_metrics().write_prometheus(&mut body);
+            text_response(body, "text/plain; version=0.0.4; charset=utf-8")
+        }
+        Err(err) => error_response(err),
+    }
+}
+
 async fn list_pools(State(state): State<Arc<AppState>>, headers: HeaderMap) -> Response {
     if let Err(err) = authorize(&headers, &state) {
         return error_response(err);
@@ -1016,15 +1076,47 @@ async fn append_message(
         Err(err) => return error_response(err),
     };
     let durability = durability_from_str(payload.durability.as_deref());
-    let tags = payload.tags.unwrap_or_default();
-
-    let result = state
-        .client
-        .open_pool(&pool_ref)
-        .and_then(|mut pool| pool.append_json_now(&payload.data, &tags, durability));
-    match result {
-        Ok(message) => json_response(json!({ "message": message_json(&message) })),
-        Err(err) => error_response(err),
+    match (payload.data, payload.messages, payload.tags) {
+        (Some(data), None, tags) => {
+            let tags = tags.unwrap_or_default();
+            let client = state.client.clone();
+            let result = run_append(durability, move || {
+                let mut pool = client.open_pool(&pool_ref)?;
+                pool.append_json_now(&data, &tags, durability)
+            })
+            .await;
+            match result {
+                Ok(message) => json_response(json!({ "message": message_json(&message) })),
+                Err(err) => error_response(err),
+            }
+        }
+        (None, Some(messages), None) => {
+            // Batched form: one append lock, one flush, and one notify for the whole request.
+            let items: Vec<(serde_json::Value, Vec<String>)> = messages
+                .into_iter()
+                .map(|item| (item.data, item.tags.unwrap_or_default()))
+                .collect();
+            let client = state.client.clone();
+            let result = run_append(durability, move || {
+                let refs: Vec<(&serde_json::Value, &[String])> = items
+                    .iter()
+                    .map(|(data, tags)| (data, tags.as_slice()))
+                    .collect();
+                let mut pool = client.open_pool(&pool_ref)?;
+                pool.append_json_batch_now(&refs, durability)
+            })
+            .await;
+            match result {
+                Ok(messages) => json_response(json!({
+                    "messages": messages.iter().map(message_json).collect::<Vec<_>>(),
+                })),
+                Err(err) => error_response(err),
+            }
+        }
+        _ => error_response(
+            Error::new(ErrorKind::Usage)
+                .with_message("append requires either data and tags, or messages"),
+        ),
     }
 }
 
@@ -1041,16 +1133,23 @@ async fn append_lite3(
     if let Err(err) = ensure_write_access(&state) {
         return error_response(err);
     }
-    if let Some(content_type) = headers
+    let batch = match headers
         .get("content-type")
         .and_then(|value| value.to_str().ok())
     {
-        if !content_type.starts_with("application/x-plasmite-lite3") {
+        Some(content_type) if content_type.starts_with(LITE3_BATCH_CONTENT_TYPE) => true,
+        Some(content_type) if content_type.starts_with("application/x-plasmite-lite3") => false,
+        Some(_) => {
             return error_response(
                 Error::new(ErrorKind::Usage).with_message("invalid content-type for lite3 append"),
             );
         }
-    }
+        None => false,
+    };
+    let payload = match decode_request_body(&headers, payload, state.max_body_bytes) {
+        Ok(payload) => payload,
+        Err(response) => return response,
+    };
     if payload.is_empty() {
         return error_response(
             Error::new(ErrorKind::Usage).with_message("lite3 payload is required"),
@@ -1061,17 +1160,76 @@ async fn append_lite3(
         Err(err) => return error_response(err),
     };
     let durability = durability_from_str(query.durability.as_deref());
-    let payload = payload.to_vec();
-    let result = state.client.open_pool(&pool_ref).and_then(|mut pool| {
+    let client = state.client.clone();
+    if batch {
+        // Batched form: one append lock, one flush, and one notify for every frame in the body.
+        let result = run_append(durability, move || {
+            let frames = decode_lite3_batch(&payload)?;
+            let mut pool = client.open_pool(&pool_ref)?;
+            pool.append_lite3_batch_now(&frames, durability)
+        })
+        .await;
+        return match result {
+            Ok(seqs) => json_response(json!({ "seqs": seqs })),
+            Err(err) => error_response(err),
+        };
+    }
+    let result = run_append(durability, move || {
+        let mut pool = client.open_pool(&pool_ref)?;
         let seq = pool.append_lite3_now(&payload, durability)?;
         pool.get_message(seq)
-    });
+    })
+    .await;
     match result {
         Ok(message) => json_response(json!({ "message": message_json(&message) })),
         Err(err) => error_response(err),
     }
 }
 
+/// Undo `Content-Encoding: zstd` on a request body, holding the result to the body limit.
+fn decode_request_body(
+    headers: &HeaderMap,
+    body: Bytes,
+    max_body_bytes: usize,
+) -> Result<Bytes, Response> {
+    let encoding = headers
+        .get(header::CONTENT_ENCODING)
+        .and_then(|value| value.to_str().ok())
+        .map(str::trim);
+    match encoding {
+        None | Some("") | Some("identity") => Ok(body),
+        Some(encoding) if encoding.eq_ignore_ascii_case("zstd") => {
+            let mut out = Vec::new();
+            zstd::stream::read::Decoder::new(&body[..])
+                .and_then(|decoder| {
+                    decoder
+                        .take(max_body_bytes as u64 + 1)
+                        .read_to_end(&mut out)
+                })
+                .map_err(|err| {
+                    error_response(
+                        Error::new(ErrorKind::Usage)
+                            .with_message("invalid zstd request body")
+                            .with_source(err),
+                    )
+                })?;
+            if out.len() > max_body_bytes {
+                return Err(error_response_with_status(
+                    Error::new(ErrorKind::Usage)
+                        .with_message("decompressed request body exceeds max body size"),
+                    StatusCode::PAYLOAD_TOO_LARGE,
+                ));
+            }
+            Ok(Bytes::from(out))
+        }
+        Some(_) => Err(error_response(
+            Error::new(ErrorKind::Usage)
+                .with_message("unsupported content-encoding")
+                .with_hint("Send an uncompressed body or use Content-Encoding: zstd."),
+        )),
+    }
+}
+
 async fn get_message(
     State(state): State<Arc<AppState>>,
     headers: HeaderMap,
@@ -1115,7 +1273,7 @@ async fn get_lite3(
     };
     let result = state.client.open_pool(&pool_ref).and_then(|pool| {
         let frame = pool.get_lite3(seq)?;
-        let payload = frame.payload.to_vec();
+        let payload = pool.frame_payload(&frame)?.into_owned();
         lite3::validate_bytes(&payload)?;
         Ok(payload)
     });
@@ -1155,7 +1313,7 @@ async fn tail_messages(
         Ok(runtime) => runtime,
         Err(err) => return error_response(err),
     };
-    spawn_tail_stream_response(&state, pool_ref, runtime, TailStreamEncoding::Jsonl)
+    spawn_tail_stream_response(&state, pool_ref, runtime, TailStreamEncoding::Jsonl, false)
 }
 
 async fn tail_lite3(
@@ -1176,7 +1334,8 @@ async fn tail_lite3(
         Ok(runtime) => runtime,
         Err(err) => return error_response(err),
     };
-    spawn_tail_stream_response(&state, pool_ref, runtime, TailStreamEncoding::Lite3)
+    let zstd = accepts_zstd(&headers);
+    spawn_tail_stream_response(&state, pool_ref, runtime, TailStreamEncoding::Lite3, zstd)
 }
 
 async fn ui_events(
@@ -1194,7 +1353,24 @@ async fn ui_events(
         Ok(runtime) => runtime,
         Err(err) => return error_response(err),
     };
-    spawn_tail_stream_response(&state, pool_ref, runtime, TailStreamEncoding::Sse)
+    spawn_tail_stream_response(&state, pool_ref, runtime, TailStreamEncoding::Sse, false)
+}
+
+/// Whether `Accept-Encoding` lists `zstd` with a non-zero quality.
+fn accepts_zstd(headers: &HeaderMap) -> bool {
+    headers
+        .get_all(header::ACCEPT_ENCODING)
+        .iter()
+        .filter_map(|value| value.to_str().ok())
+        .flat_map(|value| value.split(','))
+        .any(|entry| {
+            let mut parts = entry.split(';').map(str::trim);
+            let coding = parts.next().unwrap_or_default();
+            let quality = parts
+                .find_map(|param| param.strip_prefix("q="))
+                .map_or(Some(1.0), |q| q.parse::<f32>().ok());
+            coding.eq_ignore_ascii_case("zstd") && quality.is_some_and(|q| q > 0.0)
+        })
 }
 
 fn tail_pool_ref_from_request(
@@ -1217,7 +1393,7 @@ fn precheck_lite3_since_seq(
     };
     let precheck = client.open_pool(pool_ref).and_then(|pool| {
         let frame = pool.get_lite3(since_seq)?;
-        lite3::validate_bytes(frame.payload)?;
+        lite3::validate_bytes(&pool.frame_payload(&frame)?)?;
         Ok(())
     });
     match precheck {
@@ -1243,6 +1419,7 @@ fn prepare_tail_runtime(
     let timeout_ms = query.timeout_ms.unwrap_or(state.max_tail_timeout_ms);
     let options = TailOptions {
         since_seq: query.since_seq,
+        since_ns: query.since_time,
         max_messages: query.max.map(|value| value as usize),
         tags: parse_tags_from_query(raw_query),
         timeout: Some(Duration::from_millis(timeout_ms)),
@@ -1270,19 +1447,17 @@ fn spawn_tail_stream_response(
     pool_ref: PoolRef,
     runtime: TailRuntime,
     encoding: TailStreamEncoding,
+    zstd: bool,
 ) -> Response {
     let client = state.client.clone();
+    let hubs = state.tail_hubs.clone();
     let TailRuntime { permit, options } = runtime;
     let (tx, rx) = mpsc::channel::<Result<Bytes, Error>>(16);
-    tokio::task::spawn_blocking(move || {
+    tokio::spawn(async move {
         let _permit = permit;
-        let result = client
-            .open_pool(&pool_ref)
-            .and_then(|pool| stream_tail_bytes(&pool, options, encoding, tx.clone()));
-        if let Err(err) = result {
-            let _ = tx.blocking_send(Err(err));
-        }
+        run_tail_subscriber(client, hubs, pool_ref, options, encoding, tx).await;
     });
+    let rx = if zstd { spawn_zstd_tail_stage(rx) } else { rx };
 
     let stream = ReceiverStream::new(rx).map(move |result| match result {
         Ok(bytes) => Ok(bytes),
@@ -1293,67 +1468,432 @@ fn spawn_tail_stream_response(
     });
     let mut response = Response::new(Body::from_stream(stream));
     apply_tail_response_headers(&mut response, encoding);
+    if zstd {
+        response
+            .headers_mut()
+            .insert(header::CONTENT_ENCODING, HeaderValue::from_static("zstd"));
+        response
+            .headers_mut()
+            .insert(header::VARY, HeaderValue::from_static("accept-encoding"));
+    }
     response
         .headers_mut()
         .insert("plasmite-version", HeaderValue::from_static("0"));
     response
 }
 
-fn stream_tail_bytes(
-    pool: &plasmite::api::Pool,
-    options: TailOptions,
-    encoding: TailStreamEncoding,
-    tx: mpsc::Sender<Result<Bytes, Error>>,
+/// Compress a tail byte stream into one zstd frame. Each wakeup drains the events already
+/// queued, writes them, and flushes a block, so live frames are never held for a full window.
+fn spawn_zstd_tail_stage(
+    mut rx: mpsc::Receiver<Result<Bytes, Error>>,
+) -> mpsc::Receiver<Result<Bytes, Error>> {
+    let (tx, out) = mpsc::channel::<Result<Bytes, Error>>(16);
+    tokio::spawn(async move {
+        let compress_error = |err: std::io::Error| {
+            Error::new(ErrorKind::Io)
+                .with_message("failed to compress tail stream")
+                .with_source(err)
+        };
+        let mut encoder = match zstd::stream::write::Encoder::new(Vec::new(), TAIL_ZSTD_LEVEL) {
+            Ok(encoder) => encoder,
+            Err(err) => {
+                let _ = tx.send(Err(compress_error(err))).await;
+                return;
+            }
+        };
+        while let Some(first) = rx.recv().await {
+            let mut terminal = None;
+            let mut next = Some(first);
+            let mut drained = 0;
+            while let Some(item) = next.take() {
+                match item {
+                    Ok(bytes) => {
+                        if let Err(err) = encoder.write_all(&bytes) {
+                            terminal = Some(compress_error(err));
+                            break;
+                        }
+                    }
+                    Err(err) => {
+                        terminal = Some(err);
+                        break;
+                    }
+                }
+                drained += 1;
+                if drained < TAIL_READ_BATCH_FRAMES {
+                    next = rx.try_recv().ok();
+                }
+            }
+            let chunk = encoder
+                .flush()
+                .map(|()| Bytes::from(std::mem::take(encoder.get_mut())));
+            match chunk {
+                Ok(chunk) => {
+                    if !chunk.is_empty() && tx.send(Ok(chunk)).await.is_err() {
+                        return;
+                    }
+                }
+                Err(err) => terminal = terminal.or(Some(compress_error(err))),
+            }
+            if let Some(err) = terminal {
+                let _ = tx.send(Err(err)).await;
+                return;
+            }
+        }
+        // Upstream ended cleanly: close the zstd frame so the client sees a complete stream.
+        let result = match encoder.finish() {
+            Ok(epilogue) => Ok(Bytes::from(epilogue)),
+            Err(err) => Err(compress_error(err)),
+        };
+        let _ = tx.send(result).await;
+    });
+    out
+}
+
+/// One tail message, decoded and encoded once for every subscriber of a hub.
+#[derive(Clone)]
+struct TailEvent {
+    seq: u64,
+    timestamp_ns: u64,
+    tags: Arc<[String]>,
+    bytes: Bytes,
+}
+
+type TailHubKey = (PoolRef, TailStreamEncoding);
+
+/// Live tail readers shared by all subscribers of the same pool and encoding.
+#[derive(Default)]
+struct TailHubs {
+    hubs: Mutex<HashMap<TailHubKey, broadcast::Sender<TailEvent>>>,
+}
+
+impl TailHubs {
+    /// Join (or start) the hub for `pool_ref`. A new hub broadcasts from the pool's current
+    /// head, so anything the caller has not seen yet is either already committed (and found by
+    /// its catch-up) or still to come through the returned receiver.
+    fn subscribe(
+        self: &Arc<Self>,
+        client: &LocalClient,
+        pool: &Pool,
+        pool_ref: &PoolRef,
+        encoding: TailStreamEncoding,
+    ) -> Result<broadcast::Receiver<TailEvent>, Error> {
+        let key = (pool_ref.clone(), encoding);
+        let mut hubs = self.hubs.lock().unwrap_or_else(PoisonError::into_inner);
+        if let Some(sender) = hubs.get(&key) {
+            return Ok(sender.subscribe());
+        }
+        let start_seq = pool.bounds()?.newest_seq.map_or(0, |seq| seq + 1);
+        let (sender, receiver) = broadcast::channel(TAIL_HUB_CAPACITY);
+        hubs.insert(key.clone(), sender.clone());
+        let client = client.clone();
+        let registry = Arc::clone(self);
+        tokio::task::spawn_blocking(move || {
+            // Reader failures end the hub; subscribers then resume on their own cursor,
+            // which reports the error to the client if it persists.
+            let _ = pump_tail_hub(&client, &registry, &key, &sender, start_seq);
+            registry.retire(&key, &sender, false);
+        });
+        Ok(receiver)
+    }
+
+    /// Drop the hub entry if it still belongs to `sender` (and, with `only_if_idle`, nobody
+    /// listens). Runs under the registry lock so it cannot race a concurrent `subscribe`.
+    fn retire(
+        &self,
+        key: &TailHubKey,
+        sender: &broadcast::Sender<TailEvent>,
+        only_if_idle: bool,
+    ) -> bool {
+        let mut hubs = self.hubs.lock().unwrap_or_else(PoisonError::into_inner);
+        if only_if_idle && sender.receiver_count() > 0 {
+            return false;
+        }
+        if hubs
+            .get(key)
+            .is_some_and(|current| current.same_channel(sender))
+        {
+            hubs.remove(key);
+        }
+        true
+    }
+}
+
+fn pump_tail_hub(
+    client: &LocalClient,
+    hubs: &TailHubs,
+    key: &TailHubKey,
+    sender: &broadcast::Sender<TailEvent>,
+    start_seq: u64,
 ) -> Result<(), Error> {
-    match encoding {
-        TailStreamEncoding::Jsonl | TailStreamEncoding::Sse => {
-            let mut tail = pool.tail(options);
-            while let Some(message) = tail.next_message()? {
-                let encoded = match encoding {
-                    TailStreamEncoding::Jsonl => encode_jsonl_message(&message)?,
-                    TailStreamEncoding::Sse => encode_sse_message(&message)?,
-                    TailStreamEncoding::Lite3 => unreachable!("handled in separate branch"),
-                };
-                if tx.blocking_send(Ok(encoded)).is_err() {
-                    break;
+    let (pool_ref, encoding) = key;
+    let pool = client.open_pool(pool_ref)?;
+    // Hubs only carry live traffic; history is replayed by each subscriber's catch-up.
+    let mut next_seq = start_seq;
+    let mut notify = notify::open_for_path(pool.path());
+    let mut cursor = BatchCursor::new(Cursor::new(), TAIL_READ_BATCH_FRAMES);
+    loop {
+        match cursor.next(&pool)? {
+            CursorResult::Message(frame) => {
+                if frame.seq < next_seq {
+                    continue;
+                }
+                next_seq = frame.seq + 1;
+                let event = encode_tail_event(&pool, &frame, *encoding)?;
+                if sender.send(event).is_err() && hubs.retire(key, sender, true) {
+                    return Ok(());
                 }
             }
+            CursorResult::WouldBlock => {
+                if sender.receiver_count() == 0 && hubs.retire(key, sender, true) {
+                    return Ok(());
+                }
+                let waited = notify
+                    .as_mut()
+                    .map(|handle| handle.wait(TAIL_HUB_POLL_INTERVAL));
+                if matches!(waited, None | Some(NotifyWait::Unavailable)) {
+                    notify = None;
+                    std::thread::sleep(TAIL_HUB_POLL_INTERVAL);
+                }
+            }
+            CursorResult::FellBehind => continue,
+        }
+    }
+}
+
+/// Encode one frame for the wire; clients never see compressed payloads.
+fn encode_tail_event(
+    pool: &Pool,
+    frame: &FrameRef<'_>,
+    encoding: TailStreamEncoding,
+) -> Result<TailEvent, Error> {
+    let payload = pool.frame_payload(frame)?;
+    let frame = &frame.with_payload(&payload);
+    let (tags, bytes) = match encoding {
+        TailStreamEncoding::Jsonl => {
+            let (meta, bytes) = encode_jsonl_frame(frame)?;
+            (meta.tags, bytes)
+        }
+        TailStreamEncoding::Sse => {
+            let (meta, bytes) = encode_sse_frame(frame)?;
+            (meta.tags, bytes)
         }
         TailStreamEncoding::Lite3 => {
-            let mut tail = pool.tail_lite3(options);
-            while let Some(frame) = tail.next_frame()? {
-                lite3::validate_bytes(frame.payload)?;
-                let encoded = encode_lite3_stream_frame(&frame)?;
-                if tx.blocking_send(Ok(encoded)).is_err() {
-                    break;
+            lite3::validate_bytes(frame.payload)?;
+            let meta = Meta::from_lite3(frame.payload)?;
+            (meta.tags, encode_lite3_stream_frame(frame)?)
+        }
+    };
+    Ok(TailEvent {
+        seq: frame.seq,
+        timestamp_ns: frame.timestamp_ns,
+        tags: tags.into(),
+        bytes,
+    })
+}
+
+/// Per-request tail position and limits, carried between catch-up and live phases.
+struct TailSubscriber {
+    next_seq: Option<u64>,
+    since_ns: Option<u64>,
+    remaining: Option<usize>,
+    tags: Vec<String>,
+    tag_mask: u64,
+    deadline: Option<Instant>,
+}
+
+enum TailProgress {
+    /// The request hit `max`/`timeout` or the client went away.
+    Finished,
+    /// Caught up with the pool (or lagged the hub); switch phases.
+    Continue,
+}
+
+impl TailSubscriber {
+    fn new(options: TailOptions) -> Self {
+        Self {
+            next_seq: options.since_seq,
+            since_ns: options.since_ns,
+            remaining: options.max_messages,
+            tag_mask: tag_bloom(options.tags.iter().map(String::as_str)),
+            tags: options.tags,
+            deadline: options.timeout.map(|timeout| Instant::now() + timeout),
+        }
+    }
+
+    fn wants_frame(&self, seq: u64, timestamp_ns: u64) -> bool {
+        self.next_seq.is_none_or(|next_seq| seq >= next_seq)
+            && self.since_ns.is_none_or(|since| timestamp_ns >= since)
+    }
+
+    fn wants_tags(&self, tags: &[String]) -> bool {
+        self.tags.iter().all(|required| tags.contains(required))
+    }
+
+    fn delivered(&mut self, seq: u64) -> TailProgress {
+        self.next_seq = Some(seq + 1);
+        if let Some(remaining) = self.remaining.as_mut() {
+            *remaining = remaining.saturating_sub(1);
+        }
+        if self.is_finished() {
+            TailProgress::Finished
+        } else {
+            TailProgress::Continue
+        }
+    }
+
+    fn is_finished(&self) -> bool {
+        self.remaining == Some(0)
+            || self
+                .deadline
+                .is_some_and(|deadline| Instant::now() >= deadline)
+    }
+}
+
+async fn run_tail_subscriber(
+    client: LocalClient,
+    hubs: Arc<TailHubs>,
+    pool_ref: PoolRef,
+    options: TailOptions,
+    encoding: TailStreamEncoding,
+    tx: mpsc::Sender<Result<Bytes, Error>>,
+) {
+    let mut subscriber = TailSubscriber::new(options);
+    loop {
+        if subscriber.is_finished() {
+            return;
+        }
+        let catch_up = {
+            let client = client.clone();
+            let hubs = hubs.clone();
+            let pool_ref = pool_ref.clone();
+            let tx = tx.clone();
+            tokio::task::spawn_blocking(move || {
+                let result = client.open_pool(&pool_ref).and_then(|pool| {
+                    // Subscribe before catching up so nothing committed in between is
+                    // missed; the overlap is dropped by `wants_frame`.
+                    let events = hubs.subscribe(&client, &pool, &pool_ref, encoding)?;
+                    let progress = catch_up_tail(&pool, &mut subscriber, encoding, &tx)?;
+                    Ok((events, progress))
+                });
+                (subscriber, result)
+            })
+        };
+        let Ok((returned, result)) = catch_up.await else {
+            return;
+        };
+        subscriber = returned;
+        let mut events = match result {
+            Ok((_, TailProgress::Finished)) => return,
+            Ok((events, TailProgress::Continue)) => events,
+            Err(err) => {
+                let _ = tx.send(Err(err)).await;
+                return;
+            }
+        };
+        if let TailProgress::Finished = follow_tail_hub(&mut subscriber, &mut events, &tx).await {
+            return;
+        }
+    }
+}
+
+/// Stream retained frames from `subscriber.next_seq` until the cursor reaches the head.
+fn catch_up_tail(
+    pool: &Pool,
+    subscriber: &mut TailSubscriber,
+    encoding: TailStreamEncoding,
+    tx: &mpsc::Sender<Result<Bytes, Error>>,
+) -> Result<TailProgress, Error> {
+    let mut cursor = Cursor::new();
+    // Before the first delivery, a time bound skips straight past older history.
+    if let (None, Some(since)) = (subscriber.next_seq, subscriber.since_ns) {
+        cursor.seek_to_time(pool, since)?;
+    }
+    let mut cursor = BatchCursor::new(cursor, TAIL_READ_BATCH_FRAMES);
+    loop {
+        if subscriber.is_finished() {
+            return Ok(TailProgress::Finished);
+        }
+        match cursor.next(pool)? {
+            CursorResult::Message(frame) => {
+                if !subscriber.wants_frame(frame.seq, frame.timestamp_ns)
+                    || !tag_bloom_may_match(frame.tag_bloom, subscriber.tag_mask)
+                {
+                    continue;
+                }
+                let event = encode_tail_event(pool, &frame, encoding)?;
+                if !subscriber.wants_tags(&event.tags) {
+                    continue;
+                }
+                if tx.blocking_send(Ok(event.bytes)).is_err() {
+                    return Ok(TailProgress::Finished);
+                }
+                if let TailProgress::Finished = subscriber.delivered(event.seq) {
+                    return Ok(TailProgress::Finished);
                 }
             }
+            CursorResult::WouldBlock => return Ok(TailProgress::Continue),
+            CursorResult::FellBehind => continue,
         }
     }
-    Ok(())
 }
 
-fn encode_message_payload(message: &plasmite::api::Message) -> Result<Vec<u8>, Error> {
-    serde_json::to_vec(&message_json(message)).map_err(|err| {
-        Error::new(ErrorKind::Internal)
-            .with_message("failed to encode message")
-            .with_source(err)
-    })
+/// Forward hub events until the request finishes or the subscriber lags the ring.
+async fn follow_tail_hub(
+    subscriber: &mut TailSubscriber,
+    events: &mut broadcast::Receiver<TailEvent>,
+    tx: &mpsc::Sender<Result<Bytes, Error>>,
+) -> TailProgress {
+    loop {
+        let deadline = subscriber.deadline.map(tokio::time::Instant::from_std);
+        let received = async {
+            match deadline {
+                Some(deadline) => tokio::time::timeout_at(deadline, events.recv()).await.ok(),
+                None => Some(events.recv().await),
+            }
+        };
+        let event = tokio::select! {
+            _ = tx.closed() => return TailProgress::Finished,
+            received = received => match received {
+                None => return TailProgress::Finished,
+                Some(Ok(event)) => event,
+                // Lagged or hub ended: resume from the pool at `next_seq`.
+                Some(Err(_)) => return TailProgress::Continue,
+            },
+        };
+        if !subscriber.wants_frame(event.seq, event.timestamp_ns)
+            || !subscriber.wants_tags(&event.tags)
+        {
+            continue;
+        }
+        if tx.send(Ok(event.bytes)).await.is_err() {
+            return TailProgress::Finished;
+        }
+        if let TailProgress::Finished = subscriber.delivered(event.seq) {
+            return TailProgress::Finished;
+        }
+    }
 }
 
-fn encode_jsonl_message(message: &plasmite::api::Message) -> Result<Bytes, Error> {
-    let mut payload = encode_message_payload(message)?;
+// Tail events are written straight from the Lite3 payload (same bytes as `message_json`).
+// JSON text is usually no larger than its Lite3 encoding, so one allocation covers most frames.
+fn tail_event_buf(frame: &FrameRef<'_>) -> Vec<u8> {
+    Vec::with_capacity(frame.payload.len() + 128)
+}
+
+fn encode_jsonl_frame(frame: &FrameRef<'_>) -> Result<(Meta, Bytes), Error> {
+    let mut payload = tail_event_buf(frame);
+    let meta = Message::write_frame_json(frame, &mut payload)?;
     payload.push(b'\n');
-    Ok(Bytes::from(payload))
+    Ok((meta, Bytes::from(payload)))
 }
 
-fn encode_sse_message(message: &plasmite::api::Message) -> Result<Bytes, Error> {
-    let mut payload = encode_message_payload(message)?;
+fn encode_sse_frame(frame: &FrameRef<'_>) -> Result<(Meta, Bytes), Error> {
+    let mut payload = tail_event_buf(frame);
     // SSE event frame: clients parse one JSON message per event.
-    let mut frame = b"event: message\ndata: ".to_vec();
-    frame.append(&mut payload);
-    frame.extend_from_slice(b"\n\n");
-    Ok(Bytes::from(frame))
+    payload.extend_from_slice(b"event: message\ndata: ");
+    let meta = Message::write_frame_json(frame, &mut payload)?;
+    payload.extend_from_slice(b"\n\n");
+    Ok((meta, Bytes::from(payload)))
 }
 
 fn encode_tail_terminal_error(err: &Error, encoding: TailStreamEncoding) -> Option<Bytes> {
@@ -1447,6 +1987,17 @@ fn json_response(payload: serde_json::Value) -> Response {
     response
 }
 
+fn text_response(body: String, content_type: &'static str) -> Response {
+    let mut response = Response::new(Body::from(body));
+    response
+        .headers_mut()
+        .insert("content-type", HeaderValue::from_static(content_type));
+    response
+        .headers_mut()
+        .insert("plasmite-version", HeaderValue::from_static("0"));
+    response
+}
+
 fn html_response(body: &str) -> Response {
     let mut response = Response::new(Body::from(body.to_owned()));
     response.headers_mut().insert(
@@ -1479,10 +2030,29 @@ fn error_json_string(err: &Error) -> String {
 fn durability_from_str(value: Option<&str>) -> Durability {
     match value {
         Some("flush") => Durability::Flush,
+        Some("group") => Durability::group_commit(),
         _ => Durability::Fast,
     }
 }
 
+/// Run an append inline, or on the blocking pool when it waits for a group commit so the
+/// appends that share its flush are not starved of runtime workers.
+async fn run_append<T: Send + 'static>(
+    durability: Durability,
+    append: impl FnOnce() -> Result<T, Error> + Send + 'static,
+) -> Result<T, Error> {
+    if !matches!(durability, Durability::GroupCommit { .. }) {
+        return append();
+    }
+    tokio::task::spawn_blocking(append)
+        .await
+        .unwrap_or_else(|err| {
+            Err(Error::new(ErrorKind::Internal)
+                .with_message("append task failed")
+                .with_source(err))
+        })
+}
+
 fn error_response(err: Error) -> Response {
     let status = match err.kind() {
         ErrorKind::Usage => StatusCode::BAD_REQUEST,
@@ -1532,9 +2102,15 @@ fn is_access_forbidden(err: &Error) -> bool {
 #[cfg(test)]
 mod tests {
     use super::{
-        AccessMode, ErrorKind, ServeConfig, build_cors_layer, normalize_cors_origins,
-        normalize_tags, parse_tags_from_query, serve, validate_config,
+        AccessMode, ErrorKind, ServeConfig, TailHubs, TailStreamEncoding, build_cors_layer,
+        normalize_cors_origins, normalize_tags, parse_tags_from_query, run_tail_subscriber, serve,
+        validate_config,
     };
+    use plasmite::api::{Durability, LocalClient, PoolApiExt, PoolOptions, PoolRef, TailOptions};
+    use serde_json::json;
+    use std::sync::Arc;
+    use tokio::sync::mpsc;
+    use tokio::time::Duration;
 
     #[tokio::test]
     async fn serve_rejects_non_loopback_bind() {
@@ -1823,4 +2399,62 @@ mod tests {
 
         server.abort();
     }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn tail_subscribers_share_one_hub_for_live_messages() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let client = LocalClient::new().with_pool_dir(temp.path());
+        let pool_ref = PoolRef::name("hub");
+        client
+            .create_pool(&pool_ref, PoolOptions::new(1024 * 1024))
+            .expect("create");
+        let mut pool = client.open_pool(&pool_ref).expect("open");
+        pool.append_json_now(&json!({"n": 1}), &[], Durability::Fast)
+            .expect("append");
+
+        let hubs = Arc::new(TailHubs::default());
+        let mut streams = Vec::new();
+        for _ in 0..2 {
+            let (tx, rx) = mpsc::channel(16);
+            let options = TailOptions {
+                max_messages: Some(2),
+                timeout: Some(Duration::from_secs(10)),
+                ..TailOptions::default()
+            };
+            tokio::spawn(run_tail_subscriber(
+                client.clone(),
+                hubs.clone(),
+                pool_ref.clone(),
+                options,
+                TailStreamEncoding::Jsonl,
+                tx,
+            ));
+            streams.push(rx);
+        }
+
+        // History arrives through each subscriber's own catch-up...
+        for rx in &mut streams {
+            let line = rx.recv().await.expect("first").expect("ok");
+            assert!(String::from_utf8_lossy(&line).contains(r#""data":{"n":1}"#));
+        }
+        assert_eq!(hubs.hubs.lock().expect("lock").len(), 1);
+
+        // ...and live traffic through the shared hub.
+        pool.append_json_now(&json!({"n": 2}), &[], Durability::Fast)
+            .expect("append");
+        for rx in &mut streams {
+            let line = rx.recv().await.expect("second").expect("ok");
+            assert!(String::from_utf8_lossy(&line).contains(r#""data":{"n":2}"#));
+            assert!(rx.recv().await.is_none(), "max reached");
+        }
+
+        // The reader retires once nobody listens.
+        for _ in 0..100 {
+            if hubs.hubs.lock().expect("lock").is_empty() {
+                return;
+            }
+            tokio::time::sleep(Duration::from_millis(20)).await;
+        }
+        panic!("tail hub still registered");
+    }
 }
@@ -871,6 +871,66 @@ fn create_feed_fetch_follow_flow() {
     let _ = follower.wait();
 }
 
+#[test]
+fn pool_create_shards_makes_a_group_reported_per_shard() {
+    let temp = tempfile::tempdir().expect("tempdir");
+    let pool_dir = temp.path().join("pools");
+    let dir = pool_dir.to_str().unwrap();
+
+    let create = cmd()
+        .args([
+            "--dir",
+            dir,
+            "pool",
+            "create",
+            "--shards",
+            "3",
+            "--size",
+            "64K",
+            "--json",
+            "telemetry",
+        ])
+        .output()
+        .expect("create");
+    assert!(create.status.success());
+    let created = parse_json(std::str::from_utf8(&create.stdout).expect("utf8"));
+    let created = created["created"].as_array().expect("created");
+    assert_eq!(created.len(), 3);
+    assert_eq!(created[2]["name"], "telemetry#2");
+    assert!(pool_dir.join("telemetry.plasmite").is_dir());
+
+    let info = cmd()
+        .args(["--dir", dir, "pool", "info", "telemetry", "--json"])
+        .output()
+        .expect("info");
+    assert!(info.status.success());
+    let info = parse_json(std::str::from_utf8(&info.stdout).expect("utf8"));
+    assert_eq!(info["shard_count"], 3);
+    assert_eq!(info["shards"][1]["name"], "telemetry#1");
+    assert_eq!(info["shards"][1]["file_size"], 64 * 1024);
+
+    let list = cmd()
+        .args(["--dir", dir, "pool", "list", "--json"])
+        .output()
+        .expect("list");
+    assert!(list.status.success());
+    let list = parse_json(std::str::from_utf8(&list.stdout).expect("utf8"));
+    let names: Vec<&str> = list["pools"]
+        .as_array()
+        .expect("pools")
+        .iter()
+        .filter_map(|pool| pool["name"].as_str())
+        .collect();
+    assert_eq!(names, vec!["telemetry#0", "telemetry#1", "telemetry#2"]);
+
+    let delete = cmd()
+        .args(["--dir", dir, "pool", "delete", "telemetry"])
+        .output()
+        .expect("delete");
+    assert!(delete.status.success());
+    assert!(!pool_dir.join("telemetry.plasmite").exists());
+}
+
 #[test]
 fn pool_create_defaults_to_table_output() {
     let temp = tempfile::tempdir().expect("tempdir");
@@ -962,6 +1022,10 @@ fn pool_info_json_includes_metrics() {
     assert!(metrics["age"]["newest_time"].is_string());
     assert!(metrics["age"]["oldest_age_ms"].is_number());
     assert!(metrics["age"]["newest_age_ms"].is_number());
+    let hot = info_json.get("hot_metrics").expect("hot_metrics");
+    assert_eq!(hot["append_lock"]["acquires"], 2);
+    assert!(hot["get"]["index_hits"].is_u64());
+    assert!(hot["cursor"]["resyncs"].is_u64());
 }
 
 #[test]
@@ -3163,6 +3227,89 @@ fn emit_errors_skip_emits_notices_and_nonzero() {
     assert!(summary.get("notice").is_some());
 }
 
+#[test]
+fn feed_workers_commit_in_input_order_and_keep_skip_policy() {
+    let temp = tempfile::tempdir().expect("tempdir");
+    let pool_dir = temp.path().join("pools");
+
+    let create = cmd()
+        .args([
+            "--dir",
+            pool_dir.to_str().unwrap(),
+            "pool",
+            "create",
+            "demo",
+        ])
+        .output()
+        .expect("create");
+    assert!(create.status.success());
+
+    let mut input = String::new();
+    for x in 1..=300 {
+        if x == 150 {
+            input.push_str("not-json\n");
+        } else {
+            input.push_str(&format!("{{\"x\":{x}}}\n"));
+        }
+    }
+    let mut feed = cmd()
+        .args([
+            "--dir",
+            pool_dir.to_str().unwrap(),
+            "feed",
+            "demo",
+            "-i",
+            "jsonl",
+            "-e",
+            "skip",
+            "--workers",
+            "4",
+        ])
+        .stdin(Stdio::piped())
+        .stdout(Stdio::piped())
+        .stderr(Stdio::piped())
+        .spawn()
+        .expect("feed");
+    feed.stdin
+        .take()
+        .expect("stdin")
+        .write_all(input.as_bytes())
+        .expect("write stdin");
+    let output = feed.wait_with_output().expect("feed output");
+    assert_eq!(output.status.code().unwrap(), 1);
+    let receipts = parse_json_lines(&output.stdout);
+    assert_eq!(receipts.len(), 299);
+    let seqs: Vec<u64> = receipts
+        .iter()
+        .map(|receipt| receipt["seq"].as_u64().expect("seq"))
+        .collect();
+    assert!(seqs.windows(2).all(|pair| pair[1] == pair[0] + 1));
+
+    let notices = parse_json_lines(&output.stderr);
+    assert_eq!(notices[0]["notice"]["kind"], "ingest_skip");
+    assert!(
+        std::str::from_utf8(&output.stderr)
+            .expect("utf8")
+            .contains("not-json")
+    );
+
+    for (seq, x) in [(seqs[148], 149), (seqs[149], 151), (seqs[298], 300)] {
+        let fetch = cmd()
+            .args([
+                "--dir",
+                pool_dir.to_str().unwrap(),
+                "fetch",
+                "demo",
+                &seq.to_string(),
+            ])
+            .output()
+            .expect("fetch");
+        assert!(fetch.status.success());
+        let message = parse_json(std::str::from_utf8(&fetch.stdout).expect("utf8"));
+        assert_eq!(message["data"]["x"], x);
+    }
+}
+
 #[test]
 fn emit_errors_skip_reports_oversize() {
     let temp = tempfile::tempdir().expect("tempdir");
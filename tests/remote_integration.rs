@@ -7,7 +7,7 @@
 
 use plasmite::api::{
     AppendOptions, Durability, ErrorKind, LocalClient, Pool, PoolApiExt, PoolOptions, PoolRef,
-    RemoteClient, TailOptions,
+    RemoteClient, RemoteLite3AppenderOptions, TailOptions, lite3,
 };
 use serde_json::{Value, json};
 use std::io::Read;
@@ -186,6 +186,63 @@ fn remote_append_get_tail_lite3() -> TestResult<()> {
     Ok(())
 }
 
+#[test]
+fn remote_lite3_batches_round_trip_with_zstd() -> TestResult<()> {
+    let temp_dir = tempfile::tempdir()?;
+    let server = TestServer::start(temp_dir.path())?;
+    let client = server.client()?.with_zstd();
+    let pool_ref = PoolRef::name("lite3-batch");
+
+    client.create_pool(&pool_ref, PoolOptions::new(1024 * 1024))?;
+    let pool = client.open_pool(&pool_ref)?;
+    let payloads = (0..7)
+        .map(|index| lite3::encode_message(&[], &json!({"index": index, "body": "repeat"})))
+        .collect::<Result<Vec<_>, _>>()?;
+
+    let mut appender = pool.lite3_appender(RemoteLite3AppenderOptions {
+        max_batch_frames: 3,
+        ..RemoteLite3AppenderOptions::default()
+    });
+    for payload in &payloads[..5] {
+        appender.push(payload.as_slice())?;
+    }
+    assert_eq!(appender.pending(), 2);
+    assert_eq!(appender.flush()?, vec![1, 2, 3, 4, 5]);
+    let rest = payloads[5..]
+        .iter()
+        .map(|payload| payload.as_slice())
+        .collect::<Vec<_>>();
+    assert_eq!(
+        pool.append_lite3_batch(&rest, Durability::Flush)?,
+        vec![6, 7]
+    );
+
+    let options = TailOptions {
+        since_seq: Some(1),
+        max_messages: Some(payloads.len()),
+        timeout: Some(Duration::from_millis(500)),
+        ..TailOptions::default()
+    };
+    let mut tail = pool.tail_lite3(options)?;
+    let mut frames = Vec::new();
+    loop {
+        let batch = tail.next_batch(4)?;
+        if batch.is_empty() {
+            break;
+        }
+        assert!(batch.len() <= 4);
+        frames.extend(batch);
+    }
+    assert_eq!(
+        frames.iter().map(|frame| frame.seq).collect::<Vec<_>>(),
+        (1..=7).collect::<Vec<u64>>()
+    );
+    for (frame, payload) in frames.iter().zip(&payloads) {
+        assert_eq!(frame.payload, payload.as_slice());
+    }
+    Ok(())
+}
+
 #[test]
 fn remote_lite3_invalid_payloads_error() -> TestResult<()> {
     let temp_dir = tempfile::tempdir()?;
@@ -676,6 +733,36 @@ fn remote_tail_filters_by_tags_with_commas() -> TestResult<()> {
     Ok(())
 }
 
+#[test]
+fn remote_pool_metrics_exposes_prometheus_text() -> TestResult<()> {
+    let temp_dir = tempfile::tempdir()?;
+    let server = TestServer::start(temp_dir.path())?;
+    let client = server.client()?;
+    let pool_ref = PoolRef::name("metrics");
+
+    client.create_pool(&pool_ref, PoolOptions::new(1024 * 1024))?;
+    let pool = client.open_pool(&pool_ref)?;
+    let message = pool.append_json_now(&json!({"n": 1}), &[], Durability::Fast)?;
+    pool.get_message(message.seq)?;
+
+    let response = ureq::get(&format!("{}/v0/pools/metrics/metrics", server.base_url))
+        .call()
+        .expect("metrics route");
+    assert_eq!(response.status(), 200);
+    assert!(
+        response
+            .header("content-type")
+            .unwrap_or_default()
+            .starts_with("text/plain")
+    );
+    let body = response.into_string()?;
+    assert!(body.contains("plasmite_append_lock_acquires_total{pool=\"metrics\"} 1"));
+    assert!(body.contains("plasmite_get_index_hits_total{pool=\"metrics\"} 1"));
+    assert!(body.contains("# TYPE plasmite_append_lock_wait_seconds histogram"));
+    assert!(body.contains("plasmite_lite3_encode_calls_total"));
+    Ok(())
+}
+
 #[test]
 fn remote_ui_routes_serve_single_page_html() -> TestResult<()> {
     let temp_dir = tempfile::tempdir()?;